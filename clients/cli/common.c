@@ -955,7 +955,7 @@ nmc_secret_redisplay (void)
 	int save_point = rl_point;
 	int save_end = rl_end;
 	char *save_line_buffer = rl_line_buffer;
-	const char *subst = nmc_password_subst_char ();
+	const char *subst = nmc_password_subst_char (nmc_getenv ("TERM"));
 	int subst_len = strlen (subst);
 	int i;
 
@@ -814,7 +814,7 @@ usage (void)
 {
 	g_printerr (_("Usage: nmcli connection { COMMAND | help }\n\n"
 	              "COMMAND := { show | up | down | add | modify | clone | edit | delete | monitor | reload | load | import | export }\n\n"
-	              "  show [--active] [--order <order spec>]\n"
+	              "  show [--active] [--order <order spec>] [--offset <num>] [--limit <num>]\n"
 	              "  show [--active] [id | uuid | path | apath] <ID> ...\n\n"
 	              "  up [[id | uuid | path] <ID>] [ifname <ifname>] [ap <BSSID>] [passwd-file <file with passwords>]\n\n"
 	              "  down [id | uuid | path | apath] <ID> ...\n\n"
@@ -836,12 +836,13 @@ usage_connection_show (void)
 {
 	g_printerr (_("Usage: nmcli connection show { ARGUMENTS | help }\n"
 	              "\n"
-	              "ARGUMENTS := [--active] [--order <order spec>]\n"
+	              "ARGUMENTS := [--active] [--order <order spec>] [--offset <num>] [--limit <num>]\n"
 	              "\n"
 	              "List in-memory and on-disk connection profiles, some of which may also be\n"
 	              "active if a device is using that connection profile. Without a parameter, all\n"
 	              "profiles are listed. When --active option is specified, only the active\n"
 	              "profiles are shown. --order allows custom connection ordering (see manual page).\n"
+	              "--offset and --limit only show a window of the ordered list.\n"
 	              "\n"
 	              "ARGUMENTS := [--active] [id | uuid | path | apath] <ID> ...\n"
 	              "\n"
@@ -1922,11 +1923,14 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 	gs_free char *active_flds = NULL;
 	gboolean active_only = FALSE;
 	gs_unref_array GArray *order = NULL;
+	guint offset = 0;
+	guint limit = G_MAXUINT;
+	unsigned long num;
 	guint i;
 	int option;
 
-	/* check connection show options [--active] [--order <order spec>] */
-	while ((option = next_arg (nmc, &argc, &argv, "--active", "--order", NULL)) > 0) {
+	/* check connection show options [--active] [--order <order spec>] [--offset <num>] [--limit <num>] */
+	while ((option = next_arg (nmc, &argc, &argv, "--active", "--order", "--offset", "--limit", NULL)) > 0) {
 		switch (option) {
 		case 1: /* --active */
 			active_only = TRUE;
@@ -1943,6 +1947,28 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 			if (err)
 				goto finish;
 			break;
+		case 3: /* --offset */
+		case 4: /* --limit */
+			argc--;
+			argv++;
+			if (!argc) {
+				g_set_error (&err, NMCLI_ERROR, 0,
+				             _("'%s' argument is missing"),
+				             option == 3 ? "--offset" : "--limit");
+				goto finish;
+			}
+			if (!nmc_string_to_uint (*argv, TRUE, 0, G_MAXUINT, &num)) {
+				g_set_error (&err, NMCLI_ERROR, 0,
+				             _("invalid value '%s' of '%s' option"),
+				             *argv,
+				             option == 3 ? "--offset" : "--limit");
+				goto finish;
+			}
+			if (option == 3)
+				offset = num;
+			else
+				limit = num;
+			break;
 		default:
 			g_assert_not_reached();
 			break;
@@ -1991,6 +2017,13 @@ do_connections_show (NmCli *nmc, int argc, char **argv)
 		nm_cli_spawn_pager (nmc);
 
 		items = con_show_get_items (nmc, active_only, show_active_fields, order);
+
+		/* the items are sorted, so the window is stable between invocations. */
+		if (offset > 0)
+			g_ptr_array_remove_range (items, 0, NM_MIN (offset, items->len));
+		if (items->len > limit)
+			g_ptr_array_set_size (items, limit);
+
 		g_ptr_array_add (items, NULL);
 		if (!nmc_print (&nmc->nmc_config,
 		                items->pdata,
@@ -4904,7 +4937,7 @@ again:
 	value = nmc_readline (&nmc->nmc_config,
 	                      "%s",
 	                      prompt);
-	if (multi && !value)
+	if (!value && (multi || nmc_exit_requested ()))
 		return;
 
 	if (!set_option (nmc, connection, abstract_info, value, &error)) {
@@ -6861,6 +6894,8 @@ property_edit_submenu (NmCli *nmc,
 		cmd_property_user = nmc_readline (&nmc->nmc_config,
 		                                  "%s",
 		                                  prompt);
+		if (!cmd_property_user && nmc_exit_requested ())
+			return FALSE;
 		if (!cmd_property_user || !*cmd_property_user)
 			continue;
 		g_strstrip (cmd_property_user);
@@ -7256,6 +7291,8 @@ editor_menu_main (NmCli *nmc, NMConnection *connection, const char *connection_t
 			           "You may type 'save' to restore it.\n"));
 		}
 
+		if (!cmd_user && nmc_exit_requested ())
+			break;
 		if (!cmd_user || !*cmd_user)
 			continue;
 
@@ -8215,6 +8252,10 @@ do_connection_edit (NmCli *nmc, int argc, char **argv)
 
 			type_ask = nmc_readline (&nmc->nmc_config,
 			                         EDITOR_PROMPT_CON_TYPE);
+			if (!type_ask && nmc_exit_requested ()) {
+				g_free (tmp_str);
+				return nmc->return_value;
+			}
 			type = type_ask = nm_strstrip (type_ask);
 			connection_type = check_valid_name_toplevel (type_ask, &slave_type, &err1);
 		}
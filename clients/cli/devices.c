@@ -34,6 +34,7 @@
 #include "utils.h"
 #include "common.h"
 #include "connections.h"
+#include "event-stream.h"
 
 /* define some prompts */
 #define PROMPT_INTERFACE  _("Interface: ")
@@ -824,11 +825,12 @@ usage_device_monitor (void)
 {
 	g_printerr (_("Usage: nmcli device monitor { ARGUMENTS | help }\n"
 	              "\n"
-	              "ARGUMENTS := [<ifname>] ...\n"
+	              "ARGUMENTS := [--json] [<ifname>] ...\n"
 	              "\n"
 	              "Monitor device activity.\n"
 	              "This command prints a line whenever the specified devices change state.\n"
-	              "Monitors all devices in case no interface is specified.\n\n"));
+	              "Monitors all devices in case no interface is specified.\n"
+	              "With --json, prints a JSON object per line with the changed device properties.\n\n"));
 }
 
 static void
@@ -1216,7 +1218,7 @@ fill_output_access_point (gpointer data, gpointer user_data)
 	strength_str = g_strdup_printf ("%u", strength);
 	wpa_flags_str = ap_wpa_rsn_flags_to_string (wpa_flags);
 	rsn_flags_str = ap_wpa_rsn_flags_to_string (rsn_flags);
-	sig_bars = nmc_wifi_strength_bars (strength);
+	sig_bars = nmc_wifi_strength_bars (strength, nmc_getenv ("TERM"));
 
 	security_str = g_string_new (NULL);
 
@@ -2670,13 +2672,68 @@ device_removed (NMClient *client, NMDevice *device, NmCli *nmc)
 	device_unwatch (nmc, device);
 }
 
+static void
+device_json_removed (NMClient *client, NMDevice *device, NmCli *nmc)
+{
+	/* Terminate if all the watched devices disappeared. */
+	if (   nmc->event_stream
+	    && nmc_event_stream_get_n_watched (nmc->event_stream) == 0)
+		quit ();
+}
+
+static void
+devices_monitor_json (NmCli *nmc, int argc, char **argv)
+{
+	NmcEventStream *stream;
+
+	stream = nmc_event_stream_new ();
+	nmc->event_stream = stream;
+
+	if (argc == 0) {
+		const GPtrArray *devices = nm_client_get_devices (nmc->client);
+		guint i;
+
+		for (i = 0; i < devices->len; i++)
+			nmc_event_stream_watch (stream, devices->pdata[i]);
+
+		/* We'll watch the device additions too, never exit. */
+		nmc_event_stream_track (stream, nmc->client,
+		                        NM_CLIENT_DEVICE_ADDED, NM_CLIENT_DEVICE_REMOVED);
+		nmc->should_wait++;
+	} else {
+		GSList *queue = get_device_list (nmc, argc, argv);
+		GSList *iter;
+
+		for (iter = queue; iter; iter = g_slist_next (iter))
+			nmc_event_stream_watch (stream, iter->data);
+		g_slist_free (queue);
+
+		nmc_event_stream_track (stream, nmc->client,
+		                        NULL, NM_CLIENT_DEVICE_REMOVED);
+		if (nmc_event_stream_get_n_watched (stream) > 0) {
+			nmc->should_wait++;
+			nmc->event_stream_removed_id = g_signal_connect_after (nmc->client, NM_CLIENT_DEVICE_REMOVED,
+			                                                       G_CALLBACK (device_json_removed), nmc);
+		}
+	}
+}
+
 static NMCResultCode
 do_devices_monitor (NmCli *nmc, int argc, char **argv)
 {
+	gboolean json = FALSE;
+
 	if (nmc->complete)
 		return nmc->return_value;
 
-	next_arg (nmc, &argc, &argv, NULL);
+	while (next_arg (nmc, &argc, &argv, "--json", NULL) > 0)
+		json = TRUE;
+
+	if (json) {
+		devices_monitor_json (nmc, argc, argv);
+		return nmc->return_value;
+	}
+
 	if (argc == 0) {
 		/* No devices specified. Monitor all. */
 		const GPtrArray *devices = nm_client_get_devices (nmc->client);
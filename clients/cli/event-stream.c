@@ -0,0 +1,552 @@
+/* nmcli - command-line tool to control NetworkManager
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright 2018 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include "event-stream.h"
+
+#include <stdio.h>
+#include <math.h>
+
+#include "nm-common-macros.h"
+
+/*
+ * The event stream backs "nmcli monitor --json". Every event is a single
+ * line with a JSON object:
+ *
+ *   {"ts":1537880192437151,"path":"/org/freedesktop/NetworkManager/Devices/3",
+ *    "event":"changed","props":{"state":100,"ip4-config":"/org/..."}}
+ *
+ * "ts" is the wall clock time in microseconds at which the event was first
+ * seen. Property values are taken directly from the GObject properties of
+ * the libnm objects when they are notified, objects are referred to by their
+ * D-Bus path.
+ *
+ * Notifications are not printed right away. Changes of the same object are
+ * merged until the stream is flushed from an idle handler, which happens
+ * once per main loop iteration. A batch is written with a single write to
+ * stdout.
+ */
+
+typedef struct {
+	GObject *object;
+	gint64 ts;
+	NmcEventKind kind;
+	GPtrArray *pspecs;
+
+	/* the JSON values of @pspecs, or %NULL for those that are not
+	 * part of the stream. */
+	GPtrArray *values;
+} Event;
+
+struct _NmcEventStream {
+	GHashTable *watched;
+	GPtrArray *events;
+	GHashTable *changed;
+	GString *buf;
+	FILE *out;
+	guint flush_id;
+	NMClient *client;
+	GArray *client_handlers;
+};
+
+/*****************************************************************************/
+
+static void
+_event_free (gpointer data)
+{
+	Event *event = data;
+
+	g_object_unref (event->object);
+	if (event->pspecs) {
+		g_ptr_array_unref (event->pspecs);
+		g_ptr_array_unref (event->values);
+	}
+	g_slice_free (Event, event);
+}
+
+static const char *
+_object_get_path (GObject *object)
+{
+	if (NM_IS_OBJECT (object))
+		return nm_object_get_path (NM_OBJECT (object));
+	if (NM_IS_CLIENT (object))
+		return NM_DBUS_PATH;
+	return NULL;
+}
+
+static void
+_append_string (GString *str, const char *s)
+{
+	if (!s) {
+		g_string_append (str, "null");
+		return;
+	}
+
+	g_string_append_c (str, '"');
+	for (; *s; s++) {
+		switch (*s) {
+		case '"':
+			g_string_append (str, "\\\"");
+			break;
+		case '\\':
+			g_string_append (str, "\\\\");
+			break;
+		case '\n':
+			g_string_append (str, "\\n");
+			break;
+		case '\t':
+			g_string_append (str, "\\t");
+			break;
+		default:
+			if (((guchar) *s) < 0x20)
+				g_string_append_printf (str, "\\u%04x", (guint) ((guchar) *s));
+			else
+				g_string_append_c (str, *s);
+			break;
+		}
+	}
+	g_string_append_c (str, '"');
+}
+
+static gboolean
+_append_value (GString *str, GObject *object, GParamSpec *pspec)
+{
+	nm_auto_unset_gvalue GValue value = G_VALUE_INIT;
+	GType type = G_PARAM_SPEC_VALUE_TYPE (pspec);
+	guint i;
+
+	/* GPtrArrays of boxed values are not part of the stream. */
+	if (   type == G_TYPE_PTR_ARRAY
+	    && !g_type_is_a (nm_param_spec_get_element_type (pspec), G_TYPE_OBJECT))
+		return FALSE;
+
+	g_value_init (&value, type);
+	g_object_get_property (object, pspec->name, &value);
+
+	switch (G_TYPE_FUNDAMENTAL (type)) {
+	case G_TYPE_BOOLEAN:
+		g_string_append (str, g_value_get_boolean (&value) ? "true" : "false");
+		return TRUE;
+	case G_TYPE_CHAR:
+		g_string_append_printf (str, "%d", (int) g_value_get_schar (&value));
+		return TRUE;
+	case G_TYPE_UCHAR:
+		g_string_append_printf (str, "%u", (guint) g_value_get_uchar (&value));
+		return TRUE;
+	case G_TYPE_INT:
+		g_string_append_printf (str, "%d", g_value_get_int (&value));
+		return TRUE;
+	case G_TYPE_UINT:
+		g_string_append_printf (str, "%u", g_value_get_uint (&value));
+		return TRUE;
+	case G_TYPE_LONG:
+		g_string_append_printf (str, "%ld", g_value_get_long (&value));
+		return TRUE;
+	case G_TYPE_ULONG:
+		g_string_append_printf (str, "%lu", g_value_get_ulong (&value));
+		return TRUE;
+	case G_TYPE_INT64:
+		g_string_append_printf (str, "%"G_GINT64_FORMAT, g_value_get_int64 (&value));
+		return TRUE;
+	case G_TYPE_UINT64:
+		g_string_append_printf (str, "%"G_GUINT64_FORMAT, g_value_get_uint64 (&value));
+		return TRUE;
+	case G_TYPE_ENUM:
+		g_string_append_printf (str, "%d", g_value_get_enum (&value));
+		return TRUE;
+	case G_TYPE_FLAGS:
+		g_string_append_printf (str, "%u", g_value_get_flags (&value));
+		return TRUE;
+	case G_TYPE_FLOAT:
+	case G_TYPE_DOUBLE: {
+		char buf[G_ASCII_DTOSTR_BUF_SIZE];
+		double d;
+
+		d =   type == G_TYPE_FLOAT
+		    ? g_value_get_float (&value)
+		    : g_value_get_double (&value);
+		/* JSON has no locale: always use a decimal point. */
+		if (isfinite (d))
+			g_string_append (str, g_ascii_dtostr (buf, sizeof (buf), d));
+		else
+			g_string_append (str, "null");
+		return TRUE;
+	}
+	case G_TYPE_STRING:
+		_append_string (str, g_value_get_string (&value));
+		return TRUE;
+	case G_TYPE_OBJECT: {
+		GObject *obj = g_value_get_object (&value);
+
+		_append_string (str, obj ? _object_get_path (obj) : NULL);
+		return TRUE;
+	}
+	case G_TYPE_BOXED:
+		if (type == G_TYPE_STRV) {
+			const char *const *strv = g_value_get_boxed (&value);
+
+			g_string_append_c (str, '[');
+			for (i = 0; strv && strv[i]; i++) {
+				if (i > 0)
+					g_string_append_c (str, ',');
+				_append_string (str, strv[i]);
+			}
+			g_string_append_c (str, ']');
+			return TRUE;
+		}
+		if (type == G_TYPE_PTR_ARRAY) {
+			const GPtrArray *arr = g_value_get_boxed (&value);
+
+			g_string_append_c (str, '[');
+			for (i = 0; arr && i < arr->len; i++) {
+				if (i > 0)
+					g_string_append_c (str, ',');
+				_append_string (str, _object_get_path (arr->pdata[i]));
+			}
+			g_string_append_c (str, ']');
+			return TRUE;
+		}
+		if (type == G_TYPE_BYTES) {
+			GBytes *bytes = g_value_get_boxed (&value);
+			gs_free char *s = NULL;
+
+			if (bytes) {
+				s = nm_utils_bin2hexstr (g_bytes_get_data (bytes, NULL),
+				                         g_bytes_get_size (bytes),
+				                         -1);
+			}
+			_append_string (str, s);
+			return TRUE;
+		}
+		return FALSE;
+	default:
+		return FALSE;
+	}
+}
+
+static void
+_event_write (NmcEventStream *self, Event *event)
+{
+	GString *buf = self->buf;
+	guint i;
+	gboolean first = TRUE;
+
+	g_string_append_printf (buf, "{\"ts\":%"G_GINT64_FORMAT",\"path\":", event->ts);
+	_append_string (buf, _object_get_path (event->object));
+
+	switch (event->kind) {
+	case NMC_EVENT_ADDED:
+		g_string_append (buf, ",\"event\":\"added\",\"type\":");
+		_append_string (buf, G_OBJECT_TYPE_NAME (event->object));
+		break;
+	case NMC_EVENT_REMOVED:
+		g_string_append (buf, ",\"event\":\"removed\"");
+		break;
+	case NMC_EVENT_CHANGED:
+		g_string_append (buf, ",\"event\":\"changed\",\"props\":{");
+		for (i = 0; i < event->pspecs->len; i++) {
+			GParamSpec *pspec = event->pspecs->pdata[i];
+			const char *value = event->values->pdata[i];
+
+			if (!value)
+				continue;
+			if (!first)
+				g_string_append_c (buf, ',');
+			_append_string (buf, pspec->name);
+			g_string_append_c (buf, ':');
+			g_string_append (buf, value);
+			first = FALSE;
+		}
+		g_string_append_c (buf, '}');
+		break;
+	}
+
+	g_string_append (buf, "}\n");
+}
+
+static void
+_flush (NmcEventStream *self)
+{
+	gs_unref_ptrarray GPtrArray *events = NULL;
+	guint i;
+
+	nm_clear_g_source (&self->flush_id);
+
+	if (!self->events->len)
+		return;
+
+	/* Detach the batch first, so that a notification while writing
+	 * starts a new one. */
+	events = self->events;
+	self->events = g_ptr_array_new_with_free_func (_event_free);
+	g_hash_table_remove_all (self->changed);
+
+	for (i = 0; i < events->len; i++)
+		_event_write (self, events->pdata[i]);
+
+	fwrite (self->buf->str, 1, self->buf->len, self->out);
+	fflush (self->out);
+	g_string_truncate (self->buf, 0);
+}
+
+static gboolean
+_flush_cb (gpointer user_data)
+{
+	NmcEventStream *self = user_data;
+
+	self->flush_id = 0;
+	_flush (self);
+	return G_SOURCE_REMOVE;
+}
+
+static Event *
+_event_queue (NmcEventStream *self, GObject *object, NmcEventKind kind)
+{
+	Event *event;
+
+	event = g_slice_new (Event);
+	event->object = g_object_ref (object);
+	event->ts = g_get_real_time ();
+	event->kind = kind;
+	event->pspecs = NULL;
+	g_ptr_array_add (self->events, event);
+
+	if (!self->flush_id)
+		self->flush_id = g_idle_add_full (G_PRIORITY_DEFAULT, _flush_cb, self, NULL);
+
+	return event;
+}
+
+static void
+_notify_cb (GObject *object, GParamSpec *pspec, gpointer user_data)
+{
+	NmcEventStream *self = user_data;
+	nm_auto_free_gstring GString *str = NULL;
+	char *value = NULL;
+	Event *event;
+	guint i;
+
+	if (!(pspec->flags & G_PARAM_READABLE))
+		return;
+
+	/* Take the value now, a later change gets its own notification. The
+	 * getter may notify other properties, so do it before looking up
+	 * the event. */
+	str = g_string_new (NULL);
+	if (_append_value (str, object, pspec))
+		value = g_string_free (g_steal_pointer (&str), FALSE);
+
+	event = g_hash_table_lookup (self->changed, object);
+	if (!event) {
+		event = _event_queue (self, object, NMC_EVENT_CHANGED);
+		event->pspecs = g_ptr_array_new ();
+		event->values = g_ptr_array_new_with_free_func (g_free);
+		g_hash_table_insert (self->changed, object, event);
+	} else {
+		for (i = 0; i < event->pspecs->len; i++) {
+			if (event->pspecs->pdata[i] == pspec) {
+				g_free (event->values->pdata[i]);
+				event->values->pdata[i] = value;
+				return;
+			}
+		}
+	}
+
+	g_ptr_array_add (event->pspecs, pspec);
+	g_ptr_array_add (event->values, value);
+}
+
+/*****************************************************************************/
+
+/**
+ * nmc_event_stream_emit:
+ * @self: the #NmcEventStream
+ * @object: the #NMClient or #NMObject the event is about
+ * @kind: %NMC_EVENT_ADDED or %NMC_EVENT_REMOVED
+ *
+ * Queues an event for @object. Pending property changes of @object
+ * are written before it.
+ */
+void
+nmc_event_stream_emit (NmcEventStream *self, gpointer object, NmcEventKind kind)
+{
+	g_return_if_fail (G_IS_OBJECT (object));
+	g_return_if_fail (kind != NMC_EVENT_CHANGED);
+
+	/* Later changes are queued after this event. */
+	g_hash_table_remove (self->changed, object);
+	_event_queue (self, object, kind);
+}
+
+/**
+ * nmc_event_stream_watch:
+ * @self: the #NmcEventStream
+ * @object: the #NMClient or #NMObject to watch
+ *
+ * Queues a "changed" event whenever a property of @object changes.
+ */
+void
+nmc_event_stream_watch (NmcEventStream *self, gpointer object)
+{
+	g_return_if_fail (G_IS_OBJECT (object));
+
+	if (g_hash_table_contains (self->watched, object))
+		return;
+
+	g_hash_table_add (self->watched, g_object_ref (object));
+	g_signal_connect (object, "notify", G_CALLBACK (_notify_cb), self);
+}
+
+gboolean
+nmc_event_stream_unwatch (NmcEventStream *self, gpointer object)
+{
+	g_return_val_if_fail (G_IS_OBJECT (object), FALSE);
+
+	if (!g_hash_table_contains (self->watched, object))
+		return FALSE;
+
+	g_signal_handlers_disconnect_by_func (object, _notify_cb, self);
+	g_hash_table_remove (self->watched, object);
+	return TRUE;
+}
+
+guint
+nmc_event_stream_get_n_watched (NmcEventStream *self)
+{
+	return g_hash_table_size (self->watched);
+}
+
+static void
+_object_added_cb (NMClient *client, GObject *object, gpointer user_data)
+{
+	NmcEventStream *self = user_data;
+
+	nmc_event_stream_emit (self, object, NMC_EVENT_ADDED);
+	nmc_event_stream_watch (self, object);
+}
+
+static void
+_object_removed_cb (NMClient *client, GObject *object, gpointer user_data)
+{
+	NmcEventStream *self = user_data;
+
+	if (nmc_event_stream_unwatch (self, object))
+		nmc_event_stream_emit (self, object, NMC_EVENT_REMOVED);
+}
+
+/**
+ * nmc_event_stream_track:
+ * @self: the #NmcEventStream
+ * @client: the #NMClient
+ * @added_signal: (allow-none): the #NMClient signal announcing new objects
+ * @removed_signal: the #NMClient signal announcing removed objects
+ *
+ * Objects announced by @added_signal are watched and reported as "added".
+ * Watched objects that are announced by @removed_signal are reported as
+ * "removed" and no longer watched. Pass %NULL for @added_signal to only
+ * follow the objects that are already watched.
+ */
+void
+nmc_event_stream_track (NmcEventStream *self,
+                        NMClient *client,
+                        const char *added_signal,
+                        const char *removed_signal)
+{
+	gulong id;
+
+	g_return_if_fail (NM_IS_CLIENT (client));
+	g_return_if_fail (!self->client || self->client == client);
+
+	if (!self->client) {
+		self->client = g_object_ref (client);
+		self->client_handlers = g_array_new (FALSE, FALSE, sizeof (gulong));
+	}
+
+	if (added_signal) {
+		id = g_signal_connect (client, added_signal, G_CALLBACK (_object_added_cb), self);
+		g_array_append_val (self->client_handlers, id);
+	}
+	id = g_signal_connect (client, removed_signal, G_CALLBACK (_object_removed_cb), self);
+	g_array_append_val (self->client_handlers, id);
+}
+
+/**
+ * nmc_event_stream_set_output:
+ * @self: the #NmcEventStream
+ * @out: the stream the events are written to
+ *
+ * Events are written to stdout by default. Pending events are
+ * written to the previous stream first.
+ */
+void
+nmc_event_stream_set_output (NmcEventStream *self, FILE *out)
+{
+	g_return_if_fail (out);
+
+	_flush (self);
+	self->out = out;
+}
+
+/*****************************************************************************/
+
+NmcEventStream *
+nmc_event_stream_new (void)
+{
+	NmcEventStream *self;
+
+	self = g_slice_new0 (NmcEventStream);
+	self->watched = g_hash_table_new_full (nm_direct_hash, NULL, g_object_unref, NULL);
+	self->events = g_ptr_array_new_with_free_func (_event_free);
+	self->changed = g_hash_table_new (nm_direct_hash, NULL);
+	self->buf = g_string_sized_new (4096);
+	self->out = stdout;
+	return self;
+}
+
+void
+nmc_event_stream_free (NmcEventStream *self)
+{
+	GHashTableIter iter;
+	gpointer object;
+	guint i;
+
+	if (!self)
+		return;
+
+	if (self->client) {
+		for (i = 0; i < self->client_handlers->len; i++)
+			g_signal_handler_disconnect (self->client, g_array_index (self->client_handlers, gulong, i));
+		g_array_unref (self->client_handlers);
+		g_clear_object (&self->client);
+	}
+
+	_flush (self);
+	nm_clear_g_source (&self->flush_id);
+
+	g_hash_table_iter_init (&iter, self->watched);
+	while (g_hash_table_iter_next (&iter, &object, NULL))
+		g_signal_handlers_disconnect_by_func (object, _notify_cb, self);
+
+	g_hash_table_destroy (self->watched);
+	g_hash_table_destroy (self->changed);
+	g_ptr_array_unref (self->events);
+	g_string_free (self->buf, TRUE);
+	g_slice_free (NmcEventStream, self);
+}
@@ -0,0 +1,47 @@
+/* nmcli - command-line tool to control NetworkManager
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright 2018 Red Hat, Inc.
+ */
+
+#ifndef __NMC_EVENT_STREAM_H__
+#define __NMC_EVENT_STREAM_H__
+
+typedef enum {
+	NMC_EVENT_ADDED,
+	NMC_EVENT_CHANGED,
+	NMC_EVENT_REMOVED,
+} NmcEventKind;
+
+typedef struct _NmcEventStream NmcEventStream;
+
+NmcEventStream *nmc_event_stream_new (void);
+void nmc_event_stream_free (NmcEventStream *self);
+
+void nmc_event_stream_set_output (NmcEventStream *self, FILE *out);
+
+void nmc_event_stream_watch (NmcEventStream *self, gpointer object);
+gboolean nmc_event_stream_unwatch (NmcEventStream *self, gpointer object);
+guint nmc_event_stream_get_n_watched (NmcEventStream *self);
+
+void nmc_event_stream_track (NmcEventStream *self,
+                             NMClient *client,
+                             const char *added_signal,
+                             const char *removed_signal);
+
+void nmc_event_stream_emit (NmcEventStream *self, gpointer object, NmcEventKind kind);
+
+#endif /* __NMC_EVENT_STREAM_H__ */
@@ -34,6 +34,7 @@
 #include "common.h"
 #include "devices.h"
 #include "connections.h"
+#include "event-stream.h"
 
 /*****************************************************************************/
 
@@ -464,10 +465,12 @@ usage_radio_wwan (void)
 static void
 usage_monitor (void)
 {
-	g_printerr (_("Usage: nmcli monitor\n"
+	g_printerr (_("Usage: nmcli monitor [--json]\n"
 	              "\n"
 	              "Monitor NetworkManager changes.\n"
-	              "Prints a line whenever a change occurs in NetworkManager\n\n"));
+	              "Prints a line whenever a change occurs in NetworkManager\n"
+	              "With --json, prints a JSON object per line with the changed properties\n"
+	              "of the manager, devices, active connections and connection profiles.\n\n"));
 }
 
 static void
@@ -1362,10 +1365,44 @@ do_overview (NmCli *nmc, int argc, char **argv)
 /*
  * Entry point function for 'nmcli monitor'
  */
+static void
+monitor_json (NmCli *nmc)
+{
+	NmcEventStream *stream;
+	const GPtrArray *objects;
+	guint i;
+
+	stream = nmc_event_stream_new ();
+	nmc->event_stream = stream;
+
+	nmc_event_stream_watch (stream, nmc->client);
+
+	objects = nm_client_get_devices (nmc->client);
+	for (i = 0; i < objects->len; i++)
+		nmc_event_stream_watch (stream, objects->pdata[i]);
+	nmc_event_stream_track (stream, nmc->client,
+	                        NM_CLIENT_DEVICE_ADDED, NM_CLIENT_DEVICE_REMOVED);
+
+	objects = nm_client_get_active_connections (nmc->client);
+	for (i = 0; i < objects->len; i++)
+		nmc_event_stream_watch (stream, objects->pdata[i]);
+	nmc_event_stream_track (stream, nmc->client,
+	                        NM_CLIENT_ACTIVE_CONNECTION_ADDED, NM_CLIENT_ACTIVE_CONNECTION_REMOVED);
+
+	objects = nm_client_get_connections (nmc->client);
+	for (i = 0; i < objects->len; i++)
+		nmc_event_stream_watch (stream, objects->pdata[i]);
+	nmc_event_stream_track (stream, nmc->client,
+	                        NM_CLIENT_CONNECTION_ADDED, NM_CLIENT_CONNECTION_REMOVED);
+}
+
 NMCResultCode
 do_monitor (NmCli *nmc, int argc, char **argv)
 {
-	next_arg (nmc, &argc, &argv, NULL);
+	gboolean json = FALSE;
+
+	while (next_arg (nmc, &argc, &argv, "--json", NULL) > 0)
+		json = TRUE;
 
 	if (nmc->complete)
 		return nmc->return_value;
@@ -1380,6 +1417,12 @@ do_monitor (NmCli *nmc, int argc, char **argv)
 		return nmc->return_value;
 	}
 
+	if (json) {
+		nmc->should_wait++;
+		monitor_json (nmc);
+		return NMC_RESULT_SUCCESS;
+	}
+
 	if (!nm_client_get_nm_running (nmc->client)) {
 		char *str;
 
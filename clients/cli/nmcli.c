@@ -44,6 +44,8 @@
 #include "general.h"
 #include "agent.h"
 #include "settings.h"
+#include "server.h"
+#include "event-stream.h"
 
 #if defined(NM_DIST_VERSION)
 # define NMCLI_VERSION NM_DIST_VERSION
@@ -87,7 +89,7 @@
 	[NM_META_COLOR_ENABLED]                  = "32", \
 	[NM_META_COLOR_DISABLED]                 = "31", \
 
-NmCli nm_cli = {
+static const NmCli nm_cli_default = {
 	.client = NULL,
 
 	.return_value = NMC_RESULT_SUCCESS,
@@ -116,6 +118,8 @@ NmCli nm_cli = {
 	.editor_save_confirmation = TRUE,
 };
 
+NmCli nm_cli;
+
 /*****************************************************************************/
 
 typedef struct {
@@ -258,6 +262,7 @@ usage (void)
 	              "  -t, --terse                              terse output\n"
 	              "  -v, --version                            how program version\n"
 	              "  -w, --wait <seconds>                     set timeout waiting for finishing operations\n"
+	              "      --server <socket>                    serve nmcli invocations over a UNIX socket\n"
 	              "\n"
 	              "OBJECT\n"
 	              "  g[eneral]       NetworkManager's general status and operations\n"
@@ -471,7 +476,7 @@ check_colors (NmcColorOption color_option,
 		return FALSE;
 	}
 
-	term = g_getenv ("TERM");
+	term = nmc_getenv ("TERM");
 
 	if (color_option == NMC_USE_COLOR_AUTO) {
 		if (   nm_streq0 (term, "dumb")
@@ -882,8 +887,24 @@ nmc_clear_sigint (void)
 	nmcli_sigint = FALSE;
 }
 
+static gboolean nmcli_exit_requested = FALSE;
+
+gboolean
+nmc_exit_requested (void)
+{
+	return nmcli_exit_requested;
+}
+
 void nmc_exit (void)
 {
+	if (nm_cli.in_server) {
+		/* "nmcli --server" must keep serving. Only fail the forwarded
+		 * invocation: stop its main loop and let the prompts give up. */
+		nmcli_exit_requested = TRUE;
+		g_main_loop_quit (loop);
+		return;
+	}
+
 	tcsetattr (STDIN_FILENO, TCSADRAIN, &termios_orig);
 	nmc_cleanup_readline ();
 	exit (1);
@@ -1003,6 +1024,10 @@ nm_cli_spawn_pager (NmCli *nmc)
 {
 	if (nmc->pager_pid > 0)
 		return;
+	if (nmc->in_server) {
+		/* the output goes to the file descriptors of the client. */
+		return;
+	}
 	nmc->pager_pid = nmc_terminal_spawn_pager (&nmc->nmc_config);
 }
 
@@ -1011,6 +1036,9 @@ nmc_cleanup (NmCli *nmc)
 {
 	pid_t ret;
 
+	nm_clear_g_signal_handler (nmc->client, &nmc->event_stream_removed_id);
+	nm_clear_pointer (&nmc->event_stream, nmc_event_stream_free);
+
 	g_clear_object (&nmc->client);
 
 	g_string_free (nmc->return_text, TRUE);
@@ -1039,6 +1067,121 @@ nmc_cleanup (NmCli *nmc)
 	nmc_polkit_agent_fini (nmc);
 }
 
+static void
+nmc_init (NmCli *nmc)
+{
+	memcpy (nmc, &nm_cli_default, sizeof (*nmc));
+	nmc->return_text = g_string_new (_("Success"));
+}
+
+typedef struct {
+	NmCli *nmc;
+	int argc;
+	char **argv;
+	guint idle_id;
+} RunData;
+
+static gboolean
+_run_process_command_line_cb (gpointer user_data)
+{
+	RunData *data = user_data;
+
+	data->idle_id = 0;
+	if (!process_command_line (data->nmc, data->argc, data->argv))
+		g_main_loop_quit (loop);
+	return G_SOURCE_REMOVE;
+}
+
+static int
+nmc_run (NmCli *nmc, int argc, char **argv)
+{
+	if (nmc->in_server) {
+		RunData data = {
+			.nmc = nmc,
+			.argc = argc,
+			.argv = argv,
+		};
+
+		/* the server already has a client, so the command handlers would be
+		 * called before the main loop runs and prompts could not wait for
+		 * input. Start them from within the loop. */
+		data.idle_id = g_idle_add (_run_process_command_line_cb, &data);
+		g_main_loop_run (loop);
+		nm_clear_g_source (&data.idle_id);
+
+		if (   nmcli_exit_requested
+		    && nmc->return_value == NMC_RESULT_SUCCESS) {
+			nmc->return_value = NMC_RESULT_ERROR_UNKNOWN;
+			g_string_assign (nmc->return_text, _("Error: nmcli terminated"));
+		}
+	} else if (process_command_line (nmc, argc, argv))
+		g_main_loop_run (loop);
+
+	if (nmc->complete) {
+		/* Remove error statuses from command completion runs. */
+		if (nmc->return_value < NMC_RESULT_COMPLETE_FILE)
+			nmc->return_value = NMC_RESULT_SUCCESS;
+	} else if (nmc->return_value != NMC_RESULT_SUCCESS) {
+		/* Print result descripting text */
+		g_printerr ("%s\n", nmc->return_text->str);
+	}
+
+	return nmc->return_value;
+}
+
+/**
+ * nmc_getenv:
+ * @variable: the environment variable
+ *
+ * Like g_getenv(), but for a forwarded invocation it looks up the
+ * environment of the calling client instead of the one of the server.
+ *
+ * Returns: the value of @variable, or %NULL.
+ */
+const char *
+nmc_getenv (const char *variable)
+{
+	if (nm_cli.envp)
+		return g_environ_getenv (nm_cli.envp, variable);
+	return g_getenv (variable);
+}
+
+/**
+ * nm_cli_run_in_server:
+ * @client: the #NMClient that the server keeps around
+ * @argc: argument count
+ * @argv: the command line of the forwarded invocation
+ * @envp: the environment of the forwarded invocation
+ *
+ * Runs a forwarded nmcli invocation like main() would, but reusing
+ * @client. The standard file descriptors are already those of the
+ * calling client. The process environment is not touched, @envp is
+ * only consulted via nmc_getenv().
+ *
+ * Returns: the exit code for the invocation.
+ */
+int
+nm_cli_run_in_server (NMClient *client, int argc, char **argv, char **envp)
+{
+	int ret;
+
+	/* nm_cli was initialized by main() or by the previous invocation. */
+	nm_cli.client = g_object_ref (client);
+	nm_cli.in_server = TRUE;
+	nm_cli.envp = envp;
+	nmcli_exit_requested = FALSE;
+
+	ret = nmc_run (&nm_cli, argc, argv);
+
+	fflush (stdout);
+	fflush (stderr);
+	nmc_cleanup (&nm_cli);
+
+	/* leave nm_cli in a sane state until the next invocation. */
+	nmc_init (&nm_cli);
+	return ret;
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1057,23 +1200,35 @@ main (int argc, char *argv[])
 
 	nmc_value_transforms_register ();
 
-	nm_cli.return_text = g_string_new (_("Success"));
+	if (!(argc == 3 && nm_streq (argv[1], "--server"))) {
+		const char *server_path;
+		int ret;
+
+		/* Let a running "nmcli --server" handle the invocation, if any. */
+		server_path = g_getenv ("NMCLI_SERVER");
+		if (   server_path
+		    && server_path[0]
+		    && nmc_server_forward (server_path, argc, argv, &ret))
+			return ret;
+	}
+
+	nmc_init (&nm_cli);
 	loop = g_main_loop_new (NULL, FALSE);
 
+	if (argc == 3 && nm_streq (argv[1], "--server")) {
+		int ret;
+
+		/* the server installs its own signal handlers. */
+		ret = nmc_server_run (argv[2]);
+		g_main_loop_unref (loop);
+		nmc_cleanup (&nm_cli);
+		return ret;
+	}
+
 	g_unix_signal_add (SIGTERM, signal_handler, GINT_TO_POINTER (SIGTERM));
 	g_unix_signal_add (SIGINT, signal_handler, GINT_TO_POINTER (SIGINT));
 
-	if (process_command_line (&nm_cli, argc, argv))
-		g_main_loop_run (loop);
-
-	if (nm_cli.complete) {
-		/* Remove error statuses from command completion runs. */
-		if (nm_cli.return_value < NMC_RESULT_COMPLETE_FILE)
-			nm_cli.return_value = NMC_RESULT_SUCCESS;
-	} else if (nm_cli.return_value != NMC_RESULT_SUCCESS) {
-		/* Print result descripting text */
-		g_printerr ("%s\n", nm_cli.return_text->str);
-	}
+	nmc_run (&nm_cli, argc, argv);
 
 	g_main_loop_unref (loop);
 	nmc_cleanup (&nm_cli);
@@ -24,6 +24,7 @@
 #include "nm-meta-setting-desc.h"
 
 struct _NMPolkitListener;
+struct _NmcEventStream;
 
 typedef char *(*NmcCompEntryFunc) (const char *, int);
 
@@ -132,6 +133,8 @@ typedef struct _NmCli {
 	NMSecretAgentOld *secret_agent;                   /* Secret agent */
 	GHashTable *pwds_hash;                            /* Hash table with passwords in passwd-file */
 	struct _NMPolkitListener *pk_listener;            /* polkit agent listener */
+	struct _NmcEventStream *event_stream;             /* Event stream of 'monitor --json' */
+	gulong event_stream_removed_id;                   /* Handler terminating 'device monitor --json' */
 
 	int should_wait;                                  /* Semaphore indicating whether nmcli should not end or not yet */
 	gboolean nowait_flag;                             /* '--nowait' option; used for passing to callbacks */
@@ -147,6 +150,9 @@ typedef struct _NmCli {
 	gboolean editor_save_confirmation;                /* Whether to ask for confirmation on saving connections with 'autoconnect=yes' */
 
 	char *palette_buffer;                             /* Buffer with sequences for terminal-colors.d(5)-based coloring. */
+
+	bool in_server;                                   /* Whether the invocation was forwarded to 'nmcli --server' */
+	char **envp;                                      /* Environment of the forwarded invocation, or NULL */
 } NmCli;
 
 #define NMC_RETURN(nmc, rvalue) \
@@ -166,9 +172,14 @@ gboolean nmc_seen_sigint (void);
 void     nmc_clear_sigint (void);
 void     nmc_set_sigquit_internal (void);
 void     nmc_exit (void);
+gboolean nmc_exit_requested (void);
+
+const char *nmc_getenv (const char *variable);
 
 void nm_cli_spawn_pager (NmCli *nmc);
 
+int nm_cli_run_in_server (NMClient *client, int argc, char **argv, char **envp);
+
 void nmc_empty_output_fields (NmcOutputData *output_data);
 
 #define NMC_OUTPUT_DATA_DEFINE_SCOPED(out) \
@@ -0,0 +1,687 @@
+/* nmcli - command-line tool to control NetworkManager
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright 2018 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include "server.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <locale.h>
+#include <glib-unix.h>
+
+/*
+ * "nmcli --server <socket>" keeps one NMClient around and runs the
+ * invocations of other nmcli processes, which then don't need to create
+ * and populate their own NMClient.
+ *
+ * An nmcli that finds the socket path in the NMCLI_SERVER environment
+ * variable connects to the server and sends a single request: a 32 bit
+ * length with its stdin, stdout and stderr attached as SCM_RIGHTS,
+ * followed by the serialized GVariant "(sasas)" with the current working
+ * directory, the environment and the command line. The server runs the
+ * command with the file descriptors and the environment of the client
+ * and replies with the 32 bit exit code.
+ *
+ * Requests are read without blocking the main loop and must arrive within
+ * REQUEST_TIMEOUT_MSEC. They are run one after another.
+ */
+
+#define REQUEST_TYPE         G_VARIANT_TYPE ("(sasas)")
+#define REQUEST_MAX_SIZE     (1024 * 1024)
+#define REQUEST_TIMEOUT_MSEC 5000
+
+typedef union {
+	struct cmsghdr cmsg;
+	char buf[CMSG_SPACE (3 * sizeof (int))];
+} FdsControl;
+
+/*****************************************************************************/
+
+static gboolean
+_fill_sockaddr (const char *socket_path, struct sockaddr_un *addr, socklen_t *out_len)
+{
+	gsize l = strlen (socket_path);
+
+	if (l == 0 || l >= sizeof (addr->sun_path))
+		return FALSE;
+
+	memset (addr, 0, sizeof (*addr));
+	addr->sun_family = AF_UNIX;
+	memcpy (addr->sun_path, socket_path, l + 1);
+	*out_len = offsetof (struct sockaddr_un, sun_path) + l + 1;
+	return TRUE;
+}
+
+static gboolean
+_read_all (int fd, gpointer buf, gsize len)
+{
+	while (len > 0) {
+		gssize n;
+
+		n = read (fd, buf, len);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return FALSE;
+		}
+		if (n == 0)
+			return FALSE;
+		buf = &((char *) buf)[n];
+		len -= n;
+	}
+	return TRUE;
+}
+
+static gboolean
+_write_all (int fd, gconstpointer buf, gsize len)
+{
+	while (len > 0) {
+		gssize n;
+
+		n = write (fd, buf, len);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return FALSE;
+		}
+		buf = &((const char *) buf)[n];
+		len -= n;
+	}
+	return TRUE;
+}
+
+/*****************************************************************************/
+
+/**
+ * nmc_server_forward:
+ * @socket_path: the socket of a running "nmcli --server"
+ * @argc: argument count
+ * @argv: the command line to forward
+ * @out_exit_code: (out): the exit code of the forwarded invocation
+ *
+ * Returns: %FALSE if no server could be reached. In that case, the caller
+ *   runs the command itself. Otherwise, %TRUE and @out_exit_code is set.
+ */
+gboolean
+nmc_server_forward (const char *socket_path,
+                    int argc,
+                    char **argv,
+                    int *out_exit_code)
+{
+	const int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+	struct sockaddr_un addr;
+	socklen_t addr_len;
+	nm_auto_close int fd = -1;
+	gs_free char *cwd = NULL;
+	gs_strfreev char **envp = NULL;
+	gs_unref_variant GVariant *request = NULL;
+	FdsControl control;
+	struct iovec iov;
+	struct msghdr msg = { 0 };
+	struct cmsghdr *cmsg;
+	guint32 len;
+	gint32 exit_code;
+	gssize n;
+
+	if (!_fill_sockaddr (socket_path, &addr, &addr_len))
+		return FALSE;
+
+	fd = socket (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0)
+		return FALSE;
+	if (connect (fd, (struct sockaddr *) &addr, addr_len) < 0)
+		return FALSE;
+
+	cwd = g_get_current_dir ();
+	envp = g_get_environ ();
+	request = g_variant_ref_sink (g_variant_new ("(s^as@as)",
+	                                             cwd,
+	                                             envp,
+	                                             g_variant_new_strv ((const char *const*) argv, argc)));
+	len = g_variant_get_size (request);
+
+	iov.iov_base = &len;
+	iov.iov_len = sizeof (len);
+	memset (&control, 0, sizeof (control));
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof (control.buf);
+	cmsg = CMSG_FIRSTHDR (&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN (sizeof (fds));
+	memcpy (CMSG_DATA (cmsg), fds, sizeof (fds));
+
+	do {
+		n = sendmsg (fd, &msg, MSG_NOSIGNAL);
+	} while (n < 0 && errno == EINTR);
+	if (n != sizeof (len))
+		return FALSE;
+
+	if (!_write_all (fd, g_variant_get_data (request), len))
+		return FALSE;
+
+	/* From here on, the server owns the invocation. */
+	if (!_read_all (fd, &exit_code, sizeof (exit_code))) {
+		g_printerr (_("Error: nmcli server at '%s' did not complete the command.\n"),
+		            socket_path);
+		exit_code = NMC_RESULT_ERROR_UNKNOWN;
+	}
+
+	*out_exit_code = exit_code;
+	return TRUE;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+	int fd;
+	int fds[3];
+	gboolean have_header;
+	guint32 len;
+	gsize pos;
+	guint8 *data;
+	char *cwd;
+	char **envp;
+	char **argv;
+	guint watch_id;
+	guint timeout_id;
+} Request;
+
+static struct {
+	NMClient *client;
+	GMainLoop *loop;
+	guint hup_id;
+
+	/* requests that are still being read and complete requests that
+	 * wait for being run. */
+	GSList *reading;
+	GQueue queue;
+	guint dispatch_id;
+
+	/* the command handlers assume that the argument vector is never
+	 * freed. Keep the last one around until the next request. */
+	char **last_argv;
+} gl;
+
+static void
+_request_free (Request *req)
+{
+	int i;
+
+	nm_clear_g_source (&req->watch_id);
+	nm_clear_g_source (&req->timeout_id);
+	for (i = 0; i < 3; i++)
+		nm_close (req->fds[i]);
+	nm_close (req->fd);
+	g_free (req->data);
+	g_free (req->cwd);
+	g_strfreev (req->envp);
+	g_strfreev (req->argv);
+	g_slice_free (Request, req);
+}
+
+/* Returns: 1 if the header was read, 0 if it is not there yet and -1
+ *   on failure. */
+static int
+_request_read_header (Request *req)
+{
+	FdsControl control;
+	struct iovec iov;
+	struct msghdr msg = { 0 };
+	struct cmsghdr *cmsg;
+	gboolean have_fds = FALSE;
+	gssize n;
+
+	iov.iov_base = &req->len;
+	iov.iov_len = sizeof (req->len);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof (control.buf);
+
+	do {
+		n = recvmsg (req->fd, &msg, MSG_CMSG_CLOEXEC);
+	} while (n < 0 && errno == EINTR);
+	if (n < 0)
+		return NM_IN_SET (errno, EAGAIN, EWOULDBLOCK) ? 0 : -1;
+
+	for (cmsg = CMSG_FIRSTHDR (&msg); cmsg; cmsg = CMSG_NXTHDR (&msg, cmsg)) {
+		const int *cmsg_fds;
+		gsize n_fds, j;
+
+		if (   cmsg->cmsg_level != SOL_SOCKET
+		    || cmsg->cmsg_type != SCM_RIGHTS)
+			continue;
+
+		cmsg_fds = (const int *) CMSG_DATA (cmsg);
+		n_fds = (cmsg->cmsg_len - CMSG_LEN (0)) / sizeof (int);
+		for (j = 0; j < n_fds; j++) {
+			if (!have_fds && n_fds == 3)
+				req->fds[j] = cmsg_fds[j];
+			else
+				nm_close (cmsg_fds[j]);
+		}
+		if (n_fds == 3)
+			have_fds = TRUE;
+	}
+
+	if (   !have_fds
+	    || n != sizeof (req->len)
+	    || NM_FLAGS_HAS (msg.msg_flags, MSG_CTRUNC)
+	    || req->len > REQUEST_MAX_SIZE)
+		return -1;
+
+	req->have_header = TRUE;
+	req->data = g_malloc (req->len);
+	return 1;
+}
+
+static gboolean
+_request_parse (Request *req)
+{
+	gs_unref_variant GVariant *request = NULL;
+	guint8 *data = g_steal_pointer (&req->data);
+
+	request = g_variant_ref_sink (g_variant_new_from_data (REQUEST_TYPE, data, req->len, FALSE, g_free, data));
+	g_variant_get (request, "(s^as^as)", &req->cwd, &req->envp, &req->argv);
+	return !!req->argv[0];
+}
+
+static gboolean _request_dispatch_cb (gpointer user_data);
+
+static gboolean
+_request_read_cb (int fd, GIOCondition condition, gpointer user_data)
+{
+	Request *req = user_data;
+	int r;
+
+	if (!req->have_header) {
+		r = _request_read_header (req);
+		if (r <= 0)
+			goto out;
+	}
+
+	while (req->pos < req->len) {
+		gssize n;
+
+		n = read (req->fd, &req->data[req->pos], req->len - req->pos);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			r = NM_IN_SET (errno, EAGAIN, EWOULDBLOCK) ? 0 : -1;
+			goto out;
+		}
+		if (n == 0) {
+			r = -1;
+			goto out;
+		}
+		req->pos += n;
+	}
+
+	r = _request_parse (req) ? 1 : -1;
+
+out:
+	if (r == 0)
+		return G_SOURCE_CONTINUE;
+
+	req->watch_id = 0;
+	gl.reading = g_slist_remove (gl.reading, req);
+	if (r < 0) {
+		_request_free (req);
+		return G_SOURCE_REMOVE;
+	}
+
+	nm_clear_g_source (&req->timeout_id);
+	g_queue_push_tail (&gl.queue, req);
+	if (!gl.dispatch_id)
+		gl.dispatch_id = g_idle_add (_request_dispatch_cb, NULL);
+	return G_SOURCE_REMOVE;
+}
+
+static gboolean
+_request_timeout_cb (gpointer user_data)
+{
+	Request *req = user_data;
+
+	/* the client did not send its request in time. */
+	req->timeout_id = 0;
+	gl.reading = g_slist_remove (gl.reading, req);
+	_request_free (req);
+	return G_SOURCE_REMOVE;
+}
+
+static gboolean
+_request_hup_cb (int fd, GIOCondition condition, gpointer user_data)
+{
+	/* the client went away. Fail its invocation, the server goes on. */
+	gl.hup_id = 0;
+	nmc_exit ();
+	return G_SOURCE_REMOVE;
+}
+
+static locale_t
+_locale_new (char **envp)
+{
+	static const struct {
+		int mask;
+		const char *name;
+	} categories[] = {
+		{ LC_CTYPE_MASK,          "LC_CTYPE" },
+		{ LC_NUMERIC_MASK,        "LC_NUMERIC" },
+		{ LC_TIME_MASK,           "LC_TIME" },
+		{ LC_COLLATE_MASK,        "LC_COLLATE" },
+		{ LC_MONETARY_MASK,       "LC_MONETARY" },
+		{ LC_MESSAGES_MASK,       "LC_MESSAGES" },
+		{ LC_PAPER_MASK,          "LC_PAPER" },
+		{ LC_NAME_MASK,           "LC_NAME" },
+		{ LC_ADDRESS_MASK,        "LC_ADDRESS" },
+		{ LC_TELEPHONE_MASK,      "LC_TELEPHONE" },
+		{ LC_MEASUREMENT_MASK,    "LC_MEASUREMENT" },
+		{ LC_IDENTIFICATION_MASK, "LC_IDENTIFICATION" },
+	};
+	const char *lc_all;
+	const char *lang;
+	locale_t locale;
+	guint i;
+
+	locale = newlocale (LC_ALL_MASK, "C", (locale_t) 0);
+	if (!locale)
+		return (locale_t) 0;
+
+	/* what setlocale (LC_ALL, "") would do with @envp. */
+	lc_all = g_environ_getenv (envp, "LC_ALL");
+	lang = g_environ_getenv (envp, "LANG");
+	for (i = 0; i < G_N_ELEMENTS (categories); i++) {
+		const char *value = NULL;
+		locale_t l;
+
+		if (lc_all && lc_all[0])
+			value = lc_all;
+		else {
+			value = g_environ_getenv (envp, categories[i].name);
+			if (!value || !value[0])
+				value = lang;
+		}
+		if (!value || !value[0])
+			continue;
+
+		/* on failure, @locale is left alone. */
+		l = newlocale (categories[i].mask, value, locale);
+		if (l)
+			locale = l;
+	}
+
+	return locale;
+}
+
+static gint32
+_request_run (Request *req)
+{
+	nm_auto_close int saved_cwd = -1;
+	int saved_fds[3];
+	locale_t locale;
+	locale_t saved_locale = (locale_t) 0;
+	gint32 exit_code;
+	int i;
+
+	saved_cwd = open (".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (chdir (req->cwd) < 0) {
+		int errsv = errno;
+		char *msg;
+
+		msg = g_strdup_printf (_("Error: cannot change to directory '%s': %s\n"),
+		                       req->cwd, g_strerror (errsv));
+		_write_all (req->fds[2], msg, strlen (msg));
+		g_free (msg);
+		return NMC_RESULT_ERROR_UNKNOWN;
+	}
+
+	fflush (stdout);
+	fflush (stderr);
+	for (i = 0; i < 3; i++) {
+		saved_fds[i] = fcntl (i, F_DUPFD_CLOEXEC, 3);
+		dup2 (req->fds[i], i);
+	}
+
+	/* Run the command in the locale of the client. Unlike setlocale(),
+	 * uselocale() only affects this thread and not the one of GDBus.
+	 * The rest of the environment (TERM, ...) is looked up by
+	 * nmc_getenv(). The terminal is detected on the file descriptors,
+	 * which are the ones of the client now. */
+	locale = _locale_new (req->envp);
+	if (locale)
+		saved_locale = uselocale (locale);
+
+	g_strfreev (gl.last_argv);
+	gl.last_argv = g_steal_pointer (&req->argv);
+
+	gl.hup_id = g_unix_fd_add (req->fd, G_IO_HUP | G_IO_ERR, _request_hup_cb, NULL);
+
+	exit_code = nm_cli_run_in_server (gl.client,
+	                                  g_strv_length (gl.last_argv),
+	                                  gl.last_argv,
+	                                  req->envp);
+
+	nm_clear_g_source (&gl.hup_id);
+
+	if (locale) {
+		uselocale (saved_locale);
+		freelocale (locale);
+	}
+
+	for (i = 0; i < 3; i++) {
+		if (saved_fds[i] >= 0) {
+			dup2 (saved_fds[i], i);
+			nm_close (saved_fds[i]);
+		}
+	}
+
+	if (   saved_cwd >= 0
+	    && fchdir (saved_cwd) < 0) {
+		/* the server does not rely on its working directory. */
+	}
+
+	return exit_code;
+}
+
+static gboolean
+_request_dispatch_cb (gpointer user_data)
+{
+	Request *req;
+
+	/* Running a command iterates the main context, so the requests
+	 * that complete meanwhile are queued and picked up here. */
+	while (   g_main_loop_is_running (gl.loop)
+	       && (req = g_queue_pop_head (&gl.queue))) {
+		gint32 exit_code;
+		int i;
+
+		exit_code = _request_run (req);
+
+		/* the client may only go on once the server let go of its
+		 * file descriptors. */
+		for (i = 0; i < 3; i++) {
+			nm_close (req->fds[i]);
+			req->fds[i] = -1;
+		}
+
+		_write_all (req->fd, &exit_code, sizeof (exit_code));
+		_request_free (req);
+	}
+
+	gl.dispatch_id = 0;
+	return G_SOURCE_REMOVE;
+}
+
+static gboolean
+_server_accept_cb (int fd, GIOCondition condition, gpointer user_data)
+{
+	Request *req;
+	int conn_fd;
+	struct ucred ucred;
+	socklen_t ucred_len = sizeof (ucred);
+
+	/* the requests are read without blocking the main loop. */
+	conn_fd = accept4 (fd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+	if (conn_fd < 0)
+		return G_SOURCE_CONTINUE;
+
+	/* the socket is only accessible by the owner, but be strict. */
+	if (   getsockopt (conn_fd, SOL_SOCKET, SO_PEERCRED, &ucred, &ucred_len) < 0
+	    || ucred.uid != geteuid ()) {
+		nm_close (conn_fd);
+		return G_SOURCE_CONTINUE;
+	}
+
+	req = g_slice_new0 (Request);
+	req->fd = conn_fd;
+	req->fds[0] = -1;
+	req->fds[1] = -1;
+	req->fds[2] = -1;
+	req->watch_id = g_unix_fd_add (conn_fd, G_IO_IN | G_IO_HUP | G_IO_ERR, _request_read_cb, req);
+	req->timeout_id = g_timeout_add (REQUEST_TIMEOUT_MSEC, _request_timeout_cb, req);
+	gl.reading = g_slist_prepend (gl.reading, req);
+	return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+_server_signal_cb (gpointer user_data)
+{
+	/* abort a running command, and stop serving once it returned. */
+	if (gl.hup_id)
+		nmc_exit ();
+	g_main_loop_quit (gl.loop);
+	return G_SOURCE_CONTINUE;
+}
+
+/**
+ * nmc_server_run:
+ * @socket_path: where to listen
+ *
+ * Creates a #NMClient and serves nmcli invocations on @socket_path
+ * until interrupted.
+ *
+ * Returns: the exit code of nmcli.
+ */
+int
+nmc_server_run (const char *socket_path)
+{
+	gs_free_error GError *error = NULL;
+	struct sockaddr_un addr;
+	socklen_t addr_len;
+	nm_auto_close int fd = -1;
+	struct stat st;
+	mode_t old_umask;
+	Request *req;
+	guint accept_id;
+	guint sigint_id;
+	guint sigterm_id;
+	int r;
+
+	if (!_fill_sockaddr (socket_path, &addr, &addr_len)) {
+		g_printerr (_("Error: invalid socket path '%s'.\n"), socket_path);
+		return NMC_RESULT_ERROR_USER_INPUT;
+	}
+
+	gl.client = nm_client_new (NULL, &error);
+	if (!gl.client) {
+		g_printerr (_("Error: Could not create NMClient object: %s.\n"), error->message);
+		return NMC_RESULT_ERROR_UNKNOWN;
+	}
+
+	fd = socket (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		r = errno;
+		goto fail;
+	}
+
+	if (connect (fd, (struct sockaddr *) &addr, addr_len) == 0) {
+		g_printerr (_("Error: an nmcli server is already listening on '%s'.\n"), socket_path);
+		g_clear_object (&gl.client);
+		return NMC_RESULT_ERROR_UNKNOWN;
+	}
+	if (   errno == ECONNREFUSED
+	    && lstat (socket_path, &st) == 0
+	    && S_ISSOCK (st.st_mode)) {
+		/* a left over socket from a server that is gone. Anything else
+		 * at @socket_path is not ours, and bind() below fails on it. */
+		unlink (socket_path);
+	}
+
+	/* the state of a socket after a failed connect() is unspecified.
+	 * Bind a fresh one. */
+	nm_close (fd);
+	fd = socket (AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		r = errno;
+		goto fail;
+	}
+
+	old_umask = umask (0077);
+	r = bind (fd, (struct sockaddr *) &addr, addr_len);
+	if (r < 0)
+		r = errno;
+	umask (old_umask);
+	if (r != 0)
+		goto fail;
+
+	if (listen (fd, 16) < 0) {
+		r = errno;
+		unlink (socket_path);
+		goto fail;
+	}
+
+	gl.loop = g_main_loop_new (NULL, FALSE);
+	accept_id = g_unix_fd_add (fd, G_IO_IN, _server_accept_cb, NULL);
+	sigint_id = g_unix_signal_add (SIGINT, _server_signal_cb, NULL);
+	sigterm_id = g_unix_signal_add (SIGTERM, _server_signal_cb, NULL);
+
+	g_main_loop_run (gl.loop);
+
+	nm_clear_g_source (&sigterm_id);
+	nm_clear_g_source (&sigint_id);
+	nm_clear_g_source (&accept_id);
+	unlink (socket_path);
+
+	nm_clear_g_source (&gl.dispatch_id);
+	while ((req = g_queue_pop_head (&gl.queue)))
+		_request_free (req);
+	g_slist_free_full (g_steal_pointer (&gl.reading), (GDestroyNotify) _request_free);
+
+	g_clear_pointer (&gl.loop, g_main_loop_unref);
+	g_clear_pointer (&gl.last_argv, g_strfreev);
+	g_clear_object (&gl.client);
+	return NMC_RESULT_SUCCESS;
+
+fail:
+	g_printerr (_("Error: cannot listen on '%s': %s\n"), socket_path, g_strerror (r));
+	g_clear_object (&gl.client);
+	return NMC_RESULT_ERROR_UNKNOWN;
+}
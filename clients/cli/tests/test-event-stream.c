@@ -0,0 +1,290 @@
+/* nmcli - command-line tool to control NetworkManager
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright 2018 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include <locale.h>
+
+#include "event-stream.h"
+
+#include "nm-utils/nm-test-utils.h"
+
+/*****************************************************************************/
+
+#define TEST_TYPE_OBJECT (test_object_get_type ())
+
+typedef struct {
+	GObject parent;
+	char *str;
+	double dbl;
+	gboolean flag;
+} TestObject;
+
+typedef struct {
+	GObjectClass parent;
+} TestObjectClass;
+
+enum {
+	PROP_0,
+	PROP_STR,
+	PROP_DBL,
+	PROP_FLAG,
+};
+
+static GType test_object_get_type (void);
+
+G_DEFINE_TYPE (TestObject, test_object, G_TYPE_OBJECT)
+
+static void
+test_object_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+	TestObject *self = (TestObject *) object;
+
+	switch (prop_id) {
+	case PROP_STR:
+		g_value_set_string (value, self->str);
+		break;
+	case PROP_DBL:
+		g_value_set_double (value, self->dbl);
+		break;
+	case PROP_FLAG:
+		g_value_set_boolean (value, self->flag);
+		break;
+	default:
+		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+		break;
+	}
+}
+
+static void
+test_object_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+	TestObject *self = (TestObject *) object;
+
+	switch (prop_id) {
+	case PROP_STR:
+		g_free (self->str);
+		self->str = g_value_dup_string (value);
+		break;
+	case PROP_DBL:
+		self->dbl = g_value_get_double (value);
+		break;
+	case PROP_FLAG:
+		self->flag = g_value_get_boolean (value);
+		break;
+	default:
+		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+		break;
+	}
+}
+
+static void
+test_object_init (TestObject *self)
+{
+}
+
+static void
+test_object_finalize (GObject *object)
+{
+	g_free (((TestObject *) object)->str);
+
+	G_OBJECT_CLASS (test_object_parent_class)->finalize (object);
+}
+
+static void
+test_object_class_init (TestObjectClass *klass)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+	object_class->get_property = test_object_get_property;
+	object_class->set_property = test_object_set_property;
+	object_class->finalize = test_object_finalize;
+
+	g_object_class_install_property
+	    (object_class, PROP_STR,
+	     g_param_spec_string ("str", "", "",
+	                          NULL,
+	                          G_PARAM_READWRITE |
+	                          G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+	    (object_class, PROP_DBL,
+	     g_param_spec_double ("dbl", "", "",
+	                          -G_MAXDOUBLE, G_MAXDOUBLE, 0.0,
+	                          G_PARAM_READWRITE |
+	                          G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+	    (object_class, PROP_FLAG,
+	     g_param_spec_boolean ("flag", "", "",
+	                           FALSE,
+	                           G_PARAM_READWRITE |
+	                           G_PARAM_STATIC_STRINGS));
+}
+
+/*****************************************************************************/
+
+/* Frees @stream, which flushes the pending events to @out, and returns
+ * the written lines with the leading "ts" member stripped. */
+static char **
+_stream_finish (NmcEventStream *stream, FILE *out)
+{
+	GString *str = g_string_new (NULL);
+	char buf[256];
+	char **lines;
+	gsize n;
+	guint i;
+
+	nmc_event_stream_free (stream);
+
+	rewind (out);
+	while ((n = fread (buf, 1, sizeof (buf), out)) > 0)
+		g_string_append_len (str, buf, n);
+	fclose (out);
+
+	/* every event is terminated by a newline. */
+	g_assert (str->len > 0);
+	g_assert (str->str[str->len - 1] == '\n');
+	g_string_truncate (str, str->len - 1);
+
+	lines = g_strsplit (str->str, "\n", -1);
+	g_string_free (str, TRUE);
+
+	for (i = 0; lines[i]; i++) {
+		const char *s = lines[i];
+
+		g_assert (g_str_has_prefix (s, "{\"ts\":"));
+		s += NM_STRLEN ("{\"ts\":");
+		g_assert (g_ascii_isdigit (s[0]));
+		while (g_ascii_isdigit (s[0]))
+			s++;
+		g_assert (s[0] == ',');
+		memmove (lines[i], &s[1], strlen (&s[1]) + 1);
+	}
+
+	return lines;
+}
+
+static NmcEventStream *
+_stream_new (FILE **out)
+{
+	NmcEventStream *stream;
+
+	*out = tmpfile ();
+	g_assert (*out);
+
+	stream = nmc_event_stream_new ();
+	nmc_event_stream_set_output (stream, *out);
+	return stream;
+}
+
+/*****************************************************************************/
+
+static void
+test_event_stream_escape (void)
+{
+	gs_unref_object GObject *obj = g_object_new (TEST_TYPE_OBJECT, NULL);
+	gs_strfreev char **lines = NULL;
+	NmcEventStream *stream;
+	FILE *out;
+
+	stream = _stream_new (&out);
+	nmc_event_stream_watch (stream, obj);
+	g_object_set (obj, "str", "a\"b\\c\nd\te\001f\037g\303\244", NULL);
+
+	lines = _stream_finish (stream, out);
+	g_assert_cmpint (g_strv_length (lines), ==, 1);
+	g_assert_cmpstr (lines[0], ==, "\"path\":null,\"event\":\"changed\",\"props\":{\"str\":\"a\\\"b\\\\c\\nd\\te\\u0001f\\u001fg\303\244\"}}");
+}
+
+static void
+test_event_stream_double (void)
+{
+	gs_unref_object GObject *obj = g_object_new (TEST_TYPE_OBJECT, NULL);
+	gs_strfreev char **lines = NULL;
+	gs_free char *old_locale = NULL;
+	NmcEventStream *stream;
+	FILE *out;
+
+	/* the output must not depend on the decimal separator of the locale. */
+	old_locale = g_strdup (setlocale (LC_NUMERIC, NULL));
+	if (   !setlocale (LC_NUMERIC, "de_DE.UTF-8")
+	    && !setlocale (LC_NUMERIC, "de_DE"))
+		g_test_message ("no locale with a decimal comma available");
+
+	stream = _stream_new (&out);
+	nmc_event_stream_watch (stream, obj);
+	g_object_set (obj, "dbl", 1.5, NULL);
+
+	lines = _stream_finish (stream, out);
+	setlocale (LC_NUMERIC, old_locale);
+
+	g_assert_cmpint (g_strv_length (lines), ==, 1);
+	g_assert_cmpstr (lines[0], ==, "\"path\":null,\"event\":\"changed\",\"props\":{\"dbl\":1.5}}");
+}
+
+static void
+test_event_stream_framing (void)
+{
+	gs_unref_object GObject *obj = g_object_new (TEST_TYPE_OBJECT, NULL);
+	gs_strfreev char **lines = NULL;
+	NmcEventStream *stream;
+	FILE *out;
+
+	stream = _stream_new (&out);
+
+	nmc_event_stream_emit (stream, obj, NMC_EVENT_ADDED);
+	nmc_event_stream_watch (stream, obj);
+	g_assert_cmpint (nmc_event_stream_get_n_watched (stream), ==, 1);
+
+	/* changes of the same object are merged into one event. */
+	g_object_set (obj, "flag", TRUE, NULL);
+	g_object_set (obj, "str", "x", NULL);
+	g_object_set (obj, "flag", FALSE, NULL);
+
+	/* changes after an event are reported after it. */
+	nmc_event_stream_emit (stream, obj, NMC_EVENT_REMOVED);
+	g_object_set (obj, "str", "y", NULL);
+
+	g_assert (nmc_event_stream_unwatch (stream, obj));
+	g_assert (!nmc_event_stream_unwatch (stream, obj));
+	g_assert_cmpint (nmc_event_stream_get_n_watched (stream), ==, 0);
+
+	/* the values are taken when the changes are notified. */
+	lines = _stream_finish (stream, out);
+	g_assert_cmpint (g_strv_length (lines), ==, 4);
+	g_assert_cmpstr (lines[0], ==, "\"path\":null,\"event\":\"added\",\"type\":\"TestObject\"}");
+	g_assert_cmpstr (lines[1], ==, "\"path\":null,\"event\":\"changed\",\"props\":{\"flag\":false,\"str\":\"x\"}}");
+	g_assert_cmpstr (lines[2], ==, "\"path\":null,\"event\":\"removed\"}");
+	g_assert_cmpstr (lines[3], ==, "\"path\":null,\"event\":\"changed\",\"props\":{\"str\":\"y\"}}");
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE ();
+
+int
+main (int argc, char **argv)
+{
+	nmtst_init (&argc, &argv, TRUE);
+
+	g_test_add_func ("/client/event-stream/escape", test_event_stream_escape);
+	g_test_add_func ("/client/event-stream/double", test_event_stream_double);
+	g_test_add_func ("/client/event-stream/framing", test_event_stream_framing);
+
+	return g_test_run ();
+}
@@ -0,0 +1,210 @@
+/* nmcli - command-line tool to control NetworkManager
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Copyright 2018 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include "utils.h"
+#include "common.h"
+
+#include "nm-utils/nm-test-utils.h"
+
+/*****************************************************************************/
+
+/* utils.c is linked without the rest of nmcli. Provide what it refers to. */
+
+NmCli nm_cli;
+
+const NMMetaEnvironment *const nmc_meta_environment = &((NMMetaEnvironment) { 0 });
+NmCli *const nmc_meta_environment_arg = &nm_cli;
+
+const char *
+nmc_getenv (const char *variable)
+{
+	return NULL;
+}
+
+void
+nm_cli_spawn_pager (NmCli *nmc)
+{
+}
+
+void
+nmc_complete_strings (const char *prefix, ...)
+{
+}
+
+/*****************************************************************************/
+
+static GString *_printed;
+
+static void
+_print_handler (const char *string)
+{
+	g_string_append (_printed, string);
+}
+
+static guint
+_count_lines (const char *str)
+{
+	guint n = 0;
+
+	for (; *str; str++) {
+		if (*str == '\n')
+			n++;
+	}
+	return n;
+}
+
+static GPtrArray *
+_create_connections (guint n)
+{
+	GPtrArray *connections;
+	guint i;
+
+	connections = g_ptr_array_new_with_free_func (g_object_unref);
+	for (i = 0; i < n; i++) {
+		NMConnection *connection;
+		NMSettingConnection *s_con;
+		char id[64];
+
+		connection = nmtst_create_minimal_connection (nm_sprintf_buf (id, "con-%u", i),
+		                                              NULL,
+		                                              NM_SETTING_WIRED_SETTING_NAME,
+		                                              &s_con);
+		g_object_set (s_con,
+		              NM_SETTING_CONNECTION_AUTOCONNECT, (gboolean) (i % 2 == 0),
+		              NULL);
+		nmtst_connection_normalize (connection);
+		g_ptr_array_add (connections, connection);
+	}
+	return connections;
+}
+
+/*****************************************************************************/
+
+static void
+test_print_connections (void)
+{
+	const NMMetaSettingInfoEditor *con_info = &nm_meta_setting_infos_editor[NM_META_SETTING_TYPE_CONNECTION];
+	const NmcConfig nmc_config = {
+		.print_output = NMC_PRINT_NORMAL,
+		.multiline_output = TRUE,
+	};
+	const NmcConfig nmc_config_tabular = {
+		.print_output = NMC_PRINT_TERSE,
+	};
+	const guint n_connections = nmtst_test_quick () ? 20 : 10000;
+	gs_unref_ptrarray GPtrArray *connections = NULL;
+	gs_unref_ptrarray GPtrArray *s_cons = NULL;
+	GPrintFunc old_print_handler;
+	gint64 start_ts;
+	guint n_lines = 0;
+	guint n_fields = 0;
+	guint i, j;
+
+	connections = _create_connections (n_connections);
+
+	_printed = g_string_sized_new (4096);
+	old_print_handler = g_set_print_handler (_print_handler);
+
+	start_ts = g_get_monotonic_time ();
+
+	/* render every setting of every profile, like "nmcli connection show $ID". */
+	for (i = 0; i < n_connections; i++) {
+		gs_free NMSetting **settings = NULL;
+		guint n_settings;
+
+		settings = nm_connection_get_settings (connections->pdata[i], &n_settings);
+		for (j = 0; j < n_settings; j++) {
+			const NMMetaSettingInfoEditor *setting_info;
+
+			setting_info = nm_meta_setting_info_editor_find_by_setting (settings[j]);
+			g_assert (setting_info);
+
+			g_string_truncate (_printed, 0);
+			g_assert (nmc_print (&nmc_config,
+			                     (gpointer[]) { settings[j], NULL },
+			                     NULL,
+			                     NULL,
+			                     (const NMMetaAbstractInfo *const[]) { (const NMMetaAbstractInfo *) setting_info, NULL },
+			                     setting_info->general->setting_name,
+			                     NULL));
+
+			n_lines = _count_lines (_printed->str);
+			g_assert_cmpint (n_lines, >, 0);
+			n_fields += n_lines;
+
+			if (setting_info == con_info) {
+				const char *s;
+
+				s = strstr (_printed->str, NM_SETTING_CONNECTION_SETTING_NAME "." NM_SETTING_CONNECTION_AUTOCONNECT ":");
+				g_assert (s);
+				s += NM_STRLEN (NM_SETTING_CONNECTION_SETTING_NAME "." NM_SETTING_CONNECTION_AUTOCONNECT ":");
+				while (s[0] == ' ')
+					s++;
+				g_assert (g_str_has_prefix (s, i % 2 ? "no\n" : "yes\n"));
+			}
+		}
+	}
+
+	/* and the connection settings of all profiles in one table, which
+	 * is filled in several chunks. */
+	s_cons = g_ptr_array_new ();
+	for (i = 0; i < n_connections; i++)
+		g_ptr_array_add (s_cons, nm_connection_get_setting_connection (connections->pdata[i]));
+	g_ptr_array_add (s_cons, NULL);
+
+	g_string_truncate (_printed, 0);
+	g_assert (nmc_print (&nmc_config_tabular,
+	                     s_cons->pdata,
+	                     NULL,
+	                     NULL,
+	                     (const NMMetaAbstractInfo *const[]) { (const NMMetaAbstractInfo *) con_info, NULL },
+	                     NM_SETTING_CONNECTION_SETTING_NAME "." NM_SETTING_CONNECTION_ID ","
+	                     NM_SETTING_CONNECTION_SETTING_NAME "." NM_SETTING_CONNECTION_AUTOCONNECT,
+	                     NULL));
+	n_lines = _count_lines (_printed->str);
+	g_assert_cmpint (n_lines, ==, n_connections);
+	g_assert (g_str_has_prefix (_printed->str, "con-0:yes\ncon-1:no\n"));
+
+	if (!nmtst_test_quick ()) {
+		g_test_message ("printed %u fields of %u connections in %.3f seconds",
+		                n_fields + 2 * n_lines,
+		                n_connections,
+		                (double) (g_get_monotonic_time () - start_ts) / G_USEC_PER_SEC);
+	}
+
+	g_set_print_handler (old_print_handler);
+	g_string_free (_printed, TRUE);
+	_printed = NULL;
+}
+
+/*****************************************************************************/
+
+NMTST_DEFINE ();
+
+int
+main (int argc, char **argv)
+{
+	nmtst_init (&argc, &argv, TRUE);
+
+	g_test_add_func ("/client/print/connections", test_print_connections);
+
+	return g_test_run ();
+}
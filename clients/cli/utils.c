@@ -995,22 +995,20 @@ _print_data_cell_clear (gpointer cell_p)
 	_print_data_cell_clear_text (cell);
 }
 
-static void
-_print_fill (const NmcConfig *nmc_config,
-             gpointer const *targets,
-             gpointer targets_data,
-             const PrintDataCol *cols,
-             guint cols_len,
-             GArray **out_header_row,
-             GArray **out_cells)
+/* nmc_print() fills and prints the rows in chunks of this many rows,
+ * so that the memory does not grow with the number of rows. With more
+ * than one chunk, a first pass over all chunks determines the column
+ * widths and the columns to print, and the rows are filled again for
+ * printing. */
+#define PRINT_CHUNK_ROWS 1000
+
+static GArray *
+_print_fill_header (const NmcConfig *nmc_config,
+                    const PrintDataCol *cols,
+                    guint cols_len)
 {
-	GArray *cells;
 	GArray *header_row;
-	guint i_row, i_col;
-	guint targets_len;
-	NMMetaAccessorGetType text_get_type;
-	NMMetaAccessorGetFlags text_get_flags;
-
+	guint i_col;
 
 	header_row = g_array_sized_new (FALSE, TRUE, sizeof (PrintDataHeaderCell), cols_len);
 	g_array_set_clear_func (header_row, _print_data_header_cell_clear);
@@ -1050,12 +1048,30 @@ _print_fill (const NmcConfig *nmc_config,
 			                                      header_cell->title);
 			header_cell->title_to_free = TRUE;
 		}
+
+		/* _print_fill_cells() widens the column for the cells. */
+		header_cell->width = nmc_string_screen_width (header_cell->title, NULL);
 	}
 
-	targets_len = NM_PTRARRAY_LEN (targets);
+	return header_row;
+}
 
-	cells = g_array_sized_new (FALSE, TRUE, sizeof (PrintDataCell), targets_len * header_row->len);
-	g_array_set_clear_func (cells, _print_data_cell_clear);
+static void
+_print_fill_cells (const NmcConfig *nmc_config,
+                   GArray *header_row,
+                   GArray *cells,
+                   gpointer const *targets,
+                   guint targets_len,
+                   gpointer targets_data,
+                   gboolean update_header)
+{
+	guint i_row, i_col;
+	NMMetaAccessorGetType text_get_type;
+	NMMetaAccessorGetFlags text_get_flags;
+
+	/* @cells is reused for every chunk. Dropping the old cells frees their
+	 * texts, the new ones are zero initialized. */
+	g_array_set_size (cells, 0);
 	g_array_set_size (cells, targets_len * header_row->len);
 
 	text_get_type = nmc_print_output_to_accessor_get_type (nmc_config->print_output);
@@ -1095,9 +1111,11 @@ _print_fill (const NmcConfig *nmc_config,
 
 			nm_assert (!to_free || value == to_free);
 
-			if (   is_default
-			    && (   nmc_config->overview
-			        || NM_FLAGS_HAS (text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_HIDE))) {
+			if (!update_header) {
+				/* the columns to print were already decided by the first pass. */
+			} else if (   is_default
+			           && (   nmc_config->overview
+			               || NM_FLAGS_HAS (text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_HIDE))) {
 				/* don't mark the entry for display. This is to shorten the output in case
 				 * the property is the default value. But we only do that, if the user
 				 * opts in to this behavior (-overview), or of the property marks itself
@@ -1151,13 +1169,14 @@ _print_fill (const NmcConfig *nmc_config,
 		}
 	}
 
+	if (!update_header)
+		return;
+
 	for (i_col = 0; i_col < header_row->len; i_col++) {
 		PrintDataHeaderCell *header_cell = &g_array_index (header_row, PrintDataHeaderCell, i_col);
 
-		header_cell->width = nmc_string_screen_width (header_cell->title, NULL);
-
 		for (i_row = 0; i_row < targets_len; i_row++) {
-			const PrintDataCell *cell = &g_array_index (cells, PrintDataCell, i_row * cols_len + i_col);
+			const PrintDataCell *cell = &g_array_index (cells, PrintDataCell, i_row * header_row->len + i_col);
 			const char *const*i_strv;
 
 			switch (cell->text_format) {
@@ -1176,12 +1195,7 @@ _print_fill (const NmcConfig *nmc_config,
 				break;
 			}
 		}
-
-		header_cell->width += 1;
 	}
-
-	*out_header_row = header_row;
-	*out_cells = cells;
 }
 
 static gboolean
@@ -1221,16 +1235,14 @@ _print_skip_column (const NmcConfig *nmc_config,
 }
 
 static void
-_print_do (const NmcConfig *nmc_config,
-           const char *header_name_no_l10n,
-           guint col_len,
-           guint row_len,
-           const PrintDataHeaderCell *header_row,
-           const PrintDataCell *cells)
+_print_do_header (const NmcConfig *nmc_config,
+                  const char *header_name_no_l10n,
+                  guint col_len,
+                  const PrintDataHeaderCell *header_row)
 {
 	int width1, width2;
 	int table_width = 0;
-	guint i_row, i_col;
+	guint i_col;
 	nm_auto_free_gstring GString *str = NULL;
 
 	g_assert (col_len);
@@ -1259,13 +1271,10 @@ _print_do (const NmcConfig *nmc_config,
 		g_print ("%s\n", line);
 	}
 
-	str = !nmc_config->multiline_output
-	      ? g_string_sized_new (100)
-	      : NULL;
-
 	/* print the header for the tabular form */
 	if (   NM_IN_SET (nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
 	    && !nmc_config->multiline_output) {
+		str = g_string_sized_new (100);
 		for (i_col = 0; i_col < col_len; i_col++) {
 			const PrintDataHeaderCell *header_cell = &header_row[i_col];
 			const char *title;
@@ -1294,6 +1303,29 @@ _print_do (const NmcConfig *nmc_config,
 			g_print ("%s\n", (line = g_strnfill (table_width, '-')));
 		}
 	}
+}
+
+static void
+_print_do_rows (const NmcConfig *nmc_config,
+                guint col_len,
+                guint row_len,
+                const PrintDataHeaderCell *header_row,
+                const PrintDataCell *cells)
+{
+	int width1, width2;
+	guint i_row, i_col;
+	nm_auto_free_gstring GString *str = NULL;
+	nm_auto_free_gstring GString *prefix = NULL;
+	gs_free char *separator = NULL;
+
+	g_assert (col_len);
+
+	if (nmc_config->multiline_output) {
+		prefix = g_string_sized_new (64);
+		if (nmc_config->print_output == NMC_PRINT_PRETTY)
+			separator = g_strnfill (ML_HEADER_WIDTH, '-');
+	} else
+		str = g_string_sized_new (100);
 
 	for (i_row = 0; i_row < row_len; i_row++) {
 		const PrintDataCell *current_line = &cells[i_row * col_len];
@@ -1325,19 +1357,17 @@ _print_do (const NmcConfig *nmc_config,
 
 				text = colorize_string (nmc_config, cell->color, lines[i_lines], &text_to_free);
 				if (nmc_config->multiline_output) {
-					gs_free char *prefix = NULL;
-
+					g_string_assign (prefix, cell->header_cell->title);
 					if (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_STRV)
-						prefix = g_strdup_printf ("%s[%u]:", cell->header_cell->title, i_lines + 1);
-					else
-						prefix = g_strdup_printf ("%s:", cell->header_cell->title);
-					width1 = strlen (prefix);
-					width2 = nmc_string_screen_width (prefix, NULL);
+						g_string_append_printf (prefix, "[%u]", i_lines + 1);
+					g_string_append_c (prefix, ':');
+					width1 = prefix->len;
+					width2 = nmc_string_screen_width (prefix->str, NULL);
 					g_print ("%-*s%s\n",
 					         (int) (  nmc_config->print_output == NMC_PRINT_TERSE
 					               ? 0
 					               : ML_VALUE_INDENT+width1-width2),
-					         prefix,
+					         prefix->str,
 					         text);
 				} else {
 					nm_assert (str);
@@ -1361,7 +1391,6 @@ _print_do (const NmcConfig *nmc_config,
 						width2 = nmc_string_screen_width (text, NULL);  /* Width of the string (in screen columns) */
 						g_string_append_printf (str, "%-*s", (int) (header_cell->width + width1 - width2), text);
 						g_string_append_c (str, ' ');  /* Column separator */
-						table_width += header_cell->width + width1 - width2 + 1;
 					}
 				}
 			}
@@ -1375,12 +1404,8 @@ _print_do (const NmcConfig *nmc_config,
 			g_string_truncate (str, 0);
 		}
 
-		if (   nmc_config->print_output == NMC_PRINT_PRETTY
-		    && nmc_config->multiline_output) {
-			gs_free char *line = NULL;
-
-			g_print ("%s\n", (line = g_strnfill (ML_HEADER_WIDTH, '-')));
-		}
+		if (separator)
+			g_print ("%s\n", separator);
 	}
 }
 
@@ -1397,26 +1422,73 @@ nmc_print (const NmcConfig *nmc_config,
 	gs_unref_array GArray *cols = NULL;
 	gs_unref_array GArray *header_row = NULL;
 	gs_unref_array GArray *cells = NULL;
+	guint targets_len;
+	guint i_row;
+	guint i_col;
 
 	if (!_output_selection_parse (fields, fields_str,
 	                              &cols, &gfree_keeper,
 	                              error))
 		return FALSE;
 
-	_print_fill (nmc_config,
-	             targets,
-	             targets_data,
-	             &g_array_index (cols, PrintDataCol, 0),
-	             cols->len,
-	             &header_row,
-	             &cells);
-
-	_print_do (nmc_config,
-	           header_name_no_l10n,
-	           header_row->len,
-	           cells->len / header_row->len,
-	           &g_array_index (header_row, PrintDataHeaderCell, 0),
-	           &g_array_index (cells, PrintDataCell, 0));
+	header_row = _print_fill_header (nmc_config,
+	                                 &g_array_index (cols, PrintDataCol, 0),
+	                                 cols->len);
+
+	targets_len = NM_PTRARRAY_LEN (targets);
+
+	/* all chunks are filled into the same array. */
+	cells = g_array_sized_new (FALSE, TRUE, sizeof (PrintDataCell),
+	                           NM_MIN (targets_len, (guint) PRINT_CHUNK_ROWS) * header_row->len);
+	g_array_set_clear_func (cells, _print_data_cell_clear);
+
+	/* First determine the column widths and the columns to print over
+	 * all rows. A single chunk is kept for printing, larger tables are
+	 * filled again chunk by chunk below. */
+	i_row = 0;
+	do {
+		guint n_rows = NM_MIN (targets_len - i_row, (guint) PRINT_CHUNK_ROWS);
+
+		_print_fill_cells (nmc_config,
+		                   header_row,
+		                   cells,
+		                   &targets[i_row],
+		                   n_rows,
+		                   targets_data,
+		                   TRUE);
+		i_row += n_rows;
+	} while (i_row < targets_len);
+
+	for (i_col = 0; i_col < header_row->len; i_col++)
+		g_array_index (header_row, PrintDataHeaderCell, i_col).width += 1;
+
+	_print_do_header (nmc_config,
+	                  header_name_no_l10n,
+	                  header_row->len,
+	                  &g_array_index (header_row, PrintDataHeaderCell, 0));
+
+	i_row = 0;
+	do {
+		guint n_rows = NM_MIN (targets_len - i_row, (guint) PRINT_CHUNK_ROWS);
+
+		if (n_rows != targets_len) {
+			_print_fill_cells (nmc_config,
+			                   header_row,
+			                   cells,
+			                   &targets[i_row],
+			                   n_rows,
+			                   targets_data,
+			                   FALSE);
+		}
+
+		_print_do_rows (nmc_config,
+		                header_row->len,
+		                n_rows,
+		                &g_array_index (header_row, PrintDataHeaderCell, 0),
+		                &g_array_index (cells, PrintDataCell, 0));
+
+		i_row += n_rows;
+	} while (i_row < targets_len);
 
 	return TRUE;
 }
@@ -1451,7 +1523,7 @@ pager_fallback (void)
 pid_t
 nmc_terminal_spawn_pager (const NmcConfig *nmc_config)
 {
-	const char *pager = getenv ("PAGER");
+	const char *pager = nmc_getenv ("PAGER");
 	pid_t pager_pid;
 	pid_t parent_pid;
 	int fd[2];
@@ -443,7 +443,7 @@ nmc_activation_get_effective_state (NMActiveConnection *active,
 }
 
 static gboolean
-can_show_graphics (void)
+can_show_graphics (const char *term)
 {
 	static gboolean can_show_graphics_set = FALSE;
 	gboolean can_show_graphics = TRUE;
@@ -462,7 +462,7 @@ can_show_graphics (void)
 	}
 
 	/* The linux console font typically doesn't have characters we need */
-	if (g_strcmp0 (g_getenv ("TERM"), "linux") == 0)
+	if (g_strcmp0 (term, "linux") == 0)
 		can_show_graphics = FALSE;
 
 	return can_show_graphics;
@@ -471,6 +471,7 @@ can_show_graphics (void)
 /**
  * nmc_wifi_strength_bars:
  * @strength: the access point strength, from 0 to 100
+ * @term: the value of the TERM environment variable of the output terminal
  *
  * Converts @strength into a 4-character-wide graphical representation of
  * strength suitable for printing to stdout. If the current locale and terminal
@@ -480,9 +481,9 @@ can_show_graphics (void)
  * Returns: the graphical representation of the access point strength
  */
 const char *
-nmc_wifi_strength_bars (guint8 strength)
+nmc_wifi_strength_bars (guint8 strength, const char *term)
 {
-	if (!can_show_graphics ())
+	if (!can_show_graphics (term))
 		return nm_utils_wifi_strength_bars (strength);
 
 	if (strength > 80)
@@ -499,13 +500,14 @@ nmc_wifi_strength_bars (guint8 strength)
 
 /**
  * nmc_utils_password_subst_char:
+ * @term: the value of the TERM environment variable of the output terminal
  *
  * Returns: the string substituted when hiding actual password glyphs
  */
 const char *
-nmc_password_subst_char (void)
+nmc_password_subst_char (const char *term)
 {
-	if (can_show_graphics ())
+	if (can_show_graphics (term))
 		return "\u2022"; /* Bullet */
 	else
 		return "*";
@@ -50,8 +50,8 @@ NMActiveConnectionState nmc_activation_get_effective_state (NMActiveConnection *
                                                             NMDevice *device,
                                                             const char **reason);
 
-const char *nmc_wifi_strength_bars (guint8 strength);
+const char *nmc_wifi_strength_bars (guint8 strength, const char *term);
 
-const char *nmc_password_subst_char (void);
+const char *nmc_password_subst_char (const char *term);
 
 #endif /* __NM_CLIENT_UTILS_H__ */
@@ -86,19 +86,30 @@ nm_meta_setting_info_editor_find_by_setting (NMSetting *setting)
 const NMMetaPropertyInfo *
 nm_meta_setting_info_editor_get_property_info (const NMMetaSettingInfoEditor *setting_info, const char *property_name)
 {
+	static GHashTable *by_name[_NM_META_SETTING_TYPE_NUM];
+	GHashTable **p_by_name;
 	guint i;
 
 	g_return_val_if_fail (setting_info, NULL);
 	g_return_val_if_fail (property_name, NULL);
 
-	for (i = 0; i < setting_info->properties_num; i++) {
-		nm_assert (setting_info->properties[i]->property_name);
-		nm_assert (setting_info->properties[i]->setting_info == setting_info);
-		if (nm_streq (setting_info->properties[i]->property_name, property_name))
-			return setting_info->properties[i];
+	nm_assert (setting_info == &nm_meta_setting_infos_editor[setting_info->general->meta_type]);
+
+	/* The properties are looked up by name for every field that is printed or set.
+	 * Index them on first use. */
+	p_by_name = &by_name[setting_info->general->meta_type];
+	if (G_UNLIKELY (!*p_by_name)) {
+		*p_by_name = g_hash_table_new (nm_str_hash, g_str_equal);
+		for (i = 0; i < setting_info->properties_num; i++) {
+			nm_assert (setting_info->properties[i]->property_name);
+			nm_assert (setting_info->properties[i]->setting_info == setting_info);
+			g_hash_table_insert (*p_by_name,
+			                     (gpointer) setting_info->properties[i]->property_name,
+			                     (gpointer) setting_info->properties[i]);
+		}
 	}
 
-	return NULL;
+	return g_hash_table_lookup (*p_by_name, property_name);
 }
 
 const NMMetaPropertyInfo *
@@ -72,6 +72,30 @@ _gtype_property_get_gtype (GType gtype, const char *property_name)
 	g_return_val_if_reached (G_TYPE_INVALID);
 }
 
+static GParamSpec *
+_property_info_get_pspec (const NMMetaPropertyInfo *property_info, NMSetting *setting)
+{
+	static GHashTable *cache = NULL;
+	GParamSpec *pspec;
+
+	/* g_object_class_find_property() is comparatively expensive and the
+	 * getters are called for every field that nmcli prints. The param specs
+	 * of the NMSetting classes never change, so remember them per property info. */
+	if (G_UNLIKELY (!cache))
+		cache = g_hash_table_new (nm_direct_hash, NULL);
+
+	pspec = g_hash_table_lookup (cache, property_info);
+	if (G_UNLIKELY (!pspec)) {
+		pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (setting), property_info->property_name);
+		if (!pspec)
+			g_return_val_if_reached (NULL);
+		g_hash_table_insert (cache, (gpointer) property_info, pspec);
+	}
+
+	nm_assert (G_TYPE_CHECK_INSTANCE_TYPE (setting, pspec->owner_type));
+	return pspec;
+}
+
 /*****************************************************************************/
 
 static NMIPAddress *
@@ -682,30 +706,35 @@ _env_warn_fcn (const NMMetaEnvironment *environment,
 	} G_STMT_END
 
 static gboolean
-property_is_default (NMSetting *setting, const char *prop_name)
+_gvalue_is_default (GParamSpec *pspec, const GValue *v)
 {
-	nm_auto_unset_gvalue GValue v = G_VALUE_INIT;
-	GParamSpec *pspec;
 	GHashTable *ht;
 	char **strv;
 
-	pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (G_OBJECT (setting)),
-	                                      prop_name);
-	if (!G_IS_PARAM_SPEC (pspec))
-		g_return_val_if_reached (FALSE);
-
-	g_value_init (&v, pspec->value_type);
-	g_object_get_property (G_OBJECT (setting), prop_name, &v);
-
 	if (pspec->value_type == G_TYPE_STRV) {
-		strv = g_value_get_boxed (&v);
+		strv = g_value_get_boxed (v);
 		return !strv || !strv[0];
 	} else if (pspec->value_type == G_TYPE_HASH_TABLE) {
-		ht = g_value_get_boxed (&v);
+		ht = g_value_get_boxed (v);
 		return !ht || !g_hash_table_size (ht);
 	}
 
-	return g_param_value_defaults (pspec, &v);
+	return g_param_value_defaults (pspec, (GValue *) v);
+}
+
+static gboolean
+property_is_default (const NMMetaPropertyInfo *property_info, NMSetting *setting)
+{
+	nm_auto_unset_gvalue GValue v = G_VALUE_INIT;
+	GParamSpec *pspec;
+
+	pspec = _property_info_get_pspec (property_info, setting);
+	if (!pspec)
+		return FALSE;
+
+	g_value_init (&v, pspec->value_type);
+	g_object_get_property (G_OBJECT (setting), pspec->name, &v);
+	return _gvalue_is_default (pspec, &v);
 }
 
 static gconstpointer
@@ -716,7 +745,7 @@ _get_fcn_nmc_with_default (ARGS_GET_FCN)
 	GValue val = G_VALUE_INIT;
 
 	RETURN_UNSUPPORTED_GET_TYPE ();
-	NM_SET_OUT (out_is_default, property_is_default (setting, property_info->property_name));
+	NM_SET_OUT (out_is_default, property_is_default (property_info, setting));
 
 	if (property_info->property_typ_data->subtype.get_with_default.fcn (setting)) {
 		if (get_type == NM_META_ACCESSOR_GET_TYPE_PRETTY)
@@ -743,33 +772,57 @@ _get_fcn_gobject_impl (const NMMetaPropertyInfo *property_info,
                        gboolean *out_is_default,
                        gpointer *out_to_free)
 {
+	GParamSpec *pspec;
+	char buf[64];
 	char *s;
-	const char *s_c;
-	GType gtype_prop;
 	nm_auto_unset_gvalue GValue val = G_VALUE_INIT;
+	nm_auto_unset_gvalue GValue val_str = G_VALUE_INIT;
 
 	RETURN_UNSUPPORTED_GET_TYPE ();
-	NM_SET_OUT (out_is_default, property_is_default (setting, property_info->property_name));
 
-	gtype_prop = _gobject_property_get_gtype (G_OBJECT (setting), property_info->property_name);
+	pspec = _property_info_get_pspec (property_info, setting);
+	if (!pspec)
+		return NULL;
 
-	if (gtype_prop == G_TYPE_BOOLEAN) {
-		gboolean b;
+	/* fetch the value only once and derive both the default-ness and
+	 * the string representation from it. */
+	g_value_init (&val, pspec->value_type);
+	g_object_get_property (G_OBJECT (setting), pspec->name, &val);
+	NM_SET_OUT (out_is_default, _gvalue_is_default (pspec, &val));
 
-		g_value_init (&val, gtype_prop);
-		g_object_get_property (G_OBJECT (setting), property_info->property_name, &val);
-		b = g_value_get_boolean (&val);
+	/* Format the common types directly, the same way the GValue
+	 * transformation to a string would, but without a second GValue
+	 * and with numbers printed to a stack buffer. */
+	switch (pspec->value_type) {
+	case G_TYPE_BOOLEAN:
 		if (get_type == NM_META_ACCESSOR_GET_TYPE_PRETTY)
-			s_c = b ? _("yes") : _("no");
-		else
-			s_c = b ? "yes" : "no";
-		return s_c;
-	} else {
-		g_value_init (&val, G_TYPE_STRING);
-		g_object_get_property (G_OBJECT (setting), property_info->property_name, &val);
-		s = g_value_dup_string (&val);
-		RETURN_STR_TO_FREE (s);
+			return g_value_get_boolean (&val) ? _("yes") : _("no");
+		return g_value_get_boolean (&val) ? "yes" : "no";
+	case G_TYPE_STRING:
+		RETURN_STR_TO_FREE (g_value_dup_string (&val));
+	case G_TYPE_CHAR:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%d", (int) g_value_get_schar (&val))));
+	case G_TYPE_UCHAR:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%u", (guint) g_value_get_uchar (&val))));
+	case G_TYPE_INT:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%d", g_value_get_int (&val))));
+	case G_TYPE_UINT:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%u", g_value_get_uint (&val))));
+	case G_TYPE_LONG:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%ld", g_value_get_long (&val))));
+	case G_TYPE_ULONG:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%lu", g_value_get_ulong (&val))));
+	case G_TYPE_INT64:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%"G_GINT64_FORMAT, g_value_get_int64 (&val))));
+	case G_TYPE_UINT64:
+		RETURN_STR_TO_FREE (g_strdup (nm_sprintf_buf (buf, "%"G_GUINT64_FORMAT, g_value_get_uint64 (&val))));
 	}
+
+	g_value_init (&val_str, G_TYPE_STRING);
+	if (!g_value_transform (&val, &val_str))
+		g_return_val_if_reached (NULL);
+	s = g_value_dup_string (&val_str);
+	RETURN_STR_TO_FREE (s);
 }
 
 static gconstpointer
@@ -778,6 +831,53 @@ _get_fcn_gobject (ARGS_GET_FCN)
 	return _get_fcn_gobject_impl (property_info, setting, get_type, out_is_default, out_to_free);
 }
 
+static gconstpointer
+_get_fcn_gobject_string (ARGS_GET_FCN)
+{
+	const NMMetaPropertyTypData *typ_data = property_info->property_typ_data;
+	GParamSpec *pspec;
+	const char *s;
+
+	if (   !typ_data
+	    || !typ_data->subtype.gobject_string.get_fcn)
+		return _get_fcn_gobject_impl (property_info, setting, get_type, out_is_default, out_to_free);
+
+	RETURN_UNSUPPORTED_GET_TYPE ();
+
+	pspec = _property_info_get_pspec (property_info, setting);
+	if (!pspec)
+		return NULL;
+
+	/* the string is owned by @setting, there is no need to copy it. */
+	s = typ_data->subtype.gobject_string.get_fcn (setting);
+	NM_SET_OUT (out_is_default, nm_streq0 (s, G_PARAM_SPEC_STRING (pspec)->default_value));
+	return s;
+}
+
+static gconstpointer
+_get_fcn_gobject_bool (ARGS_GET_FCN)
+{
+	const NMMetaPropertyTypData *typ_data = property_info->property_typ_data;
+	GParamSpec *pspec;
+	gboolean b;
+
+	if (   !typ_data
+	    || !typ_data->subtype.gobject_bool.get_fcn)
+		return _get_fcn_gobject_impl (property_info, setting, get_type, out_is_default, out_to_free);
+
+	RETURN_UNSUPPORTED_GET_TYPE ();
+
+	pspec = _property_info_get_pspec (property_info, setting);
+	if (!pspec)
+		return NULL;
+
+	b = !!typ_data->subtype.gobject_bool.get_fcn (setting);
+	NM_SET_OUT (out_is_default, b == !!G_PARAM_SPEC_BOOLEAN (pspec)->default_value);
+	if (get_type == NM_META_ACCESSOR_GET_TYPE_PRETTY)
+		return b ? _("yes") : _("no");
+	return b ? "yes" : "no";
+}
+
 static gconstpointer
 _get_fcn_gobject_int (ARGS_GET_FCN)
 {
@@ -787,16 +887,17 @@ _get_fcn_gobject_int (ARGS_GET_FCN)
 	NMMetaSignUnsignInt64 v;
 	guint base = 10;
 	const NMMetaUtilsIntValueInfo *value_infos;
+	char buf[64];
 	char *return_str;
 
 	RETURN_UNSUPPORTED_GET_TYPE ();
 
-	pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (G_OBJECT (setting)), property_info->property_name);
-	if (!G_IS_PARAM_SPEC (pspec))
-		g_return_val_if_reached (FALSE);
+	pspec = _property_info_get_pspec (property_info, setting);
+	if (!pspec)
+		return NULL;
 
 	g_value_init (&gval, pspec->value_type);
-	g_object_get_property (G_OBJECT (setting), property_info->property_name, &gval);
+	g_object_get_property (G_OBJECT (setting), pspec->name, &gval);
 	NM_SET_OUT (out_is_default, g_param_value_defaults (pspec, &gval));
 	switch (pspec->value_type) {
 	case G_TYPE_INT:
@@ -826,37 +927,34 @@ _get_fcn_gobject_int (ARGS_GET_FCN)
 	switch (base) {
 	case 10:
 		if (is_uint64)
-			return_str = g_strdup_printf ("%"G_GUINT64_FORMAT, v.u64);
+			nm_sprintf_buf (buf, "%"G_GUINT64_FORMAT, v.u64);
 		else
-			return_str = g_strdup_printf ("%"G_GINT64_FORMAT, v.i64);
+			nm_sprintf_buf (buf, "%"G_GINT64_FORMAT, v.i64);
 		break;
 	case 16:
 		if (is_uint64)
-			return_str = g_strdup_printf ("0x%"G_GINT64_MODIFIER"x", v.u64);
+			nm_sprintf_buf (buf, "0x%"G_GINT64_MODIFIER"x", v.u64);
 		else
-			return_str = g_strdup_printf ("0x%"G_GINT64_MODIFIER"x", (guint64) v.i64);
+			nm_sprintf_buf (buf, "0x%"G_GINT64_MODIFIER"x", (guint64) v.i64);
 		break;
 	default:
-		return_str = NULL;
 		g_assert_not_reached ();
 	}
 
+	return_str = NULL;
 	if (   get_type == NM_META_ACCESSOR_GET_TYPE_PRETTY
 	    && property_info->property_typ_data
 	    && (value_infos = property_info->property_typ_data->subtype.gobject_int.value_infos)) {
 		for (; value_infos->nick; value_infos++) {
 			if (   ( is_uint64 && value_infos->value.u64 == v.u64)
 			    || (!is_uint64 && value_infos->value.i64 == v.i64)) {
-				char *old_str = return_str;
-
-				return_str = g_strdup_printf ("%s (%s)", old_str, value_infos->nick);
-				g_free (old_str);
+				return_str = g_strdup_printf ("%s (%s)", buf, value_infos->nick);
 				break;
 			}
 		}
 	}
 
-	RETURN_STR_TO_FREE (return_str);
+	RETURN_STR_TO_FREE (return_str ?: g_strdup (buf));
 }
 
 static gconstpointer
@@ -955,11 +1053,12 @@ _get_fcn_gobject_enum (ARGS_GET_FCN)
 
 	nm_assert (format_text || format_numeric);
 
-	pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (setting), property_info->property_name);
-	g_return_val_if_fail (pspec, NULL);
+	pspec = _property_info_get_pspec (property_info, setting);
+	if (!pspec)
+		return NULL;
 
 	g_value_init (&gval, pspec->value_type);
-	g_object_get_property (G_OBJECT (setting), property_info->property_name, &gval);
+	g_object_get_property (G_OBJECT (setting), pspec->name, &gval);
 	NM_SET_OUT (out_is_default, g_param_value_defaults (pspec, &gval));
 
 	if (   pspec->value_type == G_TYPE_INT
@@ -5117,12 +5216,12 @@ static const NMMetaPropertyType _pt_gobject_readonly = {
 };
 
 static const NMMetaPropertyType _pt_gobject_string = {
-	.get_fcn =                      _get_fcn_gobject,
+	.get_fcn =                      _get_fcn_gobject_string,
 	.set_fcn =                      _set_fcn_gobject_string,
 };
 
 static const NMMetaPropertyType _pt_gobject_bool = {
-	.get_fcn =                      _get_fcn_gobject,
+	.get_fcn =                      _get_fcn_gobject_bool,
 	.set_fcn =                      _set_fcn_gobject_bool,
 	.complete_fcn =                 _complete_fcn_gobject_bool,
 };
@@ -5202,6 +5301,16 @@ static const NMMetaPropertyType _pt_ethtool = {
 	 * that the actual type is (guint32(*)(type *)). */ \
 	((guint32 (*) (NMSetting *)) ((sizeof (func == ((guint32 (*) (type *)) func))) ? func : func) )
 
+#define STRING_GET_FCN(type, func) \
+	/* macro that returns @func as const (const char *(*)(NMSetting*)) type, but checks
+	 * that the actual type is (const char *(*)(type *)). */ \
+	((const char *(*) (NMSetting *)) ((sizeof (func == ((const char *(*) (type *)) func))) ? func : func) )
+
+#define BOOL_GET_FCN(type, func) \
+	/* macro that returns @func as const (gboolean(*)(NMSetting*)) type, but checks
+	 * that the actual type is (gboolean(*)(type *)). */ \
+	((gboolean (*) (NMSetting *)) ((sizeof (func == ((gboolean (*) (type *)) func))) ? func : func) )
+
 #define TEAM_DESCRIBE_MESSAGE \
 	N_("nmcli can accepts both direct JSON configuration data and a file name containing " \
 	   "the configuration. In the latter case the file is read and the contents is put " \
@@ -5702,12 +5811,21 @@ static const NMMetaPropertyInfo *const property_infos_CONNECTION[] = {
 		.property_alias =               "con-name",
 		.inf_flags =                    NM_META_PROPERTY_INF_FLAG_DONT_ASK,
 		.property_type =                &_pt_gobject_string,
+		.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+			.get_fcn =                  STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_id),
+		),
 	),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_UUID,
-		.property_type =                DEFINE_PROPERTY_TYPE ( .get_fcn = _get_fcn_gobject ),
+		.property_type =                DEFINE_PROPERTY_TYPE ( .get_fcn = _get_fcn_gobject_string ),
+		.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+			.get_fcn =                  STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_uuid),
+		),
 	),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_STABLE_ID,
 		.property_type =                &_pt_gobject_string,
+		.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+			.get_fcn =                  STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_stable_id),
+		),
 	),
 [_NM_META_PROPERTY_TYPE_CONNECTION_TYPE] =
 		PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_TYPE,
@@ -5716,10 +5834,13 @@ static const NMMetaPropertyInfo *const property_infos_CONNECTION[] = {
 			.inf_flags =                    NM_META_PROPERTY_INF_FLAG_REQD,
 			.prompt =                       NM_META_TEXT_PROMPT_CON_TYPE,
 			.property_type = DEFINE_PROPERTY_TYPE (
-				.get_fcn =                  _get_fcn_gobject,
+				.get_fcn =                  _get_fcn_gobject_string,
 				.set_fcn =                  _set_fcn_connection_type,
 				.complete_fcn =             _complete_fcn_connection_type,
 			),
+			.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+				.get_fcn =                  STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_connection_type),
+			),
 		),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_INTERFACE_NAME,
 		.is_cli_option =                TRUE,
@@ -5727,16 +5848,22 @@ static const NMMetaPropertyInfo *const property_infos_CONNECTION[] = {
 		.inf_flags =                    NM_META_PROPERTY_INF_FLAG_REQD,
 		.prompt =                       NM_META_TEXT_PROMPT_IFNAME,
 		.property_type = DEFINE_PROPERTY_TYPE (
-			.get_fcn =                  _get_fcn_gobject,
+			.get_fcn =                  _get_fcn_gobject_string,
 			.set_fcn =                  _set_fcn_gobject_ifname,
 			.complete_fcn =             _complete_fcn_gobject_devices,
 		),
+		.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+			.get_fcn =                  STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_interface_name),
+		),
 	),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_AUTOCONNECT,
 		.is_cli_option =                TRUE,
 		.property_alias =               "autoconnect",
 		.inf_flags =                    NM_META_PROPERTY_INF_FLAG_DONT_ASK,
 		.property_type =                &_pt_gobject_bool,
+		.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_bool,
+			.get_fcn =                  BOOL_GET_FCN (NMSettingConnection, nm_setting_connection_get_autoconnect),
+		),
 	),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_AUTOCONNECT_PRIORITY,
 		.property_type =                &_pt_gobject_int,
@@ -5787,6 +5914,9 @@ static const NMMetaPropertyInfo *const property_infos_CONNECTION[] = {
 	),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_ZONE,
 		.property_type =                &_pt_gobject_string,
+		.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+			.get_fcn =                  STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_zone),
+		),
 	),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_MASTER,
 		.is_cli_option =                TRUE,
@@ -5794,10 +5924,13 @@ static const NMMetaPropertyInfo *const property_infos_CONNECTION[] = {
 		.inf_flags =                    NM_META_PROPERTY_INF_FLAG_DONT_ASK,
 		.prompt =                       NM_META_TEXT_PROMPT_MASTER,
 		.property_type = DEFINE_PROPERTY_TYPE (
-			.get_fcn =                  _get_fcn_gobject,
+			.get_fcn =                  _get_fcn_gobject_string,
 			.set_fcn =                  _set_fcn_connection_master,
 			.complete_fcn =             _complete_fcn_connection_master,
 		),
+		.property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+			.get_fcn =                  STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_master),
+		),
 	),
 	PROPERTY_INFO_WITH_DESC (NM_SETTING_CONNECTION_SLAVE_TYPE,
 		.is_cli_option =                TRUE,
@@ -5805,6 +5938,9 @@ static const NMMetaPropertyInfo *const property_infos_CONNECTION[] = {
 		.inf_flags =                    NM_META_PROPERTY_INF_FLAG_DONT_ASK,
 		.property_type =                &_pt_gobject_string,
 		.property_typ_data = DEFINE_PROPERTY_TYP_DATA (
+			PROPERTY_TYP_DATA_SUBTYPE (gobject_string,
+				.get_fcn =              STRING_GET_FCN (NMSettingConnection, nm_setting_connection_get_slave_type),
+			),
 			.values_static =            VALUES_STATIC (NM_SETTING_BOND_SETTING_NAME,
 			                                           NM_SETTING_BRIDGE_SETTING_NAME,
 			                                           NM_SETTING_OVS_BRIDGE_SETTING_NAME,
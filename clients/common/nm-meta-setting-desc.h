@@ -267,7 +267,11 @@ struct _NMMetaPropertyTypData {
 		} gobject_int;
 		struct {
 			const char *(*validate_fcn) (const char *value, char **out_to_free, GError **error);
+			const char *(*get_fcn) (NMSetting *setting);
 		} gobject_string;
+		struct {
+			gboolean (*get_fcn) (NMSetting *setting);
+		} gobject_bool;
 		struct {
 			guint32 (*get_fcn) (NMSetting *setting);
 		} mtu;
@@ -145,6 +145,160 @@ test_client_meta_check (void)
 
 /*****************************************************************************/
 
+/* The uncached reference for the properties that are rendered straight
+ * from their GObject property: look up the param-spec and read the value
+ * through a GValue, the way the accessors did before they got cached
+ * param-specs and typed getters. */
+static char *
+_gobject_get_reference (NMSetting *setting,
+                        const char *property_name,
+                        NMMetaAccessorGetType get_type,
+                        gboolean *out_is_default)
+{
+	nm_auto_unset_gvalue GValue val = G_VALUE_INIT;
+	nm_auto_unset_gvalue GValue val_str = G_VALUE_INIT;
+	GParamSpec *pspec;
+
+	pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (setting), property_name);
+	g_assert (pspec);
+
+	g_value_init (&val, pspec->value_type);
+	g_object_get_property (G_OBJECT (setting), property_name, &val);
+
+	if (pspec->value_type == G_TYPE_STRV) {
+		const char *const*strv = g_value_get_boxed (&val);
+
+		*out_is_default = !strv || !strv[0];
+	} else if (pspec->value_type == G_TYPE_HASH_TABLE) {
+		GHashTable *ht = g_value_get_boxed (&val);
+
+		*out_is_default = !ht || !g_hash_table_size (ht);
+	} else
+		*out_is_default = g_param_value_defaults (pspec, &val);
+
+	if (pspec->value_type == G_TYPE_BOOLEAN) {
+		if (get_type == NM_META_ACCESSOR_GET_TYPE_PRETTY)
+			return g_strdup (g_value_get_boolean (&val) ? _("yes") : _("no"));
+		return g_strdup (g_value_get_boolean (&val) ? "yes" : "no");
+	}
+
+	g_value_init (&val_str, G_TYPE_STRING);
+	g_assert (g_value_transform (&val, &val_str));
+	return g_value_dup_string (&val_str);
+}
+
+static NMConnection *
+_create_get_all_connection (guint i)
+{
+	NMConnection *connection;
+	NMSettingConnection *s_con;
+	char id[64];
+	char buf[64];
+
+	connection = nmtst_create_minimal_connection (nm_sprintf_buf (id, "con-%u", i),
+	                                              NULL,
+	                                              NM_SETTING_WIRED_SETTING_NAME,
+	                                              &s_con);
+	g_object_set (s_con,
+	              NM_SETTING_CONNECTION_AUTOCONNECT, (gboolean) (i % 2 == 0),
+	              NM_SETTING_CONNECTION_INTERFACE_NAME, nm_sprintf_buf (buf, "eth%u", i),
+	              NULL);
+	if (i % 3 == 1) {
+		g_object_set (s_con,
+		              NM_SETTING_CONNECTION_ZONE, "public",
+		              NM_SETTING_CONNECTION_STABLE_ID, "stable-${CONNECTION}",
+		              NULL);
+	}
+	if (i % 3 == 2) {
+		g_object_set (s_con,
+		              NM_SETTING_CONNECTION_MASTER, "bond0",
+		              NM_SETTING_CONNECTION_SLAVE_TYPE, NM_SETTING_BOND_SETTING_NAME,
+		              NULL);
+	}
+	g_object_set (nm_connection_get_setting_wired (connection),
+	              NM_SETTING_WIRED_MTU, (guint) (i % 2 ? 1400 + i : 0),
+	              NM_SETTING_WIRED_CLONED_MAC_ADDRESS, i % 2 ? "stable" : NULL,
+	              NULL);
+	nmtst_connection_normalize (connection);
+	return connection;
+}
+
+static void
+test_client_meta_get_all (void)
+{
+	const NMMetaSettingInfoEditor *con_info = &nm_meta_setting_infos_editor[NM_META_SETTING_TYPE_CONNECTION];
+	const NMMetaPropertyType *pt_string;
+	const NMMetaPropertyType *pt_bool;
+	const NMMetaPropertyType *pt_readonly;
+	const guint n_connections = 6;
+	guint n_checked = 0;
+	guint i, j, p, t;
+
+	/* the getters that render the plain GObject property, either through
+	 * a typed getter or through a GValue. */
+	pt_string = nm_meta_setting_info_editor_get_property_info (con_info, NM_SETTING_CONNECTION_ID)->property_type;
+	pt_bool = nm_meta_setting_info_editor_get_property_info (con_info, NM_SETTING_CONNECTION_AUTOCONNECT)->property_type;
+	pt_readonly = nm_meta_setting_info_editor_get_property_info (con_info, NM_SETTING_CONNECTION_TIMESTAMP)->property_type;
+
+	/* Render every property of a few differing connections, the way "nmcli -f all
+	 * connection show" does, and compare the cached/typed accessors with the
+	 * uncached reference. */
+	for (i = 0; i < n_connections; i++) {
+		gs_unref_object NMConnection *connection = _create_get_all_connection (i);
+		gs_free NMSetting **settings = NULL;
+		guint n_settings;
+
+		settings = nm_connection_get_settings (connection, &n_settings);
+		for (j = 0; j < n_settings; j++) {
+			const NMMetaSettingInfoEditor *setting_info;
+
+			setting_info = nm_meta_setting_info_editor_find_by_setting (settings[j]);
+			g_assert (setting_info);
+
+			for (p = 0; p < setting_info->properties_num; p++) {
+				const NMMetaPropertyInfo *pi = setting_info->properties[p];
+
+				g_assert (nm_meta_setting_info_editor_get_property_info (setting_info, pi->property_name) == pi);
+
+				for (t = 0; t < 2; t++) {
+					const NMMetaAccessorGetType get_type = t ? NM_META_ACCESSOR_GET_TYPE_PRETTY : NM_META_ACCESSOR_GET_TYPE_PARSABLE;
+					NMMetaAccessorGetOutFlags out_flags = NM_META_ACCESSOR_GET_OUT_FLAGS_NONE;
+					gs_free char *to_free = NULL;
+					gs_free char *expected = NULL;
+					const char *value;
+					gboolean is_default;
+					gboolean expected_is_default;
+
+					value = nm_meta_abstract_info_get ((const NMMetaAbstractInfo *) pi,
+					                                   NULL,
+					                                   NULL,
+					                                   settings[j],
+					                                   NULL,
+					                                   get_type,
+					                                   NM_META_ACCESSOR_GET_FLAGS_NONE,
+					                                   &out_flags,
+					                                   &is_default,
+					                                   (gpointer *) &to_free);
+					g_assert (!NM_FLAGS_HAS (out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV));
+
+					if (   pi->property_type->get_fcn != pt_string->get_fcn
+					    && pi->property_type->get_fcn != pt_bool->get_fcn
+					    && pi->property_type->get_fcn != pt_readonly->get_fcn)
+						continue;
+
+					expected = _gobject_get_reference (settings[j], pi->property_name, get_type, &expected_is_default);
+					g_assert_cmpstr (value, ==, expected);
+					g_assert_cmpint (is_default, ==, expected_is_default);
+					n_checked++;
+				}
+			}
+		}
+	}
+	g_assert_cmpint (n_checked, >, 0);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int
@@ -153,6 +307,7 @@ main (int argc, char **argv)
 	nmtst_init (&argc, &argv, TRUE);
 
 	g_test_add_func ("/client/meta/check", test_client_meta_check);
+	g_test_add_func ("/client/meta/get-all", test_client_meta_get_all);
 
 	return g_test_run ();
 }
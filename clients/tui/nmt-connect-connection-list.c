@@ -524,7 +524,7 @@ nmt_connect_connection_list_rebuild (NmtConnectConnectionList *list)
 			if (nmtconn->ap) {
 				guint8 strength = nm_access_point_get_strength (nmtconn->ap);
 
-				strength_col = nmc_wifi_strength_bars (strength);
+				strength_col = nmc_wifi_strength_bars (strength, g_getenv ("TERM"));
 			} else
 				strength_col = NULL;
 
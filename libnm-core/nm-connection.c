@@ -57,8 +57,32 @@ typedef struct {
 
 	/* D-Bus path of the connection, if any */
 	char *path;
+
+	/* results of previous successful verifications of the settings,
+	 * see _verify_setting(). */
+	GHashTable *verify_cache;
+
+	/* while a setting is verified, the other settings that it looks
+	 * at are recorded here. */
+	GArray *verify_deps;
+	bool verify_deps_all:1;
 } NMConnectionPrivate;
 
+typedef struct {
+	GType setting_type;
+	guint64 generation;
+} VerifyDep;
+
+typedef struct {
+	guint64 generation;
+
+	/* if non-zero, the verification inspected all settings of the
+	 * connection, and is only valid until any of them changes. */
+	guint64 all_generation;
+
+	GArray *deps;
+} VerifyCacheEntry;
+
 static NMConnectionPrivate *nm_connection_get_private (NMConnection *connection);
 #define NM_CONNECTION_GET_PRIVATE(o) (nm_connection_get_private ((NMConnection *)o))
 
@@ -91,6 +115,142 @@ _gtype_to_hash_key (GType gtype)
 
 /*****************************************************************************/
 
+static void
+_verify_cache_entry_free (gpointer data)
+{
+	VerifyCacheEntry *entry = data;
+
+	g_array_unref (entry->deps);
+	g_slice_free (VerifyCacheEntry, entry);
+}
+
+static void
+_verify_cache_clear (NMConnectionPrivate *priv)
+{
+	if (priv->verify_cache)
+		g_hash_table_remove_all (priv->verify_cache);
+}
+
+static void
+_verify_record_dep (NMConnectionPrivate *priv, GType setting_type, NMSetting *setting)
+{
+	VerifyDep dep = {
+		.setting_type = setting_type,
+		.generation   = _nm_setting_get_generation (setting),
+	};
+
+	g_array_append_val (priv->verify_deps, dep);
+}
+
+static void
+_verify_record_all (NMConnectionPrivate *priv)
+{
+	if (priv->verify_deps)
+		priv->verify_deps_all = TRUE;
+}
+
+static guint64
+_verify_all_generation (NMConnectionPrivate *priv)
+{
+	GHashTableIter iter;
+	NMSetting *setting;
+	guint64 generation = 0;
+
+	/* generations grow monotonically, so the largest one changes whenever
+	 * any setting changes. Adding and removing settings clears the cache. */
+	g_hash_table_iter_init (&iter, priv->settings);
+	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &setting))
+		generation = MAX (generation, _nm_setting_get_generation (setting));
+	return generation;
+}
+
+static gboolean
+_verify_cache_entry_valid (NMConnectionPrivate *priv,
+                           NMSetting *setting,
+                           const VerifyCacheEntry *entry)
+{
+	guint i;
+
+	if (entry->generation != _nm_setting_get_generation (setting))
+		return FALSE;
+
+	if (   entry->all_generation
+	    && entry->all_generation != _verify_all_generation (priv))
+		return FALSE;
+
+	for (i = 0; i < entry->deps->len; i++) {
+		const VerifyDep *dep = &g_array_index (entry->deps, VerifyDep, i);
+		NMSetting *s_dep;
+
+		s_dep = g_hash_table_lookup (priv->settings, _gtype_to_hash_key (dep->setting_type));
+		if (   !s_dep
+		    || _nm_setting_get_generation (s_dep) != dep->generation)
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+/* _verify_setting:
+ *
+ * Like _nm_setting_verify(), but skips the verification if @setting
+ * passed before and neither it, nor any other setting its verify()
+ * looked at, changed since.
+ *
+ * Only successful results are remembered. Normalizable settings and
+ * errors are verified every time to return the error.
+ *
+ * Changes are noticed via the generation of the settings, which is also
+ * bumped while their notifications are frozen with g_object_freeze_notify().
+ * Boxed values that are modified in place, without calling a setter, go
+ * unnoticed. */
+static NMSettingVerifyResult
+_verify_setting (NMConnection *connection, NMSetting *setting, GError **error)
+{
+	NMConnectionPrivate *priv = NM_CONNECTION_GET_PRIVATE (connection);
+	VerifyCacheEntry *entry;
+	NMSettingVerifyResult result;
+	guint64 generation;
+
+	if (G_UNLIKELY (priv->verify_deps)) {
+		/* recursive verification of the same connection. Don't bother. */
+		return _nm_setting_verify (setting, connection, error);
+	}
+
+	if (priv->verify_cache) {
+		entry = g_hash_table_lookup (priv->verify_cache, setting);
+		if (entry) {
+			if (_verify_cache_entry_valid (priv, setting, entry))
+				return NM_SETTING_VERIFY_SUCCESS;
+			g_hash_table_remove (priv->verify_cache, setting);
+		}
+	}
+
+	generation = _nm_setting_get_generation (setting);
+
+	priv->verify_deps = g_array_new (FALSE, FALSE, sizeof (VerifyDep));
+	priv->verify_deps_all = FALSE;
+
+	result = _nm_setting_verify (setting, connection, error);
+
+	entry = g_slice_new (VerifyCacheEntry);
+	entry->generation = generation;
+	entry->all_generation = priv->verify_deps_all ? _verify_all_generation (priv) : 0;
+	entry->deps = g_steal_pointer (&priv->verify_deps);
+
+	if (result != NM_SETTING_VERIFY_SUCCESS) {
+		_verify_cache_entry_free (entry);
+		return result;
+	}
+
+	if (!priv->verify_cache)
+		priv->verify_cache = g_hash_table_new_full (nm_direct_hash, NULL, NULL, _verify_cache_entry_free);
+	g_hash_table_insert (priv->verify_cache, setting, entry);
+	return result;
+}
+
+/*****************************************************************************/
+
 static void
 setting_changed_cb (NMSetting *setting,
                     GParamSpec *pspec,
@@ -121,6 +281,7 @@ _nm_connection_add_setting (NMConnection *connection, NMSetting *setting)
 
 	if ((s_old = g_hash_table_lookup (priv->settings, _gtype_to_hash_key (setting_type))))
 		g_signal_handlers_disconnect_by_func (s_old, setting_changed_cb, connection);
+	_verify_cache_clear (priv);
 	g_hash_table_insert (priv->settings, _gtype_to_hash_key (setting_type), setting);
 	/* Listen for property changes so we can emit the 'changed' signal */
 	g_signal_connect (setting, "notify", (GCallback) setting_changed_cb, connection);
@@ -159,6 +320,7 @@ _nm_connection_remove_setting (NMConnection *connection, GType setting_type)
 	setting = g_hash_table_lookup (priv->settings, _gtype_to_hash_key (setting_type));
 	if (setting) {
 		g_signal_handlers_disconnect_by_func (setting, setting_changed_cb, connection);
+		_verify_cache_clear (priv);
 		g_hash_table_remove (priv->settings, _gtype_to_hash_key (setting_type));
 		g_signal_emit (connection, signals[CHANGED], 0);
 		return TRUE;
@@ -183,14 +345,21 @@ nm_connection_remove_setting (NMConnection *connection, GType setting_type)
 static gpointer
 _connection_get_setting (NMConnection *connection, GType setting_type)
 {
+	NMConnectionPrivate *priv;
 	NMSetting *setting;
 
 	nm_assert (NM_IS_CONNECTION (connection));
 	nm_assert (g_type_is_a (setting_type, NM_TYPE_SETTING));
 
-	setting = g_hash_table_lookup (NM_CONNECTION_GET_PRIVATE (connection)->settings,
+	priv = NM_CONNECTION_GET_PRIVATE (connection);
+	setting = g_hash_table_lookup (priv->settings,
 	                               _gtype_to_hash_key (setting_type));
 	nm_assert (!setting || G_TYPE_CHECK_INSTANCE_TYPE (setting, setting_type));
+
+	if (   G_UNLIKELY (priv->verify_deps)
+	    && setting)
+		_verify_record_dep (priv, setting_type, setting);
+
 	return setting;
 }
 
@@ -407,6 +576,7 @@ _nm_connection_replace_settings (NMConnection *connection,
 
 	if (g_hash_table_size (priv->settings) > 0) {
 		g_hash_table_foreach_remove (priv->settings, _setting_release, connection);
+		_verify_cache_clear (priv);
 		changed = TRUE;
 	} else
 		changed = (settings != NULL);
@@ -490,8 +660,10 @@ nm_connection_replace_settings_from_connection (NMConnection *connection,
 	priv = NM_CONNECTION_GET_PRIVATE (connection);
 	new_priv = NM_CONNECTION_GET_PRIVATE (new_connection);
 
-	if ((changed = g_hash_table_size (priv->settings) > 0))
+	if ((changed = g_hash_table_size (priv->settings) > 0)) {
 		g_hash_table_foreach_remove (priv->settings, _setting_release, connection);
+		_verify_cache_clear (priv);
+	}
 
 	if (g_hash_table_size (new_priv->settings)) {
 		g_hash_table_iter_init (&iter, new_priv->settings);
@@ -521,6 +693,7 @@ nm_connection_clear_settings (NMConnection *connection)
 
 	if (g_hash_table_size (priv->settings) > 0) {
 		g_hash_table_foreach_remove (priv->settings, _setting_release, connection);
+		_verify_cache_clear (priv);
 		g_signal_emit (connection, signals[CHANGED], 0);
 	}
 }
@@ -667,6 +840,8 @@ _nm_connection_find_base_type_setting (NMConnection *connection)
 	NMSetting *setting = NULL, *s_iter;
 	NMSettingPriority setting_prio, s_iter_prio;
 
+	_verify_record_all (priv);
+
 	g_hash_table_iter_init (&iter, priv->settings);
 	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &s_iter)) {
 		s_iter_prio = _nm_setting_get_base_type_priority (s_iter);
@@ -771,6 +946,8 @@ _nm_connection_detect_slave_type (NMConnection *connection, NMSetting **out_s_po
 	const char *slave_type = NULL;
 	NMSetting *s_port = NULL, *s_iter;
 
+	_verify_record_all (priv);
+
 	g_hash_table_iter_init (&iter, priv->settings);
 	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &s_iter)) {
 		const char *name = nm_setting_get_name (s_iter);
@@ -1394,7 +1571,7 @@ _nm_connection_verify (NMConnection *connection, GError **error)
 		 * @NM_SETTING_VERIFY_NORMALIZABLE, so, if we encounter such an error type,
 		 * we remember it instead (to return it as output).
 		 **/
-		verify_result = _nm_setting_verify (NM_SETTING (setting_i->data), connection, &verify_error);
+		verify_result = _verify_setting (connection, NM_SETTING (setting_i->data), &verify_error);
 		if (verify_result == NM_SETTING_VERIFY_NORMALIZABLE ||
 		    verify_result == NM_SETTING_VERIFY_NORMALIZABLE_ERROR) {
 			if (   verify_result == NM_SETTING_VERIFY_NORMALIZABLE_ERROR
@@ -1900,6 +2077,8 @@ nm_connection_to_dbus (NMConnection *connection,
 
 	g_variant_builder_init (&builder, NM_VARIANT_TYPE_CONNECTION);
 
+	_verify_record_all (priv);
+
 	/* Add each setting's hash to the main hash */
 	g_hash_table_iter_init (&iter, priv->settings);
 	while (g_hash_table_iter_next (&iter, NULL, &data)) {
@@ -1991,6 +2170,8 @@ nm_connection_get_settings (NMConnection *connection,
 		return NULL;
 	}
 
+	_verify_record_all (priv);
+
 	arr = g_new (NMSetting *, size + 1);
 
 	g_hash_table_iter_init (&iter, priv->settings);
@@ -2905,6 +3086,7 @@ nm_connection_private_free (NMConnectionPrivate *priv)
 
 	g_hash_table_foreach_remove (priv->settings, _setting_release, self);
 	g_hash_table_destroy (priv->settings);
+	nm_clear_pointer (&priv->verify_cache, g_hash_table_destroy);
 	g_free (priv->path);
 
 	g_slice_free (NMConnectionPrivate, priv);
@@ -174,6 +174,10 @@ NMSettingPriority _nm_setting_get_setting_priority (NMSetting *setting);
 
 gboolean _nm_setting_get_property (NMSetting *setting, const char *name, GValue *value);
 
+guint64 _nm_setting_get_generation (NMSetting *setting);
+
+guint64 _nm_setting_get_digest (NMSetting *setting);
+
 /* NM_CONNECTION_SERIALIZE_NO_SYNTH: This flag is passed to _nm_setting_to_dbus()
  * by nm_setting_to_string() to let it know that it shouldn't serialize the
  * synthetic properties. It wouldn't be able to do so, since the full connection
@@ -583,6 +587,23 @@ typedef GVariant *(*NMSettingPropertyTransformToFunc)   (const GValue *from);
 typedef void      (*NMSettingPropertyTransformFromFunc) (GVariant *from,
                                                           GValue *to);
 
+typedef enum {
+	/* the property has custom D-Bus handling (or no GObject property) and
+	 * is converted via the generic GValue based code. */
+	NM_SETT_INFO_PROPERTY_KIND_NONE = 0,
+	NM_SETT_INFO_PROPERTY_KIND_BOOLEAN,
+	NM_SETT_INFO_PROPERTY_KIND_INT32,
+	NM_SETT_INFO_PROPERTY_KIND_UINT32,
+	NM_SETT_INFO_PROPERTY_KIND_INT64,
+	NM_SETT_INFO_PROPERTY_KIND_UINT64,
+	NM_SETT_INFO_PROPERTY_KIND_STRING,
+	NM_SETT_INFO_PROPERTY_KIND_STRV,
+	NM_SETT_INFO_PROPERTY_KIND_BYTES,
+	NM_SETT_INFO_PROPERTY_KIND_ENUM,
+	NM_SETT_INFO_PROPERTY_KIND_FLAGS,
+	_NM_SETT_INFO_PROPERTY_KIND_NUM,
+} NMSettInfoPropertyKind;
+
 typedef struct {
 	const char *name;
 	GParamSpec *param_spec;
@@ -595,6 +616,10 @@ typedef struct {
 
 	NMSettingPropertyTransformToFunc   to_dbus;
 	NMSettingPropertyTransformFromFunc from_dbus;
+
+	/* set by _nm_setting_class_commit_full() for plain GObject properties. It
+	 * selects a direct conversion between the GValue and the GVariant. */
+	NMSettInfoPropertyKind kind;
 } NMSettInfoProperty;
 
 typedef struct {
@@ -98,7 +98,7 @@ static EAPMethodsTable eap_methods_table[];
 
 /*****************************************************************************/
 
-NM_GOBJECT_PROPERTIES_DEFINE (NMSetting8021x,
+NM_GOBJECT_PROPERTIES_DEFINE_BASE (
 	PROP_EAP,
 	PROP_IDENTITY,
 	PROP_ANONYMOUS_IDENTITY,
@@ -145,6 +145,12 @@ NM_GOBJECT_PROPERTIES_DEFINE (NMSetting8021x,
 	PROP_AUTH_TIMEOUT,
 );
 
+static void
+_notify (NMSetting8021x *self, _PropertyEnums prop)
+{
+	_nm_setting_notify_by_pspec (self, obj_properties[prop]);
+}
+
 typedef struct {
 	GSList *eap; /* GSList of strings */
 	char *identity;
@@ -602,9 +608,14 @@ _cert_impl_set (NMSetting8021x *setting,
 	} else
 		notify_password = PROP_0;
 
-	nm_gobject_notify_together (setting, notify_cert,
-	                                     notify_password,
-	                                     notify_client_cert);
+	g_object_freeze_notify (G_OBJECT (setting));
+	if (notify_cert != PROP_0)
+		_notify (setting, notify_cert);
+	if (notify_password != PROP_0)
+		_notify (setting, notify_password);
+	if (notify_client_cert != PROP_0)
+		_notify (setting, notify_client_cert);
+	g_object_thaw_notify (G_OBJECT (setting));
 
 	NM_SET_OUT (out_format, _crypto_format_to_ck (format));
 	return TRUE;
@@ -365,7 +365,7 @@ nm_setting_bond_add_option (NMSettingBond *setting,
 		g_hash_table_remove (priv->options, NM_SETTING_BOND_OPTION_UPDELAY);
 	}
 
-	g_object_notify (G_OBJECT (setting), NM_SETTING_BOND_OPTIONS);
+	_nm_setting_notify (setting, NM_SETTING_BOND_OPTIONS);
 
 	return TRUE;
 }
@@ -398,7 +398,7 @@ nm_setting_bond_remove_option (NMSettingBond *setting,
 	nm_clear_g_free (&priv->options_idx_cache);
 	found = g_hash_table_remove (priv->options, name);
 	if (found)
-		g_object_notify (G_OBJECT (setting), NM_SETTING_BOND_OPTIONS);
+		_nm_setting_notify (setting, NM_SETTING_BOND_OPTIONS);
 	return found;
 }
 
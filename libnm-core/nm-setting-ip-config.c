@@ -1515,7 +1515,7 @@ nm_setting_ip_config_add_dns (NMSettingIPConfig *setting, const char *dns)
 	}
 
 	g_ptr_array_add (priv->dns, dns_canonical);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS);
 	return TRUE;
 }
 
@@ -1537,7 +1537,7 @@ nm_setting_ip_config_remove_dns (NMSettingIPConfig *setting, int idx)
 	g_return_if_fail (idx >= 0 && idx < priv->dns->len);
 
 	g_ptr_array_remove_index (priv->dns, idx);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS);
 }
 
 /**
@@ -1566,7 +1566,7 @@ nm_setting_ip_config_remove_dns_by_value (NMSettingIPConfig *setting, const char
 	for (i = 0; i < priv->dns->len; i++) {
 		if (!strcmp (dns_canonical, priv->dns->pdata[i])) {
 			g_ptr_array_remove_index (priv->dns, i);
-			g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS);
+			_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS);
 			g_free (dns_canonical);
 			return TRUE;
 		}
@@ -1592,7 +1592,7 @@ nm_setting_ip_config_clear_dns (NMSettingIPConfig *setting)
 
 	if (priv->dns->len != 0) {
 		g_ptr_array_set_size (priv->dns, 0);
-		g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS);
+		_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS);
 	}
 }
 
@@ -1658,7 +1658,7 @@ nm_setting_ip_config_add_dns_search (NMSettingIPConfig *setting,
 	}
 
 	g_ptr_array_add (priv->dns_search, g_strdup (dns_search));
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_SEARCH);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_SEARCH);
 	return TRUE;
 }
 
@@ -1680,7 +1680,7 @@ nm_setting_ip_config_remove_dns_search (NMSettingIPConfig *setting, int idx)
 	g_return_if_fail (idx >= 0 && idx < priv->dns_search->len);
 
 	g_ptr_array_remove_index (priv->dns_search, idx);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_SEARCH);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_SEARCH);
 }
 
 /**
@@ -1707,7 +1707,7 @@ nm_setting_ip_config_remove_dns_search_by_value (NMSettingIPConfig *setting,
 	for (i = 0; i < priv->dns_search->len; i++) {
 		if (!strcmp (dns_search, priv->dns_search->pdata[i])) {
 			g_ptr_array_remove_index (priv->dns_search, i);
-			g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_SEARCH);
+			_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_SEARCH);
 			return TRUE;
 		}
 	}
@@ -1731,7 +1731,7 @@ nm_setting_ip_config_clear_dns_searches (NMSettingIPConfig *setting)
 
 	if (priv->dns_search->len != 0) {
 		g_ptr_array_set_size (priv->dns_search, 0);
-		g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_SEARCH);
+		_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_SEARCH);
 	}
 }
 
@@ -1863,7 +1863,7 @@ nm_setting_ip_config_add_dns_option (NMSettingIPConfig *setting,
 	}
 
 	g_ptr_array_add (priv->dns_options, g_strdup (dns_option));
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_OPTIONS);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_OPTIONS);
 	return TRUE;
 }
 
@@ -1888,7 +1888,7 @@ nm_setting_ip_config_remove_dns_option (NMSettingIPConfig *setting, int idx)
 	g_return_if_fail (idx >= 0 && idx < priv->dns_options->len);
 
 	g_ptr_array_remove_index (priv->dns_options, idx);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_OPTIONS);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_OPTIONS);
 }
 
 /**
@@ -1920,7 +1920,7 @@ nm_setting_ip_config_remove_dns_option_by_value (NMSettingIPConfig *setting,
 	i = _nm_utils_dns_option_find_idx (priv->dns_options, dns_option);
 	if (i >= 0) {
 		g_ptr_array_remove_index (priv->dns_options, i);
-		g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_OPTIONS);
+		_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_OPTIONS);
 		return TRUE;
 	}
 
@@ -1959,7 +1959,7 @@ nm_setting_ip_config_clear_dns_options (NMSettingIPConfig *setting, gboolean is_
 			g_ptr_array_set_size (priv->dns_options, 0);
 		}
 	}
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_DNS_OPTIONS);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_DNS_OPTIONS);
 }
 
 /**
@@ -2042,7 +2042,7 @@ nm_setting_ip_config_add_address (NMSettingIPConfig *setting,
 
 	g_ptr_array_add (priv->addresses, nm_ip_address_dup (address));
 
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ADDRESSES);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ADDRESSES);
 	return TRUE;
 }
 
@@ -2065,7 +2065,7 @@ nm_setting_ip_config_remove_address (NMSettingIPConfig *setting, int idx)
 
 	g_ptr_array_remove_index (priv->addresses, idx);
 
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ADDRESSES);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ADDRESSES);
 }
 
 /**
@@ -2091,7 +2091,7 @@ nm_setting_ip_config_remove_address_by_value (NMSettingIPConfig *setting,
 	for (i = 0; i < priv->addresses->len; i++) {
 		if (nm_ip_address_equal (priv->addresses->pdata[i], address)) {
 			g_ptr_array_remove_index (priv->addresses, i);
-			g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ADDRESSES);
+			_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ADDRESSES);
 			return TRUE;
 		}
 	}
@@ -2113,7 +2113,7 @@ nm_setting_ip_config_clear_addresses (NMSettingIPConfig *setting)
 
 	if (priv->addresses->len != 0) {
 		g_ptr_array_set_size (priv->addresses, 0);
-		g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ADDRESSES);
+		_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ADDRESSES);
 	}
 }
 
@@ -2200,7 +2200,7 @@ nm_setting_ip_config_add_route (NMSettingIPConfig *setting,
 	}
 
 	g_ptr_array_add (priv->routes, nm_ip_route_dup (route));
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ROUTES);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ROUTES);
 	return TRUE;
 }
 
@@ -2222,7 +2222,7 @@ nm_setting_ip_config_remove_route (NMSettingIPConfig *setting, int idx)
 	g_return_if_fail (idx >= 0 && idx < priv->routes->len);
 
 	g_ptr_array_remove_index (priv->routes, idx);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ROUTES);
+	_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ROUTES);
 }
 
 /**
@@ -2250,7 +2250,7 @@ nm_setting_ip_config_remove_route_by_value (NMSettingIPConfig *setting,
 	for (i = 0; i < priv->routes->len; i++) {
 		if (nm_ip_route_equal_full (priv->routes->pdata[i], route, NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS)) {
 			g_ptr_array_remove_index (priv->routes, i);
-			g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ROUTES);
+			_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ROUTES);
 			return TRUE;
 		}
 	}
@@ -2272,7 +2272,7 @@ nm_setting_ip_config_clear_routes (NMSettingIPConfig *setting)
 
 	if (priv->routes->len != 0) {
 		g_ptr_array_set_size (priv->routes, 0);
-		g_object_notify (G_OBJECT (setting), NM_SETTING_IP_CONFIG_ROUTES);
+		_nm_setting_notify (setting, NM_SETTING_IP_CONFIG_ROUTES);
 	}
 }
 
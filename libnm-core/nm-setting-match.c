@@ -42,10 +42,16 @@ struct _NMSettingMatchClass {
 
 G_DEFINE_TYPE (NMSettingMatch, nm_setting_match, NM_TYPE_SETTING)
 
-NM_GOBJECT_PROPERTIES_DEFINE (NMSettingMatch,
+NM_GOBJECT_PROPERTIES_DEFINE_BASE (
 	PROP_INTERFACE_NAME,
 );
 
+static void
+_notify (NMSettingMatch *self, _PropertyEnums prop)
+{
+	_nm_setting_notify_by_pspec (self, obj_properties[prop]);
+}
+
 /*****************************************************************************/
 
 /**
@@ -129,6 +129,10 @@ _nm_setting_class_commit (NMSettingClass *setting_class,
 	_nm_setting_class_commit_full (setting_class, meta_type, NULL, NULL);
 }
 
+void _nm_setting_notify (gpointer setting, const char *property_name);
+
+void _nm_setting_notify_by_pspec (gpointer setting, GParamSpec *pspec);
+
 #define NM_SETT_INFO_SETT_GENDATA(...) \
 	({ \
 		static const NMSettInfoSettGendata _g = { \
@@ -251,7 +251,7 @@ nm_setting_team_port_add_link_watcher (NMSettingTeamPort *setting,
 	}
 
 	g_ptr_array_add (priv->link_watchers, nm_team_link_watcher_dup (link_watcher));
-	g_object_notify (G_OBJECT (setting), NM_SETTING_TEAM_PORT_LINK_WATCHERS);
+	_nm_setting_notify (setting, NM_SETTING_TEAM_PORT_LINK_WATCHERS);
 	return TRUE;
 }
 
@@ -273,7 +273,7 @@ nm_setting_team_port_remove_link_watcher (NMSettingTeamPort *setting, guint idx)
 	g_return_if_fail (idx < priv->link_watchers->len);
 
 	g_ptr_array_remove_index (priv->link_watchers, idx);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_TEAM_PORT_LINK_WATCHERS);
+	_nm_setting_notify (setting, NM_SETTING_TEAM_PORT_LINK_WATCHERS);
 }
 
 /**
@@ -299,7 +299,7 @@ nm_setting_team_port_remove_link_watcher_by_value (NMSettingTeamPort *setting,
 	for (i = 0; i < priv->link_watchers->len; i++) {
 		if (nm_team_link_watcher_equal (priv->link_watchers->pdata[i], link_watcher)) {
 			g_ptr_array_remove_index (priv->link_watchers, i);
-			g_object_notify (G_OBJECT (setting), NM_SETTING_TEAM_PORT_LINK_WATCHERS);
+			_nm_setting_notify (setting, NM_SETTING_TEAM_PORT_LINK_WATCHERS);
 			return TRUE;
 		}
 	}
@@ -323,7 +323,7 @@ nm_setting_team_port_clear_link_watchers (NMSettingTeamPort *setting)
 
 	if (priv->link_watchers->len != 0) {
 		g_ptr_array_set_size (priv->link_watchers, 0);
-		g_object_notify (G_OBJECT (setting), NM_SETTING_TEAM_PORT_LINK_WATCHERS);
+		_nm_setting_notify (setting, NM_SETTING_TEAM_PORT_LINK_WATCHERS);
 	}
 }
 
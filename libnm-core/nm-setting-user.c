@@ -39,10 +39,16 @@
 
 /*****************************************************************************/
 
-NM_GOBJECT_PROPERTIES_DEFINE (NMSettingUser,
+NM_GOBJECT_PROPERTIES_DEFINE_BASE (
 	PROP_DATA,
 );
 
+static void
+_notify (NMSettingUser *self, _PropertyEnums prop)
+{
+	_nm_setting_notify_by_pspec (self, obj_properties[prop]);
+}
+
 typedef struct {
 	GHashTable *data;
 	GHashTable *data_invalid;
@@ -194,7 +194,7 @@ nm_setting_vpn_add_data_item (NMSettingVpn *setting,
 
 	g_hash_table_insert (NM_SETTING_VPN_GET_PRIVATE (setting)->data,
 	                     g_strdup (key), g_strdup (item));
-	g_object_notify (G_OBJECT (setting), NM_SETTING_VPN_DATA);
+	_nm_setting_notify (setting, NM_SETTING_VPN_DATA);
 }
 
 /**
@@ -259,7 +259,7 @@ nm_setting_vpn_remove_data_item (NMSettingVpn *setting, const char *key)
 
 	found = g_hash_table_remove (NM_SETTING_VPN_GET_PRIVATE (setting)->data, key);
 	if (found)
-		g_object_notify (G_OBJECT (setting), NM_SETTING_VPN_DATA);
+		_nm_setting_notify (setting, NM_SETTING_VPN_DATA);
 	return found;
 }
 
@@ -371,7 +371,7 @@ nm_setting_vpn_add_secret (NMSettingVpn *setting,
 
 	g_hash_table_insert (NM_SETTING_VPN_GET_PRIVATE (setting)->secrets,
 	                     g_strdup (key), g_strdup (secret));
-	g_object_notify (G_OBJECT (setting), NM_SETTING_VPN_SECRETS);
+	_nm_setting_notify (setting, NM_SETTING_VPN_SECRETS);
 }
 
 /**
@@ -436,7 +436,7 @@ nm_setting_vpn_remove_secret (NMSettingVpn *setting, const char *key)
 
 	found = g_hash_table_remove (NM_SETTING_VPN_GET_PRIVATE (setting)->secrets, key);
 	if (found)
-		g_object_notify (G_OBJECT (setting), NM_SETTING_VPN_SECRETS);
+		_nm_setting_notify (setting, NM_SETTING_VPN_SECRETS);
 	return found;
 }
 
@@ -634,7 +634,7 @@ update_one_secret (NMSetting *setting, const char *key, GVariant *value, GError
 	}
 
 	if (success == NM_SETTING_UPDATE_SECRET_SUCCESS_MODIFIED)
-		g_object_notify (G_OBJECT (setting), NM_SETTING_VPN_SECRETS);
+		_nm_setting_notify (setting, NM_SETTING_VPN_SECRETS);
 
 	return success;
 }
@@ -683,7 +683,7 @@ set_secret_flags (NMSetting *setting,
 	g_hash_table_insert (NM_SETTING_VPN_GET_PRIVATE (setting)->data,
 	                     g_strdup_printf ("%s-flags", secret_name),
 	                     g_strdup_printf ("%u", flags));
-	g_object_notify (G_OBJECT (setting), NM_SETTING_VPN_SECRETS);
+	_nm_setting_notify (setting, NM_SETTING_VPN_SECRETS);
 	return TRUE;
 }
 
@@ -794,7 +794,7 @@ clear_secrets_with_flags (NMSetting *setting,
 	}
 
 	if (changed)
-		g_object_notify (G_OBJECT (setting), NM_SETTING_VPN_SECRETS);
+		_nm_setting_notify (setting, NM_SETTING_VPN_SECRETS);
 
 	return changed;
 }
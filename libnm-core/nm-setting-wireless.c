@@ -523,7 +523,7 @@ nm_setting_wireless_add_mac_blacklist_item (NMSettingWireless *setting, const ch
 
 	mac = nm_utils_hwaddr_canonical (mac, ETH_ALEN);
 	g_array_append_val (priv->mac_address_blacklist, mac);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
+	_nm_setting_notify (setting, NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
 	return TRUE;
 }
 
@@ -545,7 +545,7 @@ nm_setting_wireless_remove_mac_blacklist_item (NMSettingWireless *setting, guint
 	g_return_if_fail (idx < priv->mac_address_blacklist->len);
 
 	g_array_remove_index (priv->mac_address_blacklist, idx);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
+	_nm_setting_notify (setting, NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
 }
 
 /**
@@ -573,7 +573,7 @@ nm_setting_wireless_remove_mac_blacklist_item_by_value (NMSettingWireless *setti
 		candidate = g_array_index (priv->mac_address_blacklist, char *, i);
 		if (!nm_utils_hwaddr_matches (mac, -1, candidate, -1)) {
 			g_array_remove_index (priv->mac_address_blacklist, i);
-			g_object_notify (G_OBJECT (setting), NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
+			_nm_setting_notify (setting, NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
 			return TRUE;
 		}
 	}
@@ -592,7 +592,7 @@ nm_setting_wireless_clear_mac_blacklist_items (NMSettingWireless *setting)
 	g_return_if_fail (NM_IS_SETTING_WIRELESS (setting));
 
 	g_array_set_size (NM_SETTING_WIRELESS_GET_PRIVATE (setting)->mac_address_blacklist, 0);
-	g_object_notify (G_OBJECT (setting), NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
+	_nm_setting_notify (setting, NM_SETTING_WIRELESS_MAC_ADDRESS_BLACKLIST);
 }
 
 /**
@@ -695,7 +695,7 @@ nm_setting_wireless_add_seen_bssid (NMSettingWireless *setting,
 
 	if (!found) {
 		priv->seen_bssids = g_slist_prepend (priv->seen_bssids, lower_bssid);
-		g_object_notify (G_OBJECT (setting), NM_SETTING_WIRELESS_SEEN_BSSIDS);
+		_nm_setting_notify (setting, NM_SETTING_WIRELESS_SEEN_BSSIDS);
 	} else
 		g_free (lower_bssid);
 
@@ -953,6 +953,9 @@ nm_setting_wireless_get_security (NMSetting    *setting,
                                   NMConnection *connection,
                                   const char   *property_name)
 {
+	if (!connection)
+		return NULL;
+
 	if (nm_connection_get_setting_wireless_security (connection))
 		return g_variant_new_string (NM_SETTING_WIRELESS_SECURITY_SETTING_NAME);
 	else
@@ -76,6 +76,13 @@ enum {
 
 typedef struct {
 	GenData *gendata;
+
+	/* bumped on every change of the setting, see _nm_setting_get_generation(). */
+	guint64 generation;
+
+	/* cached content digest, see _nm_setting_get_digest(). */
+	guint64 digest;
+	bool digest_valid:1;
 } NMSettingPrivate;
 
 G_DEFINE_ABSTRACT_TYPE (NMSetting, nm_setting, G_TYPE_OBJECT)
@@ -88,6 +95,117 @@ static GenData *_gendata_hash (NMSetting *setting, gboolean create_if_necessary)
 
 /*****************************************************************************/
 
+static guint64 _generation_counter;
+
+static guint64
+_generation_next (void)
+{
+	/* settings may be created and modified on different threads,
+	 * as long as each one is used by only one thread at a time. */
+	return __atomic_add_fetch (&_generation_counter, 1, __ATOMIC_RELAXED);
+}
+
+static void
+_setting_changed (NMSetting *setting)
+{
+	NMSettingPrivate *priv = NM_SETTING_GET_PRIVATE (setting);
+
+	priv->generation = _generation_next ();
+	priv->digest_valid = FALSE;
+}
+
+/**
+ * _nm_setting_notify:
+ * @setting: the #NMSetting
+ * @property_name: the name of the property that changed
+ *
+ * Like g_object_notify(), but the generation and the digest of
+ * @setting are updated right away. With g_object_freeze_notify()
+ * the "notify" signal is only emitted on thaw, but the content
+ * already changed. Setters that modify a setting outside of
+ * set_property() must notify with this function.
+ */
+void
+_nm_setting_notify (gpointer setting, const char *property_name)
+{
+	nm_assert (NM_IS_SETTING (setting));
+
+	_setting_changed (setting);
+	g_object_notify (setting, property_name);
+}
+
+void
+_nm_setting_notify_by_pspec (gpointer setting, GParamSpec *pspec)
+{
+	nm_assert (NM_IS_SETTING (setting));
+
+	_setting_changed (setting);
+	g_object_notify_by_pspec (setting, pspec);
+}
+
+/* GObject invokes the set_property() function of the class that installed
+ * the property. Each such class of a setting gets it wrapped, so that
+ * g_object_set() bumps the generation also while notifications are frozen.
+ * The original function is kept as qdata of the type. */
+static GQuark
+_set_property_quark (void)
+{
+	return g_quark_from_static_string ("nm-setting-set-property");
+}
+
+static void
+_set_property_changed (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+	GObjectSetPropertyFunc set_property;
+
+	set_property = g_type_get_qdata (pspec->owner_type, _set_property_quark ());
+	nm_assert (set_property);
+
+	set_property (object, prop_id, value, pspec);
+	_setting_changed (NM_SETTING (object));
+}
+
+static void
+_set_property_wrap (NMSettingClass *setting_class)
+{
+	GType gtype;
+
+	for (gtype = G_TYPE_FROM_CLASS (setting_class);
+	     gtype != NM_TYPE_SETTING;
+	     gtype = g_type_parent (gtype)) {
+		GObjectClass *object_class = g_type_class_peek (gtype);
+
+		nm_assert (object_class);
+
+		if (   !object_class->set_property
+		    || object_class->set_property == _set_property_changed)
+			continue;
+
+		g_type_set_qdata (gtype, _set_property_quark (), object_class->set_property);
+		object_class->set_property = _set_property_changed;
+	}
+}
+
+/**
+ * _nm_setting_get_generation:
+ * @setting: the #NMSetting
+ *
+ * Returns: a number that changes whenever the content of @setting
+ *   changes. The numbers are unique across all settings, and a newer
+ *   change always has a larger number than an older one. Like the
+ *   digest, the generation is bumped by set_property(), by setters and
+ *   by property notifications, also while notifications are frozen.
+ */
+guint64
+_nm_setting_get_generation (NMSetting *setting)
+{
+	g_return_val_if_fail (NM_IS_SETTING (setting), 0);
+
+	return NM_SETTING_GET_PRIVATE (setting)->generation;
+}
+
+/*****************************************************************************/
+
 static NMSettingPriority
 _get_base_type_priority (const NMMetaSettingInfo *setting_info,
                          GType gtype)
@@ -354,6 +472,57 @@ _properties_override_add_transform (GArray *properties_override,
 
 static NMSettInfoSetting _sett_info_settings[_NM_META_SETTING_TYPE_NUM];
 
+static NMSettInfoPropertyKind
+_property_kind_detect (const NMSettInfoProperty *property)
+{
+	GParamSpec *pspec = property->param_spec;
+	GType gtype;
+
+	if (   !pspec
+	    || property->dbus_type
+	    || property->get_func
+	    || property->synth_func
+	    || property->set_func
+	    || property->to_dbus
+	    || property->from_dbus)
+		return NM_SETT_INFO_PROPERTY_KIND_NONE;
+
+	if (   !(pspec->flags & G_PARAM_WRITABLE)
+	    || (pspec->flags & G_PARAM_CONSTRUCT_ONLY))
+		return NM_SETT_INFO_PROPERTY_KIND_NONE;
+
+	/* only the types that settings actually use. Others, like uchar or
+	 * double, are handled by the generic conversion. */
+	gtype = pspec->value_type;
+	switch (G_TYPE_FUNDAMENTAL (gtype)) {
+	case G_TYPE_BOOLEAN:
+		return NM_SETT_INFO_PROPERTY_KIND_BOOLEAN;
+	case G_TYPE_INT:
+		return NM_SETT_INFO_PROPERTY_KIND_INT32;
+	case G_TYPE_UINT:
+		return NM_SETT_INFO_PROPERTY_KIND_UINT32;
+	case G_TYPE_INT64:
+		return NM_SETT_INFO_PROPERTY_KIND_INT64;
+	case G_TYPE_UINT64:
+		return NM_SETT_INFO_PROPERTY_KIND_UINT64;
+	case G_TYPE_STRING:
+		return NM_SETT_INFO_PROPERTY_KIND_STRING;
+	case G_TYPE_ENUM:
+		return NM_SETT_INFO_PROPERTY_KIND_ENUM;
+	case G_TYPE_FLAGS:
+		return NM_SETT_INFO_PROPERTY_KIND_FLAGS;
+	case G_TYPE_BOXED:
+		if (gtype == G_TYPE_STRV)
+			return NM_SETT_INFO_PROPERTY_KIND_STRV;
+		if (gtype == G_TYPE_BYTES)
+			return NM_SETT_INFO_PROPERTY_KIND_BYTES;
+		break;
+	default:
+		break;
+	}
+	return NM_SETT_INFO_PROPERTY_KIND_NONE;
+}
+
 void
 _nm_setting_class_commit_full (NMSettingClass *setting_class,
                                NMMetaSettingType meta_type,
@@ -422,6 +591,14 @@ _nm_setting_class_commit_full (NMSettingClass *setting_class,
 	G_STATIC_ASSERT_EXPR (G_STRUCT_OFFSET (NMSettInfoProperty, name) == 0);
 	g_array_sort (properties_override, nm_strcmp_p);
 
+	for (i = 0; i < properties_override->len; i++) {
+		NMSettInfoProperty *p = &g_array_index (properties_override, NMSettInfoProperty, i);
+
+		p->kind = _property_kind_detect (p);
+	}
+
+	_set_property_wrap (setting_class);
+
 	setting_class->setting_info = &nm_meta_setting_infos[meta_type];
 	sett_info->setting_class = setting_class;
 	if (detail)
@@ -543,6 +720,105 @@ variant_type_for_gtype (GType type)
 		g_assert_not_reached ();
 }
 
+static GVariant *
+_property_kind_to_dbus (NMSettInfoPropertyKind kind, const GValue *value)
+{
+	const char *const*strv;
+
+	switch (kind) {
+	case NM_SETT_INFO_PROPERTY_KIND_BOOLEAN:
+		return g_variant_new_boolean (g_value_get_boolean (value));
+	case NM_SETT_INFO_PROPERTY_KIND_INT32:
+		return g_variant_new_int32 (g_value_get_int (value));
+	case NM_SETT_INFO_PROPERTY_KIND_UINT32:
+		return g_variant_new_uint32 (g_value_get_uint (value));
+	case NM_SETT_INFO_PROPERTY_KIND_INT64:
+		return g_variant_new_int64 (g_value_get_int64 (value));
+	case NM_SETT_INFO_PROPERTY_KIND_UINT64:
+		return g_variant_new_uint64 (g_value_get_uint64 (value));
+	case NM_SETT_INFO_PROPERTY_KIND_STRING:
+		/* like g_dbus_gvalue_to_gvariant(), which serializes %NULL as "". */
+		return g_variant_new_string (g_value_get_string (value) ?: "");
+	case NM_SETT_INFO_PROPERTY_KIND_STRV:
+		strv = g_value_get_boxed (value);
+		return g_variant_new_strv (strv, strv ? -1 : 0);
+	case NM_SETT_INFO_PROPERTY_KIND_BYTES:
+		return nm_utils_gbytes_to_variant_ay (g_value_get_boxed (value));
+	case NM_SETT_INFO_PROPERTY_KIND_ENUM:
+		return g_variant_new_int32 (g_value_get_enum (value));
+	case NM_SETT_INFO_PROPERTY_KIND_FLAGS:
+		return g_variant_new_uint32 (g_value_get_flags (value));
+	case NM_SETT_INFO_PROPERTY_KIND_NONE:
+	case _NM_SETT_INFO_PROPERTY_KIND_NUM:
+		break;
+	}
+	g_return_val_if_reached (NULL);
+}
+
+static gboolean
+_property_kind_from_dbus (NMSettInfoPropertyKind kind, GVariant *src_value, GValue *dst_value)
+{
+	/* Converts @src_value if it has exactly the D-Bus type of @kind. Otherwise,
+	 * returns %FALSE and the caller falls back to the generic conversion, which
+	 * also accepts values that need a GValue transformation. */
+	switch (kind) {
+	case NM_SETT_INFO_PROPERTY_KIND_BOOLEAN:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_BOOLEAN))
+			return FALSE;
+		g_value_set_boolean (dst_value, g_variant_get_boolean (src_value));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_INT32:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_INT32))
+			return FALSE;
+		g_value_set_int (dst_value, g_variant_get_int32 (src_value));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_UINT32:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_UINT32))
+			return FALSE;
+		g_value_set_uint (dst_value, g_variant_get_uint32 (src_value));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_INT64:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_INT64))
+			return FALSE;
+		g_value_set_int64 (dst_value, g_variant_get_int64 (src_value));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_UINT64:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_UINT64))
+			return FALSE;
+		g_value_set_uint64 (dst_value, g_variant_get_uint64 (src_value));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_STRING:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_STRING))
+			return FALSE;
+		g_value_set_string (dst_value, g_variant_get_string (src_value, NULL));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_STRV:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_STRING_ARRAY))
+			return FALSE;
+		g_value_take_boxed (dst_value, g_variant_dup_strv (src_value, NULL));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_BYTES:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_BYTESTRING))
+			return FALSE;
+		_nm_utils_bytes_from_dbus (src_value, dst_value);
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_ENUM:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_INT32))
+			return FALSE;
+		g_value_set_enum (dst_value, g_variant_get_int32 (src_value));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_FLAGS:
+		if (!g_variant_is_of_type (src_value, G_VARIANT_TYPE_UINT32))
+			return FALSE;
+		g_value_set_flags (dst_value, g_variant_get_uint32 (src_value));
+		return TRUE;
+	case NM_SETT_INFO_PROPERTY_KIND_NONE:
+	case _NM_SETT_INFO_PROPERTY_KIND_NUM:
+		break;
+	}
+	return FALSE;
+}
+
 static GVariant *
 get_property_for_dbus (NMSetting *setting,
                        const NMSettInfoProperty *property,
@@ -564,7 +840,9 @@ get_property_for_dbus (NMSetting *setting,
 		return NULL;
 	}
 
-	if (property->to_dbus)
+	if (property->kind != NM_SETT_INFO_PROPERTY_KIND_NONE)
+		dbus_value = _property_kind_to_dbus (property->kind, &prop_value);
+	else if (property->to_dbus)
 		dbus_value = property->to_dbus (&prop_value);
 	else if (property->dbus_type)
 		dbus_value = g_dbus_gvalue_to_gvariant (&prop_value, property->dbus_type);
@@ -588,6 +866,10 @@ set_property_from_dbus (const NMSettInfoProperty *property,
 {
 	g_return_val_if_fail (property->param_spec != NULL, FALSE);
 
+	if (   property->kind != NM_SETT_INFO_PROPERTY_KIND_NONE
+	    && _property_kind_from_dbus (property->kind, src_value, dst_value))
+		return TRUE;
+
 	if (property->from_dbus) {
 		if (!g_variant_type_equal (g_variant_get_type (src_value), property->dbus_type))
 			return FALSE;
@@ -617,6 +899,41 @@ set_property_from_dbus (const NMSettInfoProperty *property,
 	return TRUE;
 }
 
+static void
+_variant_unref0 (gpointer variant)
+{
+	if (variant)
+		g_variant_unref (variant);
+}
+
+static gboolean
+_property_set_value (NMSetting *setting,
+                     const NMSettInfoProperty *property,
+                     GValue *value,
+                     GError **error)
+{
+	GParamSpec *pspec = property->param_spec;
+
+	if (   property->kind == NM_SETT_INFO_PROPERTY_KIND_NONE
+	    || G_VALUE_TYPE (value) != pspec->value_type)
+		return nm_g_object_set_property (G_OBJECT (setting), pspec->name, value, error);
+
+	/* The value already has the type of the property, which is writable
+	 * and not construct-only. Skip the copy and the checks of
+	 * nm_g_object_set_property() and only validate the value. */
+	if (   g_param_value_validate (pspec, value)
+	    && !(pspec->flags & G_PARAM_LAX_VALIDATION)) {
+		g_set_error (error, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+		             _("value is invalid or out of range for property '%s' of type '%s'"),
+		             pspec->name,
+		             g_type_name (pspec->value_type));
+		return FALSE;
+	}
+
+	g_object_set_property (G_OBJECT (setting), pspec->name, value);
+	return TRUE;
+}
+
 /**
  * _nm_setting_to_dbus:
  * @setting: the #NMSetting
@@ -735,6 +1052,7 @@ _nm_setting_new_from_dbus (GType setting_type,
 {
 	gs_unref_object NMSetting *setting = NULL;
 	gs_unref_hashtable GHashTable *keys = NULL;
+	gs_unref_ptrarray GPtrArray *values = NULL;
 	const NMSettInfoSetting *sett_info;
 	guint i;
 
@@ -801,6 +1119,35 @@ _nm_setting_new_from_dbus (GType setting_type,
 		return g_steal_pointer (&setting);
 	}
 
+	/* Look up the values for all properties in one pass over @setting_dict,
+	 * instead of searching the dictionary for each property. Like
+	 * g_variant_lookup_value(), the first of duplicate keys wins. */
+	values = g_ptr_array_new_full (sett_info->property_infos_len, _variant_unref0);
+	g_ptr_array_set_size (values, sett_info->property_infos_len);
+	{
+		GVariantIter iter;
+		const char *key;
+		GVariant *val;
+
+		g_variant_iter_init (&iter, setting_dict);
+		while (g_variant_iter_next (&iter, "{&sv}", &key, &val)) {
+			const NMSettInfoProperty *property;
+			guint idx;
+
+			property = _nm_sett_info_property_get (NM_SETTING_GET_CLASS (setting), key);
+			if (!property) {
+				g_variant_unref (val);
+				continue;
+			}
+			idx = property - sett_info->property_infos;
+			if (values->pdata[idx]) {
+				g_variant_unref (val);
+				continue;
+			}
+			values->pdata[idx] = val;
+		}
+	}
+
 	for (i = 0; i < sett_info->property_infos_len; i++) {
 		const NMSettInfoProperty *property = &sett_info->property_infos[i];
 		gs_unref_variant GVariant *value = NULL;
@@ -809,7 +1156,7 @@ _nm_setting_new_from_dbus (GType setting_type,
 		if (property->param_spec && !(property->param_spec->flags & G_PARAM_WRITABLE))
 			continue;
 
-		value = g_variant_lookup_value (setting_dict, property->name, NULL);
+		value = g_steal_pointer (&values->pdata[i]);
 
 		if (value && keys)
 			g_hash_table_remove (keys, property->name);
@@ -878,7 +1225,7 @@ _nm_setting_new_from_dbus (GType setting_type,
 				return NULL;
 			}
 
-			if (!nm_g_object_set_property (G_OBJECT (setting), property->param_spec->name, &object_value, &local)) {
+			if (!_property_set_value (setting, property, &object_value, &local)) {
 				if (!NM_FLAGS_HAS (parse_flags, NM_SETTING_PARSE_FLAGS_STRICT))
 					continue;
 				g_set_error (error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY,
@@ -1190,6 +1537,61 @@ compare_property (NMSetting *setting,
 	return cmp == 0;
 }
 
+/**
+ * _nm_setting_get_digest:
+ * @setting: the #NMSetting
+ *
+ * Returns a siphash over the D-Bus representation of @setting, including
+ * secrets.
+ *
+ * The digest is computed lazily and cached until the setting changes,
+ * see _nm_setting_get_generation(). A matching digest does not prove
+ * equality, the content might have changed unnoticed, e.g. by modifying
+ * boxed values returned by a getter in place. nm_setting_compare() only
+ * trusts a mismatch, and only for settings that can't be modified in place.
+ *
+ * Returns: the content digest of @setting.
+ */
+guint64
+_nm_setting_get_digest (NMSetting *setting)
+{
+	NMSettingPrivate *priv;
+	gs_unref_variant GVariant *variant = NULL;
+	NMHashState h;
+
+	g_return_val_if_fail (NM_IS_SETTING (setting), 0);
+
+	priv = NM_SETTING_GET_PRIVATE (setting);
+
+	if (priv->digest_valid)
+		return priv->digest;
+
+	nm_hash_init (&h, 1542201047u);
+	nm_hash_update_str (&h, G_OBJECT_TYPE_NAME (setting));
+
+	variant = g_variant_ref_sink (_nm_setting_to_dbus (setting, NULL, NM_CONNECTION_SERIALIZE_ALL));
+	nm_hash_update_mem (&h, g_variant_get_data (variant), g_variant_get_size (variant));
+
+	priv->digest = c_siphash_finalize (&h._state);
+	priv->digest_valid = TRUE;
+	return priv->digest;
+}
+
+static gboolean
+_digest_differs (NMSetting *a, NMSetting *b, NMSettingCompareFlags flags)
+{
+	/* The default compare_property() compares the D-Bus values of the
+	 * properties. So for an exact comparison, different D-Bus values (and
+	 * thus different digests) mean different settings. Subclasses that
+	 * override compare_property() may consider different D-Bus values
+	 * equal (e.g. ignoring the order), and other flags ignore properties. */
+	if (   flags != NM_SETTING_COMPARE_FLAG_EXACT
+	    || NM_SETTING_GET_CLASS (a)->compare_property != compare_property)
+		return FALSE;
+
+	return _nm_setting_get_digest (a) != _nm_setting_get_digest (b);
+}
+
 /**
  * nm_setting_compare:
  * @a: a #NMSetting
@@ -1232,6 +1634,11 @@ nm_setting_compare (NMSetting *a,
 		                                  g_variant_equal);
 	}
 
+	/* A digest mismatch is a fast answer for different settings. Matching
+	 * digests might be stale, so they don't save comparing the properties. */
+	if (_digest_differs (a, b, flags))
+		return FALSE;
+
 	/* And now all properties */
 	property_specs = g_object_class_list_properties (G_OBJECT_GET_CLASS (a), &n_property_specs);
 	for (i = 0; i < n_property_specs && same; i++) {
@@ -2094,6 +2501,8 @@ _nm_setting_gendata_notify (NMSetting *setting,
 {
 	GenData *gendata;
 
+	_setting_changed (setting);
+
 	gendata = _gendata_hash (setting, FALSE);
 	if (!gendata)
 		return;
@@ -2309,6 +2718,7 @@ _nm_setting_gendata_reset_from_hash (NMSetting *setting,
 static void
 nm_setting_init (NMSetting *setting)
 {
+	NM_SETTING_GET_PRIVATE (setting)->generation = _generation_next ();
 }
 
 static void
@@ -2327,6 +2737,18 @@ get_property (GObject *object, guint prop_id,
 	}
 }
 
+static void
+dispatch_properties_changed (GObject *object,
+                             guint n_pspecs,
+                             GParamSpec **pspecs)
+{
+	/* set_property() and the setters already bumped the generation. This
+	 * covers subclasses that notify without _nm_setting_notify(). */
+	_setting_changed (NM_SETTING (object));
+
+	G_OBJECT_CLASS (nm_setting_parent_class)->dispatch_properties_changed (object, n_pspecs, pspecs);
+}
+
 static void
 finalize (GObject *object)
 {
@@ -2364,8 +2786,9 @@ nm_setting_class_init (NMSettingClass *setting_class)
 
 	g_type_class_add_private (setting_class, sizeof (NMSettingPrivate));
 
-	object_class->get_property = get_property;
-	object_class->finalize     = finalize;
+	object_class->get_property                = get_property;
+	object_class->dispatch_properties_changed = dispatch_properties_changed;
+	object_class->finalize                    = finalize;
 
 	setting_class->update_one_secret = update_one_secret;
 	setting_class->get_secret_flags = get_secret_flags;
@@ -2076,6 +2076,152 @@ new_connection_dict (char **out_uuid,
 	return g_variant_builder_end (&conn_builder);
 }
 
+static NMConnection *
+_create_roundtrip_connection (void)
+{
+	NMConnection *connection;
+	NMSetting *setting;
+	const char *const dns_search[] = { "example.com", "example.org", NULL };
+	gs_unref_bytes GBytes *ssid = NULL;
+
+	connection = new_test_connection ();
+
+	/* cover all kinds of plain properties that settings use: booleans,
+	 * integers, enums, flags, strings, string lists and bytes. */
+	setting = nm_setting_wireless_new ();
+	ssid = g_bytes_new_static ("some-ssid", NM_STRLEN ("some-ssid"));
+	g_object_set (setting,
+	              NM_SETTING_WIRELESS_SSID, ssid,
+	              NM_SETTING_WIRELESS_MODE, NM_SETTING_WIRELESS_MODE_INFRA,
+	              NM_SETTING_WIRELESS_CHANNEL, 11,
+	              NM_SETTING_WIRELESS_HIDDEN, TRUE,
+	              NM_SETTING_WIRELESS_POWERSAVE, (guint) NM_SETTING_WIRELESS_POWERSAVE_DISABLE,
+	              NM_SETTING_WIRELESS_WAKE_ON_WLAN, (guint) NM_SETTING_WIRELESS_WAKE_ON_WLAN_MAGIC,
+	              NULL);
+	nm_connection_add_setting (connection, setting);
+
+	setting = NM_SETTING (nm_connection_get_setting_ip4_config (connection));
+	g_object_set (setting,
+	              NM_SETTING_IP_CONFIG_DNS_SEARCH, dns_search,
+	              NM_SETTING_IP_CONFIG_ROUTE_METRIC, (gint64) 4242,
+	              NM_SETTING_IP_CONFIG_MAY_FAIL, FALSE,
+	              NM_SETTING_IP_CONFIG_DHCP_TIMEOUT, 77,
+	              NULL);
+
+	setting = NM_SETTING (nm_connection_get_setting_connection (connection));
+	g_object_set (setting,
+	              NM_SETTING_CONNECTION_AUTOCONNECT_PRIORITY, -5,
+	              NM_SETTING_CONNECTION_LLDP, (int) NM_SETTING_CONNECTION_LLDP_ENABLE_RX,
+	              NM_SETTING_CONNECTION_METERED, NM_METERED_YES,
+	              NULL);
+
+	setting = nm_setting_wireless_security_new ();
+	g_object_set (setting,
+	              NM_SETTING_WIRELESS_SECURITY_KEY_MGMT, "wpa-psk",
+	              NM_SETTING_WIRELESS_SECURITY_PSK, "s3cr3t-passphrase",
+	              NM_SETTING_WIRELESS_SECURITY_PSK_FLAGS, NM_SETTING_SECRET_FLAG_AGENT_OWNED,
+	              NULL);
+	nm_connection_add_setting (connection, setting);
+
+	return connection;
+}
+
+static void
+test_connection_to_dbus_roundtrip (void)
+{
+	gs_unref_object NMConnection *connection = NULL;
+	gs_unref_variant GVariant *dict = NULL;
+	gs_unref_object NMConnection *connection2 = NULL;
+	gboolean kind_used[_NM_SETT_INFO_PROPERTY_KIND_NUM] = { FALSE, };
+	gboolean kind_covered[_NM_SETT_INFO_PROPERTY_KIND_NUM] = { FALSE, };
+	GError *error = NULL;
+	NMMetaSettingType m;
+	guint i, j;
+
+	connection = _create_roundtrip_connection ();
+
+	dict = nm_connection_to_dbus (connection, NM_CONNECTION_SERIALIZE_ALL);
+	connection2 = _nm_simple_connection_new_from_dbus (dict, NM_SETTING_PARSE_FLAGS_STRICT, &error);
+	g_assert_no_error (error);
+	g_assert (connection2);
+	nmtst_assert_connection_equals (connection, FALSE, connection2, FALSE);
+
+	/* check that the connection has a non-default value for every kind
+	 * of property that a setting uses. */
+	for (m = 0; m < _NM_META_SETTING_TYPE_NUM; m++) {
+		nm_auto_unref_gtypeclass NMSettingClass *klass = g_type_class_ref (nm_meta_setting_infos[m].get_setting_gtype ());
+		const NMSettInfoSetting *sett_info = _nm_sett_info_setting_get (klass);
+
+		for (j = 0; j < sett_info->property_infos_len; j++)
+			kind_used[sett_info->property_infos[j].kind] = TRUE;
+	}
+	for (m = 0; m < _NM_META_SETTING_TYPE_NUM; m++) {
+		const char *setting_name = nm_meta_setting_infos[m].setting_name;
+		gs_unref_variant GVariant *setting_dict = NULL;
+		NMSetting *s;
+		const NMSettInfoSetting *sett_info;
+
+		s = nm_connection_get_setting_by_name (connection, setting_name);
+		if (!s)
+			continue;
+
+		setting_dict = g_variant_lookup_value (dict, setting_name, NM_VARIANT_TYPE_SETTING);
+		g_assert (setting_dict);
+
+		sett_info = _nm_sett_info_setting_get (NM_SETTING_GET_CLASS (s));
+		for (j = 0; j < sett_info->property_infos_len; j++) {
+			const NMSettInfoProperty *property = &sett_info->property_infos[j];
+			gs_unref_variant GVariant *value = NULL;
+
+			value = g_variant_lookup_value (setting_dict, property->name, NULL);
+			if (value)
+				kind_covered[property->kind] = TRUE;
+		}
+	}
+	for (i = NM_SETT_INFO_PROPERTY_KIND_NONE + 1; i < _NM_SETT_INFO_PROPERTY_KIND_NUM; i++) {
+		g_assert (kind_used[i]);
+		g_assert (kind_covered[i]);
+	}
+}
+
+static void
+test_connection_to_dbus_benchmark (void)
+{
+	gs_unref_object NMConnection *connection = NULL;
+	const guint n_iterations = nmtst_test_quick () ? 10 : 20000;
+	gint64 ts_to = 0;
+	gint64 ts_from = 0;
+	gint64 ts;
+	guint i;
+
+	/* With NMTST_DEBUG=no-quick, convert the connection many times and
+	 * report how long the conversions to and from D-Bus took. */
+	connection = _create_roundtrip_connection ();
+
+	for (i = 0; i < n_iterations; i++) {
+		gs_unref_variant GVariant *dict = NULL;
+		gs_unref_object NMConnection *connection2 = NULL;
+		GError *error = NULL;
+
+		ts = g_get_monotonic_time ();
+		dict = nm_connection_to_dbus (connection, NM_CONNECTION_SERIALIZE_ALL);
+		ts_to += g_get_monotonic_time () - ts;
+
+		ts = g_get_monotonic_time ();
+		connection2 = _nm_simple_connection_new_from_dbus (dict, NM_SETTING_PARSE_FLAGS_STRICT, &error);
+		ts_from += g_get_monotonic_time () - ts;
+		g_assert_no_error (error);
+		g_assert (connection2);
+	}
+
+	if (!nmtst_test_quick ()) {
+		g_test_message ("%u iterations: to D-Bus %.3f sec, from D-Bus %.3f sec",
+		                n_iterations,
+		                (double) ts_to / G_USEC_PER_SEC,
+		                (double) ts_from / G_USEC_PER_SEC);
+	}
+}
+
 static void
 test_connection_replace_settings (void)
 {
@@ -2834,6 +2980,225 @@ test_connection_diff_inferrable (void)
 	g_object_unref (b);
 }
 
+static void
+test_connection_compare_digest (void)
+{
+	gs_unref_object NMConnection *a = NULL;
+	gs_unref_object NMConnection *b = NULL;
+	gs_unref_object NMSetting *s_ethtool_a = NULL;
+	gs_unref_object NMSetting *s_ethtool_b = NULL;
+	gs_unref_object NMSetting *s_wsec_a = NULL;
+	gs_unref_object NMSetting *s_wsec_b = NULL;
+	NMSettingConnection *s_con;
+	NMSettingIPConfig *s_ip4;
+	NMSettingWired *s_wired;
+	NMIPAddress *addr;
+	GHashTable *out_diffs = NULL;
+
+	a = new_test_connection ();
+	b = nm_simple_connection_new_clone (a);
+
+	g_assert (_nm_setting_get_digest (NM_SETTING (nm_connection_get_setting_ip4_config (a)))
+	          == _nm_setting_get_digest (NM_SETTING (nm_connection_get_setting_ip4_config (b))));
+	g_assert (nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	/* changing an address attribute must invalidate the cached digest. */
+	s_ip4 = nm_connection_get_setting_ip4_config (b);
+	addr = nm_ip_address_new (AF_INET, "192.168.1.5", 24, NULL);
+	nm_ip_address_set_attribute (addr, NM_IP_ADDRESS_ATTRIBUTE_LABEL, g_variant_new_string ("eth0:1"));
+	nm_setting_ip_config_add_address (nm_connection_get_setting_ip4_config (a), addr);
+	g_assert (!nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+	nm_ip_address_set_attribute (addr, NM_IP_ADDRESS_ATTRIBUTE_LABEL, g_variant_new_string ("eth0:2"));
+	nm_setting_ip_config_add_address (s_ip4, addr);
+	g_assert (!nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+	nm_setting_ip_config_clear_addresses (s_ip4);
+	nm_ip_address_set_attribute (addr, NM_IP_ADDRESS_ATTRIBUTE_LABEL, g_variant_new_string ("eth0:1"));
+	nm_setting_ip_config_add_address (s_ip4, addr);
+	nm_ip_address_unref (addr);
+	g_assert (nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	/* %NULL and "" serialize the same way on D-Bus, but don't compare equal. */
+	s_wired = nm_connection_get_setting_wired (b);
+	g_object_set (s_wired, NM_SETTING_WIRED_CLONED_MAC_ADDRESS, "", NULL);
+	g_assert (!nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (!nm_connection_diff (a, b, NM_SETTING_COMPARE_FLAG_EXACT, &out_diffs));
+	g_assert (out_diffs);
+	g_assert (g_hash_table_lookup (out_diffs, NM_SETTING_WIRED_SETTING_NAME));
+	g_clear_pointer (&out_diffs, g_hash_table_destroy);
+	g_object_set (s_wired, NM_SETTING_WIRED_CLONED_MAC_ADDRESS, NULL, NULL);
+
+	/* gendata changes don't emit a notification. */
+	s_ethtool_a = nm_setting_ethtool_new ();
+	s_ethtool_b = nm_setting_ethtool_new ();
+	g_assert (nm_setting_compare (s_ethtool_a, s_ethtool_b, NM_SETTING_COMPARE_FLAG_EXACT));
+	nm_setting_ethtool_set_feature (NM_SETTING_ETHTOOL (s_ethtool_b), NM_ETHTOOL_OPTNAME_FEATURE_GRO, NM_TERNARY_TRUE);
+	g_assert (!nm_setting_compare (s_ethtool_a, s_ethtool_b, NM_SETTING_COMPARE_FLAG_EXACT));
+	nm_setting_ethtool_set_feature (NM_SETTING_ETHTOOL (s_ethtool_a), NM_ETHTOOL_OPTNAME_FEATURE_GRO, NM_TERNARY_TRUE);
+	g_assert (nm_setting_compare (s_ethtool_a, s_ethtool_b, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	/* the digests are cached now, compare and diff must still agree. */
+	g_assert (nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (nm_connection_diff (a, b, NM_SETTING_COMPARE_FLAG_EXACT, &out_diffs));
+	g_assert (!out_diffs);
+
+	/* a change while notifications are frozen leaves the cached digest
+	 * matching. The properties are compared nonetheless. */
+	s_con = nm_connection_get_setting_connection (b);
+	g_object_freeze_notify (G_OBJECT (s_con));
+	g_object_set (s_con, NM_SETTING_CONNECTION_ZONE, "frozen", NULL);
+	g_assert (!nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (!nm_connection_diff (a, b, NM_SETTING_COMPARE_FLAG_EXACT, &out_diffs));
+	g_assert (out_diffs);
+	g_assert (g_hash_table_lookup (out_diffs, NM_SETTING_CONNECTION_SETTING_NAME));
+	g_clear_pointer (&out_diffs, g_hash_table_destroy);
+	g_object_set (s_con, NM_SETTING_CONNECTION_ZONE, NULL, NULL);
+	g_object_thaw_notify (G_OBJECT (s_con));
+	g_assert (nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	/* the same for a boxed value that is modified in place. */
+	s_ip4 = nm_connection_get_setting_ip4_config (b);
+	addr = nm_setting_ip_config_get_address (s_ip4, 0);
+	nm_ip_address_set_attribute (addr, NM_IP_ADDRESS_ATTRIBUTE_LABEL, g_variant_new_string ("eth0:3"));
+	g_assert (!nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+	nm_ip_address_set_attribute (addr, NM_IP_ADDRESS_ATTRIBUTE_LABEL, g_variant_new_string ("eth0:1"));
+	g_assert (nm_connection_compare (a, b, NM_SETTING_COMPARE_FLAG_EXACT));
+
+	/* different digests of a setting without own compare_property()
+	 * are a fast answer, but not for flags that ignore properties. */
+	s_wsec_a = nm_setting_wireless_security_new ();
+	s_wsec_b = nm_setting_wireless_security_new ();
+	g_object_set (s_wsec_a,
+	              NM_SETTING_WIRELESS_SECURITY_KEY_MGMT, "wpa-psk",
+	              NM_SETTING_WIRELESS_SECURITY_PSK, "s3cr3t-passphrase",
+	              NULL);
+	g_object_set (s_wsec_b,
+	              NM_SETTING_WIRELESS_SECURITY_KEY_MGMT, "wpa-psk",
+	              NULL);
+	g_assert (_nm_setting_get_digest (s_wsec_a) != _nm_setting_get_digest (s_wsec_b));
+	g_assert (!nm_setting_compare (s_wsec_a, s_wsec_b, NM_SETTING_COMPARE_FLAG_EXACT));
+	g_assert (nm_setting_compare (s_wsec_a, s_wsec_b, NM_SETTING_COMPARE_FLAG_IGNORE_SECRETS));
+}
+
+static int (*_verify_counted_orig) (NMSetting *setting, NMConnection *connection, GError **error);
+static guint _verify_counted_num;
+
+static int
+_verify_counted (NMSetting *setting, NMConnection *connection, GError **error)
+{
+	_verify_counted_num++;
+	return _verify_counted_orig (setting, connection, error);
+}
+
+static void
+_verify_cached_add_route (NMSettingIPConfig *s_ip4, guint i)
+{
+	NMIPRoute *route;
+	char dest[NM_UTILS_INET_ADDRSTRLEN];
+	GError *error = NULL;
+
+	route = nm_ip_route_new (AF_INET,
+	                         nm_utils_inet4_ntop (htonl (0x0a000000u + (i << 8)), dest),
+	                         24, NULL, i, &error);
+	g_assert_no_error (error);
+	g_assert (nm_setting_ip_config_add_route (s_ip4, route));
+	nm_ip_route_unref (route);
+}
+
+static void
+_verify_cached_check (NMConnection *connection, gboolean valid, guint n_verified)
+{
+	GError *error = NULL;
+
+	if (valid) {
+		g_assert (nm_connection_verify (connection, &error));
+		g_assert_no_error (error);
+	} else {
+		g_assert (!nm_connection_verify (connection, &error));
+		g_assert_error (error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_MISSING_PROPERTY);
+		g_clear_error (&error);
+	}
+	g_assert_cmpint (_verify_counted_num, ==, n_verified);
+}
+
+static void
+test_connection_verify_cached (void)
+{
+	gs_unref_object NMConnection *connection = NULL;
+	NMSettingClass *klass;
+	NMSettingConnection *s_con;
+	NMSettingIPConfig *s_ip4;
+	GError *error = NULL;
+	guint i;
+
+	connection = new_test_connection ();
+	s_con = nm_connection_get_setting_connection (connection);
+	s_ip4 = nm_connection_get_setting_ip4_config (connection);
+
+	for (i = 0; i < 500; i++)
+		_verify_cached_add_route (s_ip4, i);
+
+	g_assert (nm_connection_normalize (connection, NULL, NULL, &error));
+	g_assert_no_error (error);
+
+	/* count how often the ip4 setting with its many routes is verified. */
+	klass = g_type_class_ref (NM_TYPE_SETTING_IP4_CONFIG);
+	_verify_counted_orig = klass->verify;
+	_verify_counted_num = 0;
+	klass->verify = _verify_counted;
+
+	_verify_cached_check (connection, TRUE, 1);
+	_verify_cached_check (connection, TRUE, 1);
+
+	/* editing an unrelated setting keeps the result. */
+	for (i = 0; i < 3; i++) {
+		char id[100];
+
+		nm_sprintf_buf (id, "connection-%u", i);
+		g_object_set (s_con, NM_SETTING_CONNECTION_ID, id, NULL);
+		_verify_cached_check (connection, TRUE, 1);
+	}
+
+	/* a cached result is dropped when the setting changes, and errors
+	 * are not cached. */
+	g_object_set (s_ip4,
+	              NM_SETTING_IP_CONFIG_METHOD, NM_SETTING_IP4_CONFIG_METHOD_MANUAL,
+	              NULL);
+	_verify_cached_check (connection, FALSE, 2);
+	_verify_cached_check (connection, FALSE, 3);
+
+	g_object_set (s_ip4,
+	              NM_SETTING_IP_CONFIG_METHOD, NM_SETTING_IP4_CONFIG_METHOD_AUTO,
+	              NULL);
+	_verify_cached_check (connection, TRUE, 4);
+	_verify_cached_check (connection, TRUE, 4);
+
+	_verify_cached_add_route (s_ip4, 500);
+	_verify_cached_check (connection, TRUE, 5);
+
+	/* changes are noticed while the notifications are still frozen. */
+	g_object_freeze_notify (G_OBJECT (s_ip4));
+
+	_verify_cached_add_route (s_ip4, 501);
+	_verify_cached_check (connection, TRUE, 6);
+
+	g_object_set (s_ip4,
+	              NM_SETTING_IP_CONFIG_METHOD, NM_SETTING_IP4_CONFIG_METHOD_MANUAL,
+	              NULL);
+	_verify_cached_check (connection, FALSE, 7);
+
+	g_object_set (s_ip4,
+	              NM_SETTING_IP_CONFIG_METHOD, NM_SETTING_IP4_CONFIG_METHOD_AUTO,
+	              NULL);
+	_verify_cached_check (connection, TRUE, 8);
+
+	/* thawing announces the same changes once more. */
+	g_object_thaw_notify (G_OBJECT (s_ip4));
+	_verify_cached_check (connection, TRUE, 9);
+
+	klass->verify = _verify_counted_orig;
+	g_type_class_unref (klass);
+}
+
 static void
 add_generic_settings (NMConnection *connection, const char *ctype)
 {
@@ -7459,6 +7824,8 @@ int main (int argc, char **argv)
 	g_test_add_func ("/core/general/test_setting_new_from_dbus_transform", test_setting_new_from_dbus_transform);
 	g_test_add_func ("/core/general/test_setting_new_from_dbus_enum", test_setting_new_from_dbus_enum);
 	g_test_add_func ("/core/general/test_setting_new_from_dbus_bad", test_setting_new_from_dbus_bad);
+	g_test_add_func ("/core/general/test_connection_to_dbus_roundtrip", test_connection_to_dbus_roundtrip);
+	g_test_add_func ("/core/general/test_connection_to_dbus_benchmark", test_connection_to_dbus_benchmark);
 	g_test_add_func ("/core/general/test_connection_replace_settings", test_connection_replace_settings);
 	g_test_add_func ("/core/general/test_connection_replace_settings_from_connection", test_connection_replace_settings_from_connection);
 	g_test_add_func ("/core/general/test_connection_replace_settings_bad", test_connection_replace_settings_bad);
@@ -7506,6 +7873,8 @@ int main (int argc, char **argv)
 	g_test_add_func ("/core/general/test_connection_diff_different", test_connection_diff_different);
 	g_test_add_func ("/core/general/test_connection_diff_no_secrets", test_connection_diff_no_secrets);
 	g_test_add_func ("/core/general/test_connection_diff_inferrable", test_connection_diff_inferrable);
+	g_test_add_func ("/core/general/test_connection_compare_digest", test_connection_compare_digest);
+	g_test_add_func ("/core/general/test_connection_verify_cached", test_connection_verify_cached);
 	g_test_add_func ("/core/general/test_connection_good_base_types", test_connection_good_base_types);
 	g_test_add_func ("/core/general/test_connection_bad_base_types", test_connection_bad_base_types);
 
@@ -35,9 +35,11 @@
 #include "nm-active-connection.h"
 #include "nm-vpn-connection.h"
 #include "nm-remote-connection.h"
+#include "nm-remote-connection-private.h"
 #include "nm-dbus-helpers.h"
 #include "nm-wimax-nsp.h"
 #include "nm-object-private.h"
+#include "nm-common-macros.h"
 
 #include "introspection/org.freedesktop.NetworkManager.h"
 #include "introspection/org.freedesktop.NetworkManager.Device.Wireless.h"
@@ -2500,16 +2502,12 @@ proxy_type (GDBusObjectManagerClient *manager,
 	return G_TYPE_DBUS_PROXY;
 }
 
-static NMObject *
-obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager *object_manager)
+static GType
+obj_nm_type_for_gdbus_object (GDBusObject *object, gboolean replace_match)
 {
-	NMClientPrivate *priv;
 	GList *interfaces;
 	GList *l;
 	GType type = G_TYPE_INVALID;
-	NMObject *obj_nm;
-
-	g_return_val_if_fail (G_IS_DBUS_OBJECT_PROXY (object), NULL);
 
 	interfaces = g_dbus_object_get_interfaces (object);
 	for (l = interfaces; l; l = l->next) {
@@ -2518,7 +2516,8 @@ obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager
 
 		/* This is a performance/scalability hack. It makes sense to call it
 		 * from here, since this is in the common object creation path. */
-		_nm_dbus_proxy_replace_match (proxy);
+		if (replace_match)
+			_nm_dbus_proxy_replace_match (proxy);
 
 		if (strcmp (ifname, NM_DBUS_INTERFACE) == 0)
 			type = NM_TYPE_MANAGER;
@@ -2604,13 +2603,86 @@ obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager
 	}
 
 	g_list_free_full (interfaces, g_object_unref);
-	if (type == G_TYPE_INVALID)
-		return NULL;
+	return type;
+}
+
+static gboolean
+obj_nm_type_is_lazy (GType type)
+{
+	/* These objects are only reachable via properties of other objects.
+	 * They are not created up front, but only once such a property is
+	 * resolved. See _nm_client_get_or_create_obj_nm(). */
+	return    type == NM_TYPE_ACCESS_POINT
+	       || type == NM_TYPE_IP4_CONFIG
+	       || type == NM_TYPE_IP6_CONFIG
+	       || type == NM_TYPE_DHCP4_CONFIG
+	       || type == NM_TYPE_DHCP6_CONFIG;
+}
+
+static NMObject *
+obj_nm_new (GType type, GDBusObject *object, GDBusObjectManager *object_manager)
+{
+	NMObject *obj_nm;
 
 	obj_nm = g_object_new (type,
 	                       NM_OBJECT_DBUS_OBJECT, object,
 	                       NM_OBJECT_DBUS_OBJECT_MANAGER, object_manager,
 	                       NULL);
+	g_object_set_qdata_full (G_OBJECT (object), _nm_object_obj_nm_quark (),
+	                         obj_nm, g_object_unref);
+	return obj_nm;
+}
+
+/**
+ * _nm_client_get_or_create_obj_nm:
+ * @object_manager: the object manager of the client
+ * @object: the #GDBusObject
+ *
+ * Returns the #NMObject for @object. Objects of lazy types are created
+ * and initialized on demand. Their initialization only reads the cached
+ * properties of the proxies and completes right away.
+ *
+ * Returns: (transfer none): the #NMObject or %NULL.
+ */
+NMObject *
+_nm_client_get_or_create_obj_nm (GDBusObjectManager *object_manager,
+                                 GDBusObject *object)
+{
+	NMObject *obj_nm;
+	GType type;
+
+	obj_nm = g_object_get_qdata (G_OBJECT (object), _nm_object_obj_nm_quark ());
+	if (obj_nm)
+		return obj_nm;
+
+	type = obj_nm_type_for_gdbus_object (object, FALSE);
+	if (!obj_nm_type_is_lazy (type))
+		return NULL;
+
+	obj_nm = obj_nm_new (type, object, object_manager);
+	if (!g_initable_init (G_INITABLE (obj_nm), NULL, NULL)) {
+		/* This is a can-not-happen situation, the NMObject subclasses are not
+		 * supposed to fail initialization. */
+		g_warn_if_reached ();
+	}
+	return obj_nm;
+}
+
+static NMObject *
+obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager *object_manager)
+{
+	NMClientPrivate *priv;
+	GType type;
+	NMObject *obj_nm;
+
+	g_return_val_if_fail (G_IS_DBUS_OBJECT_PROXY (object), NULL);
+
+	type = obj_nm_type_for_gdbus_object (object, TRUE);
+	if (   type == G_TYPE_INVALID
+	    || obj_nm_type_is_lazy (type))
+		return NULL;
+
+	obj_nm = obj_nm_new (type, object, object_manager);
 	if (NM_IS_DEVICE (obj_nm)) {
 		priv = NM_CLIENT_GET_PRIVATE (self);
 		if (G_UNLIKELY (!priv->udev_inited)) {
@@ -2622,8 +2694,6 @@ obj_nm_for_gdbus_object (NMClient *self, GDBusObject *object, GDBusObjectManager
 		if (priv->udev)
 			_nm_device_set_udev (NM_DEVICE (obj_nm), priv->udev);
 	}
-	g_object_set_qdata_full (G_OBJECT (object), _nm_object_obj_nm_quark (),
-	                         obj_nm, g_object_unref);
 	return obj_nm;
 }
 
@@ -2778,6 +2848,73 @@ _om_has_name_owner (GDBusObjectManager *object_manager)
 	return !!name_owner;
 }
 
+/*****************************************************************************/
+
+/* Fetch the settings of all connections with a single GetAllSettings() call,
+ * instead of having each NMRemoteConnection call GetSettings() during
+ * its initialization. */
+
+#define ALL_SETTINGS_REPLY_TYPE G_VARIANT_TYPE ("(a{oa{sa{sv}}})")
+
+static void
+all_settings_distribute (GDBusObjectManager *object_manager, GVariant *result)
+{
+	gs_unref_hashtable GHashTable *by_path = NULL;
+	gs_unref_variant GVariant *dict = NULL;
+	GList *objects, *iter;
+	GVariantIter viter;
+	const char *path;
+	GVariant *settings;
+
+	dict = g_variant_get_child_value (result, 0);
+
+	/* g_variant_lookup_value() scans the dictionary linearly. Index the
+	 * reply once, instead of scanning it again for every connection. */
+	by_path = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, (GDestroyNotify) g_variant_unref);
+	g_variant_iter_init (&viter, dict);
+	while (g_variant_iter_next (&viter, "{&o@a{sa{sv}}}", &path, &settings))
+		g_hash_table_insert (by_path, (gpointer) path, settings);
+
+	objects = g_dbus_object_manager_get_objects (object_manager);
+	for (iter = objects; iter; iter = iter->next) {
+		NMObject *obj_nm;
+
+		obj_nm = g_object_get_qdata (iter->data, _nm_object_obj_nm_quark ());
+		if (!NM_IS_REMOTE_CONNECTION (obj_nm))
+			continue;
+
+		/* connections missing from the reply are not visible to us. */
+		_nm_remote_connection_set_initial_settings (NM_REMOTE_CONNECTION (obj_nm),
+		                                            g_hash_table_lookup (by_path,
+		                                                                 g_dbus_object_get_object_path (iter->data)));
+	}
+	g_list_free_full (objects, g_object_unref);
+}
+
+static void
+all_settings_fetch_sync (GDBusObjectManager *object_manager, GCancellable *cancellable)
+{
+	gs_unref_variant GVariant *result = NULL;
+
+	result = g_dbus_connection_call_sync (g_dbus_object_manager_client_get_connection (G_DBUS_OBJECT_MANAGER_CLIENT (object_manager)),
+	                                      NM_DBUS_SERVICE,
+	                                      NM_DBUS_PATH_SETTINGS,
+	                                      NM_DBUS_INTERFACE_SETTINGS,
+	                                      "GetAllSettings",
+	                                      NULL,
+	                                      ALL_SETTINGS_REPLY_TYPE,
+	                                      G_DBUS_CALL_FLAGS_NONE,
+	                                      -1,
+	                                      cancellable,
+	                                      NULL);
+	/* on failure (e.g. an older daemon), the connections fetch
+	 * their settings individually. */
+	if (result)
+		all_settings_distribute (object_manager, result);
+}
+
+/*****************************************************************************/
+
 static gboolean
 init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
 {
@@ -2785,6 +2922,11 @@ init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
 	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (client);
 	GList *objects, *iter;
 
+	/* The object manager still creates a GDBusProxy for every interface
+	 * of every object, each with its own cache of the property values.
+	 * The NMObjects are populated from these proxies. Getting rid of them
+	 * requires parsing GetManagedObjects() and PropertiesChanged directly,
+	 * which NMClient does not do (yet). */
 	priv->object_manager = g_dbus_object_manager_client_new_for_bus_sync (_nm_dbus_bus_type (),
 	                                                                      G_DBUS_OBJECT_MANAGER_CLIENT_FLAGS_DO_NOT_AUTO_START,
 	                                                                      "org.freedesktop.NetworkManager",
@@ -2799,6 +2941,8 @@ init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
 		if (!objects_created (client, priv->object_manager, error))
 			return FALSE;
 
+		all_settings_fetch_sync (priv->object_manager, cancellable);
+
 		objects = g_dbus_object_manager_get_objects (priv->object_manager);
 		for (iter = objects; iter; iter = iter->next) {
 			NMObject *obj_nm;
@@ -2914,13 +3058,53 @@ new_object_manager (GObject *source_object, GAsyncResult *res, gpointer user_dat
 	g_object_notify (G_OBJECT (user_data), NM_CLIENT_NM_RUNNING);
 }
 
+static void
+init_async_objects (NMClientInitData *init_data)
+{
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (init_data->client);
+	GList *objects, *iter;
+
+	objects = g_dbus_object_manager_get_objects (priv->object_manager);
+	for (iter = objects; iter; iter = iter->next) {
+		NMObject *obj_nm;
+
+		obj_nm = g_object_get_qdata (iter->data, _nm_object_obj_nm_quark ());
+		if (!obj_nm)
+			continue;
+
+		init_data->pending_init++;
+		g_async_initable_init_async (G_ASYNC_INITABLE (obj_nm),
+		                             G_PRIORITY_DEFAULT, init_data->cancellable,
+		                             async_inited_obj_nm, init_data);
+	}
+	g_list_free_full (objects, g_object_unref);
+}
+
+static void
+got_all_settings (GObject *object, GAsyncResult *result, gpointer user_data)
+{
+	NMClientInitData *init_data = user_data;
+	NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE (init_data->client);
+	gs_unref_variant GVariant *ret = NULL;
+
+	nm_assert (init_data->pending_init > 0);
+
+	ret = g_dbus_connection_call_finish (G_DBUS_CONNECTION (object), result, NULL);
+	if (ret)
+		all_settings_distribute (priv->object_manager, ret);
+
+	init_async_objects (init_data);
+
+	init_data->pending_init--;
+	init_async_complete (init_data);
+}
+
 static void
 got_object_manager (GObject *object, GAsyncResult *result, gpointer user_data)
 {
 	NMClientInitData *init_data = user_data;
 	NMClient *client;
 	NMClientPrivate *priv;
-	GList *objects, *iter;
 	GError *error = NULL;
 	GDBusObjectManager *object_manager;
 
@@ -2942,20 +3126,21 @@ got_object_manager (GObject *object, GAsyncResult *result, gpointer user_data)
 			return;
 		}
 
-		objects = g_dbus_object_manager_get_objects (priv->object_manager);
-		for (iter = objects; iter; iter = iter->next) {
-			NMObject *obj_nm;
-
-			obj_nm = g_object_get_qdata (iter->data, _nm_object_obj_nm_quark ());
-			if (!obj_nm)
-				continue;
-
-			init_data->pending_init++;
-			g_async_initable_init_async (G_ASYNC_INITABLE (obj_nm),
-			                             G_PRIORITY_DEFAULT, init_data->cancellable,
-			                             async_inited_obj_nm, init_data);
-		}
-		g_list_free_full (objects, g_object_unref);
+		/* initialize the objects only after the settings of all
+		 * connections were fetched. */
+		init_data->pending_init++;
+		g_dbus_connection_call (g_dbus_object_manager_client_get_connection (G_DBUS_OBJECT_MANAGER_CLIENT (priv->object_manager)),
+		                        NM_DBUS_SERVICE,
+		                        NM_DBUS_PATH_SETTINGS,
+		                        NM_DBUS_INTERFACE_SETTINGS,
+		                        "GetAllSettings",
+		                        NULL,
+		                        ALL_SETTINGS_REPLY_TYPE,
+		                        G_DBUS_CALL_FLAGS_NONE,
+		                        -1,
+		                        init_data->cancellable,
+		                        got_all_settings,
+		                        init_data);
 	}
 
 	init_async_complete (init_data);
@@ -3596,6 +3781,17 @@ nm_client_class_init (NMClientClass *client_class)
 		                     G_PARAM_READABLE |
 		                     G_PARAM_STATIC_STRINGS));
 
+	nm_param_spec_set_element_type (g_object_class_find_property (object_class, NM_CLIENT_ACTIVE_CONNECTIONS),
+	                                NM_TYPE_ACTIVE_CONNECTION);
+	nm_param_spec_set_element_type (g_object_class_find_property (object_class, NM_CLIENT_DEVICES),
+	                                NM_TYPE_DEVICE);
+	nm_param_spec_set_element_type (g_object_class_find_property (object_class, NM_CLIENT_ALL_DEVICES),
+	                                NM_TYPE_DEVICE);
+	nm_param_spec_set_element_type (g_object_class_find_property (object_class, NM_CLIENT_CONNECTIONS),
+	                                NM_TYPE_REMOTE_CONNECTION);
+	nm_param_spec_set_element_type (g_object_class_find_property (object_class, NM_MANAGER_CHECKPOINTS),
+	                                NM_TYPE_CHECKPOINT);
+
 	/* signals */
 
 	/**
@@ -218,10 +218,10 @@ init_dbus (NMObject *object)
 		{ NM_DEVICE_AUTOCONNECT,       &priv->autoconnect },
 		{ NM_DEVICE_FIRMWARE_MISSING,  &priv->firmware_missing },
 		{ NM_DEVICE_NM_PLUGIN_MISSING, &priv->nm_plugin_missing },
-		{ NM_DEVICE_IP4_CONFIG,        &priv->ip4_config, NULL, NM_TYPE_IP4_CONFIG },
-		{ NM_DEVICE_DHCP4_CONFIG,      &priv->dhcp4_config, NULL, NM_TYPE_DHCP4_CONFIG },
-		{ NM_DEVICE_IP6_CONFIG,        &priv->ip6_config, NULL, NM_TYPE_IP6_CONFIG },
-		{ NM_DEVICE_DHCP6_CONFIG,      &priv->dhcp6_config, NULL, NM_TYPE_DHCP6_CONFIG },
+		{ NM_DEVICE_IP4_CONFIG,        &priv->ip4_config, NULL, NM_TYPE_IP4_CONFIG, NULL, TRUE },
+		{ NM_DEVICE_DHCP4_CONFIG,      &priv->dhcp4_config, NULL, NM_TYPE_DHCP4_CONFIG, NULL, TRUE },
+		{ NM_DEVICE_IP6_CONFIG,        &priv->ip6_config, NULL, NM_TYPE_IP6_CONFIG, NULL, TRUE },
+		{ NM_DEVICE_DHCP6_CONFIG,      &priv->dhcp6_config, NULL, NM_TYPE_DHCP6_CONFIG, NULL, TRUE },
 		{ NM_DEVICE_IP4_CONNECTIVITY,  &priv->ip4_connectivity },
 		{ NM_DEVICE_IP6_CONNECTIVITY,  &priv->ip6_connectivity },
 		{ NM_DEVICE_STATE,             &priv->state },
@@ -1212,6 +1212,7 @@ nm_device_get_ip4_config (NMDevice *device)
 {
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), NM_DEVICE_IP4_CONFIG);
 	return NM_DEVICE_GET_PRIVATE (device)->ip4_config;
 }
 
@@ -1232,6 +1233,7 @@ nm_device_get_dhcp4_config (NMDevice *device)
 {
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), NM_DEVICE_DHCP4_CONFIG);
 	return NM_DEVICE_GET_PRIVATE (device)->dhcp4_config;
 }
 
@@ -1251,6 +1253,7 @@ nm_device_get_ip6_config (NMDevice *device)
 {
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), NM_DEVICE_IP6_CONFIG);
 	return NM_DEVICE_GET_PRIVATE (device)->ip6_config;
 }
 
@@ -1271,6 +1274,7 @@ nm_device_get_dhcp6_config (NMDevice *device)
 {
 	g_return_val_if_fail (NM_IS_DEVICE (device), NULL);
 
+	_nm_object_ensure_lazy_property (NM_OBJECT (device), NM_DEVICE_DHCP6_CONFIG);
 	return NM_DEVICE_GET_PRIVATE (device)->dhcp6_config;
 }
 
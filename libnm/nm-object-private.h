@@ -37,12 +37,18 @@ typedef struct {
 	PropertyMarshalFunc func;
 	GType object_type;
 	const char *signal_prefix;
+
+	/* for object properties: don't resolve the referenced objects until
+	 * _nm_object_ensure_lazy_property() is called. */
+	gboolean lazy;
 } NMPropertiesInfo;
 
 void _nm_object_register_properties (NMObject *object,
                                      const char *interface,
                                      const NMPropertiesInfo *info);
 
+void _nm_object_ensure_lazy_property (NMObject *object, const char *property_name);
+
 void _nm_object_queue_notify (NMObject *object, const char *property);
 
 GDBusObjectManager *_nm_object_get_dbus_object_manager (NMObject *object);
@@ -63,4 +69,7 @@ GDBusProxy *_nm_object_get_proxy (NMObject   *object,
 struct udev;
 void _nm_device_set_udev (NMDevice *device, struct udev *udev);
 
+NMObject *_nm_client_get_or_create_obj_nm (GDBusObjectManager *object_manager,
+                                           GDBusObject *object);
+
 #endif /* __NM_OBJECT_PRIVATE_H__ */
@@ -32,6 +32,7 @@
 #include "nm-object-private.h"
 #include "nm-dbus-helpers.h"
 #include "nm-client.h"
+#include "nm-common-macros.h"
 #include "nm-core-internal.h"
 #include "c-list/src/c-list.h"
 
@@ -64,6 +65,29 @@ typedef struct {
 	const char *signal_prefix;
 } PropertyInfo;
 
+typedef struct {
+	/* the GObject property name. It is the static string from
+	 * NMPropertiesInfo, so it is not copied. */
+	const char *name;
+	/* resolved once at registration, may be %NULL for properties that
+	 * are not backed by a GObject property. */
+	GParamSpec *pspec;
+	PropertyInfo pi;
+
+	/* for lazy properties that were not yet accessed: the last
+	 * object path(s) received from D-Bus. */
+	GVariant *lazy_value;
+	bool lazy:1;
+	bool lazy_resolved:1;
+} PropertyEntry;
+
+/* The property table of one D-Bus interface. It is allocated as one chunk,
+ * with the entries sorted by name for bsearch(). */
+typedef struct {
+	guint len;
+	PropertyEntry entries[];
+} PropertyTable;
+
 static void reload_complete (NMObject *object, gboolean emit_now);
 static gboolean demarshal_generic (NMObject *object, GParamSpec *pspec, GVariant *value, gpointer field);
 
@@ -337,6 +361,9 @@ typedef struct {
 
 	gboolean array;
 	const char *property_name;
+
+	/* don't emit added/removed signals or notifications on completion. */
+	gboolean silent;
 } ObjectCreatedData;
 
 static void
@@ -352,13 +379,40 @@ odata_free (gpointer data)
 
 static void object_property_maybe_complete (NMObject *self);
 
-/* Stolen from dbus-glib */
-static char*
-wincaps_to_dash (const char *caps)
+/* Stolen from dbus-glib.
+ *
+ * Writes the result to @buf if it fits, otherwise returns
+ * a newly allocated string in @out_free. */
+static const char *
+wincaps_to_dash (const char *caps, char *buf, gsize buf_len, char **out_free)
 {
 	const char *p;
 	GString *str;
+	gsize len = 0;
+
+	nm_assert (buf_len > 0);
+	nm_assert (out_free && !*out_free);
+
+	for (p = caps; *p; p++) {
+		if (g_ascii_isupper (*p)) {
+			if (len > 0 && (len < 2 || buf[len - 2] != '-')) {
+				if (len + 1 >= buf_len)
+					goto slow;
+				buf[len++] = '-';
+			}
+			if (len + 1 >= buf_len)
+				goto slow;
+			buf[len++] = g_ascii_tolower (*p);
+		} else {
+			if (len + 1 >= buf_len)
+				goto slow;
+			buf[len++] = *p;
+		}
+	}
+	buf[len] = '\0';
+	return buf;
 
+slow:
 	str = g_string_new (NULL);
 	p = caps;
 	while (*p) {
@@ -371,7 +425,35 @@ wincaps_to_dash (const char *caps)
 		++p;
 	}
 
-	return g_string_free (str, FALSE);
+	*out_free = g_string_free (str, FALSE);
+	return *out_free;
+}
+
+static void
+_property_table_free (gpointer data)
+{
+	PropertyTable *table = data;
+	guint i;
+
+	for (i = 0; i < table->len; i++)
+		nm_clear_g_variant (&table->entries[i].lazy_value);
+	g_free (table);
+}
+
+static int
+_property_entry_cmp (gconstpointer a, gconstpointer b)
+{
+	return strcmp (((const PropertyEntry *) a)->name,
+	               ((const PropertyEntry *) b)->name);
+}
+
+static PropertyEntry *
+_property_table_lookup (PropertyTable *table, const char *name)
+{
+	const PropertyEntry needle = { .name = name };
+
+	return bsearch (&needle, table->entries, table->len,
+	                sizeof (PropertyEntry), _property_entry_cmp);
 }
 
 /* Adds object to array if it's not already there */
@@ -494,7 +576,8 @@ object_property_maybe_complete (NMObject *self)
 
 			*((GPtrArray **) pi->field) = new;
 
-			if (pi->signal_prefix) {
+			if (   pi->signal_prefix
+			    && !odata->silent) {
 				GPtrArray *added = g_ptr_array_sized_new (3);
 				GPtrArray *removed = g_ptr_array_sized_new (3);
 
@@ -552,7 +635,7 @@ object_property_maybe_complete (NMObject *self)
 			_nm_object_queue_notify (self, odata->property_name);
 
 		if (--priv->reload_remaining == 0)
-			reload_complete (self, TRUE);
+			reload_complete (self, !odata->silent);
 
 		odata_free (odata);
 	}
@@ -578,7 +661,7 @@ object_created (GObject *obj, const char *path, gpointer user_data)
 
 static gboolean
 handle_object_property (NMObject *self, const char *property_name, GVariant *value,
-                        PropertyInfo *pi)
+                        PropertyInfo *pi, gboolean silent)
 {
 	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
 	gs_unref_object GDBusObject *object = NULL;
@@ -593,6 +676,7 @@ handle_object_property (NMObject *self, const char *property_name, GVariant *val
 	odata->length = odata->remaining = 1;
 	odata->array = FALSE;
 	odata->property_name = property_name;
+	odata->silent = silent;
 
 	c_list_link_tail (&priv->pending, &odata->lst_pending);
 
@@ -625,7 +709,7 @@ handle_object_property (NMObject *self, const char *property_name, GVariant *val
 		return FALSE;
 	}
 
-	obj = g_object_get_qdata (G_OBJECT (object), _nm_object_obj_nm_quark ());
+	obj = (GObject *) _nm_client_get_or_create_obj_nm (priv->object_manager, object);
 	object_created (obj, path, odata);
 
 	return TRUE;
@@ -633,7 +717,7 @@ handle_object_property (NMObject *self, const char *property_name, GVariant *val
 
 static gboolean
 handle_object_array_property (NMObject *self, const char *property_name, GVariant *value,
-                              PropertyInfo *pi)
+                              PropertyInfo *pi, gboolean silent)
 {
 	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
 	GObject *obj;
@@ -651,6 +735,7 @@ handle_object_array_property (NMObject *self, const char *property_name, GVarian
 	odata->length = odata->remaining = npaths;
 	odata->array = TRUE;
 	odata->property_name = property_name;
+	odata->silent = silent;
 
 	c_list_link_tail (&priv->pending, &odata->lst_pending);
 
@@ -667,7 +752,7 @@ handle_object_array_property (NMObject *self, const char *property_name, GVarian
 
 		object = g_dbus_object_manager_get_object (priv->object_manager, path);
 		if (object) {
-			obj = g_object_get_qdata (G_OBJECT (object), _nm_object_obj_nm_quark ());
+			obj = (GObject *) _nm_client_get_or_create_obj_nm (priv->object_manager, object);
 			object_created (obj, path, odata);
 		} else {
 			g_warning ("no object known for %s\n", path);
@@ -680,44 +765,132 @@ handle_object_array_property (NMObject *self, const char *property_name, GVarian
 	return TRUE;
 }
 
-static void
-handle_property_changed (NMObject *self, const char *dbus_name, GVariant *value)
+static PropertyEntry *
+_property_lookup (NMObject *self, const char *prop_name)
 {
 	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (self);
-	char *prop_name;
-	PropertyInfo *pi;
-	GParamSpec *pspec;
-	gboolean success = FALSE, found = FALSE;
+	PropertyEntry *entry;
 	GSList *iter;
 
-	prop_name = wincaps_to_dash (dbus_name);
-
 	/* Iterate through the object and its parents to find the property */
 	for (iter = priv->property_tables; iter; iter = g_slist_next (iter)) {
-		pi = g_hash_table_lookup ((GHashTable *) iter->data, prop_name);
-		if (pi) {
-			if (!pi->field) {
-				/* We know about this property but aren't tracking changes on it. */
-				goto out;
-			}
-
-			found = TRUE;
-			break;
-		}
+		entry = _property_table_lookup (iter->data, prop_name);
+		if (entry)
+			return entry;
 	}
+	return NULL;
+}
+
+static gboolean
+_lazy_property_has_listeners (NMObject *self, const PropertyEntry *entry)
+{
+	char buf[50];
+	guint signal_id;
 
-	if (!found) {
+	/* if somebody is interested in the added/removed signals, the
+	 * objects must be resolved when the property changes. */
+	if (!entry->pi.signal_prefix)
+		return FALSE;
+
+	signal_id = g_signal_lookup (nm_sprintf_buf (buf, "%s-added", entry->pi.signal_prefix),
+	                             G_OBJECT_TYPE (self));
+	if (signal_id && g_signal_has_handler_pending (self, signal_id, 0, FALSE))
+		return TRUE;
+
+	signal_id = g_signal_lookup (nm_sprintf_buf (buf, "%s-removed", entry->pi.signal_prefix),
+	                             G_OBJECT_TYPE (self));
+	if (signal_id && g_signal_has_handler_pending (self, signal_id, 0, FALSE))
+		return TRUE;
+
+	return FALSE;
+}
+
+static gboolean
+handle_object_property_value (NMObject *self, const char *property_name, GVariant *value,
+                              PropertyInfo *pi, gboolean silent)
+{
+	if (g_variant_is_of_type (value, G_VARIANT_TYPE_OBJECT_PATH))
+		return handle_object_property (self, property_name, value, pi, silent);
+	if (g_variant_is_of_type (value, G_VARIANT_TYPE ("ao")))
+		return handle_object_array_property (self, property_name, value, pi, silent);
+	g_return_val_if_reached (FALSE);
+}
+
+static void
+_lazy_property_resolve (NMObject *self, PropertyEntry *entry)
+{
+	gs_unref_variant GVariant *value = NULL;
+
+	nm_assert (entry->lazy && !entry->lazy_resolved);
+
+	entry->lazy_resolved = TRUE;
+	value = g_steal_pointer (&entry->lazy_value);
+	if (!value)
+		return;
+
+	/* The property change was already notified when the value was received.
+	 * Fill in the objects silently: the referenced objects are not new, so
+	 * there are no added signals to emit, and this may be called from a
+	 * getter, where emitting signals would be reentrant. */
+	handle_object_property_value (self, NULL, value, &entry->pi, TRUE);
+}
+
+/**
+ * _nm_object_ensure_lazy_property:
+ * @object: the #NMObject
+ * @property_name: the name of a property registered as lazy
+ *
+ * Lazy object properties only remember the object paths they refer to.
+ * This resolves them to #NMObject instances, creating the referenced
+ * objects on demand. Afterwards, the property is kept up to date
+ * like any other.
+ */
+void
+_nm_object_ensure_lazy_property (NMObject *object, const char *property_name)
+{
+	PropertyEntry *entry;
+
+	entry = _property_lookup (object, property_name);
+	if (   !entry
+	    || !entry->lazy
+	    || entry->lazy_resolved)
+		return;
+
+	_lazy_property_resolve (object, entry);
+}
+
+static void
+handle_property_changed (NMObject *self, const char *dbus_name, GVariant *value)
+{
+	gs_free char *prop_name_free = NULL;
+	char prop_name_buf[64];
+	const char *prop_name;
+	PropertyEntry *entry;
+	PropertyInfo *pi;
+	GParamSpec *pspec;
+	gboolean success = FALSE;
+
+	prop_name = wincaps_to_dash (dbus_name, prop_name_buf, sizeof (prop_name_buf), &prop_name_free);
+
+	entry = _property_lookup (self, prop_name);
+	if (!entry) {
 		dbgmsg ("Property '%s' unhandled.", prop_name);
-		goto out;
+		return;
+	}
+
+	pi = &entry->pi;
+	if (!pi->field) {
+		/* We know about this property but aren't tracking changes on it. */
+		return;
 	}
 
-	pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (G_OBJECT (self)), prop_name);
+	pspec = entry->pspec;
 	if (!pspec && pi->func == demarshal_generic) {
 		dbgmsg ("%s: property '%s' changed but wasn't defined by object type %s.",
 		        __func__,
 		        prop_name,
 		        G_OBJECT_TYPE_NAME (self));
-		goto out;
+		return;
 	}
 
 	if (G_UNLIKELY (debug)) {
@@ -734,14 +907,34 @@ handle_property_changed (NMObject *self, const char *dbus_name, GVariant *value)
 	}
 
 	if (pspec && pi->object_type) {
-		if (g_variant_is_of_type (value, G_VARIANT_TYPE_OBJECT_PATH))
-			success = handle_object_property (self, pspec->name, value, pi);
-		else if (g_variant_is_of_type (value, G_VARIANT_TYPE ("ao")))
-			success = handle_object_array_property (self, pspec->name, value, pi);
-		else {
+		if (   !g_variant_is_of_type (value, G_VARIANT_TYPE_OBJECT_PATH)
+		    && !g_variant_is_of_type (value, G_VARIANT_TYPE ("ao"))) {
 			g_warn_if_reached ();
-			goto out;
+			return;
 		}
+
+		if (   entry->lazy
+		    && !entry->lazy_resolved) {
+			if (!_lazy_property_has_listeners (self, entry)) {
+				/* Only remember the path(s). The objects get resolved
+				 * once the property is accessed. */
+				if (   !entry->lazy_value
+				    || !g_variant_equal (entry->lazy_value, value)) {
+					nm_clear_g_variant (&entry->lazy_value);
+					entry->lazy_value = g_variant_ref (value);
+					_nm_object_queue_notify (self, pspec->name);
+				}
+				return;
+			}
+
+			/* A handler for the added/removed signals was connected since
+			 * the last change. Resolve the previous value first, so that
+			 * the signals are only emitted for what changes now, and not
+			 * replayed for the objects that already existed. */
+			_lazy_property_resolve (self, entry);
+		}
+
+		success = handle_object_property_value (self, pspec->name, value, pi, FALSE);
 	} else
 		success = (*(pi->func)) (self, pspec, value, pi->field);
 
@@ -751,9 +944,6 @@ handle_property_changed (NMObject *self, const char *dbus_name, GVariant *value)
 		        prop_name,
 		        G_OBJECT_TYPE_NAME (self));
 	}
-
-out:
-	g_free (prop_name);
 }
 
 static void
@@ -933,8 +1123,10 @@ _nm_object_register_properties (NMObject *object,
 	GDBusProxy *proxy;
 	static gsize dval = 0;
 	const char *debugstr;
-	NMPropertiesInfo *tmp;
-	GHashTable *instance;
+	const NMPropertiesInfo *tmp;
+	PropertyTable *table;
+	GObjectClass *klass;
+	guint n;
 
 	g_return_if_fail (NM_IS_OBJECT (object));
 	g_return_if_fail (interface != NULL);
@@ -952,24 +1144,40 @@ _nm_object_register_properties (NMObject *object,
 	                  G_CALLBACK (properties_changed), object);
 	g_ptr_array_add (priv->proxies, proxy);
 
-	instance = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, g_free);
-	priv->property_tables = g_slist_prepend (priv->property_tables, instance);
+	for (n = 0; info[n].name; n++)
+		/* count */;
+
+	table = g_malloc (sizeof (PropertyTable) + n * sizeof (PropertyEntry));
+	table->len = 0;
 
-	for (tmp = (NMPropertiesInfo *) info; tmp->name; tmp++) {
-		PropertyInfo *pi;
+	klass = G_OBJECT_GET_CLASS (object);
+	for (tmp = info; tmp->name; tmp++) {
+		PropertyEntry *entry;
 
-		if (!tmp->name || (tmp->func && !tmp->field)) {
+		if (tmp->func && !tmp->field) {
 			g_warning ("%s: missing field in NMPropertiesInfo", __func__);
 			continue;
 		}
 
-		pi = g_malloc0 (sizeof (PropertyInfo));
-		pi->func = tmp->func ?: demarshal_generic;
-		pi->object_type = tmp->object_type;
-		pi->field = tmp->field;
-		pi->signal_prefix = tmp->signal_prefix;
-		g_hash_table_insert (instance, g_strdup (tmp->name), pi);
+		entry = &table->entries[table->len++];
+		entry->name = tmp->name;
+		entry->pspec = g_object_class_find_property (klass, tmp->name);
+		if (   entry->pspec
+		    && tmp->object_type
+		    && G_PARAM_SPEC_VALUE_TYPE (entry->pspec) == G_TYPE_PTR_ARRAY)
+			nm_param_spec_set_element_type (entry->pspec, tmp->object_type);
+		entry->pi.func = tmp->func ?: demarshal_generic;
+		entry->pi.object_type = tmp->object_type;
+		entry->pi.field = tmp->field;
+		entry->pi.signal_prefix = tmp->signal_prefix;
+		entry->lazy_value = NULL;
+		entry->lazy = tmp->lazy && tmp->object_type;
+		entry->lazy_resolved = FALSE;
 	}
+
+	qsort (table->entries, table->len, sizeof (PropertyEntry), _property_entry_cmp);
+
+	priv->property_tables = g_slist_prepend (priv->property_tables, table);
 }
 
 void
@@ -1036,7 +1244,6 @@ init_if (GDBusProxy *proxy, NMObject *self)
 	char **props;
 	char **prop;
 	GVariant *val;
-	char *str;
 
 	nm_assert (G_IS_DBUS_PROXY (proxy));
 	nm_assert (NM_IS_OBJECT (self));
@@ -1045,10 +1252,8 @@ init_if (GDBusProxy *proxy, NMObject *self)
 
 	for (prop = props; prop && *prop; prop++) {
 		val = g_dbus_proxy_get_cached_property (proxy, *prop);
-		str = g_variant_print (val, TRUE);
 		handle_property_changed (self, *prop, val);
 		g_variant_unref (val);
-		g_free (str);
 	}
 
 	g_strfreev (props);
@@ -1265,7 +1470,7 @@ finalize (GObject *object)
 {
 	NMObjectPrivate *priv = NM_OBJECT_GET_PRIVATE (object);
 
-	g_slist_free_full (priv->property_tables, (GDestroyNotify) g_hash_table_destroy);
+	g_slist_free_full (priv->property_tables, _property_table_free);
 
 	G_OBJECT_CLASS (nm_object_parent_class)->finalize (object);
 }
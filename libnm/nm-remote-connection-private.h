@@ -34,4 +34,7 @@ typedef enum {
 	NM_REMOTE_CONNECTION_INIT_RESULT_INVISIBLE,
 } NMRemoteConnectionInitResult;
 
+void _nm_remote_connection_set_initial_settings (NMRemoteConnection *self,
+                                                 GVariant *settings);
+
 #endif  /* __NM_REMOTE_CONNECTION_PRIVATE__ */
@@ -72,6 +72,11 @@ typedef struct {
 	guint32 flags;
 	char *filename;
 
+	/* settings that NMClient fetched for all connections at once
+	 * via GetAllSettings(), before initializing the connection. */
+	GVariant *initial_settings;
+	bool initial_settings_set:1;
+
 	gboolean visible;
 } NMRemoteConnectionPrivate;
 
@@ -777,6 +782,50 @@ updated_cb (NMDBusSettingsConnection *proxy, gpointer user_data)
 	                                              g_object_ref (self));
 }
 
+/**
+ * _nm_remote_connection_set_initial_settings:
+ * @self: the #NMRemoteConnection, not yet initialized
+ * @settings: (allow-none): the settings of the connection, or %NULL
+ *   if the connection is not visible to the user.
+ *
+ * Provide the settings, so that initializing the connection does not
+ * need to call GetSettings().
+ */
+void
+_nm_remote_connection_set_initial_settings (NMRemoteConnection *self,
+                                            GVariant *settings)
+{
+	NMRemoteConnectionPrivate *priv;
+
+	g_return_if_fail (NM_IS_REMOTE_CONNECTION (self));
+
+	priv = NM_REMOTE_CONNECTION_GET_PRIVATE (self);
+	if (settings)
+		g_variant_ref (settings);
+	if (priv->initial_settings)
+		g_variant_unref (priv->initial_settings);
+	priv->initial_settings = settings;
+	priv->initial_settings_set = TRUE;
+}
+
+static gboolean
+init_take_initial_settings (NMRemoteConnection *self)
+{
+	NMRemoteConnectionPrivate *priv = NM_REMOTE_CONNECTION_GET_PRIVATE (self);
+	gs_unref_variant GVariant *settings = NULL;
+
+	if (!priv->initial_settings_set)
+		return FALSE;
+
+	priv->initial_settings_set = FALSE;
+	settings = g_steal_pointer (&priv->initial_settings);
+	if (settings) {
+		priv->visible = TRUE;
+		replace_settings (self, settings);
+	}
+	return TRUE;
+}
+
 /*****************************************************************************/
 
 static void
@@ -807,10 +856,11 @@ init_sync (GInitable *initable, GCancellable *cancellable, GError **error)
 	priv->proxy = NMDBUS_SETTINGS_CONNECTION (_nm_object_get_proxy (NM_OBJECT (initable), NM_DBUS_INTERFACE_SETTINGS_CONNECTION));
 	g_signal_connect_object (priv->proxy, "updated", G_CALLBACK (updated_cb), initable, 0);
 
-	if (nmdbus_settings_connection_call_get_settings_sync (priv->proxy,
-	                                                       &settings,
-	                                                       cancellable,
-	                                                       NULL)) {
+	if (   !init_take_initial_settings (self)
+	    && nmdbus_settings_connection_call_get_settings_sync (priv->proxy,
+	                                                          &settings,
+	                                                          cancellable,
+	                                                          NULL)) {
 		priv->visible = TRUE;
 		replace_settings (self, settings);
 		g_variant_unref (settings);
@@ -899,6 +949,12 @@ init_async (GAsyncInitable *initable, int io_priority,
 	g_signal_connect_object (priv->proxy, "updated",
 	                         G_CALLBACK (updated_cb), initable, 0);
 
+	if (init_take_initial_settings (NM_REMOTE_CONNECTION (initable))) {
+		nm_remote_connection_parent_async_initable_iface->
+			init_async (initable, io_priority, init_data->cancellable, init_async_parent_inited, init_data);
+		return;
+	}
+
 	nmdbus_settings_connection_call_get_settings (NM_REMOTE_CONNECTION_GET_PRIVATE (init_data->initable)->proxy,
 	                                              init_data->cancellable,
 	                                              init_get_settings_cb, init_data);
@@ -948,6 +1004,7 @@ dispose (GObject *object)
 
 	g_clear_object (&priv->proxy);
 	nm_clear_g_free (&priv->filename);
+	nm_clear_g_variant (&priv->initial_settings);
 
 	G_OBJECT_CLASS (nm_remote_connection_parent_class)->dispose (object);
 }
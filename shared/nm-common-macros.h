@@ -58,4 +58,25 @@ NM_CLONED_MAC_IS_SPECIAL (const char *str)
 
 /*****************************************************************************/
 
+/* The GParamSpec of a GPtrArray property does not tell the type of the
+ * elements. libnm attaches it to the properties that hold objects. */
+#define NM_PARAM_SPEC_QDATA_ELEMENT_TYPE "nm-element-type"
+
+static inline void
+nm_param_spec_set_element_type (GParamSpec *pspec, GType element_type)
+{
+	g_param_spec_set_qdata (pspec,
+	                        g_quark_from_static_string (NM_PARAM_SPEC_QDATA_ELEMENT_TYPE),
+	                        GSIZE_TO_POINTER (element_type));
+}
+
+static inline GType
+nm_param_spec_get_element_type (GParamSpec *pspec)
+{
+	return GPOINTER_TO_SIZE (g_param_spec_get_qdata (pspec,
+	                                                 g_quark_from_static_string (NM_PARAM_SPEC_QDATA_ELEMENT_TYPE)));
+}
+
+/*****************************************************************************/
+
 #endif /* __NM_COMMON_MACROS_H__ */
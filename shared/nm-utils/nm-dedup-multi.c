@@ -45,6 +45,9 @@ struct _NMDedupMultiIndex {
 	int ref_count;
 	GHashTable *idx_entries;
 	GHashTable *idx_objs;
+
+	guint64 intern_lookups;
+	guint64 intern_hits;
 };
 
 /*****************************************************************************/
@@ -837,6 +840,43 @@ nm_dedup_multi_index_obj_find (NMDedupMultiIndex *self,
 	return g_hash_table_lookup (self->idx_objs, obj);
 }
 
+/**
+ * nm_dedup_multi_index_get_stats:
+ * @self: the #NMDedupMultiIndex
+ * @out_stats: (out): the statistics
+ *
+ * Reports how many objects are interned in the index, and how often
+ * interning an object found an existing instance to share. Counting
+ * the shared objects iterates over all of them, so this is meant for
+ * debugging only.
+ */
+void
+nm_dedup_multi_index_get_stats (NMDedupMultiIndex *self,
+                                NMDedupMultiIndexStats *out_stats)
+{
+	GHashTableIter iter;
+	const NMDedupMultiObj *obj;
+
+	g_return_if_fail (self);
+	g_return_if_fail (out_stats);
+
+	memset (out_stats, 0, sizeof (*out_stats));
+	out_stats->n_objs = g_hash_table_size (self->idx_objs);
+	out_stats->n_entries = g_hash_table_size (self->idx_entries);
+	out_stats->intern_lookups = self->intern_lookups;
+	out_stats->intern_hits = self->intern_hits;
+
+	g_hash_table_iter_init (&iter, self->idx_objs);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &obj, NULL)) {
+		/* one reference is held by the user that interned it. Every
+		 * additional one is a user sharing the same instance. */
+		if (obj->_ref_count > 1) {
+			out_stats->n_objs_shared++;
+			out_stats->n_refs_shared += obj->_ref_count - 1;
+		}
+	}
+}
+
 gconstpointer
 nm_dedup_multi_index_obj_intern (NMDedupMultiIndex *self,
                                  /* const NMDedupMultiObj * */ gconstpointer obj)
@@ -847,8 +887,11 @@ nm_dedup_multi_index_obj_intern (NMDedupMultiIndex *self,
 	nm_assert (self);
 	nm_assert (obj_new);
 
+	self->intern_lookups++;
+
 	if (obj_new->_multi_idx == self) {
 		nm_assert (g_hash_table_lookup (self->idx_objs, obj_new) == obj_new);
+		self->intern_hits++;
 		nm_dedup_multi_obj_ref (obj_new);
 		return obj_new;
 	}
@@ -858,6 +901,7 @@ nm_dedup_multi_index_obj_intern (NMDedupMultiIndex *self,
 
 	if (obj_old) {
 		nm_assert (obj_old->_multi_idx == self);
+		self->intern_hits++;
 		nm_dedup_multi_obj_ref (obj_old);
 		return obj_old;
 	}
@@ -110,6 +110,22 @@ void nm_dedup_multi_index_obj_release (NMDedupMultiIndex *self,
 /* const NMDedupMultiObj * */ gconstpointer nm_dedup_multi_index_obj_find (NMDedupMultiIndex *self,
                                                                            /* const NMDedupMultiObj * */ gconstpointer obj);
 
+typedef struct {
+	guint n_objs;
+	guint n_entries;
+
+	/* number of interned objects that are referenced more than once,
+	 * and the sum of these additional references. */
+	guint n_objs_shared;
+	guint n_refs_shared;
+
+	guint64 intern_lookups;
+	guint64 intern_hits;
+} NMDedupMultiIndexStats;
+
+void nm_dedup_multi_index_get_stats (NMDedupMultiIndex *self,
+                                     NMDedupMultiIndexStats *out_stats);
+
 /*****************************************************************************/
 
 /* the NMDedupMultiIdxType is an access handle under which you can store and
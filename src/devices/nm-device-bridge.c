@@ -529,12 +529,18 @@ static const NMDBusInterfaceInfoExtended interface_info_device_bridge = {
 static void
 nm_device_bridge_class_init (NMDeviceBridgeClass *klass)
 {
+	static const char *const connection_types[] = {
+		NM_SETTING_BRIDGE_SETTING_NAME,
+		NM_SETTING_BLUETOOTH_SETTING_NAME,
+		NULL,
+	};
 	NMDBusObjectClass *dbus_object_class = NM_DBUS_OBJECT_CLASS (klass);
 	NMDeviceClass *device_class = NM_DEVICE_CLASS (klass);
 
 	dbus_object_class->interface_infos = NM_DBUS_INTERFACE_INFOS (&interface_info_device_bridge);
 
 	device_class->connection_type_supported = NM_SETTING_BRIDGE_SETTING_NAME;
+	device_class->connection_types_check_compatible = connection_types;
 	device_class->link_types = NM_DEVICE_DEFINE_LINK_TYPES (NM_LINK_TYPE_BRIDGE);
 
 	device_class->is_master = TRUE;
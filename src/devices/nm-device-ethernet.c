@@ -1774,6 +1774,11 @@ static const NMDBusInterfaceInfoExtended interface_info_device_wired = {
 static void
 nm_device_ethernet_class_init (NMDeviceEthernetClass *klass)
 {
+	static const char *const connection_types[] = {
+		NM_SETTING_WIRED_SETTING_NAME,
+		NM_SETTING_PPPOE_SETTING_NAME,
+		NULL,
+	};
 	GObjectClass *object_class = G_OBJECT_CLASS (klass);
 	NMDBusObjectClass *dbus_object_class = NM_DBUS_OBJECT_CLASS (klass);
 	NMDeviceClass *device_class = NM_DEVICE_CLASS (klass);
@@ -1788,6 +1793,7 @@ nm_device_ethernet_class_init (NMDeviceEthernetClass *klass)
 	dbus_object_class->interface_infos = NM_DBUS_INTERFACE_INFOS (&interface_info_device_wired);
 
 	device_class->connection_type_supported = NM_SETTING_WIRED_SETTING_NAME;
+	device_class->connection_types_check_compatible = connection_types;
 	device_class->link_types = NM_DEVICE_DEFINE_LINK_TYPES (NM_LINK_TYPE_ETHERNET);
 
 	device_class->get_generic_capabilities = get_generic_capabilities;
@@ -184,6 +184,22 @@ typedef struct {
 	NMTernary requested[_NM_ETHTOOL_ID_FEATURE_NUM];
 } EthtoolState;
 
+typedef enum {
+	STAGE_STATE_INIT = 0,
+	STAGE_STATE_PENDING,
+	STAGE_STATE_COMPLETED,
+} StageState;
+
+typedef struct {
+	CList sriov_op_lst;
+	NMDevice *self;
+	GCancellable *cancellable;
+	NMPlatformAsyncCallback callback;
+	gpointer callback_data;
+	guint num_vfs;
+	int autoprobe;
+} SriovOp;
+
 /*****************************************************************************/
 
 enum {
@@ -197,6 +213,7 @@ enum {
 	REMOVED,
 	RECHECK_AUTO_ACTIVATE,
 	RECHECK_ASSUME,
+	RECHECK_DEFAULT_ROUTE,
 	LAST_SIGNAL,
 };
 static guint signals[LAST_SIGNAL] = { 0 };
@@ -304,6 +321,7 @@ typedef struct _NMDevicePrivate {
 	char *        driver;
 	char *        driver_version;
 	char *        firmware_version;
+	GCancellable *driver_info_cancellable;
 	RfKillType    rfkill_type;
 	bool          firmware_missing:1;
 	bool          nm_plugin_missing:1;
@@ -524,6 +542,13 @@ typedef struct _NMDevicePrivate {
 
 	EthtoolState  *ethtool_state;
 
+	/* SR-IOV operations. The first one is running on the platform
+	 * worker, the others wait for it to complete. */
+	CList          sriov_op_lst_head;
+
+	GCancellable *stage1_sriov_cancellable;
+	StageState    stage1_sriov_state:3;
+
 	struct {
 		NMDhcpClient *   client;
 		NMNDiscDHCPLevel mode;
@@ -4158,6 +4183,75 @@ nm_device_update_from_platform_link (NMDevice *self, const NMPlatformLink *plink
 	}
 }
 
+static void sriov_op_start (NMDevice *self, SriovOp *op);
+
+static void
+sriov_op_cb (GError *error, gpointer user_data)
+{
+	SriovOp *op = user_data;
+	gs_unref_object NMDevice *self = op->self;
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+
+	nm_assert (op == c_list_first_entry (&priv->sriov_op_lst_head, SriovOp, sriov_op_lst));
+
+	c_list_unlink_stale (&op->sriov_op_lst);
+
+	if (op->callback)
+		op->callback (error, op->callback_data);
+	nm_g_object_unref (op->cancellable);
+	g_slice_free (SriovOp, op);
+
+	op = c_list_first_entry (&priv->sriov_op_lst_head, SriovOp, sriov_op_lst);
+	if (op)
+		sriov_op_start (self, op);
+}
+
+static void
+sriov_op_start (NMDevice *self, SriovOp *op)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+
+	/* the operation keeps the device alive until the worker is done. */
+	op->self = g_object_ref (self);
+
+	nm_platform_link_set_sriov_params_async (nm_device_get_platform (self),
+	                                         priv->ifindex,
+	                                         op->num_vfs,
+	                                         op->autoprobe,
+	                                         sriov_op_cb,
+	                                         op,
+	                                         op->cancellable);
+}
+
+/* Changing the number of VFs blocks in the kernel while the driver creates
+ * them, so the platform writes the value from a worker thread. Operations
+ * for the same device must not overlap, so they get serialized here. */
+static void
+sriov_op_queue (NMDevice *self,
+                guint num_vfs,
+                int autoprobe,
+                NMPlatformAsyncCallback callback,
+                gpointer callback_data,
+                GCancellable *cancellable)
+{
+	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	gboolean is_idle;
+	SriovOp *op;
+
+	is_idle = c_list_is_empty (&priv->sriov_op_lst_head);
+
+	op = g_slice_new0 (SriovOp);
+	op->num_vfs = num_vfs;
+	op->autoprobe = autoprobe;
+	op->callback = callback;
+	op->callback_data = callback_data;
+	op->cancellable = nm_g_object_ref (cancellable);
+	c_list_link_tail (&priv->sriov_op_lst_head, &op->sriov_op_lst);
+
+	if (is_idle)
+		sriov_op_start (self, op);
+}
+
 static void
 device_init_static_sriov_num_vfs (NMDevice *self)
 {
@@ -4172,10 +4266,8 @@ device_init_static_sriov_num_vfs (NMDevice *self)
 		                                          self,
 		                                          NULL);
 		num_vfs = _nm_utils_ascii_str_to_int64 (value, 10, 0, G_MAXINT32, -1);
-		if (num_vfs >= 0) {
-			nm_platform_link_set_sriov_params (nm_device_get_platform (self),
-			                                   priv->ifindex, num_vfs, -1);
-		}
+		if (num_vfs >= 0)
+			sriov_op_queue (self, num_vfs, -1, NULL, NULL, NULL);
 	}
 }
 
@@ -4192,8 +4284,12 @@ config_changed (NMConfig *config,
 	    || priv->state > NM_DEVICE_STATE_ACTIVATED)
 		priv->ignore_carrier = nm_config_data_get_ignore_carrier (config_data, self);
 
-	if (NM_FLAGS_HAS (changes, NM_CONFIG_CHANGE_VALUES))
+	if (NM_FLAGS_HAS (changes, NM_CONFIG_CHANGE_VALUES)) {
 		device_init_static_sriov_num_vfs (self);
+
+		/* the default route-metric might come from the configuration. */
+		g_signal_emit (self, signals[RECHECK_DEFAULT_ROUTE], 0);
+	}
 }
 
 static void
@@ -4205,6 +4301,53 @@ realize_start_notify (NMDevice *self,
 	NM_DEVICE_GET_CLASS (self)->link_changed (self, pllink);
 }
 
+static void
+driver_info_cb (const NMPlatformEthtoolInfo *info,
+                GError *error,
+                gpointer user_data)
+{
+	NMDevice *self;
+	NMDevicePrivate *priv;
+	gboolean changed = FALSE;
+
+	if (nm_utils_error_is_cancelled (error, FALSE))
+		return;
+
+	self = user_data;
+	priv = NM_DEVICE_GET_PRIVATE (self);
+
+	g_clear_object (&priv->driver_info_cancellable);
+
+	if (   info
+	    && info->has_driver_info) {
+		if (   info->driver_version[0]
+		    && !nm_streq0 (priv->driver_version, info->driver_version)) {
+			g_free (priv->driver_version);
+			priv->driver_version = g_strdup (info->driver_version);
+			_notify (self, PROP_DRIVER_VERSION);
+			changed = TRUE;
+		}
+		if (   info->fw_version[0]
+		    && !nm_streq0 (priv->firmware_version, info->fw_version)) {
+			g_free (priv->firmware_version);
+			priv->firmware_version = g_strdup (info->fw_version);
+			_notify (self, PROP_FIRMWARE_VERSION);
+		}
+	}
+
+	if (changed) {
+		/* realize_start_setup() matched the device specs without a driver
+		 * version. Match "driver-version:" specs again. */
+		if (   priv->state <= NM_DEVICE_STATE_DISCONNECTED
+		    || priv->state > NM_DEVICE_STATE_ACTIVATED)
+			priv->ignore_carrier = nm_config_data_get_ignore_carrier (NM_CONFIG_GET_DATA, self);
+		nm_device_set_unmanaged_by_user_conf (self);
+		nm_device_set_unmanaged_by_user_settings (self);
+	}
+
+	device_init_static_sriov_num_vfs (self);
+}
+
 /**
  * realize_start_setup():
  * @self: the #NMDevice
@@ -4285,15 +4428,17 @@ realize_start_setup (NMDevice *self,
 		          nm_platform_link_get_mtu (nm_device_get_platform (self),
 		                                    priv->ifindex));
 
-		nm_platform_link_get_driver_info (nm_device_get_platform (self),
-		                                  priv->ifindex,
-		                                  NULL,
-		                                  &priv->driver_version,
-		                                  &priv->firmware_version);
-		if (priv->driver_version)
-			_notify (self, PROP_DRIVER_VERSION);
-		if (priv->firmware_version)
-			_notify (self, PROP_FIRMWARE_VERSION);
+		/* Some drivers take long to answer the ethtool ioctls. Don't block
+		 * realizing the device on them. The device specs that can match on
+		 * the driver version are evaluated again in driver_info_cb(). */
+		nm_clear_g_cancellable (&priv->driver_info_cancellable);
+		priv->driver_info_cancellable = g_cancellable_new ();
+		nm_platform_link_get_ethtool_info_async (nm_device_get_platform (self),
+		                                         priv->ifindex,
+		                                         NM_PLATFORM_ETHTOOL_INFO_DRIVER,
+		                                         driver_info_cb,
+		                                         self,
+		                                         priv->driver_info_cancellable);
 
 		if (nm_platform_check_kernel_support (nm_device_get_platform (self),
 		                                      NM_PLATFORM_KERNEL_SUPPORT_USER_IPV6LL))
@@ -4337,8 +4482,6 @@ realize_start_setup (NMDevice *self,
 
 	nm_device_set_carrier_from_platform (self);
 
-	device_init_static_sriov_num_vfs (self);
-
 	nm_assert (!priv->stats.timeout_id);
 	real_rate = _stats_refresh_rate_real (priv->stats.refresh_rate_ms);
 	if (real_rate)
@@ -4513,6 +4656,7 @@ nm_device_unrealize (NMDevice *self, gboolean remove_resources, GError **error)
 
 	_set_mtu (self, 0);
 
+	nm_clear_g_cancellable (&priv->driver_info_cancellable);
 	if (priv->driver_version) {
 		g_clear_pointer (&priv->driver_version, g_free);
 		_notify (self, PROP_DRIVER_VERSION);
@@ -6229,64 +6373,107 @@ sriov_vf_config_to_platform (NMDevice *self,
 	return g_steal_pointer (&plat_vf);
 }
 
+static void
+sriov_params_cb (GError *error, gpointer data)
+{
+	NMDevice *self;
+	NMDevicePrivate *priv;
+	nm_auto_freev NMPlatformVF **plat_vfs = NULL;
+
+	nm_utils_user_data_unpack (data, &self, &plat_vfs);
+
+	if (nm_utils_error_is_cancelled (error, TRUE))
+		return;
+
+	priv = NM_DEVICE_GET_PRIVATE (self);
+
+	g_clear_object (&priv->stage1_sriov_cancellable);
+
+	if (error) {
+		_LOGE (LOGD_DEVICE, "failed to set SR-IOV parameters: %s", error->message);
+		nm_device_state_changed (self,
+		                         NM_DEVICE_STATE_FAILED,
+		                         NM_DEVICE_STATE_REASON_SRIOV_CONFIGURATION_FAILED);
+		return;
+	}
+
+	if (!nm_platform_link_set_sriov_vfs (nm_device_get_platform (self),
+	                                     priv->ifindex,
+	                                     (const NMPlatformVF *const *) plat_vfs)) {
+		_LOGE (LOGD_DEVICE, "failed to apply SR-IOV VFs");
+		nm_device_state_changed (self,
+		                         NM_DEVICE_STATE_FAILED,
+		                         NM_DEVICE_STATE_REASON_SRIOV_CONFIGURATION_FAILED);
+		return;
+	}
+
+	priv->stage1_sriov_state = STAGE_STATE_COMPLETED;
+	nm_device_activate_schedule_stage1_device_prepare (self);
+}
+
 static NMActStageReturn
-act_stage1_prepare (NMDevice *self, NMDeviceStateReason *out_failure_reason)
+act_stage1_prepare_sriov (NMDevice *self, NMDeviceStateReason *out_failure_reason)
 {
 	NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE (self);
+	nm_auto_freev NMPlatformVF **plat_vfs = NULL;
 	NMSettingSriov *s_sriov;
 	guint i, num;
+	int autoprobe;
 
-	if (   priv->ifindex > 0
-	    && nm_device_has_capability (self, NM_DEVICE_CAP_SRIOV)
-	    && (s_sriov = nm_device_get_applied_setting (self, NM_TYPE_SETTING_SRIOV))) {
-		nm_auto_freev NMPlatformVF **plat_vfs = NULL;
-		gs_free_error GError *error = NULL;
-		NMSriovVF *vf;
-		int autoprobe;
-
-		autoprobe = nm_setting_sriov_get_autoprobe_drivers (s_sriov);
-		if (autoprobe == NM_TERNARY_DEFAULT) {
-			autoprobe = nm_config_data_get_connection_default_int64 (NM_CONFIG_GET_DATA,
-			                                                         "sriov.autoprobe-drivers",
-			                                                         self,
-			                                                         NM_TERNARY_FALSE,
-			                                                         NM_TERNARY_TRUE,
-			                                                         NM_TERNARY_TRUE);
-		}
+	if (priv->stage1_sriov_state == STAGE_STATE_PENDING)
+		return NM_ACT_STAGE_RETURN_POSTPONE;
 
-		num = nm_setting_sriov_get_num_vfs (s_sriov);
-		plat_vfs = g_new0 (NMPlatformVF *, num + 1);
-		for (i = 0; i < num; i++) {
-			vf = nm_setting_sriov_get_vf (s_sriov, i);
-			plat_vfs[i] = sriov_vf_config_to_platform (self, vf, &error);
-			if (!plat_vfs[i]) {
-				_LOGE (LOGD_DEVICE,
-				       "failed to apply SR-IOV VF '%s': %s",
-				       nm_utils_sriov_vf_to_str (vf, FALSE, NULL),
-				       error->message);
-				NM_SET_OUT (out_failure_reason, NM_DEVICE_STATE_REASON_SRIOV_CONFIGURATION_FAILED);
-				return NM_ACT_STAGE_RETURN_FAILURE;
-			}
-		}
+	if (   priv->ifindex <= 0
+	    || !nm_device_has_capability (self, NM_DEVICE_CAP_SRIOV)
+	    || !(s_sriov = nm_device_get_applied_setting (self, NM_TYPE_SETTING_SRIOV))) {
+		priv->stage1_sriov_state = STAGE_STATE_COMPLETED;
+		return NM_ACT_STAGE_RETURN_SUCCESS;
+	}
 
-		if (!nm_platform_link_set_sriov_params (nm_device_get_platform (self),
-		                                        priv->ifindex,
-		                                        nm_setting_sriov_get_total_vfs (s_sriov),
-		                                        autoprobe)) {
-			_LOGE (LOGD_DEVICE, "failed to apply SR-IOV parameters");
-			NM_SET_OUT (out_failure_reason, NM_DEVICE_STATE_REASON_SRIOV_CONFIGURATION_FAILED);
-			return NM_ACT_STAGE_RETURN_FAILURE;
-		}
+	autoprobe = nm_setting_sriov_get_autoprobe_drivers (s_sriov);
+	if (autoprobe == NM_TERNARY_DEFAULT) {
+		autoprobe = nm_config_data_get_connection_default_int64 (NM_CONFIG_GET_DATA,
+		                                                         "sriov.autoprobe-drivers",
+		                                                         self,
+		                                                         NM_TERNARY_FALSE,
+		                                                         NM_TERNARY_TRUE,
+		                                                         NM_TERNARY_TRUE);
+	}
 
-		if (!nm_platform_link_set_sriov_vfs (nm_device_get_platform (self),
-		                                     priv->ifindex,
-		                                     (const NMPlatformVF *const *) plat_vfs)) {
-			_LOGE (LOGD_DEVICE, "failed to apply SR-IOV VFs");
+	num = nm_setting_sriov_get_num_vfs (s_sriov);
+	plat_vfs = g_new0 (NMPlatformVF *, num + 1);
+	for (i = 0; i < num; i++) {
+		gs_free_error GError *error = NULL;
+		NMSriovVF *vf;
+
+		vf = nm_setting_sriov_get_vf (s_sriov, i);
+		plat_vfs[i] = sriov_vf_config_to_platform (self, vf, &error);
+		if (!plat_vfs[i]) {
+			_LOGE (LOGD_DEVICE,
+			       "failed to apply SR-IOV VF '%s': %s",
+			       nm_utils_sriov_vf_to_str (vf, FALSE, NULL),
+			       error->message);
 			NM_SET_OUT (out_failure_reason, NM_DEVICE_STATE_REASON_SRIOV_CONFIGURATION_FAILED);
 			return NM_ACT_STAGE_RETURN_FAILURE;
 		}
 	}
 
+	/* Creating the VFs is slow. Don't block the main loop (and thereby the
+	 * activation of all other devices) but continue in sriov_params_cb(). */
+	priv->stage1_sriov_state = STAGE_STATE_PENDING;
+	priv->stage1_sriov_cancellable = g_cancellable_new ();
+	sriov_op_queue (self,
+	                nm_setting_sriov_get_total_vfs (s_sriov),
+	                autoprobe,
+	                sriov_params_cb,
+	                nm_utils_user_data_pack (self, g_steal_pointer (&plat_vfs)),
+	                priv->stage1_sriov_cancellable);
+	return NM_ACT_STAGE_RETURN_POSTPONE;
+}
+
+static NMActStageReturn
+act_stage1_prepare (NMDevice *self, NMDeviceStateReason *out_failure_reason)
+{
 	return NM_ACT_STAGE_RETURN_SUCCESS;
 }
 
@@ -6316,6 +6503,16 @@ activate_stage1_device_prepare (NMDevice *self)
 	if (!nm_device_sys_iface_state_is_external_or_assume (self)) {
 		NMDeviceStateReason failure_reason = NM_DEVICE_STATE_REASON_NONE;
 
+		if (priv->stage1_sriov_state != STAGE_STATE_COMPLETED) {
+			ret = act_stage1_prepare_sriov (self, &failure_reason);
+			if (ret == NM_ACT_STAGE_RETURN_POSTPONE) {
+				return;
+			} else if (ret == NM_ACT_STAGE_RETURN_FAILURE) {
+				nm_device_state_changed (self, NM_DEVICE_STATE_FAILED, failure_reason);
+				return;
+			}
+		}
+
 		ret = NM_DEVICE_GET_CLASS (self)->act_stage1_prepare (self, &failure_reason);
 		if (ret == NM_ACT_STAGE_RETURN_POSTPONE) {
 			return;
@@ -11199,6 +11396,11 @@ check_and_reapply_connection (NMDevice *self,
 
 	reactivate_proxy_config (self);
 
+	/* never-default or the route-metric might have changed, without the
+	 * IP configuration changing. */
+	if (diffs)
+		g_signal_emit (self, signals[RECHECK_DEFAULT_ROUTE], 0);
+
 	return TRUE;
 }
 
@@ -14113,6 +14315,9 @@ _cancel_activation (NMDevice *self)
 
 	ip_check_gw_ping_cleanup (self);
 
+	nm_clear_g_cancellable (&priv->stage1_sriov_cancellable);
+	priv->stage1_sriov_state = STAGE_STATE_INIT;
+
 	/* Break the activation chain */
 	activation_source_clear (self, AF_INET);
 	activation_source_clear (self, AF_INET6);
@@ -15898,6 +16103,7 @@ nm_device_init (NMDevice *self)
 	self->_priv = priv;
 
 	c_list_init (&priv->concheck_lst_head);
+	c_list_init (&priv->sriov_op_lst_head);
 	c_list_init (&self->devices_lst);
 	c_list_init (&priv->slaves);
 
@@ -16034,6 +16240,8 @@ dispose (GObject *object)
 	}
 
 	nm_clear_g_cancellable (&priv->deactivating_cancellable);
+	nm_clear_g_cancellable (&priv->stage1_sriov_cancellable);
+	nm_clear_g_cancellable (&priv->driver_info_cancellable);
 
 	nm_device_assume_state_reset (self);
 
@@ -16897,4 +17105,11 @@ nm_device_class_init (NMDeviceClass *klass)
 	                  G_SIGNAL_RUN_FIRST,
 	                  0, NULL, NULL, NULL,
 	                  G_TYPE_NONE, 0);
+
+	signals[RECHECK_DEFAULT_ROUTE] =
+	    g_signal_new (NM_DEVICE_RECHECK_DEFAULT_ROUTE,
+	                  G_OBJECT_CLASS_TYPE (object_class),
+	                  G_SIGNAL_RUN_FIRST,
+	                  0, NULL, NULL, NULL,
+	                  G_TYPE_NONE, 0);
 }
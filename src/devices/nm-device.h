@@ -140,6 +140,7 @@ nm_device_state_reason_check (NMDeviceStateReason reason)
 #define NM_DEVICE_REMOVED               "removed"
 #define NM_DEVICE_RECHECK_AUTO_ACTIVATE "recheck-auto-activate"
 #define NM_DEVICE_RECHECK_ASSUME        "recheck-assume"
+#define NM_DEVICE_RECHECK_DEFAULT_ROUTE "recheck-default-route"
 #define NM_DEVICE_STATE_CHANGED         "state-changed"
 #define NM_DEVICE_LINK_INITIALIZED      "link-initialized"
 #define NM_DEVICE_AUTOCONNECT_ALLOWED   "autoconnect-allowed"
@@ -238,6 +239,12 @@ typedef struct _NMDeviceClass {
 	 * is the connection.type setting, as checked by nm_device_check_connection_compatible() */
 	const char *connection_type_check_compatible;
 
+	/* for device types that accept several connection types and therefore
+	 * don't set connection_type_check_compatible, the %NULL terminated list
+	 * of those types. It only serves as a pre-filter for autoconnect
+	 * candidates, check_connection_compatible() still decides. */
+	const char *const *connection_types_check_compatible;
+
 	const NMLinkType *link_types;
 
 	/* Whether the device type is a master-type. This depends purely on the
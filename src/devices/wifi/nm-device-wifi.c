@@ -47,6 +47,8 @@
 #include "nm-ip4-config.h"
 #include "nm-setting-ip6-config.h"
 #include "platform/nm-platform.h"
+#include "platform/nmp-netns.h"
+#include "platform/wifi/nm-wifi-utils-nl80211.h"
 #include "nm-auth-utils.h"
 #include "settings/nm-settings-connection.h"
 #include "settings/nm-settings.h"
@@ -63,6 +65,14 @@ _LOG_DECLARE_SELF(NMDeviceWifi);
 #define SCAN_INTERVAL_STEP 20
 #define SCAN_INTERVAL_MAX 120
 
+/* Periodic scans only cover part of the channels while the scan interval
+ * is at most this long, so that every channel is scanned again well before
+ * wpa_supplicant expires the BSSs on it (bss_expire_age defaults to 180). */
+#define SCAN_PARTIAL_INTERVAL_MAX 60
+
+/* How long a periodic scan is delayed while another device is scanning */
+#define SCAN_STAGGER_MSEC 2000
+
 #define SCAN_RAND_MAC_ADDRESS_EXPIRE_MIN 5
 
 /*****************************************************************************/
@@ -89,6 +99,7 @@ typedef struct {
 	gint8             invalid_strength_counter;
 
 	CList             aps_lst_head;
+	NMWifiAPIndex    *aps_idx;
 
 	NMWifiAP *        current_ap;
 	guint32           rate;
@@ -97,6 +108,8 @@ typedef struct {
 	bool              ssid_found:1;
 	bool              is_scanning:1;
 	bool              hidden_probe_scan_warn:1;
+	bool              scan_last_partial:1;
+	bool              scan_staggered:1;
 
 	gint64            last_scan; /* milliseconds */
 	gint32            scheduled_scan_time; /* seconds */
@@ -104,6 +117,29 @@ typedef struct {
 	guint             pending_scan_id;
 	guint             ap_dump_id;
 
+	/* Links all Wi-Fi devices so that their periodic scans can be
+	 * coordinated, see _scan_plan(). */
+	CList             scan_devices_lst;
+	GArray           *scan_freqs; /* guint32, supported frequencies in MHz */
+
+	/* announces new scan results of the kernel, see update_aps_from_kernel(). */
+	NMWifiUtilsNl80211ScanMonitor *scan_monitor;
+
+	/* While processing scan results, AccessPointAdded/Removed signals and
+	 * property changes of the APs are collected and emitted in one go once
+	 * the scan is done (or AP_BATCH_TIMEOUT_MSEC passed). */
+	struct {
+		GPtrArray    *added;      /* NMWifiAP, not yet announced */
+		GPtrArray    *removed;    /* NMWifiAP, no longer in the list but still exported */
+		GHashTable   *frozen;     /* NMWifiAP with held back property notifications */
+		guint         timeout_id;
+		guint         n_list_changes;
+		guint         n_signals_unbatched;
+		guint64       n_signals_sent;
+		guint64       n_signals_saved;
+		bool          recheck_available_connections:1;
+	} ap_batch;
+
 	NMSupplicantManager   *sup_mgr;
 	NMSupplicantInterface *sup_iface;
 	guint                  sup_timeout_id; /* supplicant association timeout */
@@ -148,10 +184,16 @@ G_DEFINE_TYPE (NMDeviceWifi, nm_device_wifi, NM_TYPE_DEVICE)
 
 /*****************************************************************************/
 
+static CList _scan_devices_lst_head = C_LIST_INIT (_scan_devices_lst_head);
+
+/*****************************************************************************/
+
 static gboolean check_scanning_prohibited (NMDeviceWifi *self, gboolean periodic);
 
 static void schedule_scan (NMDeviceWifi *self, gboolean backoff);
 
+static gboolean request_wireless_scan_periodic (gpointer user_data);
+
 static void cleanup_association_attempt (NMDeviceWifi * self,
                                          gboolean disconnect);
 
@@ -196,8 +238,12 @@ static void ap_add_remove (NMDeviceWifi *self,
                            NMWifiAP *ap,
                            gboolean recheck_available_connections);
 
+static void _ap_batch_flush (NMDeviceWifi *self);
+
 static void _hw_addr_set_scanning (NMDeviceWifi *self, gboolean do_reset);
 
+static void update_aps_from_kernel (NMDeviceWifi *self);
+
 /*****************************************************************************/
 
 static void
@@ -244,6 +290,38 @@ unmanaged_on_quit (NMDevice *self)
 	return TRUE;
 }
 
+static void
+scan_monitor_scan_done_cb (gpointer user_data)
+{
+	update_aps_from_kernel (user_data);
+}
+
+static void
+scan_monitor_start (NMDeviceWifi *self)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	NMDevice *device = NM_DEVICE (self);
+	nm_auto_pop_netns NMPNetns *netns = NULL;
+
+	if (priv->scan_monitor)
+		return;
+
+	if (!nm_config_data_get_device_config_boolean (NM_CONFIG_GET_DATA,
+	                                               NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_NL80211_SCAN_RESULTS,
+	                                               device,
+	                                               FALSE, FALSE))
+		return;
+
+	if (!nm_platform_netns_push (nm_device_get_platform (device), &netns))
+		return;
+
+	priv->scan_monitor = nm_wifi_utils_nl80211_scan_monitor_new (nm_device_get_ifindex (device),
+	                                                             scan_monitor_scan_done_cb,
+	                                                             self);
+	if (!priv->scan_monitor)
+		_LOGD (LOGD_WIFI, "wifi-scan: cannot watch the scan results of the kernel");
+}
+
 static gboolean
 supplicant_interface_acquire (NMDeviceWifi *self)
 {
@@ -292,6 +370,8 @@ supplicant_interface_acquire (NMDeviceWifi *self)
 	                  G_CALLBACK (supplicant_iface_notify_current_bss),
 	                  self);
 
+	scan_monitor_start (self);
+
 	_notify_scanning (self);
 
 	return TRUE;
@@ -337,6 +417,8 @@ supplicant_interface_release (NMDeviceWifi *self)
 
 	nm_clear_g_source (&priv->ap_dump_id);
 
+	g_clear_pointer (&priv->scan_monitor, nm_wifi_utils_nl80211_scan_monitor_free);
+
 	if (priv->sup_iface) {
 		/* Clear supplicant interface signal handlers */
 		g_signal_handlers_disconnect_by_data (priv->sup_iface, self);
@@ -461,6 +543,126 @@ periodic_update_cb (gpointer user_data)
 	return TRUE;
 }
 
+#define AP_BATCH_TIMEOUT_MSEC 500
+
+static gboolean
+_ap_batch_timeout_cb (gpointer user_data)
+{
+	NMDeviceWifi *self = user_data;
+
+	NM_DEVICE_WIFI_GET_PRIVATE (self)->ap_batch.timeout_id = 0;
+	_ap_batch_flush (self);
+	return G_SOURCE_REMOVE;
+}
+
+static void
+_ap_batch_start (NMDeviceWifi *self)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+
+	if (!priv->ap_batch.timeout_id)
+		priv->ap_batch.timeout_id = g_timeout_add (AP_BATCH_TIMEOUT_MSEC, _ap_batch_timeout_cb, self);
+}
+
+static gboolean
+_ap_batch_active (NMDeviceWifi *self)
+{
+	return NM_DEVICE_WIFI_GET_PRIVATE (self)->ap_batch.timeout_id != 0;
+}
+
+static void
+_ap_thaw_and_unref (gpointer ap)
+{
+	g_object_thaw_notify (ap);
+	g_object_unref (ap);
+}
+
+static void
+_ap_batch_freeze (NMDeviceWifi *self, NMWifiAP *ap)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+
+	if (!_ap_batch_active (self))
+		return;
+
+	if (!priv->ap_batch.frozen)
+		priv->ap_batch.frozen = g_hash_table_new_full (nm_direct_hash, NULL, _ap_thaw_and_unref, NULL);
+	else if (g_hash_table_contains (priv->ap_batch.frozen, ap))
+		return;
+
+	g_object_freeze_notify (G_OBJECT (ap));
+	g_hash_table_add (priv->ap_batch.frozen, g_object_ref (ap));
+}
+
+static void
+_ap_batch_flush (NMDeviceWifi *self)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	gs_unref_ptrarray GPtrArray *added = NULL;
+	gs_unref_ptrarray GPtrArray *removed = NULL;
+	gs_unref_hashtable GHashTable *frozen = NULL;
+	guint n_list_changes;
+	guint n_signals = 0;
+	guint n_signals_unbatched;
+	gboolean recheck_available_connections;
+	guint i;
+
+	nm_clear_g_source (&priv->ap_batch.timeout_id);
+
+	added = g_steal_pointer (&priv->ap_batch.added);
+	removed = g_steal_pointer (&priv->ap_batch.removed);
+	frozen = g_steal_pointer (&priv->ap_batch.frozen);
+	n_list_changes = priv->ap_batch.n_list_changes;
+	n_signals_unbatched = priv->ap_batch.n_signals_unbatched;
+	recheck_available_connections = priv->ap_batch.recheck_available_connections;
+	priv->ap_batch.n_list_changes = 0;
+	priv->ap_batch.n_signals_unbatched = 0;
+	priv->ap_batch.recheck_available_connections = FALSE;
+
+	if (added) {
+		for (i = 0; i < added->len; i++)
+			nm_device_wifi_emit_signal_access_point (NM_DEVICE (self), added->pdata[i], TRUE);
+		n_signals += added->len;
+	}
+
+	if (n_list_changes) {
+		_notify (self, PROP_ACCESS_POINTS);
+		n_signals++;
+	}
+
+	if (removed) {
+		for (i = 0; i < removed->len; i++) {
+			NMWifiAP *ap = removed->pdata[i];
+
+			nm_device_wifi_emit_signal_access_point (NM_DEVICE (self), ap, FALSE);
+			nm_dbus_object_clear_and_unexport (&ap);
+		}
+		n_signals += removed->len;
+	}
+
+	if (frozen) {
+		/* thaws the notifications of the APs */
+		n_signals += g_hash_table_size (frozen);
+		nm_clear_pointer (&frozen, g_hash_table_unref);
+	}
+
+	if (n_signals_unbatched) {
+		priv->ap_batch.n_signals_sent += n_signals;
+		priv->ap_batch.n_signals_saved += n_signals_unbatched - NM_MIN (n_signals, n_signals_unbatched);
+		_LOGD (LOGD_WIFI_SCAN, "wifi-scan: emitted AP changes with %u D-Bus signals instead of %u "
+		       "(total %"G_GUINT64_FORMAT" signals, %"G_GUINT64_FORMAT" saved)",
+		       n_signals, n_signals_unbatched,
+		       priv->ap_batch.n_signals_sent,
+		       priv->ap_batch.n_signals_saved);
+	}
+
+	if (n_list_changes) {
+		nm_device_emit_recheck_auto_activate (NM_DEVICE (self));
+		if (recheck_available_connections)
+			nm_device_recheck_available_connections (NM_DEVICE (self));
+	}
+}
+
 static void
 ap_add_remove (NMDeviceWifi *self,
                gboolean is_adding, /* or else removing */
@@ -468,18 +670,49 @@ ap_add_remove (NMDeviceWifi *self,
                gboolean recheck_available_connections)
 {
 	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	gboolean batch = _ap_batch_active (self);
 
 	if (is_adding) {
 		g_object_ref (ap);
 		ap->wifi_device = NM_DEVICE (self);
 		c_list_link_tail (&priv->aps_lst_head, &ap->aps_lst);
+		nm_wifi_ap_index_add (priv->aps_idx, ap);
 		nm_dbus_object_export (NM_DBUS_OBJECT (ap));
 		_ap_dump (self, LOGL_DEBUG, ap, "added", 0);
-		nm_device_wifi_emit_signal_access_point (NM_DEVICE (self), ap, TRUE);
+		if (batch) {
+			if (!priv->ap_batch.added)
+				priv->ap_batch.added = g_ptr_array_new_with_free_func (g_object_unref);
+			g_ptr_array_add (priv->ap_batch.added, g_object_ref (ap));
+		} else
+			nm_device_wifi_emit_signal_access_point (NM_DEVICE (self), ap, TRUE);
 	} else {
 		ap->wifi_device = NULL;
 		c_list_unlink (&ap->aps_lst);
+		nm_wifi_ap_index_remove (priv->aps_idx, ap);
 		_ap_dump (self, LOGL_DEBUG, ap, "removed", 0);
+		if (priv->ap_batch.frozen)
+			g_hash_table_remove (priv->ap_batch.frozen, ap);
+	}
+
+	if (batch) {
+		/* AccessPointAdded/Removed and the AccessPoints property change */
+		priv->ap_batch.n_signals_unbatched += 2;
+		priv->ap_batch.n_list_changes++;
+		if (recheck_available_connections)
+			priv->ap_batch.recheck_available_connections = TRUE;
+
+		if (!is_adding) {
+			if (   priv->ap_batch.added
+			    && g_ptr_array_remove (priv->ap_batch.added, ap)) {
+				/* never announced, just drop it */
+				nm_dbus_object_clear_and_unexport (&ap);
+			} else {
+				if (!priv->ap_batch.removed)
+					priv->ap_batch.removed = g_ptr_array_new ();
+				g_ptr_array_add (priv->ap_batch.removed, ap);
+			}
+		}
+		return;
 	}
 
 	_notify (self, PROP_ACCESS_POINTS);
@@ -508,6 +741,8 @@ remove_all_aps (NMDeviceWifi *self)
 	while ((ap = c_list_first_entry (&priv->aps_lst_head, NMWifiAP, aps_lst)))
 		ap_add_remove (self, FALSE, ap, FALSE);
 
+	_ap_batch_flush (self);
+
 	nm_device_recheck_available_connections (NM_DEVICE (self));
 }
 
@@ -742,7 +977,7 @@ check_connection_available (NMDevice *device,
 	    || NM_FLAGS_HAS (flags, _NM_DEVICE_CHECK_CON_AVAILABLE_FOR_USER_REQUEST_IGNORE_AP))
 		return TRUE;
 
-	if (!nm_wifi_aps_find_first_compatible (&priv->aps_lst_head, connection)) {
+	if (!nm_wifi_ap_index_find_first_compatible (priv->aps_idx, connection)) {
 		nm_utils_error_set_literal (error, NM_UTILS_ERROR_CONNECTION_AVAILABLE_TEMPORARY,
 		                            "no compatible access point found");
 		return FALSE;
@@ -795,7 +1030,7 @@ complete_connection (NMDevice *device,
 
 		if (!nm_streq0 (mode, NM_SETTING_WIRELESS_MODE_AP)) {
 			/* Find a compatible AP in the scan list */
-			ap = nm_wifi_aps_find_first_compatible (&priv->aps_lst_head, connection);
+			ap = nm_wifi_ap_index_find_first_compatible (priv->aps_idx, connection);
 
 			/* If we still don't have an AP, then the WiFI settings needs to be
 			 * fully specified by the client.  Might not be able to find an AP
@@ -998,7 +1233,7 @@ can_auto_connect (NMDevice *device,
 			return FALSE;
 	}
 
-	ap = nm_wifi_aps_find_first_compatible (&priv->aps_lst_head, connection);
+	ap = nm_wifi_ap_index_find_first_compatible (priv->aps_idx, connection);
 	if (ap) {
 		/* All good; connection is usable */
 		NM_SET_OUT (specific_object, g_strdup (nm_dbus_object_get_path (NM_DBUS_OBJECT (ap))));
@@ -1329,6 +1564,122 @@ build_hidden_probe_list (NMDeviceWifi *self)
 	return ssids;
 }
 
+/*****************************************************************************/
+
+static gboolean
+_scan_peer_is_scanning (NMDeviceWifi *self)
+{
+	NMDeviceWifi *peer;
+
+	c_list_for_each_entry (peer, &_scan_devices_lst_head, _priv.scan_devices_lst) {
+		if (   peer != self
+		    && (peer->_priv.requested_scan || peer->_priv.is_scanning))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/* Whether the device is disconnected and only scans to find networks. */
+static gboolean
+_scan_is_idle (NMDeviceWifi *self)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	NMDeviceState state = nm_device_get_state (NM_DEVICE (self));
+
+	return    priv->sup_iface
+	       && nm_supplicant_interface_get_state (priv->sup_iface) >= NM_SUPPLICANT_INTERFACE_STATE_READY
+	       && state > NM_DEVICE_STATE_UNAVAILABLE
+	       && state < NM_DEVICE_STATE_PREPARE;
+}
+
+static GArray *
+_scan_get_freqs (NMDeviceWifi *self)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	int ifindex;
+
+	if (!priv->scan_freqs) {
+		ifindex = nm_device_get_ifindex (NM_DEVICE (self));
+		if (ifindex > 0) {
+			priv->scan_freqs = nm_platform_wifi_get_frequencies (nm_device_get_platform (NM_DEVICE (self)),
+			                                                     ifindex);
+		}
+	}
+	return priv->scan_freqs;
+}
+
+static gboolean
+_scan_freqs_contains (GArray *freqs, guint32 freq)
+{
+	guint i;
+
+	for (i = 0; i < freqs->len; i++) {
+		if (g_array_index (freqs, guint32, i) == freq)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/* Collects the channels on which any Wi-Fi device currently sees an AP
+ * that one of the profiles already connected to. */
+static gboolean
+_scan_plan_known (NMDeviceWifi *self, GArray *supported, GArray *out_freqs)
+{
+	NMDeviceWifi *peer;
+	NMWifiAP *ap;
+
+	c_list_for_each_entry (peer, &_scan_devices_lst_head, _priv.scan_devices_lst) {
+		c_list_for_each_entry (ap, &peer->_priv.aps_lst_head, aps_lst) {
+			const char *bssid = nm_wifi_ap_get_address (ap);
+			guint32 freq = nm_wifi_ap_get_freq (ap);
+
+			if (   !bssid
+			    || !freq
+			    || !_scan_freqs_contains (supported, freq)
+			    || _scan_freqs_contains (out_freqs, freq))
+				continue;
+			if (nm_settings_connection_find_by_seen_bssid (bssid))
+				g_array_append_val (out_freqs, freq);
+		}
+	}
+	return out_freqs->len > 0;
+}
+
+/* Returns the channels for the next periodic scan, or %NULL to scan all
+ * of them. As long as the scan interval is short, every other scan is a
+ * partial one that only covers the channels where known networks were
+ * seen.
+ *
+ * The channels are not split among several idle radios: each device only
+ * considers its own scan results, so a network on a channel scanned by
+ * another radio would not be found by this one. */
+static GArray *
+_scan_plan (NMDeviceWifi *self)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	gs_unref_array GArray *freqs = NULL;
+	GArray *supported;
+
+	if (   priv->scan_last_partial
+	    || priv->scan_interval > SCAN_PARTIAL_INTERVAL_MAX
+	    || !_scan_is_idle (self)
+	    || !(supported = _scan_get_freqs (self))) {
+		priv->scan_last_partial = FALSE;
+		return NULL;
+	}
+
+	freqs = g_array_new (FALSE, FALSE, sizeof (guint32));
+	if (!_scan_plan_known (self, supported, freqs)) {
+		priv->scan_last_partial = FALSE;
+		return NULL;
+	}
+
+	_LOGD (LOGD_WIFI, "wifi-scan: scanning %u of %u channels with known networks",
+	       freqs->len, supported->len);
+	priv->scan_last_partial = TRUE;
+	return g_steal_pointer (&freqs);
+}
+
 static void
 request_wireless_scan (NMDeviceWifi *self,
                        gboolean periodic,
@@ -1345,8 +1696,22 @@ request_wireless_scan (NMDeviceWifi *self,
 		return;
 	}
 
+	if (   periodic
+	    && !priv->scan_staggered
+	    && _scan_peer_is_scanning (self)) {
+		/* Don't let several radios scan at the same time, but only wait once. */
+		_LOGD (LOGD_WIFI, "wifi-scan: another device is scanning, delaying periodic scan");
+		priv->scan_staggered = TRUE;
+		priv->pending_scan_id = g_timeout_add (SCAN_STAGGER_MSEC,
+		                                       request_wireless_scan_periodic,
+		                                       self);
+		return;
+	}
+	priv->scan_staggered = FALSE;
+
 	if (!check_scanning_prohibited (self, periodic)) {
 		gs_unref_ptrarray GPtrArray *hidden_ssids = NULL;
+		gs_unref_array GArray *freqs = NULL;
 
 		_LOGD (LOGD_WIFI, "wifi-scan: scanning requested");
 
@@ -1380,11 +1745,16 @@ request_wireless_scan (NMDeviceWifi *self,
 				_LOGD (LOGD_WIFI, "wifi-scan: no SSIDs to probe scan");
 		}
 
+		if (periodic)
+			freqs = _scan_plan (self);
+
 		_hw_addr_set_scanning (self, FALSE);
 
 		nm_supplicant_interface_request_scan (priv->sup_iface,
 		                                      ssids ? (GBytes *const*) ssids->pdata : NULL,
-		                                      ssids ? ssids->len : 0u);
+		                                      ssids ? ssids->len : 0u,
+		                                      freqs ? (const guint32 *) freqs->data : NULL,
+		                                      freqs ? freqs->len : 0u);
 		request_started = TRUE;
 	} else
 		_LOGD (LOGD_WIFI, "wifi-scan: scanning requested but not allowed at this time");
@@ -1462,6 +1832,8 @@ supplicant_iface_scan_done_cb (NMSupplicantInterface *iface,
 
 	_LOGD (LOGD_WIFI, "wifi-scan: scan-done callback: %s", success ? "successful" : "failed");
 
+	_ap_batch_flush (self);
+
 	priv->last_scan = nm_utils_get_monotonic_timestamp_ms ();
 	_notify (self, PROP_LAST_SCAN);
 	schedule_scan (self, success);
@@ -1511,8 +1883,8 @@ try_fill_ssid_for_hidden_ap (NMDeviceWifi *self,
                              NMWifiAP *ap)
 {
 	const char *bssid;
-	NMSettingsConnection *const*connections;
-	guint i;
+	NMSettingsConnection *sett_conn;
+	NMSettingWireless *s_wifi;
 
 	g_return_if_fail (nm_wifi_ap_get_ssid (ap) == NULL);
 
@@ -1521,19 +1893,12 @@ try_fill_ssid_for_hidden_ap (NMDeviceWifi *self,
 
 	/* Look for this AP's BSSID in the seen-bssids list of a connection,
 	 * and if a match is found, copy over the SSID */
-	connections = nm_settings_get_connections (nm_device_get_settings ((NMDevice *) self), NULL);
-	for (i = 0; connections[i]; i++) {
-		NMSettingsConnection *sett_conn = connections[i];
-		NMSettingWireless *s_wifi;
+	sett_conn = nm_settings_connection_find_by_seen_bssid (bssid);
+	if (!sett_conn)
+		return;
 
-		s_wifi = nm_connection_get_setting_wireless (nm_settings_connection_get_connection (sett_conn));
-		if (s_wifi) {
-			if (nm_settings_connection_has_seen_bssid (sett_conn, bssid)) {
-				nm_wifi_ap_set_ssid (ap, nm_setting_wireless_get_ssid (s_wifi));
-				break;
-			}
-		}
-	}
+	s_wifi = nm_connection_get_setting_wireless (nm_settings_connection_get_connection (sett_conn));
+	nm_wifi_ap_set_ssid (ap, nm_setting_wireless_get_ssid (s_wifi));
 }
 
 static void
@@ -1558,10 +1923,26 @@ supplicant_iface_bss_updated_cb (NMSupplicantInterface *iface,
 	if (NM_DEVICE_WIFI_GET_PRIVATE (self)->mode == NM_802_11_MODE_AP)
 		return;
 
-	found_ap = nm_wifi_aps_find_by_supplicant_path (&priv->aps_lst_head, object_path);
+	_ap_batch_start (self);
+
+	found_ap = nm_wifi_ap_index_find_by_supplicant_path (priv->aps_idx, object_path);
+	if (!found_ap) {
+		/* take over an AP that so far was only known from the kernel's
+		 * scan results. */
+		found_ap = nm_wifi_ap_index_find_by_properties (priv->aps_idx, properties);
+		if (   found_ap
+		    && (   nm_wifi_ap_get_supplicant_path (found_ap)
+		        || nm_wifi_ap_get_fake (found_ap)))
+			found_ap = NULL;
+	}
 	if (found_ap) {
+		_ap_batch_freeze (self, found_ap);
 		if (!nm_wifi_ap_update_from_properties (found_ap, object_path, properties))
 			return;
+		/* a BSS that hides its SSID clears the one filled in before. */
+		if (!nm_wifi_ap_get_ssid (found_ap))
+			try_fill_ssid_for_hidden_ap (self, found_ap);
+		priv->ap_batch.n_signals_unbatched++;
 		_ap_dump (self, LOGL_DEBUG, found_ap, "updated", 0);
 	} else {
 		gs_unref_object NMWifiAP *ap = NULL;
@@ -1618,7 +1999,7 @@ supplicant_iface_bss_removed_cb (NMSupplicantInterface *iface,
 	g_return_if_fail (object_path != NULL);
 
 	priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
-	ap = nm_wifi_aps_find_by_supplicant_path (&priv->aps_lst_head, object_path);
+	ap = nm_wifi_ap_index_find_by_supplicant_path (priv->aps_idx, object_path);
 	if (!ap)
 		return;
 
@@ -1631,6 +2012,7 @@ supplicant_iface_bss_removed_cb (NMSupplicantInterface *iface,
 		if (nm_wifi_ap_set_fake (ap, TRUE))
 			_ap_dump (self, LOGL_DEBUG, ap, "updated", 0);
 	} else {
+		_ap_batch_start (self);
 		ap_add_remove (self, FALSE, ap, TRUE);
 		schedule_ap_list_dump (self);
 	}
@@ -2155,6 +2537,79 @@ supplicant_iface_assoc_cb (NMSupplicantInterface *iface,
 	}
 }
 
+/* Populate the AP list from the scan results of the kernel, without waiting
+ * for wpa_supplicant to announce and describe each BSS. Such APs have no
+ * supplicant path until the supplicant reports the same BSS, which then
+ * takes over the AP. Called when nl80211 announces new scan results. */
+static void
+update_aps_from_kernel (NMDeviceWifi *self)
+{
+	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
+	NMDevice *device = NM_DEVICE (self);
+	gs_unref_ptrarray GPtrArray *results = NULL;
+	gs_unref_hashtable GHashTable *seen = NULL;
+	NMWifiAP *ap, *ap_safe;
+	guint i;
+
+	if (   nm_device_get_state (device) <= NM_DEVICE_STATE_UNAVAILABLE
+	    || priv->mode == NM_802_11_MODE_AP)
+		return;
+
+	if (!nm_config_data_get_device_config_boolean (NM_CONFIG_GET_DATA,
+	                                               NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_NL80211_SCAN_RESULTS,
+	                                               device,
+	                                               FALSE, FALSE))
+		return;
+
+	results = nm_platform_wifi_get_scan_results (nm_device_get_platform (device),
+	                                             nm_device_get_ifindex (device));
+	if (!results)
+		return;
+
+	_ap_batch_start (self);
+
+	seen = g_hash_table_new (nm_direct_hash, NULL);
+	for (i = 0; i < results->len; i++) {
+		GVariant *properties = results->pdata[i];
+
+		ap = nm_wifi_ap_index_find_by_properties (priv->aps_idx, properties);
+		if (ap) {
+			g_hash_table_add (seen, ap);
+			if (   nm_wifi_ap_get_supplicant_path (ap)
+			    || nm_wifi_ap_get_fake (ap))
+				continue;
+			_ap_batch_freeze (self, ap);
+			if (nm_wifi_ap_update_from_properties (ap, NULL, properties)) {
+				if (!nm_wifi_ap_get_ssid (ap))
+					try_fill_ssid_for_hidden_ap (self, ap);
+				priv->ap_batch.n_signals_unbatched++;
+			}
+			continue;
+		}
+
+		ap = nm_wifi_ap_new_from_properties (NULL, properties);
+		if (!ap)
+			continue;
+		if (!nm_wifi_ap_get_ssid (ap))
+			try_fill_ssid_for_hidden_ap (self, ap);
+		ap_add_remove (self, TRUE, ap, TRUE);
+		g_hash_table_add (seen, ap);
+		g_object_unref (ap);
+	}
+
+	/* the kernel dropped these from its scan results. */
+	c_list_for_each_entry_safe (ap, ap_safe, &priv->aps_lst_head, aps_lst) {
+		if (   ap == priv->current_ap
+		    || nm_wifi_ap_get_supplicant_path (ap)
+		    || nm_wifi_ap_get_fake (ap)
+		    || g_hash_table_contains (seen, ap))
+			continue;
+		ap_add_remove (self, FALSE, ap, TRUE);
+	}
+
+	schedule_ap_list_dump (self);
+}
+
 static void
 supplicant_iface_notify_scanning_cb (NMSupplicantInterface *iface,
                                      GParamSpec *pspec,
@@ -2179,7 +2634,7 @@ supplicant_iface_notify_current_bss (NMSupplicantInterface *iface,
 
 	current_bss = nm_supplicant_interface_get_current_bss (iface);
 	if (current_bss)
-		new_ap = nm_wifi_aps_find_by_supplicant_path (&priv->aps_lst_head, current_bss);
+		new_ap = nm_wifi_ap_index_find_by_supplicant_path (priv->aps_idx, current_bss);
 
 	if (new_ap != priv->current_ap) {
 		const char *new_bssid = NULL;
@@ -2592,7 +3047,7 @@ act_stage1_prepare (NMDevice *device, NMDeviceStateReason *out_failure_reason)
 		if (ap)
 			goto done;
 
-		ap = nm_wifi_aps_find_first_compatible (&priv->aps_lst_head, connection);
+		ap = nm_wifi_ap_index_find_first_compatible (priv->aps_idx, connection);
 	}
 
 	if (ap) {
@@ -3274,6 +3729,8 @@ nm_device_wifi_init (NMDeviceWifi *self)
 	NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE (self);
 
 	c_list_init (&priv->aps_lst_head);
+	priv->aps_idx = nm_wifi_ap_index_new ();
+	c_list_link_tail (&_scan_devices_lst_head, &priv->scan_devices_lst);
 
 	priv->hidden_probe_scan_warn = TRUE;
 	priv->mode = NM_802_11_MODE_INFRA;
@@ -3325,6 +3782,9 @@ dispose (GObject *object)
 	g_clear_object (&priv->sup_mgr);
 
 	remove_all_aps (self);
+	_ap_batch_flush (self);
+
+	c_list_unlink (&priv->scan_devices_lst);
 
 	G_OBJECT_CLASS (nm_device_wifi_parent_class)->dispose (object);
 }
@@ -3337,6 +3797,9 @@ finalize (GObject *object)
 
 	nm_assert (c_list_is_empty (&priv->aps_lst_head));
 
+	nm_wifi_ap_index_free (priv->aps_idx);
+	nm_clear_pointer (&priv->scan_freqs, g_array_unref);
+
 	G_OBJECT_CLASS (nm_device_wifi_parent_class)->finalize (object);
 }
 
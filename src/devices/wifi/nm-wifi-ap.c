@@ -54,9 +54,16 @@ NM_GOBJECT_PROPERTIES_DEFINE (NMWifiAP,
 	PROP_LAST_SEEN,
 );
 
+typedef struct _ApIndexBucket ApIndexBucket;
+
 struct _NMWifiAPPrivate {
 	char *supplicant_path;   /* D-Bus object path of this AP from wpa_supplicant */
 
+	/* The NMWifiAPIndex tracking this AP, and the buckets it is linked in. */
+	NMWifiAPIndex      *index;
+	ApIndexBucket      *index_bssid_bucket;
+	ApIndexBucket      *index_ssid_bucket;
+
 	/* Scanned or cached values */
 	GBytes *           ssid;
 	char *             address;
@@ -87,6 +94,10 @@ G_DEFINE_TYPE (NMWifiAP, nm_wifi_ap, NM_TYPE_DBUS_OBJECT)
 
 /*****************************************************************************/
 
+static void _index_update (NMWifiAP *ap);
+
+/*****************************************************************************/
+
 const char *
 nm_wifi_ap_get_supplicant_path (NMWifiAP *ap)
 {
@@ -124,6 +135,7 @@ nm_wifi_ap_set_ssid_arr (NMWifiAP *ap,
 	if (ssid_len > 0)
 		priv->ssid = g_bytes_new (ssid, ssid_len);
 
+	_index_update (ap);
 	_notify (ap, PROP_SSID);
 	return TRUE;
 }
@@ -155,6 +167,7 @@ nm_wifi_ap_set_ssid (NMWifiAP *ap, GBytes *ssid)
 	if (ssid)
 		priv->ssid = g_bytes_ref (ssid);
 
+	_index_update (ap);
 	_notify (ap, PROP_SSID);
 	return TRUE;
 }
@@ -227,6 +240,7 @@ nm_wifi_ap_set_address_bin (NMWifiAP *ap, const guint8 *addr /* ETH_ALEN bytes *
 	    || !nm_utils_hwaddr_matches (addr, ETH_ALEN, priv->address, -1)) {
 		g_free (priv->address);
 		priv->address = nm_utils_hwaddr_ntoa (addr, ETH_ALEN);
+		_index_update (ap);
 		_notify (ap, PROP_HW_ADDRESS);
 		return TRUE;
 	}
@@ -770,6 +784,57 @@ get_max_rate (const guint8 *bytes, gsize len)
 
 /*****************************************************************************/
 
+static gboolean
+_props_get_ssid (GVariant *properties, const guint8 **out_ssid, gsize *out_len)
+{
+	gs_unref_variant GVariant *v = NULL;
+	const guint8 *bytes;
+	gsize len;
+
+	v = g_variant_lookup_value (properties, "SSID", G_VARIANT_TYPE_BYTESTRING);
+	if (!v)
+		return FALSE;
+
+	bytes = g_variant_get_fixed_array (v, &len, 1);
+	len = MIN (32, len);
+
+	/* Stupid ieee80211 layer uses <hidden> */
+	if (   bytes
+	    && len
+	    && !(   NM_IN_SET (len, 8, 9)
+	         && memcmp (bytes, "<hidden>", len) == 0)
+	    && !nm_utils_is_empty_ssid (bytes, len)) {
+		/* good */
+	} else
+		len = 0;
+
+	/* the data stays valid while @properties is alive */
+	*out_ssid = bytes;
+	*out_len = len;
+	return TRUE;
+}
+
+static gboolean
+_props_get_bssid (GVariant *properties, guint8 *out_bssid /* ETH_ALEN bytes */)
+{
+	gs_unref_variant GVariant *v = NULL;
+	const guint8 *bytes;
+	gsize len;
+
+	v = g_variant_lookup_value (properties, "BSSID", G_VARIANT_TYPE_BYTESTRING);
+	if (!v)
+		return FALSE;
+
+	bytes = g_variant_get_fixed_array (v, &len, 1);
+	if (   len != ETH_ALEN
+	    || memcmp (bytes, nm_ip_addr_zero.addr_eth, ETH_ALEN) == 0
+	    || memcmp (bytes, (char[ETH_ALEN]) { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }, ETH_ALEN) == 0)
+		return FALSE;
+
+	memcpy (out_bssid, bytes, ETH_ALEN);
+	return TRUE;
+}
+
 gboolean
 nm_wifi_ap_update_from_properties (NMWifiAP *ap,
                                    const char *supplicant_path,
@@ -786,6 +851,7 @@ nm_wifi_ap_update_from_properties (NMWifiAP *ap,
 	guint16 u16;
 	gboolean changed = FALSE;
 	guint32 max_rate;
+	guint8 bssid[ETH_ALEN];
 
 	g_return_val_if_fail (NM_IS_WIFI_AP (ap), FALSE);
 	g_return_val_if_fail (properties, FALSE);
@@ -822,35 +888,11 @@ nm_wifi_ap_update_from_properties (NMWifiAP *ap,
 	if (g_variant_lookup (properties, "Frequency", "q", &u16))
 		changed |= nm_wifi_ap_set_freq (ap, u16);
 
-	v = g_variant_lookup_value (properties, "SSID", G_VARIANT_TYPE_BYTESTRING);
-	if (v) {
-		bytes = g_variant_get_fixed_array (v, &len, 1);
-		len = MIN (32, len);
-
-		/* Stupid ieee80211 layer uses <hidden> */
-		if (   bytes
-		    && len
-		    && !(   NM_IN_SET (len, 8, 9)
-		         && memcmp (bytes, "<hidden>", len) == 0)
-		    && !nm_utils_is_empty_ssid (bytes, len)) {
-			/* good */
-		} else
-			len = 0;
-
+	if (_props_get_ssid (properties, &bytes, &len))
 		changed |= nm_wifi_ap_set_ssid_arr (ap, bytes, len);
 
-		g_variant_unref (v);
-	}
-
-	v = g_variant_lookup_value (properties, "BSSID", G_VARIANT_TYPE_BYTESTRING);
-	if (v) {
-		bytes = g_variant_get_fixed_array (v, &len, 1);
-		if (   len == ETH_ALEN
-		    && memcmp (bytes, nm_ip_addr_zero.addr_eth, ETH_ALEN) != 0
-		    && memcmp (bytes, (char[ETH_ALEN]) { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF }, ETH_ALEN) != 0)
-			changed |= nm_wifi_ap_set_address_bin (ap, bytes);
-		g_variant_unref (v);
-	}
+	if (_props_get_bssid (properties, bssid))
+		changed |= nm_wifi_ap_set_address_bin (ap, bssid);
 
 	max_rate = 0;
 	v = g_variant_lookup_value (properties, "Rates", G_VARIANT_TYPE ("au"));
@@ -882,8 +924,10 @@ nm_wifi_ap_update_from_properties (NMWifiAP *ap,
 		g_variant_unref (v);
 	}
 
-	if (!priv->supplicant_path) {
+	if (   supplicant_path
+	    && !priv->supplicant_path) {
 		priv->supplicant_path = g_strdup (supplicant_path);
+		_index_update (ap);
 		changed = TRUE;
 	}
 
@@ -1184,6 +1228,8 @@ nm_wifi_ap_init (NMWifiAP *self)
 	self->_priv = priv;
 
 	c_list_init (&self->aps_lst);
+	c_list_init (&self->index_bssid_lst);
+	c_list_init (&self->index_ssid_lst);
 
 	priv->mode = NM_802_11_MODE_INFRA;
 	priv->flags = NM_802_11_AP_FLAGS_NONE;
@@ -1192,12 +1238,20 @@ nm_wifi_ap_init (NMWifiAP *self)
 	priv->last_seen = -1;
 }
 
+/**
+ * nm_wifi_ap_new_from_properties:
+ * @supplicant_path: the D-Bus path of the BSS in wpa_supplicant, or %NULL
+ *   for BSSs that were obtained from the kernel directly.
+ * @properties: the properties of the BSS
+ *
+ * Returns: (transfer full): the new AP or %NULL if @properties don't
+ *   describe a valid BSS.
+ */
 NMWifiAP *
 nm_wifi_ap_new_from_properties (const char *supplicant_path, GVariant *properties)
 {
 	NMWifiAP *ap;
 
-	g_return_val_if_fail (supplicant_path != NULL, NULL);
 	g_return_val_if_fail (properties != NULL, NULL);
 
 	ap = (NMWifiAP *) g_object_new (NM_TYPE_WIFI_AP, NULL);
@@ -1345,6 +1399,7 @@ finalize (GObject *object)
 
 	nm_assert (!self->wifi_device);
 	nm_assert (c_list_is_empty (&self->aps_lst));
+	nm_assert (!priv->index);
 
 	g_free (priv->supplicant_path);
 	if (priv->ssid)
@@ -1527,6 +1582,314 @@ nm_wifi_aps_find_by_supplicant_path (const CList *aps_lst_head, const char *path
 
 /*****************************************************************************/
 
+/* NMWifiAPIndex tracks APs by supplicant path, BSSID and SSID, so that
+ * looking them up while processing scan results doesn't have to walk
+ * the list of all APs for each BSS. APs keep their index up to date
+ * themselves whenever one of these keys changes. */
+
+struct _ApIndexBucket {
+	CList lst_head;
+	GBytes *ssid;
+	guint8 bssid[ETH_ALEN];
+};
+
+struct _NMWifiAPIndex {
+	GHashTable *by_supplicant_path;
+	GHashTable *by_bssid;
+	GHashTable *by_ssid;
+
+	/* APs without SSID are not in @by_ssid, but linked here. */
+	CList hidden_lst_head;
+};
+
+static guint
+_bucket_bssid_hash (gconstpointer ptr)
+{
+	const ApIndexBucket *bucket = ptr;
+	NMHashState h;
+
+	nm_hash_init (&h, 1771040887u);
+	nm_hash_update (&h, bucket->bssid, ETH_ALEN);
+	return nm_hash_complete (&h);
+}
+
+static gboolean
+_bucket_bssid_equal (gconstpointer a, gconstpointer b)
+{
+	return memcmp (((const ApIndexBucket *) a)->bssid,
+	               ((const ApIndexBucket *) b)->bssid,
+	               ETH_ALEN) == 0;
+}
+
+static guint
+_bucket_ssid_hash (gconstpointer ptr)
+{
+	return g_bytes_hash (((const ApIndexBucket *) ptr)->ssid);
+}
+
+static gboolean
+_bucket_ssid_equal (gconstpointer a, gconstpointer b)
+{
+	return g_bytes_equal (((const ApIndexBucket *) a)->ssid,
+	                      ((const ApIndexBucket *) b)->ssid);
+}
+
+static void
+_bucket_free (gpointer ptr)
+{
+	ApIndexBucket *bucket = ptr;
+
+	nm_assert (c_list_is_empty (&bucket->lst_head));
+
+	if (bucket->ssid)
+		g_bytes_unref (bucket->ssid);
+	g_slice_free (ApIndexBucket, bucket);
+}
+
+static ApIndexBucket *
+_bucket_ensure (GHashTable *table, const ApIndexBucket *needle)
+{
+	ApIndexBucket *bucket;
+
+	bucket = g_hash_table_lookup (table, needle);
+	if (!bucket) {
+		bucket = g_slice_new0 (ApIndexBucket);
+		c_list_init (&bucket->lst_head);
+		memcpy (bucket->bssid, needle->bssid, ETH_ALEN);
+		if (needle->ssid)
+			bucket->ssid = g_bytes_ref (needle->ssid);
+		g_hash_table_add (table, bucket);
+	}
+	return bucket;
+}
+
+static void
+_bucket_unlink (GHashTable *table, ApIndexBucket **p_bucket, CList *lst)
+{
+	ApIndexBucket *bucket = *p_bucket;
+
+	c_list_unlink (lst);
+	if (!bucket)
+		return;
+	*p_bucket = NULL;
+	if (c_list_is_empty (&bucket->lst_head))
+		g_hash_table_remove (table, bucket);
+}
+
+static void
+_index_unlink (NMWifiAP *ap)
+{
+	NMWifiAPPrivate *priv = NM_WIFI_AP_GET_PRIVATE (ap);
+	NMWifiAPIndex *index = priv->index;
+
+	if (   priv->supplicant_path
+	    && g_hash_table_lookup (index->by_supplicant_path, priv->supplicant_path) == ap)
+		g_hash_table_remove (index->by_supplicant_path, priv->supplicant_path);
+
+	_bucket_unlink (index->by_bssid, &priv->index_bssid_bucket, &ap->index_bssid_lst);
+	_bucket_unlink (index->by_ssid, &priv->index_ssid_bucket, &ap->index_ssid_lst);
+}
+
+static void
+_index_link (NMWifiAP *ap)
+{
+	NMWifiAPPrivate *priv = NM_WIFI_AP_GET_PRIVATE (ap);
+	NMWifiAPIndex *index = priv->index;
+	ApIndexBucket needle = { };
+
+	if (priv->supplicant_path)
+		g_hash_table_replace (index->by_supplicant_path, priv->supplicant_path, ap);
+
+	if (   priv->address
+	    && nm_utils_hwaddr_aton (priv->address, needle.bssid, ETH_ALEN)) {
+		priv->index_bssid_bucket = _bucket_ensure (index->by_bssid, &needle);
+		c_list_link_tail (&priv->index_bssid_bucket->lst_head, &ap->index_bssid_lst);
+	}
+
+	if (priv->ssid) {
+		needle.ssid = priv->ssid;
+		priv->index_ssid_bucket = _bucket_ensure (index->by_ssid, &needle);
+		c_list_link_tail (&priv->index_ssid_bucket->lst_head, &ap->index_ssid_lst);
+	} else
+		c_list_link_tail (&index->hidden_lst_head, &ap->index_ssid_lst);
+}
+
+static void
+_index_update (NMWifiAP *ap)
+{
+	if (!NM_WIFI_AP_GET_PRIVATE (ap)->index)
+		return;
+
+	_index_unlink (ap);
+	_index_link (ap);
+}
+
+NMWifiAPIndex *
+nm_wifi_ap_index_new (void)
+{
+	NMWifiAPIndex *index;
+
+	index = g_slice_new (NMWifiAPIndex);
+	index->by_supplicant_path = g_hash_table_new (nm_str_hash, g_str_equal);
+	index->by_bssid = g_hash_table_new_full (_bucket_bssid_hash, _bucket_bssid_equal, NULL, _bucket_free);
+	index->by_ssid = g_hash_table_new_full (_bucket_ssid_hash, _bucket_ssid_equal, NULL, _bucket_free);
+	c_list_init (&index->hidden_lst_head);
+	return index;
+}
+
+void
+nm_wifi_ap_index_free (NMWifiAPIndex *index)
+{
+	if (!index)
+		return;
+
+	nm_assert (g_hash_table_size (index->by_supplicant_path) == 0);
+	nm_assert (g_hash_table_size (index->by_bssid) == 0);
+	nm_assert (g_hash_table_size (index->by_ssid) == 0);
+	nm_assert (c_list_is_empty (&index->hidden_lst_head));
+
+	g_hash_table_unref (index->by_supplicant_path);
+	g_hash_table_unref (index->by_bssid);
+	g_hash_table_unref (index->by_ssid);
+	g_slice_free (NMWifiAPIndex, index);
+}
+
+void
+nm_wifi_ap_index_add (NMWifiAPIndex *index, NMWifiAP *ap)
+{
+	NMWifiAPPrivate *priv;
+
+	g_return_if_fail (index);
+	g_return_if_fail (NM_IS_WIFI_AP (ap));
+
+	priv = NM_WIFI_AP_GET_PRIVATE (ap);
+	g_return_if_fail (!priv->index);
+
+	priv->index = index;
+	_index_link (ap);
+}
+
+void
+nm_wifi_ap_index_remove (NMWifiAPIndex *index, NMWifiAP *ap)
+{
+	NMWifiAPPrivate *priv;
+
+	g_return_if_fail (index);
+	g_return_if_fail (NM_IS_WIFI_AP (ap));
+
+	priv = NM_WIFI_AP_GET_PRIVATE (ap);
+	g_return_if_fail (priv->index == index);
+
+	_index_unlink (ap);
+	priv->index = NULL;
+}
+
+NMWifiAP *
+nm_wifi_ap_index_find_by_supplicant_path (const NMWifiAPIndex *index, const char *path)
+{
+	g_return_val_if_fail (index, NULL);
+	g_return_val_if_fail (path, NULL);
+
+	return g_hash_table_lookup (index->by_supplicant_path, path);
+}
+
+/**
+ * nm_wifi_ap_index_find_by_properties:
+ * @index: the index
+ * @properties: the BSS properties, as for nm_wifi_ap_update_from_properties()
+ *
+ * Returns: (transfer none): an AP with the same BSSID and SSID as the BSS
+ *   described by @properties, or %NULL. If the BSS hides its SSID, an AP
+ *   with the same BSSID matches too, as its SSID might have been filled
+ *   in from the seen BSSIDs of a connection.
+ */
+NMWifiAP *
+nm_wifi_ap_index_find_by_properties (const NMWifiAPIndex *index,
+                                     GVariant *properties)
+{
+	ApIndexBucket needle = { };
+	ApIndexBucket *bucket;
+	const guint8 *ssid = NULL;
+	gsize ssid_len = 0;
+	NMWifiAP *ap;
+	NMWifiAP *found = NULL;
+
+	g_return_val_if_fail (index, NULL);
+	g_return_val_if_fail (properties, NULL);
+
+	if (!_props_get_bssid (properties, needle.bssid))
+		return NULL;
+
+	bucket = g_hash_table_lookup (index->by_bssid, &needle);
+	if (!bucket)
+		return NULL;
+
+	_props_get_ssid (properties, &ssid, &ssid_len);
+
+	c_list_for_each_entry (ap, &bucket->lst_head, index_bssid_lst) {
+		if (nm_utils_gbytes_equal_mem (NM_WIFI_AP_GET_PRIVATE (ap)->ssid, ssid, ssid_len))
+			return ap;
+		if (   ssid_len == 0
+		    && !found)
+			found = ap;
+	}
+	return found;
+}
+
+NMWifiAP *
+nm_wifi_ap_index_find_first_compatible (const NMWifiAPIndex *index,
+                                        NMConnection *connection)
+{
+	NMSettingWireless *s_wifi;
+	ApIndexBucket needle = { };
+	ApIndexBucket *bucket;
+	const char *bssid;
+	NMWifiAP *ap;
+
+	g_return_val_if_fail (index, NULL);
+	g_return_val_if_fail (connection, NULL);
+
+	s_wifi = nm_connection_get_setting_wireless (connection);
+	if (!s_wifi)
+		return NULL;
+
+	/* Only APs matching the connection's BSSID (if any) and SSID can be
+	 * compatible, so only look at the smallest candidate set. */
+	bssid = nm_setting_wireless_get_bssid (s_wifi);
+	if (bssid) {
+		if (!nm_utils_hwaddr_aton (bssid, needle.bssid, ETH_ALEN))
+			return NULL;
+		bucket = g_hash_table_lookup (index->by_bssid, &needle);
+		if (!bucket)
+			return NULL;
+		c_list_for_each_entry (ap, &bucket->lst_head, index_bssid_lst) {
+			if (nm_wifi_ap_check_compatible (ap, connection))
+				return ap;
+		}
+		return NULL;
+	}
+
+	needle.ssid = nm_setting_wireless_get_ssid (s_wifi);
+	if (needle.ssid) {
+		bucket = g_hash_table_lookup (index->by_ssid, &needle);
+		if (!bucket)
+			return NULL;
+		c_list_for_each_entry (ap, &bucket->lst_head, index_ssid_lst) {
+			if (nm_wifi_ap_check_compatible (ap, connection))
+				return ap;
+		}
+		return NULL;
+	}
+
+	c_list_for_each_entry (ap, &index->hidden_lst_head, index_ssid_lst) {
+		if (nm_wifi_ap_check_compatible (ap, connection))
+			return ap;
+	}
+	return NULL;
+}
+
+/*****************************************************************************/
+
 NMWifiAP *
 nm_wifi_ap_lookup_for_device (NMDevice *device, const char *exported_path)
 {
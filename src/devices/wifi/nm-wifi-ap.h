@@ -48,6 +48,8 @@ typedef struct {
 	NMDBusObject parent;
 	NMDevice *wifi_device;
 	CList aps_lst;
+	CList index_bssid_lst;
+	CList index_ssid_lst;
 	struct _NMWifiAPPrivate *_priv;
 } NMWifiAP;
 
@@ -110,6 +112,21 @@ NMWifiAP         *nm_wifi_aps_find_first_compatible (const CList *aps_lst_head,
 
 NMWifiAP         *nm_wifi_aps_find_by_supplicant_path (const CList *aps_lst_head, const char *path);
 
+typedef struct _NMWifiAPIndex NMWifiAPIndex;
+
+NMWifiAPIndex    *nm_wifi_ap_index_new (void);
+void              nm_wifi_ap_index_free (NMWifiAPIndex *index);
+
+void              nm_wifi_ap_index_add (NMWifiAPIndex *index, NMWifiAP *ap);
+void              nm_wifi_ap_index_remove (NMWifiAPIndex *index, NMWifiAP *ap);
+
+NMWifiAP         *nm_wifi_ap_index_find_by_supplicant_path (const NMWifiAPIndex *index,
+                                                            const char *path);
+NMWifiAP         *nm_wifi_ap_index_find_by_properties (const NMWifiAPIndex *index,
+                                                       GVariant *properties);
+NMWifiAP         *nm_wifi_ap_index_find_first_compatible (const NMWifiAPIndex *index,
+                                                          NMConnection *connection);
+
 NMWifiAP         *nm_wifi_ap_lookup_for_device (NMDevice *device, const char *exported_path);
 
 #endif /* __NM_WIFI_AP_H__ */
@@ -21,8 +21,11 @@
 #include "nm-default.h"
 
 #include <string.h>
+#include <linux/nl80211.h>
 
 #include "devices/wifi/nm-wifi-utils.h"
+#include "devices/wifi/nm-wifi-ap.h"
+#include "platform/wifi/nm-wifi-utils-nl80211.h"
 
 #include "nm-core-internal.h"
 
@@ -1354,6 +1357,374 @@ test_strength_all (void)
 
 /*****************************************************************************/
 
+static GVariant *
+_bss_properties (guint idx, gboolean hidden, guint round)
+{
+	GVariantBuilder builder;
+	guint8 bssid[ETH_ALEN] = { 0x02, 0x00, 0x00, 0x00, (idx >> 8) & 0xFF, idx & 0xFF };
+	char ssid[32];
+	gsize ssid_len = 0;
+
+	if (!hidden)
+		ssid_len = g_snprintf (ssid, sizeof (ssid), "net-%u", idx % 40);
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+	g_variant_builder_add (&builder, "{sv}", "BSSID",
+	                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE, bssid, ETH_ALEN, 1));
+	g_variant_builder_add (&builder, "{sv}", "SSID",
+	                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE, ssid, ssid_len, 1));
+	g_variant_builder_add (&builder, "{sv}", "Mode", g_variant_new_string ("infrastructure"));
+	g_variant_builder_add (&builder, "{sv}", "Signal", g_variant_new_int16 (-50 - (idx % 40)));
+	g_variant_builder_add (&builder, "{sv}", "Frequency", g_variant_new_uint16 (2412 + 5 * ((idx + round) % 13)));
+	return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+static NMConnection *
+_wifi_connection_new (const char *ssid, const char *bssid)
+{
+	NMConnection *connection;
+	NMSettingWireless *s_wifi;
+	gs_unref_bytes GBytes *ssid_bytes = g_bytes_new (ssid, strlen (ssid));
+
+	connection = nm_simple_connection_new ();
+	s_wifi = (NMSettingWireless *) nm_setting_wireless_new ();
+	g_object_set (s_wifi,
+	              NM_SETTING_WIRELESS_SSID, ssid_bytes,
+	              NM_SETTING_WIRELESS_BSSID, bssid,
+	              NULL);
+	nm_connection_add_setting (connection, NM_SETTING (s_wifi));
+	return connection;
+}
+
+static void
+_ap_index_assert_bss (const NMWifiAPIndex *index, guint idx, NMWifiAP *expected)
+{
+	gs_free char *path = g_strdup_printf ("/fi/w1/wpa_supplicant1/Interfaces/0/BSSs/%u", idx);
+	gs_unref_variant GVariant *props = _bss_properties (idx, idx % 100 == 0, 1);
+
+	g_assert (nm_wifi_ap_index_find_by_supplicant_path (index, path) == expected);
+	g_assert (nm_wifi_ap_index_find_by_properties (index, props) == expected);
+}
+
+static void
+test_ap_index (void)
+{
+	const guint n_bss = 2000;
+	NMWifiAPIndex *index;
+	gs_unref_ptrarray GPtrArray *aps = g_ptr_array_new_with_free_func (g_object_unref);
+	gs_unref_object NMConnection *connection = NULL;
+	gs_unref_bytes GBytes *ssid = NULL;
+	guint round;
+	guint i;
+	NMWifiAP *ap;
+
+	index = nm_wifi_ap_index_new ();
+
+	/* Feed the BSSs like the supplicant would: first the initial scan
+	 * result with some hidden networks, then a property update for each. */
+	for (round = 0; round < 2; round++) {
+		for (i = 0; i < n_bss; i++) {
+			gs_free char *path = g_strdup_printf ("/fi/w1/wpa_supplicant1/Interfaces/0/BSSs/%u", i);
+			gs_unref_variant GVariant *props = _bss_properties (i, i % 100 == 0, round);
+
+			ap = nm_wifi_ap_index_find_by_supplicant_path (index, path);
+			if (round == 0) {
+				g_assert (!ap);
+				ap = nm_wifi_ap_new_from_properties (path, props);
+				g_assert (ap);
+				g_ptr_array_add (aps, ap);
+				nm_wifi_ap_index_add (index, ap);
+			} else {
+				g_assert (ap == aps->pdata[i]);
+				g_assert (nm_wifi_ap_update_from_properties (ap, path, props));
+			}
+		}
+	}
+	g_assert_cmpint (aps->len, ==, n_bss);
+
+	for (i = 0; i < n_bss; i++)
+		_ap_index_assert_bss (index, i, aps->pdata[i]);
+
+	connection = _wifi_connection_new ("net-7", NULL);
+	ap = nm_wifi_ap_index_find_first_compatible (index, connection);
+	g_assert (ap == aps->pdata[7]);
+	g_clear_object (&connection);
+
+	connection = _wifi_connection_new ("net-7", "02:00:00:00:03:EF");
+	ap = nm_wifi_ap_index_find_first_compatible (index, connection);
+	g_assert (ap == aps->pdata[1007]);
+	g_clear_object (&connection);
+
+	/* the hidden AP only becomes compatible once its SSID is filled in. */
+	connection = _wifi_connection_new ("net-0", "02:00:00:00:00:64");
+	g_assert (!nm_wifi_ap_index_find_first_compatible (index, connection));
+	ssid = g_bytes_new ("net-0", 5);
+	nm_wifi_ap_set_ssid (aps->pdata[100], ssid);
+	g_assert (nm_wifi_ap_index_find_first_compatible (index, connection) == aps->pdata[100]);
+	g_clear_object (&connection);
+
+	connection = _wifi_connection_new ("net-unknown", NULL);
+	g_assert (!nm_wifi_ap_index_find_first_compatible (index, connection));
+
+	/* removing some APs doesn't affect the lookup of the others. */
+	for (i = 0; i < n_bss; i += 2)
+		nm_wifi_ap_index_remove (index, aps->pdata[i]);
+	for (i = 0; i < n_bss; i++)
+		_ap_index_assert_bss (index, i, i % 2 ? aps->pdata[i] : NULL);
+	g_clear_object (&connection);
+
+	connection = _wifi_connection_new ("net-8", NULL);
+	g_assert (!nm_wifi_ap_index_find_first_compatible (index, connection));
+	g_clear_object (&connection);
+
+	connection = _wifi_connection_new ("net-7", NULL);
+	g_assert (nm_wifi_ap_index_find_first_compatible (index, connection) == aps->pdata[7]);
+
+	for (i = 1; i < n_bss; i += 2)
+		nm_wifi_ap_index_remove (index, aps->pdata[i]);
+	for (i = 0; i < n_bss; i++)
+		_ap_index_assert_bss (index, i, NULL);
+	g_assert (!nm_wifi_ap_index_find_first_compatible (index, connection));
+	nm_wifi_ap_index_free (index);
+}
+
+/*****************************************************************************/
+
+/* builds a NL80211_CMD_NEW_SCAN_RESULTS message like the kernel sends
+ * in reply to a NL80211_CMD_GET_SCAN dump. */
+static struct nl_msg *
+_mock_nl80211_scan_result (const guint8 *bssid,
+                           guint32 freq,
+                           gint32 signal_mbm,
+                           guint16 capability,
+                           const guint8 *ies,
+                           gsize ies_len)
+{
+	nm_auto_nlmsg struct nl_msg *msg = NULL;
+	struct nlattr *nest;
+
+	msg = nlmsg_alloc ();
+	g_assert (genlmsg_put (msg, 0, 0, 0, 0, 0, NL80211_CMD_NEW_SCAN_RESULTS, 0));
+	NLA_PUT_U32 (msg, NL80211_ATTR_IFINDEX, 1);
+
+	nest = nla_nest_start (msg, NL80211_ATTR_BSS);
+	g_assert (nest);
+	NLA_PUT (msg, NL80211_BSS_BSSID, ETH_ALEN, bssid);
+	NLA_PUT_U32 (msg, NL80211_BSS_FREQUENCY, freq);
+	NLA_PUT_U32 (msg, NL80211_BSS_SIGNAL_MBM, (guint32) signal_mbm);
+	NLA_PUT_U16 (msg, NL80211_BSS_CAPABILITY, capability);
+	if (ies_len)
+		NLA_PUT (msg, NL80211_BSS_INFORMATION_ELEMENTS, ies_len, ies);
+	nla_nest_end (msg, nest);
+
+	return g_steal_pointer (&msg);
+
+nla_put_failure:
+	g_assert_not_reached ();
+	return NULL;
+}
+
+static void
+test_nl80211_scan_result (void)
+{
+	const guint8 bssid1[ETH_ALEN] = { 0x02, 0x11, 0x22, 0x33, 0x44, 0x55 };
+	const guint8 bssid2[ETH_ALEN] = { 0x02, 0x11, 0x22, 0x33, 0x44, 0x66 };
+	const guint8 ies[] = {
+		/* SSID */
+		0x00, 0x08, 't', 'e', 's', 't', '-', 'n', 'e', 't',
+		/* RSN: group CCMP, pairwise CCMP, AKM PSK */
+		0x30, 0x14, 0x01, 0x00,
+		0x00, 0x0F, 0xAC, 0x04,
+		0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+		0x01, 0x00, 0x00, 0x0F, 0xAC, 0x02,
+		0x00, 0x00,
+	};
+	nm_auto_nlmsg struct nl_msg *msg1 = NULL;
+	nm_auto_nlmsg struct nl_msg *msg2 = NULL;
+	gs_unref_variant GVariant *props1 = NULL;
+	gs_unref_variant GVariant *props2 = NULL;
+	gs_unref_object NMWifiAP *ap1 = NULL;
+	gs_unref_object NMWifiAP *ap2 = NULL;
+	NMWifiAPIndex *index;
+	NM80211ApSecurityFlags rsn_flags;
+	GBytes *ssid;
+
+	msg1 = _mock_nl80211_scan_result (bssid1, 5180, -5000, 0x0011, ies, sizeof (ies));
+	props1 = nm_wifi_utils_nl80211_parse_scan_result (msg1);
+	g_assert (props1);
+
+	ap1 = nm_wifi_ap_new_from_properties (NULL, props1);
+	g_assert (ap1);
+	g_assert (!nm_wifi_ap_get_supplicant_path (ap1));
+	g_assert_cmpstr (nm_wifi_ap_get_address (ap1), ==, "02:11:22:33:44:55");
+	ssid = nm_wifi_ap_get_ssid (ap1);
+	g_assert (ssid);
+	g_assert (nm_utils_gbytes_equal_mem (ssid, "test-net", 8));
+	g_assert_cmpint (nm_wifi_ap_get_freq (ap1), ==, 5180);
+	g_assert_cmpint (nm_wifi_ap_get_mode (ap1), ==, NM_802_11_MODE_INFRA);
+	g_assert_cmpint (nm_wifi_ap_get_strength (ap1), ==, nm_wifi_utils_level_to_quality (-50));
+	g_assert (NM_FLAGS_HAS (nm_wifi_ap_get_flags (ap1), NM_802_11_AP_FLAGS_PRIVACY));
+	g_object_get (ap1, NM_WIFI_AP_RSN_FLAGS, &rsn_flags, NULL);
+	g_assert_cmpint (rsn_flags, ==,   NM_802_11_AP_SEC_KEY_MGMT_PSK
+	                                | NM_802_11_AP_SEC_PAIR_CCMP
+	                                | NM_802_11_AP_SEC_GROUP_CCMP);
+
+	/* an open IBSS, without SSID */
+	msg2 = _mock_nl80211_scan_result (bssid2, 2412, -7000, 0x0002, NULL, 0);
+	props2 = nm_wifi_utils_nl80211_parse_scan_result (msg2);
+	g_assert (props2);
+
+	ap2 = nm_wifi_ap_new_from_properties (NULL, props2);
+	g_assert (ap2);
+	g_assert (!nm_wifi_ap_get_ssid (ap2));
+	g_assert_cmpint (nm_wifi_ap_get_mode (ap2), ==, NM_802_11_MODE_ADHOC);
+	g_assert (!NM_FLAGS_HAS (nm_wifi_ap_get_flags (ap2), NM_802_11_AP_FLAGS_PRIVACY));
+
+	/* the supplicant later reports the same BSS and takes over the AP. */
+	index = nm_wifi_ap_index_new ();
+	nm_wifi_ap_index_add (index, ap1);
+	nm_wifi_ap_index_add (index, ap2);
+	g_assert (nm_wifi_ap_index_find_by_properties (index, props1) == ap1);
+	g_assert (nm_wifi_ap_index_find_by_properties (index, props2) == ap2);
+
+	/* a BSS without SSID still matches once the SSID of the AP was filled in. */
+	nm_wifi_ap_set_ssid_arr (ap2, (const guint8 *) "hidden-net", NM_STRLEN ("hidden-net"));
+	g_assert (nm_wifi_ap_index_find_by_properties (index, props2) == ap2);
+
+	/* updates from the kernel don't set a supplicant path. */
+	nm_wifi_ap_update_from_properties (ap1, NULL, props1);
+	g_assert (!nm_wifi_ap_get_supplicant_path (ap1));
+
+	nm_wifi_ap_update_from_properties (ap1, "/fi/w1/wpa_supplicant1/Interfaces/0/BSSs/7", props1);
+	g_assert (nm_wifi_ap_index_find_by_supplicant_path (index, "/fi/w1/wpa_supplicant1/Interfaces/0/BSSs/7") == ap1);
+
+	nm_wifi_ap_index_remove (index, ap1);
+	nm_wifi_ap_index_remove (index, ap2);
+	nm_wifi_ap_index_free (index);
+}
+
+static struct nl_msg *
+_mock_nl80211_msg (guint8 cmd, int ifindex)
+{
+	nm_auto_nlmsg struct nl_msg *msg = NULL;
+
+	msg = nlmsg_alloc ();
+	/* any id of a generic netlink family, which are above NLMSG_MIN_TYPE. */
+	g_assert (genlmsg_put (msg, 0, 0, NLMSG_MIN_TYPE + 10, 0, 0, cmd, 0));
+	NLA_PUT_U32 (msg, NL80211_ATTR_IFINDEX, ifindex);
+	return g_steal_pointer (&msg);
+
+nla_put_failure:
+	g_assert_not_reached ();
+	return NULL;
+}
+
+static void
+test_nl80211_scan_result_quirks (void)
+{
+	const guint8 bssid[ETH_ALEN] = { 0x02, 0x11, 0x22, 0x33, 0x44, 0x77 };
+	const guint8 ies[] = {
+		/* SSID, twice */
+		0x00, 0x05, 'f', 'i', 'r', 's', 't',
+		0x00, 0x06, 's', 'e', 'c', 'o', 'n', 'd',
+		/* RSN, twice: AKM PSK, then AKM 802.1X */
+		0x30, 0x14, 0x01, 0x00,
+		0x00, 0x0F, 0xAC, 0x04,
+		0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+		0x01, 0x00, 0x00, 0x0F, 0xAC, 0x02,
+		0x00, 0x00,
+		0x30, 0x14, 0x01, 0x00,
+		0x00, 0x0F, 0xAC, 0x04,
+		0x01, 0x00, 0x00, 0x0F, 0xAC, 0x04,
+		0x01, 0x00, 0x00, 0x0F, 0xAC, 0x01,
+		0x00, 0x00,
+	};
+	nm_auto_nlmsg struct nl_msg *msg = NULL;
+	gs_unref_variant GVariant *props = NULL;
+	gs_unref_object NMWifiAP *ap = NULL;
+	GVariantIter iter;
+	const char *key;
+	GVariant *value;
+	gint16 signal;
+	guint n_ssid = 0;
+	guint n_rsn = 0;
+	NM80211ApSecurityFlags rsn_flags;
+	struct nlattr *nest;
+
+	/* a driver that reports the signal as quality instead of mBm. */
+	msg = _mock_nl80211_msg (NL80211_CMD_NEW_SCAN_RESULTS, 1);
+	nest = nla_nest_start (msg, NL80211_ATTR_BSS);
+	g_assert (nest);
+	NLA_PUT (msg, NL80211_BSS_BSSID, ETH_ALEN, bssid);
+	NLA_PUT_U32 (msg, NL80211_BSS_FREQUENCY, 2437);
+	NLA_PUT_U8 (msg, NL80211_BSS_SIGNAL_UNSPEC, 80);
+	NLA_PUT_U16 (msg, NL80211_BSS_CAPABILITY, 0x0011);
+	NLA_PUT (msg, NL80211_BSS_INFORMATION_ELEMENTS, sizeof (ies), ies);
+	nla_nest_end (msg, nest);
+
+	props = nm_wifi_utils_nl80211_parse_scan_result (msg);
+	g_assert (props);
+
+	g_assert (g_variant_lookup (props, "Signal", "n", &signal));
+	g_assert_cmpint (signal, <, 0);
+	g_assert_cmpint (nm_wifi_utils_level_to_quality (signal), ==, 80);
+
+	/* repeated elements don't produce duplicate keys, the first one wins. */
+	g_variant_iter_init (&iter, props);
+	while (g_variant_iter_next (&iter, "{&sv}", &key, &value)) {
+		if (nm_streq (key, "SSID"))
+			n_ssid++;
+		else if (nm_streq (key, "RSN"))
+			n_rsn++;
+		g_variant_unref (value);
+	}
+	g_assert_cmpint (n_ssid, ==, 1);
+	g_assert_cmpint (n_rsn, ==, 1);
+
+	ap = nm_wifi_ap_new_from_properties (NULL, props);
+	g_assert (ap);
+	g_assert (nm_utils_gbytes_equal_mem (nm_wifi_ap_get_ssid (ap), "first", 5));
+	g_assert_cmpint (nm_wifi_ap_get_strength (ap), ==, 80);
+	g_object_get (ap, NM_WIFI_AP_RSN_FLAGS, &rsn_flags, NULL);
+	g_assert (NM_FLAGS_HAS (rsn_flags, NM_802_11_AP_SEC_KEY_MGMT_PSK));
+	g_assert (!NM_FLAGS_HAS (rsn_flags, NM_802_11_AP_SEC_KEY_MGMT_802_1X));
+	return;
+
+nla_put_failure:
+	g_assert_not_reached ();
+}
+
+static void
+test_nl80211_scan_done (void)
+{
+	const guint8 bssid[ETH_ALEN] = { 0x02, 0x11, 0x22, 0x33, 0x44, 0x88 };
+	nm_auto_nlmsg struct nl_msg *msg_done = NULL;
+	nm_auto_nlmsg struct nl_msg *msg_trigger = NULL;
+	nm_auto_nlmsg struct nl_msg *msg_bss = NULL;
+	struct nlattr *nest;
+
+	/* the event of the "scan" multicast group when a scan finished. */
+	msg_done = _mock_nl80211_msg (NL80211_CMD_NEW_SCAN_RESULTS, 3);
+	g_assert_cmpint (nm_wifi_utils_nl80211_parse_scan_done (msg_done), ==, 3);
+
+	msg_trigger = _mock_nl80211_msg (NL80211_CMD_TRIGGER_SCAN, 3);
+	g_assert_cmpint (nm_wifi_utils_nl80211_parse_scan_done (msg_trigger), ==, 0);
+
+	/* a reply of a scan dump has the same command, but is no event. */
+	msg_bss = _mock_nl80211_msg (NL80211_CMD_NEW_SCAN_RESULTS, 3);
+	nest = nla_nest_start (msg_bss, NL80211_ATTR_BSS);
+	g_assert (nest);
+	NLA_PUT (msg_bss, NL80211_BSS_BSSID, ETH_ALEN, bssid);
+	nla_nest_end (msg_bss, nest);
+	g_assert_cmpint (nm_wifi_utils_nl80211_parse_scan_done (msg_bss), ==, 0);
+	return;
+
+nla_put_failure:
+	g_assert_not_reached ();
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int
@@ -1518,5 +1889,10 @@ main (int argc, char **argv)
 	g_test_add_func ("/wifi/strength/all",
 	                 test_strength_all);
 
+	g_test_add_func ("/wifi/ap_index", test_ap_index);
+	g_test_add_func ("/wifi/nl80211_scan_result", test_nl80211_scan_result);
+	g_test_add_func ("/wifi/nl80211_scan_result/quirks", test_nl80211_scan_result_quirks);
+	g_test_add_func ("/wifi/nl80211_scan_done", test_nl80211_scan_done);
+
 	return g_test_run ();
 }
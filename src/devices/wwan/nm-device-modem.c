@@ -780,6 +780,11 @@ static const NMDBusInterfaceInfoExtended interface_info_device_modem = {
 static void
 nm_device_modem_class_init (NMDeviceModemClass *klass)
 {
+	static const char *const connection_types[] = {
+		NM_SETTING_GSM_SETTING_NAME,
+		NM_SETTING_CDMA_SETTING_NAME,
+		NULL,
+	};
 	GObjectClass *object_class = G_OBJECT_CLASS (klass);
 	NMDBusObjectClass *dbus_object_class = NM_DBUS_OBJECT_CLASS (klass);
 	NMDeviceClass *device_class = NM_DEVICE_CLASS (klass);
@@ -790,6 +795,8 @@ nm_device_modem_class_init (NMDeviceModemClass *klass)
 
 	dbus_object_class->interface_infos = NM_DBUS_INTERFACE_INFOS (&interface_info_device_modem);
 
+	device_class->connection_types_check_compatible = connection_types;
+
 	device_class->get_generic_capabilities = get_generic_capabilities;
 	device_class->get_type_description = get_type_description;
 	device_class->check_connection_compatible = check_connection_compatible;
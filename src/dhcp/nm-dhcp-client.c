@@ -58,6 +58,7 @@ NM_GOBJECT_PROPERTIES_DEFINE (NMDhcpClient,
 	PROP_IFACE,
 	PROP_IFINDEX,
 	PROP_MULTI_IDX,
+	PROP_PID,
 	PROP_ROUTE_METRIC,
 	PROP_ROUTE_TABLE,
 	PROP_TIMEOUT,
@@ -99,6 +100,17 @@ nm_dhcp_client_get_pid (NMDhcpClient *self)
 	return NM_DHCP_CLIENT_GET_PRIVATE (self)->pid;
 }
 
+static void
+_set_pid (NMDhcpClient *self, pid_t pid)
+{
+	NMDhcpClientPrivate *priv = NM_DHCP_CLIENT_GET_PRIVATE (self);
+
+	if (priv->pid == pid)
+		return;
+	priv->pid = pid;
+	_notify (self, PROP_PID);
+}
+
 NMDedupMultiIndex *
 nm_dhcp_client_get_multi_idx (NMDhcpClient *self)
 {
@@ -385,7 +397,7 @@ stop (NMDhcpClient *self, gboolean release, GBytes *duid)
 		watch_cleanup (self);
 		nm_dhcp_client_stop_pid (priv->pid, priv->iface);
 	}
-	priv->pid = -1;
+	_set_pid (self, -1);
 }
 
 void
@@ -474,7 +486,7 @@ daemon_watch_cb (GPid pid, int status, gpointer user_data)
 	else
 		_LOGW ("client died abnormally");
 
-	priv->pid = -1;
+	_set_pid (self, -1);
 
 	nm_dhcp_client_set_state (self, NM_DHCP_STATE_TERMINATED, NULL, NULL);
 }
@@ -501,7 +513,7 @@ nm_dhcp_client_watch_child (NMDhcpClient *self, pid_t pid)
 	NMDhcpClientPrivate *priv = NM_DHCP_CLIENT_GET_PRIVATE (self);
 
 	g_return_if_fail (priv->pid == -1);
-	priv->pid = pid;
+	_set_pid (self, pid);
 
 	nm_dhcp_client_start_timeout (self);
 
@@ -742,12 +754,11 @@ maybe_add_option (NMDhcpClient *self,
 }
 
 gboolean
-nm_dhcp_client_handle_event (gpointer unused,
+nm_dhcp_client_handle_event (NMDhcpClient *self,
                              const char *iface,
                              int pid,
                              GVariant *options,
-                             const char *reason,
-                             NMDhcpClient *self)
+                             const char *reason)
 {
 	NMDhcpClientPrivate *priv;
 	guint32 old_state;
@@ -872,6 +883,9 @@ get_property (GObject *object, guint prop_id,
 	case PROP_TIMEOUT:
 		g_value_set_uint (value, priv->timeout);
 		break;
+	case PROP_PID:
+		g_value_set_int (value, priv->pid);
+		break;
 	default:
 		G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 		break;
@@ -950,6 +964,7 @@ nm_dhcp_client_init (NMDhcpClient *self)
 	self->_priv = priv;
 
 	c_list_init (&self->dhcp_client_lst);
+	self->dhcp_client_idx_pid = -1;
 
 	priv->pid = -1;
 }
@@ -1056,6 +1071,12 @@ nm_dhcp_client_class_init (NMDhcpClientClass *client_class)
 	                       G_PARAM_WRITABLE | G_PARAM_CONSTRUCT_ONLY |
 	                       G_PARAM_STATIC_STRINGS);
 
+	obj_properties[PROP_PID] =
+	    g_param_spec_int (NM_DHCP_CLIENT_PID, "", "",
+	                      -1, G_MAXINT, -1,
+	                      G_PARAM_READABLE |
+	                      G_PARAM_STATIC_STRINGS);
+
 	g_object_class_install_properties (object_class, _PROPERTY_ENUMS_LAST, obj_properties);
 
 	signals[SIGNAL_STATE_CHANGED] =
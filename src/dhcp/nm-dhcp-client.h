@@ -41,6 +41,7 @@
 #define NM_DHCP_CLIENT_IFINDEX      "ifindex"
 #define NM_DHCP_CLIENT_INTERFACE    "iface"
 #define NM_DHCP_CLIENT_MULTI_IDX    "multi-idx"
+#define NM_DHCP_CLIENT_PID          "pid"
 #define NM_DHCP_CLIENT_ROUTE_METRIC "route-metric"
 #define NM_DHCP_CLIENT_ROUTE_TABLE  "route-table"
 #define NM_DHCP_CLIENT_TIMEOUT      "timeout"
@@ -67,6 +68,9 @@ typedef struct {
 	GObject parent;
 	struct _NMDhcpClientPrivate *_priv;
 	CList dhcp_client_lst;
+
+	/* the PID under which NMDhcpManager indexed the client */
+	pid_t dhcp_client_idx_pid;
 } NMDhcpClient;
 
 typedef enum {
@@ -181,12 +185,11 @@ void nm_dhcp_client_set_state (NMDhcpClient *self,
                                NMIPConfig *ip_config,
                                GHashTable *options); /* str:str hash */
 
-gboolean nm_dhcp_client_handle_event (gpointer unused,
+gboolean nm_dhcp_client_handle_event (NMDhcpClient *self,
                                       const char *iface,
                                       int pid,
                                       GVariant *options,
-                                      const char *reason,
-                                      NMDhcpClient *self);
+                                      const char *reason);
 
 void nm_dhcp_client_set_client_id (NMDhcpClient *self,
                                    GBytes *client_id);
@@ -704,11 +704,9 @@ nm_dhcp_dhclient_init (NMDhcpDhclient *self)
 		}
 	}
 
+	/* The listener dispatches the helper's events to the client with the
+	 * matching PID. Keep it alive as long as there are clients. */
 	priv->dhcp_listener = g_object_ref (nm_dhcp_listener_get ());
-	g_signal_connect (priv->dhcp_listener,
-	                  NM_DHCP_LISTENER_EVENT,
-	                  G_CALLBACK (nm_dhcp_client_handle_event),
-	                  self);
 }
 
 static void
@@ -716,12 +714,7 @@ dispose (GObject *object)
 {
 	NMDhcpDhclientPrivate *priv = NM_DHCP_DHCLIENT_GET_PRIVATE ((NMDhcpDhclient *) object);
 
-	if (priv->dhcp_listener) {
-		g_signal_handlers_disconnect_by_func (priv->dhcp_listener,
-		                                      G_CALLBACK (nm_dhcp_client_handle_event),
-		                                      NM_DHCP_DHCLIENT (object));
-		g_clear_object (&priv->dhcp_listener);
-	}
+	g_clear_object (&priv->dhcp_listener);
 
 	nm_clear_g_free (&priv->pid_file);
 	nm_clear_g_free (&priv->conf_file);
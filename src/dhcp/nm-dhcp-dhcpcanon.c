@@ -235,11 +235,9 @@ nm_dhcp_dhcpcanon_init (NMDhcpDhcpcanon *self)
 {
 	NMDhcpDhcpcanonPrivate *priv = NM_DHCP_DHCPCANON_GET_PRIVATE (self);
 
+	/* The listener dispatches the helper's events to the client with the
+	 * matching PID. Keep it alive as long as there are clients. */
 	priv->dhcp_listener = g_object_ref (nm_dhcp_listener_get ());
-	g_signal_connect (priv->dhcp_listener,
-	                  NM_DHCP_LISTENER_EVENT,
-	                  G_CALLBACK (nm_dhcp_client_handle_event),
-	                  self);
 }
 
 static void
@@ -247,12 +245,7 @@ dispose (GObject *object)
 {
 	NMDhcpDhcpcanonPrivate *priv = NM_DHCP_DHCPCANON_GET_PRIVATE ((NMDhcpDhcpcanon *) object);
 
-	if (priv->dhcp_listener) {
-		g_signal_handlers_disconnect_by_func (priv->dhcp_listener,
-		                                      G_CALLBACK (nm_dhcp_client_handle_event),
-		                                      NM_DHCP_DHCPCANON (object));
-		g_clear_object (&priv->dhcp_listener);
-	}
+	g_clear_object (&priv->dhcp_listener);
 
 	nm_clear_g_free (&priv->pid_file);
 
@@ -0,0 +1,156 @@
+/* -*- Mode: C; tab-width: 4; indent-tabs-mode: t; c-basic-offset: 4 -*- */
+/* NetworkManager -- Network link manager
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ * (C) Copyright 2018 Red Hat, Inc.
+ */
+
+#include "nm-default.h"
+
+#include "nm-dhcp-helper-api.h"
+
+#include <string.h>
+
+/*****************************************************************************/
+
+static const char *const ignore[] = {"PATH", "SHLVL", "_", "PWD", "dhc_dbus", NULL};
+
+/* Ignore non-DCHP-related environment variables */
+static gboolean
+env_ignored (const char *item)
+{
+	const char *const*p;
+
+	for (p = ignore; *p; p++) {
+		if (strncmp (item, *p, strlen (*p)) == 0)
+			return TRUE;
+	}
+	return FALSE;
+}
+
+/**
+ * nm_dhcp_helper_build_signal_parameters:
+ * @envp: the environment of the helper
+ *
+ * Returns: (transfer full): the parameters for the "Notify" D-Bus
+ *   method, a "(a{sv})" tuple with the DHCP options from @envp.
+ */
+GVariant *
+nm_dhcp_helper_build_signal_parameters (const char *const *envp)
+{
+	const char *const*item;
+	GVariantBuilder builder;
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+	/* List environment and format for dbus dict */
+	for (item = envp; *item; item++) {
+		char *name, *val;
+
+		/* Split on the = */
+		name = g_strdup (*item);
+		val = strchr (name, '=');
+		if (!val || val == name)
+			goto next;
+		*val++ = '\0';
+
+		if (env_ignored (name))
+			goto next;
+
+		/* Value passed as a byte array rather than a string, because there are
+		 * no character encoding guarantees with DHCP, and D-Bus requires
+		 * strings to be UTF-8.
+		 *
+		 * Note that we can't use g_variant_new_bytestring() here, because that
+		 * includes the trailing '\0'. (??!?)
+		 */
+		g_variant_builder_add (&builder, "{sv}",
+		                       name,
+		                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE,
+		                                                  val, strlen (val), 1));
+
+	next:
+		g_free (name);
+	}
+
+	return g_variant_ref_sink (g_variant_new ("(a{sv})", &builder));
+}
+
+/**
+ * nm_dhcp_helper_event_build:
+ * @envp: the environment of the helper
+ *
+ * Returns: (transfer full): the datagram for the event socket, with the
+ *   same options as nm_dhcp_helper_build_signal_parameters().
+ */
+GString *
+nm_dhcp_helper_event_build (const char *const *envp)
+{
+	const char *const*item;
+	GString *buf;
+
+	buf = g_string_sized_new (4096);
+	g_string_append_len (buf, NM_DHCP_HELPER_EVENT_MAGIC, sizeof (NM_DHCP_HELPER_EVENT_MAGIC));
+	for (item = envp; *item; item++) {
+		const char *val = strchr (*item, '=');
+
+		if (   !val
+		    || val == *item
+		    || env_ignored (*item))
+			continue;
+		g_string_append_len (buf, *item, strlen (*item) + 1);
+	}
+	return buf;
+}
+
+/**
+ * nm_dhcp_helper_event_parse:
+ * @buf: the received datagram
+ * @len: the length of @buf
+ *
+ * Returns: (transfer full): the DHCP options of the event as "a{sv}",
+ *   like the argument of the "Notify" D-Bus method, or %NULL if @buf
+ *   is malformed.
+ */
+GVariant *
+nm_dhcp_helper_event_parse (const char *buf, gsize len)
+{
+	GVariantBuilder builder;
+	const char *end = &buf[len];
+	const char *s;
+
+	if (   len < sizeof (NM_DHCP_HELPER_EVENT_MAGIC)
+	    || memcmp (buf, NM_DHCP_HELPER_EVENT_MAGIC, sizeof (NM_DHCP_HELPER_EVENT_MAGIC)) != 0
+	    || buf[len - 1] != '\0')
+		return NULL;
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+	for (s = &buf[sizeof (NM_DHCP_HELPER_EVENT_MAGIC)]; s < end; s = &s[strlen (s) + 1]) {
+		const char *val = strchr (s, '=');
+		gs_free char *name = NULL;
+
+		if (!val || val == s)
+			continue;
+		name = g_strndup (s, val - s);
+		val++;
+		g_variant_builder_add (&builder, "{sv}",
+		                       name,
+		                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE,
+		                                                  val, strlen (val), 1));
+	}
+	return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
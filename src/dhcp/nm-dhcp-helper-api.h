@@ -31,6 +31,22 @@
 #define NM_DHCP_HELPER_SERVER_INTERFACE_NAME    "org.freedesktop.nm_dhcp_server"
 #define NM_DHCP_HELPER_SERVER_METHOD_NOTIFY     "Notify"
 
+/* Besides the D-Bus method, the helper can deliver an event as a single
+ * datagram on this socket. The datagram starts with NM_DHCP_HELPER_EVENT_MAGIC,
+ * followed by the DHCP options as NUL-terminated "name=value" strings
+ * (just like the environment the helper gets from the DHCP client). */
+#define NM_DHCP_HELPER_EVENT_SOCKET_PATH        NMRUNDIR "/private-dhcp-event"
+#define NM_DHCP_HELPER_EVENT_MAGIC              "NMDHCP1"
+#define NM_DHCP_HELPER_EVENT_MAX_SIZE           (64 * 1024)
+
+/*****************************************************************************/
+
+GVariant *nm_dhcp_helper_build_signal_parameters (const char *const *envp);
+
+GString *nm_dhcp_helper_event_build (const char *const *envp);
+
+GVariant *nm_dhcp_helper_event_parse (const char *buf, gsize len);
+
 /*****************************************************************************/
 
 #endif /* __NM_DHCP_HELPER_API_H__ */
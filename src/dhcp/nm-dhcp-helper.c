@@ -24,6 +24,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 #include "nm-utils/nm-vpn-plugin-macros.h"
 
@@ -62,50 +65,36 @@
 
 /*****************************************************************************/
 
-static const char * ignore[] = {"PATH", "SHLVL", "_", "PWD", "dhc_dbus", NULL};
-
-static GVariant *
-build_signal_parameters (void)
+/* Sends the event as one datagram. This is much cheaper than setting up
+ * a D-Bus connection, but requires a NetworkManager that listens on the
+ * socket. Returns FALSE if the caller should fall back to D-Bus. */
+static gboolean
+notify_event_socket (void)
 {
-	char **item;
-	GVariantBuilder builder;
-
-	g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
-
-	/* List environment and format for dbus dict */
-	for (item = environ; *item; item++) {
-		char *name, *val, **p;
-
-		/* Split on the = */
-		name = g_strdup (*item);
-		val = strchr (name, '=');
-		if (!val || val == name)
-			goto next;
-		*val++ = '\0';
-
-		/* Ignore non-DCHP-related environment variables */
-		for (p = (char **) ignore; *p; p++) {
-			if (strncmp (name, *p, strlen (*p)) == 0)
-				goto next;
-		}
+	struct sockaddr_un addr = {
+		.sun_family = AF_UNIX,
+		.sun_path   = NM_DHCP_HELPER_EVENT_SOCKET_PATH,
+	};
+	nm_auto_free_gstring GString *buf = NULL;
+	nm_auto_close int fd = -1;
+
+	buf = nm_dhcp_helper_event_build ((const char *const*) environ);
+	if (buf->len > NM_DHCP_HELPER_EVENT_MAX_SIZE) {
+		_LOGi ("event too large for the event socket (%zu bytes)", (size_t) buf->len);
+		return FALSE;
+	}
 
-		/* Value passed as a byte array rather than a string, because there are
-		 * no character encoding guarantees with DHCP, and D-Bus requires
-		 * strings to be UTF-8.
-		 *
-		 * Note that we can't use g_variant_new_bytestring() here, because that
-		 * includes the trailing '\0'. (??!?)
-		 */
-		g_variant_builder_add (&builder, "{sv}",
-		                       name,
-		                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE,
-		                                                  val, strlen (val), 1));
-
-	next:
-		g_free (name);
+	fd = socket (AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (fd < 0) {
+		_LOGi ("could not create event socket: %s", g_strerror (errno));
+		return FALSE;
 	}
 
-	return g_variant_ref_sink (g_variant_new ("(a{sv})", &builder));
+	if (sendto (fd, buf->str, buf->len, 0, (struct sockaddr *) &addr, sizeof (addr)) < 0) {
+		_LOGi ("could not send event to %s: %s", NM_DHCP_HELPER_EVENT_SOCKET_PATH, g_strerror (errno));
+		return FALSE;
+	}
+	return TRUE;
 }
 
 static void
@@ -134,6 +123,9 @@ main (int argc, char *argv[])
 	guint try_count = 0;
 	gint64 time_end;
 
+	if (notify_event_socket ())
+		return EXIT_SUCCESS;
+
 	/* FIXME: g_dbus_connection_new_for_address_sync() tries to connect to the socket in
 	 * non-blocking mode, which can easily fail with EAGAIN, causing the creation of the
 	 * socket to fail with "Could not connect: Resource temporarily unavailable".
@@ -150,7 +142,7 @@ main (int argc, char *argv[])
 		goto out;
 	}
 
-	parameters = build_signal_parameters ();
+	parameters = nm_dhcp_helper_build_signal_parameters ((const char *const*) environ);
 
 	time_end = g_get_monotonic_time () + (200 * 1000L); /* retry for at most 200 milliseconds */
 
@@ -22,6 +22,8 @@
 #include "nm-dhcp-listener.h"
 
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <sys/wait.h>
 #include <signal.h>
 #include <string.h>
@@ -64,6 +66,8 @@ typedef struct {
 	gulong              new_conn_id;
 	gulong              dis_conn_id;
 	GHashTable *        connections;
+	GIOChannel *        event_channel;
+	guint               event_id;
 } NMDhcpListenerPrivate;
 
 struct _NMDhcpListener {
@@ -75,12 +79,6 @@ struct _NMDhcpListenerClass {
 	GObjectClass parent;
 };
 
-enum {
-	EVENT,
-	LAST_SIGNAL
-};
-static guint signals[LAST_SIGNAL] = { 0 };
-
 G_DEFINE_TYPE (NMDhcpListener, nm_dhcp_listener, G_TYPE_OBJECT)
 
 #define NM_DHCP_LISTENER_GET_PRIVATE(self) _NM_GET_PRIVATE(self, NMDhcpListener, NM_IS_DHCP_LISTENER)
@@ -139,18 +137,16 @@ get_option (GVariant *options, const char *key)
 }
 
 static void
-_method_call_handle (NMDhcpListener *self,
-                     GVariant *parameters)
+_handle_event (NMDhcpListener *self,
+               GVariant *options)
 {
 	gs_free char *iface = NULL;
 	gs_free char *pid_str = NULL;
 	gs_free char *reason = NULL;
-	gs_unref_variant GVariant *options = NULL;
+	NMDhcpClient *client;
 	int pid;
 	gboolean handled = FALSE;
 
-	g_variant_get (parameters, "(@a{sv})", &options);
-
 	iface = get_option (options, "interface");
 	if (iface == NULL) {
 		_LOGW ("dhcp-event: didn't have associated interface.");
@@ -170,7 +166,9 @@ _method_call_handle (NMDhcpListener *self,
 		return;
 	}
 
-	g_signal_emit (self, signals[EVENT], 0, iface, pid, options, reason, &handled);
+	client = nm_dhcp_manager_get_client_by_pid (nm_dhcp_manager_get (), pid);
+	if (client)
+		handled = nm_dhcp_client_handle_event (client, iface, pid, options, reason);
 	if (!handled) {
 		if (g_ascii_strcasecmp (reason, "RELEASE") == 0) {
 			/* Ignore event when the dhcp client gets killed and we receive its last message */
@@ -191,6 +189,7 @@ _method_call (GDBusConnection *connection,
               gpointer user_data)
 {
 	NMDhcpListener *self = NM_DHCP_LISTENER (user_data);
+	gs_unref_variant GVariant *options = NULL;
 
 	if (   !nm_streq (interface_name, NM_DHCP_HELPER_SERVER_INTERFACE_NAME)
 	    || !nm_streq (method_name, NM_DHCP_HELPER_SERVER_METHOD_NOTIFY)) {
@@ -202,7 +201,8 @@ _method_call (GDBusConnection *connection,
 		return;
 	}
 
-	_method_call_handle (self, parameters);
+	g_variant_get (parameters, "(@a{sv})", &options);
+	_handle_event (self, options);
 	g_dbus_method_invocation_return_value (invocation, NULL);
 }
 
@@ -276,6 +276,109 @@ dis_connection_cb (NMDBusManager *mgr,
 
 /*****************************************************************************/
 
+static gboolean
+_event_socket_receive (NMDhcpListener *self, int fd, char *buf)
+{
+	union {
+		struct cmsghdr cmsghdr;
+		char buf[CMSG_SPACE (sizeof (struct ucred))];
+	} control;
+	struct iovec iov = {
+		.iov_base = buf,
+		.iov_len  = NM_DHCP_HELPER_EVENT_MAX_SIZE,
+	};
+	struct msghdr msg = {
+		.msg_iov        = &iov,
+		.msg_iovlen     = 1,
+		.msg_control    = &control,
+		.msg_controllen = sizeof (control),
+	};
+	const struct ucred *cred = NULL;
+	struct cmsghdr *cmsg;
+	gs_unref_variant GVariant *options = NULL;
+	ssize_t n;
+
+	n = recvmsg (fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+	if (n < 0) {
+		if (!NM_IN_SET (errno, EAGAIN, EINTR))
+			_LOGW ("dhcp-event: failure to receive event: %s", g_strerror (errno));
+		return FALSE;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR (&msg); cmsg; cmsg = CMSG_NXTHDR (&msg, cmsg)) {
+		if (   cmsg->cmsg_level == SOL_SOCKET
+		    && cmsg->cmsg_type == SCM_CREDENTIALS
+		    && cmsg->cmsg_len >= CMSG_LEN (sizeof (struct ucred))) {
+			cred = (const struct ucred *) CMSG_DATA (cmsg);
+			break;
+		}
+	}
+	if (!cred || cred->uid != 0) {
+		_LOGW ("dhcp-event: ignore event from unprivileged sender");
+		return TRUE;
+	}
+	if (msg.msg_flags & MSG_TRUNC) {
+		_LOGW ("dhcp-event: (pid %d) ignore truncated event", (int) cred->pid);
+		return TRUE;
+	}
+
+	options = nm_dhcp_helper_event_parse (buf, n);
+	if (!options) {
+		_LOGW ("dhcp-event: (pid %d) ignore malformed event", (int) cred->pid);
+		return TRUE;
+	}
+
+	_handle_event (self, options);
+	return TRUE;
+}
+
+static gboolean
+_event_socket_ready (GIOChannel *channel,
+                     GIOCondition condition,
+                     NMDhcpListener *self)
+{
+	gs_free char *buf = g_malloc (NM_DHCP_HELPER_EVENT_MAX_SIZE);
+	int fd = g_io_channel_unix_get_fd (channel);
+
+	while (_event_socket_receive (self, fd, buf))
+		;
+	return G_SOURCE_CONTINUE;
+}
+
+static void
+_event_socket_open (NMDhcpListener *self)
+{
+	NMDhcpListenerPrivate *priv = NM_DHCP_LISTENER_GET_PRIVATE (self);
+	struct sockaddr_un addr = {
+		.sun_family = AF_UNIX,
+		.sun_path   = NM_DHCP_HELPER_EVENT_SOCKET_PATH,
+	};
+	const int one = 1;
+	int fd;
+
+	fd = socket (AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+	if (fd < 0) {
+		_LOGW ("failure to create event socket: %s", g_strerror (errno));
+		return;
+	}
+
+	unlink (NM_DHCP_HELPER_EVENT_SOCKET_PATH);
+	if (   bind (fd, (struct sockaddr *) &addr, sizeof (addr)) < 0
+	    || chmod (NM_DHCP_HELPER_EVENT_SOCKET_PATH, S_IRUSR | S_IWUSR) < 0
+	    || setsockopt (fd, SOL_SOCKET, SO_PASSCRED, &one, sizeof (one)) < 0) {
+		_LOGW ("failure to set up event socket %s: %s",
+		       NM_DHCP_HELPER_EVENT_SOCKET_PATH, g_strerror (errno));
+		nm_close (fd);
+		return;
+	}
+
+	priv->event_channel = g_io_channel_unix_new (fd);
+	g_io_channel_set_close_on_unref (priv->event_channel, TRUE);
+	priv->event_id = g_io_add_watch (priv->event_channel, G_IO_IN, (GIOFunc) _event_socket_ready, self);
+}
+
+/*****************************************************************************/
+
 static void
 nm_dhcp_listener_init (NMDhcpListener *self)
 {
@@ -296,6 +399,9 @@ nm_dhcp_listener_init (NMDhcpListener *self)
 	                                      NM_DBUS_MANAGER_PRIVATE_CONNECTION_DISCONNECTED "::" PRIV_SOCK_TAG,
 	                                      G_CALLBACK (dis_connection_cb),
 	                                      self);
+
+	/* Events from the helper as datagrams, sparing it a D-Bus connection */
+	_event_socket_open (self);
 }
 
 static void
@@ -309,6 +415,12 @@ dispose (GObject *object)
 
 	g_clear_pointer (&priv->connections, g_hash_table_destroy);
 
+	nm_clear_g_source (&priv->event_id);
+	if (priv->event_channel) {
+		g_clear_pointer (&priv->event_channel, g_io_channel_unref);
+		unlink (NM_DHCP_HELPER_EVENT_SOCKET_PATH);
+	}
+
 	G_OBJECT_CLASS (nm_dhcp_listener_parent_class)->dispose (object);
 }
 
@@ -318,17 +430,4 @@ nm_dhcp_listener_class_init (NMDhcpListenerClass *listener_class)
 	GObjectClass *object_class = G_OBJECT_CLASS (listener_class);
 
 	object_class->dispose = dispose;
-
-	signals[EVENT] =
-	    g_signal_new (NM_DHCP_LISTENER_EVENT,
-	                  G_OBJECT_CLASS_TYPE (object_class),
-	                  G_SIGNAL_RUN_LAST, 0,
-	                  g_signal_accumulator_true_handled,
-	                  NULL, NULL,
-	                  G_TYPE_BOOLEAN,     /* listeners return TRUE if handled */
-	                  4,
-	                  G_TYPE_STRING,      /* iface */
-	                  G_TYPE_INT,         /* pid */
-	                  G_TYPE_VARIANT,     /* options */
-	                  G_TYPE_STRING);     /* reason */
 }
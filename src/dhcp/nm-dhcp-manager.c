@@ -45,6 +45,15 @@ typedef struct {
 	const NMDhcpClientFactory *client_factory;
 	char *default_hostname;
 	CList dhcp_client_lst_head;
+
+	/* [IS_IPv4]: ifindex -> NMDhcpClient, for the clients in dhcp_client_lst_head */
+	GHashTable *clients_by_ifindex_x[2];
+
+	/* pid -> NMDhcpClient. Clients stay in this index as long as their
+	 * DHCP client process runs, even after they are removed from
+	 * dhcp_client_lst_head, so that the events of their helper are
+	 * still delivered. */
+	GHashTable *clients_by_pid;
 } NMDhcpManagerPrivate;
 
 struct _NMDhcpManager {
@@ -98,20 +107,77 @@ static NMDhcpClient *
 get_client_for_ifindex (NMDhcpManager *manager, int addr_family, int ifindex)
 {
 	NMDhcpManagerPrivate *priv;
-	NMDhcpClient *client;
+	const gboolean IS_IPv4 = (addr_family == AF_INET);
 
 	g_return_val_if_fail (NM_IS_DHCP_MANAGER (manager), NULL);
 	g_return_val_if_fail (ifindex > 0, NULL);
 
 	priv = NM_DHCP_MANAGER_GET_PRIVATE (manager);
 
-	c_list_for_each_entry (client, &priv->dhcp_client_lst_head, dhcp_client_lst) {
-		if (   nm_dhcp_client_get_ifindex (client) == ifindex
-		    && nm_dhcp_client_get_addr_family (client) == addr_family)
-			return client;
+	return g_hash_table_lookup (priv->clients_by_ifindex_x[IS_IPv4], GINT_TO_POINTER (ifindex));
+}
+
+/**
+ * nm_dhcp_manager_get_client_by_pid:
+ * @self: the #NMDhcpManager
+ * @pid: the PID of a DHCP client process
+ *
+ * Returns: (transfer none): the #NMDhcpClient that spawned the DHCP client
+ *   process @pid, or %NULL.
+ */
+NMDhcpClient *
+nm_dhcp_manager_get_client_by_pid (NMDhcpManager *self, pid_t pid)
+{
+	g_return_val_if_fail (NM_IS_DHCP_MANAGER (self), NULL);
+
+	if (pid <= 0)
+		return NULL;
+	return g_hash_table_lookup (NM_DHCP_MANAGER_GET_PRIVATE (self)->clients_by_pid,
+	                            GINT_TO_POINTER (pid));
+}
+
+static void
+_client_idx_pid_weak_cb (gpointer user_data, GObject *where_the_object_was)
+{
+	NMDhcpManager *self = user_data;
+	NMDhcpManagerPrivate *priv = NM_DHCP_MANAGER_GET_PRIVATE (self);
+	NMDhcpClient *client = (NMDhcpClient *) where_the_object_was;
+
+	/* the client is being disposed; its fields are still valid. */
+	if (g_hash_table_lookup (priv->clients_by_pid, GINT_TO_POINTER (client->dhcp_client_idx_pid)) == client)
+		g_hash_table_remove (priv->clients_by_pid, GINT_TO_POINTER (client->dhcp_client_idx_pid));
+}
+
+static void
+_client_idx_pid_update (NMDhcpManager *self, NMDhcpClient *client)
+{
+	NMDhcpManagerPrivate *priv = NM_DHCP_MANAGER_GET_PRIVATE (self);
+	pid_t pid = nm_dhcp_client_get_pid (client);
+
+	if (   client->dhcp_client_idx_pid == pid
+	    || !priv->clients_by_pid)
+		return;
+
+	if (client->dhcp_client_idx_pid > 0) {
+		if (g_hash_table_lookup (priv->clients_by_pid, GINT_TO_POINTER (client->dhcp_client_idx_pid)) == client)
+			g_hash_table_remove (priv->clients_by_pid, GINT_TO_POINTER (client->dhcp_client_idx_pid));
+		g_object_weak_unref (G_OBJECT (client), _client_idx_pid_weak_cb, self);
 	}
 
-	return NULL;
+	client->dhcp_client_idx_pid = pid;
+
+	if (pid > 0) {
+		g_hash_table_insert (priv->clients_by_pid, GINT_TO_POINTER (pid), client);
+		g_object_weak_ref (G_OBJECT (client), _client_idx_pid_weak_cb, self);
+	}
+}
+
+static void
+client_pid_changed (NMDhcpClient *client,
+                    GParamSpec *pspec,
+                    NMDhcpManager *self)
+{
+	_client_idx_pid_update (self, client);
 }
 
 static void client_state_changed (NMDhcpClient *client,
@@ -124,8 +190,14 @@ static void client_state_changed (NMDhcpClient *client,
 static void
 remove_client (NMDhcpManager *self, NMDhcpClient *client)
 {
+	NMDhcpManagerPrivate *priv = NM_DHCP_MANAGER_GET_PRIVATE (self);
+	const gboolean IS_IPv4 = (nm_dhcp_client_get_addr_family (client) == AF_INET);
+	gpointer ifindex = GINT_TO_POINTER (nm_dhcp_client_get_ifindex (client));
+
 	g_signal_handlers_disconnect_by_func (client, client_state_changed, self);
 	c_list_unlink (&client->dhcp_client_lst);
+	if (g_hash_table_lookup (priv->clients_by_ifindex_x[IS_IPv4], ifindex) == client)
+		g_hash_table_remove (priv->clients_by_ifindex_x[IS_IPv4], ifindex);
 
 	/* Stopping the client is left up to the controlling device
 	 * explicitly since we may want to quit NetworkManager but not terminate
@@ -231,7 +303,11 @@ client_start (NMDhcpManager *self,
 	                       NULL);
 	nm_assert (client && c_list_is_empty (&client->dhcp_client_lst));
 	c_list_link_tail (&priv->dhcp_client_lst_head, &client->dhcp_client_lst);
+	g_hash_table_insert (priv->clients_by_ifindex_x[addr_family == AF_INET],
+	                     GINT_TO_POINTER (ifindex),
+	                     client);
 	g_signal_connect (client, NM_DHCP_CLIENT_SIGNAL_STATE_CHANGED, G_CALLBACK (client_state_changed), self);
+	g_signal_connect_object (client, "notify::" NM_DHCP_CLIENT_PID, G_CALLBACK (client_pid_changed), self, 0);
 
 	if (addr_family == AF_INET) {
 		success = nm_dhcp_client_start_ip4 (client,
@@ -401,6 +477,9 @@ nm_dhcp_manager_init (NMDhcpManager *self)
 	const NMDhcpClientFactory *client_factory = NULL;
 
 	c_list_init (&priv->dhcp_client_lst_head);
+	priv->clients_by_ifindex_x[0] = g_hash_table_new (nm_direct_hash, NULL);
+	priv->clients_by_ifindex_x[1] = g_hash_table_new (nm_direct_hash, NULL);
+	priv->clients_by_pid = g_hash_table_new (nm_direct_hash, NULL);
 
 	for (i = 0; i < G_N_ELEMENTS (_nm_dhcp_manager_factories); i++) {
 		const NMDhcpClientFactory *f = _nm_dhcp_manager_factories[i];
@@ -465,10 +544,22 @@ dispose (GObject *object)
 	NMDhcpManager *self = NM_DHCP_MANAGER (object);
 	NMDhcpManagerPrivate *priv = NM_DHCP_MANAGER_GET_PRIVATE (self);
 	NMDhcpClient *client, *client_safe;
+	GHashTableIter iter;
 
 	c_list_for_each_entry_safe (client, client_safe, &priv->dhcp_client_lst_head, dhcp_client_lst)
 		remove_client_unref (self, client);
 
+	if (priv->clients_by_pid) {
+		g_hash_table_iter_init (&iter, priv->clients_by_pid);
+		while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &client)) {
+			g_object_weak_unref (G_OBJECT (client), _client_idx_pid_weak_cb, self);
+			client->dhcp_client_idx_pid = -1;
+		}
+		g_clear_pointer (&priv->clients_by_pid, g_hash_table_destroy);
+	}
+	g_clear_pointer (&priv->clients_by_ifindex_x[0], g_hash_table_destroy);
+	g_clear_pointer (&priv->clients_by_ifindex_x[1], g_hash_table_destroy);
+
 	G_OBJECT_CLASS (nm_dhcp_manager_parent_class)->dispose (object);
 
 	nm_clear_g_free (&priv->default_hostname);
@@ -42,6 +42,8 @@ NMDhcpManager *nm_dhcp_manager_get (void);
 
 const char *nm_dhcp_manager_get_config (NMDhcpManager *self);
 
+NMDhcpClient *nm_dhcp_manager_get_client_by_pid (NMDhcpManager *self, pid_t pid);
+
 void           nm_dhcp_manager_set_default_hostname (NMDhcpManager *manager,
                                                      const char *hostname);
 
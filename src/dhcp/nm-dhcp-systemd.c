@@ -36,6 +36,7 @@
 #include "nm-dhcp-utils.h"
 #include "NetworkManagerUtils.h"
 #include "platform/nm-platform.h"
+#include "devices/nm-acd-manager.h"
 #include "nm-dhcp-client-logging.h"
 #include "systemd/nm-sd.h"
 
@@ -59,10 +60,15 @@ typedef struct {
 	sd_dhcp_client *client4;
 	sd_dhcp6_client *client6;
 	char *lease_file;
+	sd_dhcp_lease *cached_lease;
+	NMAcdManager *cached_lease_acd;
 
 	guint request_count;
+	guint cached_lease_id;
+	guint32 cached_lease_elapsed;
 
 	bool privacy:1;
+	bool cached_lease_applied:1;
 } NMDhcpSystemdPrivate;
 
 struct _NMDhcpSystemd {
@@ -222,6 +228,7 @@ lease_to_ip4_config (NMDedupMultiIndex *multi_idx,
                      const char *iface,
                      int ifindex,
                      sd_dhcp_lease *lease,
+                     guint32 elapsed,
                      GHashTable *options,
                      guint32 route_table,
                      guint32 route_metric,
@@ -272,6 +279,7 @@ lease_to_ip4_config (NMDedupMultiIndex *multi_idx,
 
 	/* Lease time */
 	sd_dhcp_lease_get_lifetime (lease, &lifetime);
+	lifetime = nm_dhcp_utils_lease_get_remaining_lifetime (lifetime, elapsed);
 	address.timestamp = nm_utils_get_monotonic_timestamp_s ();
 	address.lifetime = address.preferred = lifetime;
 	end_time = (guint64) time (NULL) + lifetime;
@@ -498,6 +506,16 @@ _save_client_id (NMDhcpSystemd *self,
 	}
 }
 
+static void
+cached_lease_clear (NMDhcpSystemd *self)
+{
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+
+	nm_clear_g_source (&priv->cached_lease_id);
+	nm_clear_pointer (&priv->cached_lease_acd, nm_acd_manager_free);
+	g_clear_pointer (&priv->cached_lease, sd_dhcp_lease_unref);
+}
+
 static void
 bound4_handle (NMDhcpSystemd *self)
 {
@@ -518,11 +536,15 @@ bound4_handle (NMDhcpSystemd *self)
 
 	_LOGD ("lease available");
 
+	cached_lease_clear (self);
+	priv->cached_lease_applied = FALSE;
+
 	options = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
 	ip4_config = lease_to_ip4_config (nm_dhcp_client_get_multi_idx (NM_DHCP_CLIENT (self)),
 	                                  iface,
 	                                  nm_dhcp_client_get_ifindex (NM_DHCP_CLIENT (self)),
 	                                  lease,
+	                                  0,
 	                                  options,
 	                                  nm_dhcp_client_get_route_table (NM_DHCP_CLIENT (self)),
 	                                  nm_dhcp_client_get_route_metric (NM_DHCP_CLIENT (self)),
@@ -554,6 +576,112 @@ bound4_handle (NMDhcpSystemd *self)
 	g_clear_object (&ip4_config);
 }
 
+/* Minimum remaining lifetime of a lease from a previous run to
+ * configure it before the server confirms it. */
+#define CACHED_LEASE_MIN_REMAINING_SEC 30
+
+/* Maximum duration of the conflict detection for the address of a
+ * cached lease. */
+#define CACHED_LEASE_ACD_TIMEOUT_MSEC 200
+
+static void
+cached_lease_apply (NMDhcpSystemd *self)
+{
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+	gs_unref_hashtable GHashTable *options = NULL;
+	gs_unref_object NMIP4Config *ip4_config = NULL;
+	gs_free_error GError *error = NULL;
+
+	options = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, g_free);
+	ip4_config = lease_to_ip4_config (nm_dhcp_client_get_multi_idx (NM_DHCP_CLIENT (self)),
+	                                  nm_dhcp_client_get_iface (NM_DHCP_CLIENT (self)),
+	                                  nm_dhcp_client_get_ifindex (NM_DHCP_CLIENT (self)),
+	                                  priv->cached_lease,
+	                                  priv->cached_lease_elapsed,
+	                                  options,
+	                                  nm_dhcp_client_get_route_table (NM_DHCP_CLIENT (self)),
+	                                  nm_dhcp_client_get_route_metric (NM_DHCP_CLIENT (self)),
+	                                  TRUE,
+	                                  &error);
+	g_clear_pointer (&priv->cached_lease, sd_dhcp_lease_unref);
+	if (!ip4_config) {
+		_LOGD ("cached lease not usable: %s", error->message);
+		return;
+	}
+
+	_LOGI ("using cached lease while confirming it with the server");
+
+	add_requests_to_options (options, dhcp4_requests);
+	priv->cached_lease_applied = TRUE;
+	nm_dhcp_client_set_state (NM_DHCP_CLIENT (self),
+	                          NM_DHCP_STATE_BOUND,
+	                          NM_IP_CONFIG_CAST (ip4_config),
+	                          options);
+}
+
+static void
+cached_lease_acd_terminated (NMAcdManager *acd_manager, gpointer user_data)
+{
+	NMDhcpSystemd *self = user_data;
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+	struct in_addr addr = { 0 };
+
+	nm_assert (priv->cached_lease_acd == acd_manager);
+	nm_assert (priv->cached_lease);
+
+	sd_dhcp_lease_get_address (priv->cached_lease, &addr);
+	if (!nm_acd_manager_check_address (acd_manager, addr.s_addr)) {
+		_LOGW ("cached lease not used: address %s is already in use",
+		       nm_utils_inet4_ntop (addr.s_addr, NULL));
+		cached_lease_clear (self);
+		return;
+	}
+
+	nm_clear_pointer (&priv->cached_lease_acd, nm_acd_manager_free);
+	cached_lease_apply (self);
+}
+
+static gboolean
+cached_lease_cb (gpointer user_data)
+{
+	static const NMAcdCallbacks acd_callbacks = {
+		.probe_terminated_callback = cached_lease_acd_terminated,
+	};
+	NMDhcpSystemd *self = user_data;
+	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE (self);
+	GBytes *hwaddr;
+	const guint8 *hwaddr_arr = NULL;
+	gsize hwaddr_len = 0;
+	struct in_addr addr = { 0 };
+
+	priv->cached_lease_id = 0;
+
+	/* Nobody confirmed the address of the cached lease yet. Only
+	 * configure it if no other host on the link uses it. */
+	hwaddr = nm_dhcp_client_get_hw_addr (NM_DHCP_CLIENT (self));
+	if (hwaddr)
+		hwaddr_arr = g_bytes_get_data (hwaddr, &hwaddr_len);
+	if (!hwaddr_arr || hwaddr_len != ETH_ALEN) {
+		_LOGD ("cached lease not used: can't check the address for conflicts");
+		cached_lease_clear (self);
+		return G_SOURCE_REMOVE;
+	}
+
+	sd_dhcp_lease_get_address (priv->cached_lease, &addr);
+	priv->cached_lease_acd = nm_acd_manager_new (nm_dhcp_client_get_ifindex (NM_DHCP_CLIENT (self)),
+	                                             hwaddr_arr,
+	                                             hwaddr_len,
+	                                             &acd_callbacks,
+	                                             self);
+	nm_acd_manager_add_address (priv->cached_lease_acd, addr.s_addr);
+	if (!nm_acd_manager_start_probe (priv->cached_lease_acd, CACHED_LEASE_ACD_TIMEOUT_MSEC)) {
+		_LOGD ("cached lease not used: conflict detection failed");
+		cached_lease_clear (self);
+	}
+
+	return G_SOURCE_REMOVE;
+}
+
 static void
 dhcp_event_cb (sd_dhcp_client *client, int event, gpointer user_data)
 {
@@ -566,6 +694,15 @@ dhcp_event_cb (sd_dhcp_client *client, int event, gpointer user_data)
 
 	switch (event) {
 	case SD_DHCP_CLIENT_EVENT_EXPIRED:
+		cached_lease_clear (self);
+		if (priv->cached_lease_applied) {
+			/* The server refused the cached lease. Don't try it again
+			 * on the next start. */
+			_LOGD ("cached lease rejected");
+			priv->cached_lease_applied = FALSE;
+			if (unlink (priv->lease_file) != 0 && errno != ENOENT)
+				_LOGD ("failed to remove lease file: %s", g_strerror (errno));
+		}
 		nm_dhcp_client_set_state (NM_DHCP_CLIENT (user_data), NM_DHCP_STATE_EXPIRE, NULL, NULL);
 		break;
 	case SD_DHCP_CLIENT_EVENT_STOP:
@@ -656,6 +793,16 @@ ip4_start (NMDhcpClient *client,
 		goto errout;
 	}
 
+	r = sd_dhcp_client_set_shared_io (priv->client4,
+	                                  nm_config_data_get_value_boolean (NM_CONFIG_GET_DATA,
+	                                                                    NM_CONFIG_KEYFILE_GROUP_MAIN,
+	                                                                    NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_SHARED_IO,
+	                                                                    FALSE));
+	if (r < 0) {
+		nm_utils_error_set_errno (error, r, "failed to set shared I/O: %s");
+		goto errout;
+	}
+
 	r = sd_dhcp_client_set_callback (priv->client4, dhcp_event_cb, client);
 	if (r < 0) {
 		nm_utils_error_set_errno (error, r, "failed to set callback: %s");
@@ -669,6 +816,34 @@ ip4_start (NMDhcpClient *client,
 	else if (lease)
 		sd_dhcp_lease_get_address (lease, &last_addr);
 
+	cached_lease_clear (self);
+	priv->cached_lease_applied = FALSE;
+	if (   lease
+	    && nm_config_data_get_value_boolean (NM_CONFIG_GET_DATA,
+	                                         NM_CONFIG_KEYFILE_GROUP_MAIN,
+	                                         NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_LEASE_CACHE,
+	                                         FALSE)) {
+		struct in_addr lease_addr = { 0 };
+		guint32 lifetime = 0;
+		guint32 remaining;
+		guint32 age;
+
+		/* The lease of the last run is still valid: configure it right
+		 * away while the client confirms it with INIT-REBOOT. A NAK
+		 * withdraws it again. */
+		sd_dhcp_lease_get_address (lease, &lease_addr);
+		sd_dhcp_lease_get_lifetime (lease, &lifetime);
+		age = nm_dhcp_utils_lease_file_get_age (priv->lease_file, time (NULL));
+		remaining = nm_dhcp_utils_lease_get_remaining_lifetime (lifetime, age);
+		if (   lease_addr.s_addr
+		    && lease_addr.s_addr == last_addr.s_addr
+		    && age != G_MAXUINT32
+		    && remaining > CACHED_LEASE_MIN_REMAINING_SEC) {
+			priv->cached_lease = sd_dhcp_lease_ref (lease);
+			priv->cached_lease_elapsed = age;
+		}
+	}
+
 	if (last_addr.s_addr) {
 		r = sd_dhcp_client_set_request_address (priv->client4, &last_addr);
 		if (r < 0) {
@@ -726,12 +901,19 @@ ip4_start (NMDhcpClient *client,
 
 	nm_dhcp_client_start_timeout (client);
 
+	/* Defer the cached lease, the caller only connects to
+	 * state changes after we return. */
+	if (priv->cached_lease)
+		priv->cached_lease_id = g_idle_add (cached_lease_cb, self);
+
 	success = TRUE;
 
 errout:
 	sd_dhcp_lease_unref (lease);
-	if (!success)
+	if (!success) {
+		cached_lease_clear (self);
 		sd_dhcp_client_unref (g_steal_pointer (&priv->client4));
+	}
 	return success;
 }
 
@@ -1021,6 +1203,8 @@ stop (NMDhcpClient *client, gboolean release, GBytes *duid)
 
 	NM_DHCP_CLIENT_CLASS (nm_dhcp_systemd_parent_class)->stop (client, release, duid);
 
+	cached_lease_clear (self);
+
 	_LOGT ("dhcp-client%d: stop %p",
 	       priv->client4 ? '4' : '6',
 	       priv->client4 ? (gpointer) priv->client4 : (gpointer) priv->client6);
@@ -1050,6 +1234,7 @@ dispose (GObject *object)
 	NMDhcpSystemdPrivate *priv = NM_DHCP_SYSTEMD_GET_PRIVATE ((NMDhcpSystemd *) object);
 
 	g_clear_pointer (&priv->lease_file, g_free);
+	cached_lease_clear ((NMDhcpSystemd *) object);
 
 	if (priv->client4) {
 		sd_dhcp_client_stop (priv->client4);
@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <unistd.h>
 #include <arpa/inet.h>
+#include <sys/stat.h>
 
 #include "nm-utils/nm-dedup-multi.h"
 
@@ -775,3 +776,46 @@ nm_dhcp_utils_client_id_string_to_bytes (const char *client_id)
 	return bytes;
 }
 
+
+/**
+ * nm_dhcp_utils_lease_file_get_age:
+ * @lease_file: path of a lease file
+ * @now: the current time, in seconds since the epoch
+ *
+ * The lease file is rewritten on every ACK, so its modification time
+ * is when the lease was last (re)acquired.
+ *
+ * Returns: the age of the lease in seconds, or %G_MAXUINT32 if it
+ * is unknown.
+ */
+guint32
+nm_dhcp_utils_lease_file_get_age (const char *lease_file, gint64 now)
+{
+	struct stat st;
+
+	g_return_val_if_fail (lease_file, G_MAXUINT32);
+
+	if (stat (lease_file, &st) != 0)
+		return G_MAXUINT32;
+
+	if (now < (gint64) st.st_mtime)
+		return G_MAXUINT32;
+
+	return (guint32) NM_MIN ((guint64) (now - st.st_mtime), (guint64) G_MAXUINT32);
+}
+
+/**
+ * nm_dhcp_utils_lease_get_remaining_lifetime:
+ * @lifetime: the lifetime of the lease, in seconds
+ * @elapsed: the seconds since the lease was acquired
+ *
+ * Returns: the remaining lifetime of the lease in seconds. An infinite
+ * @lifetime stays infinite.
+ */
+guint32
+nm_dhcp_utils_lease_get_remaining_lifetime (guint32 lifetime, guint32 elapsed)
+{
+	if (lifetime == NM_PLATFORM_LIFETIME_PERMANENT)
+		return lifetime;
+	return lifetime > elapsed ? lifetime - elapsed : 0;
+}
@@ -43,5 +43,9 @@ char *nm_dhcp_utils_duid_to_string (GBytes *duid);
 
 GBytes *     nm_dhcp_utils_client_id_string_to_bytes (const char *client_id);
 
+guint32 nm_dhcp_utils_lease_file_get_age (const char *lease_file, gint64 now);
+
+guint32 nm_dhcp_utils_lease_get_remaining_lifetime (guint32 lifetime, guint32 elapsed);
+
 #endif /* __NETWORKMANAGER_DHCP_UTILS_H__ */
 
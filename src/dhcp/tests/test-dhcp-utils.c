@@ -22,12 +22,15 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <string.h>
+#include <unistd.h>
+#include <utime.h>
 #include <linux/rtnetlink.h>
 
 #include "nm-utils/nm-dedup-multi.h"
 #include "nm-utils.h"
 
 #include "dhcp/nm-dhcp-utils.h"
+#include "dhcp/nm-dhcp-helper-api.h"
 #include "platform/nm-platform.h"
 
 #include "nm-test-utils-core.h"
@@ -720,6 +723,155 @@ test_client_id_from_string (void)
 	COMPARE_ID (endcolon, TRUE, endcolon, strlen (endcolon));
 }
 
+/*****************************************************************************/
+
+static char *
+_event_get_option (GVariant *options, const char *name)
+{
+	gs_unref_variant GVariant *value = NULL;
+	const char *data;
+	gsize len;
+
+	value = g_variant_lookup_value (options, name, G_VARIANT_TYPE_BYTESTRING);
+	if (!value)
+		return NULL;
+	data = g_variant_get_fixed_array (value, &len, 1);
+	return g_strndup (data, len);
+}
+
+static void
+test_helper_event_parse (void)
+{
+	static const char event[] = NM_DHCP_HELPER_EVENT_MAGIC "\0"
+	                            "reason=BOUND\0"
+	                            "noequal\0"
+	                            "=novalue\0"
+	                            "empty=\0"
+	                            "new_ip_address=192.168.1.5";
+	static const char event_bad_magic[] = "NMDHCP0\0reason=BOUND";
+	static const char event_no_magic[] = "reason=BOUND";
+	gs_unref_variant GVariant *options = NULL;
+	gs_free char *reason = NULL;
+	gs_free char *address = NULL;
+	gs_free char *empty = NULL;
+
+	options = nm_dhcp_helper_event_parse (event, sizeof (event));
+	g_assert (options);
+	g_assert (g_variant_is_of_type (options, G_VARIANT_TYPE_VARDICT));
+
+	/* entries without a name or without '=' are skipped. */
+	g_assert_cmpint (g_variant_n_children (options), ==, 3);
+	reason = _event_get_option (options, "reason");
+	g_assert_cmpstr (reason, ==, "BOUND");
+	address = _event_get_option (options, "new_ip_address");
+	g_assert_cmpstr (address, ==, "192.168.1.5");
+	empty = _event_get_option (options, "empty");
+	g_assert_cmpstr (empty, ==, "");
+	g_assert (!_event_get_option (options, "noequal"));
+	g_clear_pointer (&options, g_variant_unref);
+
+	/* the last entry must be NUL terminated. */
+	g_assert (!nm_dhcp_helper_event_parse (event, sizeof (event) - 1));
+
+	/* the magic, including its NUL, must come first. */
+	g_assert (!nm_dhcp_helper_event_parse (event_bad_magic, sizeof (event_bad_magic)));
+	g_assert (!nm_dhcp_helper_event_parse (event_no_magic, sizeof (event_no_magic)));
+	g_assert (!nm_dhcp_helper_event_parse (event, sizeof (NM_DHCP_HELPER_EVENT_MAGIC) - 1));
+	g_assert (!nm_dhcp_helper_event_parse (event, 0));
+
+	/* an event without options */
+	options = nm_dhcp_helper_event_parse (event, sizeof (NM_DHCP_HELPER_EVENT_MAGIC));
+	g_assert (options);
+	g_assert_cmpint (g_variant_n_children (options), ==, 0);
+}
+
+static void
+test_helper_event_roundtrip (void)
+{
+	const char *const envp[] = {
+		"reason=BOUND",
+		"PATH=/usr/bin:/bin",
+		"interface=eth0",
+		"SHLVL=1",
+		"noequal",
+		"=novalue",
+		"new_ip_address=10.0.0.2",
+		"new_domain_name=ex\303\244mple.com",
+		"new_host_name=",
+		NULL,
+	};
+	nm_auto_free_gstring GString *buf = NULL;
+	gs_unref_variant GVariant *parameters = NULL;
+	gs_unref_variant GVariant *expected = NULL;
+	gs_unref_variant GVariant *options = NULL;
+
+	buf = nm_dhcp_helper_event_build (envp);
+	g_assert (buf);
+	g_assert_cmpint (buf->len, <=, NM_DHCP_HELPER_EVENT_MAX_SIZE);
+
+	/* the datagram carries the same options as the D-Bus call. */
+	options = nm_dhcp_helper_event_parse (buf->str, buf->len);
+	g_assert (options);
+
+	parameters = nm_dhcp_helper_build_signal_parameters (envp);
+	g_assert (g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(a{sv})")));
+	expected = g_variant_get_child_value (parameters, 0);
+
+	g_assert_cmpint (g_variant_n_children (options), ==, 5);
+	g_assert (g_variant_equal (options, expected));
+}
+
+/*****************************************************************************/
+
+static void
+test_lease_file_get_age (void)
+{
+	gs_free char *path = NULL;
+	const gint64 mtime = 1500000000;
+	struct utimbuf times = {
+		.actime = mtime,
+		.modtime = mtime,
+	};
+	int fd;
+
+	fd = g_file_open_tmp ("test-dhcp-lease-XXXXXX", &path, NULL);
+	g_assert (fd >= 0);
+	close (fd);
+	g_assert (utime (path, &times) == 0);
+
+	g_assert_cmpuint (nm_dhcp_utils_lease_file_get_age (path, mtime), ==, 0);
+	g_assert_cmpuint (nm_dhcp_utils_lease_file_get_age (path, mtime + 100), ==, 100);
+
+	/* a lease from the future or from too long ago has no usable age. */
+	g_assert_cmpuint (nm_dhcp_utils_lease_file_get_age (path, mtime - 1), ==, G_MAXUINT32);
+	g_assert_cmpuint (nm_dhcp_utils_lease_file_get_age (path, mtime + G_MAXUINT32), ==, G_MAXUINT32);
+	g_assert_cmpuint (nm_dhcp_utils_lease_file_get_age (path, mtime + ((gint64) G_MAXUINT32) * 2), ==, G_MAXUINT32);
+
+	g_assert (unlink (path) == 0);
+	g_assert_cmpuint (nm_dhcp_utils_lease_file_get_age (path, mtime + 100), ==, G_MAXUINT32);
+}
+
+static void
+test_lease_remaining_lifetime (void)
+{
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (3600, 0), ==, 3600);
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (3600, 100), ==, 3500);
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (3600, 3599), ==, 1);
+
+	/* an expired lease has no lifetime left. */
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (3600, 3600), ==, 0);
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (3600, 7200), ==, 0);
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (3600, G_MAXUINT32), ==, 0);
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (0, 0), ==, 0);
+
+	/* an infinite lease stays infinite. */
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (NM_PLATFORM_LIFETIME_PERMANENT, 0), ==, NM_PLATFORM_LIFETIME_PERMANENT);
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (NM_PLATFORM_LIFETIME_PERMANENT, 100000), ==, NM_PLATFORM_LIFETIME_PERMANENT);
+	g_assert_cmpuint (nm_dhcp_utils_lease_get_remaining_lifetime (NM_PLATFORM_LIFETIME_PERMANENT - 1, 1), ==, NM_PLATFORM_LIFETIME_PERMANENT - 2);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE ();
 
 int main (int argc, char **argv)
@@ -747,6 +899,10 @@ int main (int argc, char **argv)
 	g_test_add_func ("/dhcp/ip4-prefix-classless", test_ip4_prefix_classless);
 	g_test_add_func ("/dhcp/client-id-from-string", test_client_id_from_string);
 	g_test_add_func ("/dhcp/vendor-option-metered", test_vendor_option_metered);
+	g_test_add_func ("/dhcp/helper-event/parse", test_helper_event_parse);
+	g_test_add_func ("/dhcp/helper-event/roundtrip", test_helper_event_roundtrip);
+	g_test_add_func ("/dhcp/lease-file-age", test_lease_file_get_age);
+	g_test_add_func ("/dhcp/lease-remaining-lifetime", test_lease_remaining_lifetime);
 
 	return g_test_run ();
 }
@@ -1080,6 +1080,72 @@ nm_manager_get_activatable_connections (NMManager *manager,
 	                                          NULL);
 }
 
+/**
+ * nm_manager_get_autoconnect_candidates:
+ * @manager: the #NMManager
+ * @device: the device that wants to autoconnect
+ * @out_len: (allow-none): the number of returned connections
+ *
+ * Like nm_manager_get_activatable_connections() for auto activation,
+ * but only returns the connections that have autoconnect enabled, are
+ * not blocked from autoconnecting and have a type that @device can
+ * handle. Only those get sorted by autoconnect priority.
+ *
+ * Returns: (transfer container): a %NULL terminated array of candidates.
+ */
+NMSettingsConnection **
+nm_manager_get_autoconnect_candidates (NMManager *manager,
+                                       NMDevice *device,
+                                       guint *out_len)
+{
+	NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE (manager);
+	NMDeviceClass *klass = NM_DEVICE_GET_CLASS (device);
+	const GetActivatableConnectionsFilterData d = {
+		.self = manager,
+		.for_auto_activation = TRUE,
+	};
+	const char *types_one[2] = { NULL, NULL };
+	const char *const*types;
+	GPtrArray *list;
+	guint i, t, len;
+
+	if (klass->connection_type_check_compatible) {
+		types_one[0] = klass->connection_type_check_compatible;
+		types = types_one;
+	} else if (klass->connection_types_check_compatible)
+		types = klass->connection_types_check_compatible;
+	else {
+		/* the device type doesn't tell which profiles it accepts. Look
+		 * at all of them. */
+		types = types_one;
+	}
+
+	list = g_ptr_array_new ();
+	t = 0;
+	do {
+		NMSettingsConnection *const*index;
+
+		index = nm_settings_get_autoconnect_connections (priv->settings, types[t], &len);
+		for (i = 0; i < len; i++) {
+			if (nm_settings_connection_autoconnect_is_blocked (index[i]))
+				continue;
+			if (!_get_activatable_connections_filter (priv->settings, index[i], (gpointer) &d))
+				continue;
+			g_ptr_array_add (list, index[i]);
+		}
+	} while (types[t] && types[++t]);
+
+	len = list->len;
+	if (len > 1) {
+		g_ptr_array_sort_with_data (list,
+		                            nm_settings_connection_cmp_autoconnect_priority_p_with_data,
+		                            NULL);
+	}
+	g_ptr_array_add (list, NULL);
+	NM_SET_OUT (out_len, len);
+	return (NMSettingsConnection **) g_ptr_array_free (list, FALSE);
+}
+
 static NMActiveConnection *
 active_connection_get_by_path (NMManager *self, const char *path)
 {
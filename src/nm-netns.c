@@ -27,6 +27,7 @@
 #include "platform/nm-platform.h"
 #include "platform/nmp-netns.h"
 #include "nm-core-internal.h"
+#include "nm-config.h"
 #include "NetworkManagerUtils.h"
 
 /*****************************************************************************/
@@ -79,6 +80,45 @@ nm_netns_get_multi_idx (NMNetns *self)
 
 /*****************************************************************************/
 
+static void
+_log_multi_idx_stats (NMNetns *self)
+{
+	NMDedupMultiIndexStats stats;
+
+	if (!nm_logging_enabled (LOGL_INFO, LOGD_CORE))
+		return;
+
+	/* The platform cache and all NMIP4Config/NMIP6Config instances share the
+	 * same index, so the hit ratio tells how well addresses and routes
+	 * get deduplicated. */
+	nm_dedup_multi_index_get_stats (nm_netns_get_multi_idx (self), &stats);
+	nm_log_info (LOGD_CORE,
+	             "netns: dedup index has %u objects (%u shared by %u additional references) in %u entries; "
+	             "interned %"G_GUINT64_FORMAT" times with %"G_GUINT64_FORMAT" hits (%u%%)",
+	             stats.n_objs,
+	             stats.n_objs_shared,
+	             stats.n_refs_shared,
+	             stats.n_entries,
+	             stats.intern_lookups,
+	             stats.intern_hits,
+	             stats.intern_lookups > 0
+	               ? (guint) ((stats.intern_hits * 100) / stats.intern_lookups)
+	               : 0u);
+}
+
+static void
+config_changed_cb (NMConfig *config,
+                   NMConfigData *config_data,
+                   NMConfigChangeFlags changes,
+                   NMConfigData *old_data,
+                   NMNetns *self)
+{
+	if (NM_FLAGS_HAS (changes, NM_CONFIG_CHANGE_CAUSE_SIGUSR1))
+		_log_multi_idx_stats (self);
+}
+
+/*****************************************************************************/
+
 static void
 set_property (GObject *object, guint prop_id,
               const GValue *value, GParamSpec *pspec)
@@ -118,6 +158,15 @@ constructed (GObject *object)
 
 	priv->platform_netns = nm_platform_netns_get (priv->platform);
 
+	/* NMConfig keeps us alive and may already be gone when we get disposed.
+	 * Let GObject disconnect the handler when we are destroyed, instead of
+	 * looking up the config singleton during dispose. */
+	g_signal_connect_object (nm_config_get (),
+	                         NM_CONFIG_SIGNAL_CONFIG_CHANGED,
+	                         G_CALLBACK (config_changed_cb),
+	                         self,
+	                         0);
+
 	G_OBJECT_CLASS (nm_netns_parent_class)->constructed (object);
 }
 
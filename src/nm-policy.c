@@ -62,6 +62,12 @@ NM_GOBJECT_PROPERTIES_DEFINE (NMPolicy,
 	PROP_ACTIVATING_IP6_AC,
 );
 
+typedef enum {
+	HEAP_ALL,
+	HEAP_ACTIVATED,
+	_HEAP_NUM,
+} HeapType;
+
 typedef struct {
 	NMManager *manager;
 	NMNetns *netns;
@@ -82,6 +88,15 @@ typedef struct {
 	NMActiveConnection *default_ac4, *activating_ac4;
 	NMActiveConnection *default_ac6, *activating_ac6;
 
+	/* Per address family, the devices that are candidates for the default
+	 * route. Binary min-heaps of DefaultRouteCandidate, so that the best
+	 * one is always at index zero. One heap holds all candidates, the other
+	 * one only those that are fully activated. */
+	struct {
+		GPtrArray *heaps[_HEAP_NUM];
+		GHashTable *by_device;
+	} default_route_candidates_x[2];
+
 	struct {
 		GInetAddress *addr;
 		GResolver *resolver;
@@ -150,6 +165,188 @@ static NMDevice *get_default_device (NMPolicy *self, int addr_family);
 
 /*****************************************************************************/
 
+typedef struct {
+	NMDevice *device;
+	guint32 metric;
+
+	/* the position in the heaps, or G_MAXUINT if it's not in one. */
+	guint heap_idx[_HEAP_NUM];
+
+	/* whether the device already has a default route. Otherwise, it is
+	 * still activating and its applied connection wants a default route. */
+	bool is_fully_activated:1;
+} DefaultRouteCandidate;
+
+static int
+_default_route_candidate_cmp (HeapType heap_type,
+                              const DefaultRouteCandidate *a,
+                              const DefaultRouteCandidate *b)
+{
+	NM_CMP_FIELD (a, b, metric);
+	if (heap_type == HEAP_ALL) {
+		/* on equal metric, an activated device beats an activating one. */
+		NM_CMP_FIELD_BOOL (b, a, is_fully_activated);
+	}
+	return 0;
+}
+
+static void
+_default_route_heap_swap (HeapType heap_type, GPtrArray *heap, guint i, guint j)
+{
+	DefaultRouteCandidate *a = heap->pdata[i];
+	DefaultRouteCandidate *b = heap->pdata[j];
+
+	heap->pdata[i] = b;
+	heap->pdata[j] = a;
+	b->heap_idx[heap_type] = i;
+	a->heap_idx[heap_type] = j;
+}
+
+static void
+_default_route_heap_sift (HeapType heap_type, GPtrArray *heap, guint idx)
+{
+	guint parent, child;
+
+	while (idx > 0) {
+		parent = (idx - 1) / 2;
+		if (_default_route_candidate_cmp (heap_type, heap->pdata[parent], heap->pdata[idx]) <= 0)
+			break;
+		_default_route_heap_swap (heap_type, heap, parent, idx);
+		idx = parent;
+	}
+
+	for (;;) {
+		child = 2 * idx + 1;
+		if (child >= heap->len)
+			break;
+		if (   child + 1 < heap->len
+		    && _default_route_candidate_cmp (heap_type, heap->pdata[child + 1], heap->pdata[child]) < 0)
+			child++;
+		if (_default_route_candidate_cmp (heap_type, heap->pdata[idx], heap->pdata[child]) <= 0)
+			break;
+		_default_route_heap_swap (heap_type, heap, idx, child);
+		idx = child;
+	}
+}
+
+static void
+_default_route_heap_add (HeapType heap_type, GPtrArray *heap, DefaultRouteCandidate *candidate)
+{
+	if (candidate->heap_idx[heap_type] == G_MAXUINT) {
+		candidate->heap_idx[heap_type] = heap->len;
+		g_ptr_array_add (heap, candidate);
+	}
+	_default_route_heap_sift (heap_type, heap, candidate->heap_idx[heap_type]);
+}
+
+static void
+_default_route_heap_remove (HeapType heap_type, GPtrArray *heap, DefaultRouteCandidate *candidate)
+{
+	guint idx = candidate->heap_idx[heap_type];
+
+	if (idx == G_MAXUINT)
+		return;
+
+	nm_assert (heap->pdata[idx] == candidate);
+	if (idx != heap->len - 1) {
+		_default_route_heap_swap (heap_type, heap, idx, heap->len - 1);
+		g_ptr_array_set_size (heap, heap->len - 1);
+		_default_route_heap_sift (heap_type, heap, idx);
+	} else
+		g_ptr_array_set_size (heap, heap->len - 1);
+	candidate->heap_idx[heap_type] = G_MAXUINT;
+}
+
+static gboolean
+_default_route_candidate_remove (NMPolicy *self, NMDevice *device, int addr_family)
+{
+	NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE (self);
+	const gboolean IS_IPv4 = (addr_family == AF_INET);
+	DefaultRouteCandidate *candidate;
+	HeapType heap_type;
+
+	candidate = g_hash_table_lookup (priv->default_route_candidates_x[IS_IPv4].by_device, device);
+	if (!candidate)
+		return FALSE;
+
+	g_hash_table_remove (priv->default_route_candidates_x[IS_IPv4].by_device, device);
+
+	for (heap_type = 0; heap_type < _HEAP_NUM; heap_type++)
+		_default_route_heap_remove (heap_type, priv->default_route_candidates_x[IS_IPv4].heaps[heap_type], candidate);
+
+	g_slice_free (DefaultRouteCandidate, candidate);
+	return TRUE;
+}
+
+/* Re-evaluate whether @device is a candidate for the default route and
+ * reposition it in the heap. This must be called whenever one of the
+ * inputs changes, that is the device state, the IP configuration, the
+ * applied connection or the route-metric. Returns whether the candidate
+ * changed. */
+static gboolean
+_default_route_candidate_update (NMPolicy *self, NMDevice *device, int addr_family)
+{
+	NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE (self);
+	const gboolean IS_IPv4 = (addr_family == AF_INET);
+	GPtrArray *const*heaps = priv->default_route_candidates_x[IS_IPv4].heaps;
+	DefaultRouteCandidate *candidate;
+	NMDeviceState state;
+	NMConnection *connection;
+	const NMPObject *r;
+	guint32 metric;
+	gboolean is_fully_activated;
+
+	state = nm_device_get_state (device);
+	if (   state <= NM_DEVICE_STATE_DISCONNECTED
+	    || state >= NM_DEVICE_STATE_DEACTIVATING
+	    || nm_device_sys_iface_state_is_external (device)
+	    || !nm_device_get_act_request (device))
+		goto remove;
+
+	r = nm_device_get_best_default_route (device, addr_family);
+	if (r) {
+		/* NOTE: the best route might have rt_source NM_IP_CONFIG_SOURCE_VPN,
+		 * which means it was injected by a VPN, not added by device.
+		 *
+		 * In this case, is it really the best device? Why do we even need the best
+		 * device?? */
+		metric = nm_utils_ip_route_metric_normalize (addr_family,
+		                                             NMP_OBJECT_CAST_IP_ROUTE (r)->metric);
+		is_fully_activated = TRUE;
+	} else if (   (connection = nm_device_get_applied_connection (device))
+	           && nm_utils_connection_has_default_route (connection, addr_family, NULL)) {
+		metric = nm_utils_ip_route_metric_normalize (addr_family,
+		                                             nm_device_get_route_metric (device, addr_family));
+		is_fully_activated = FALSE;
+	} else
+		goto remove;
+
+	candidate = g_hash_table_lookup (priv->default_route_candidates_x[IS_IPv4].by_device, device);
+	if (!candidate) {
+		candidate = g_slice_new (DefaultRouteCandidate);
+		candidate->device = device;
+		candidate->heap_idx[HEAP_ALL] = G_MAXUINT;
+		candidate->heap_idx[HEAP_ACTIVATED] = G_MAXUINT;
+		g_hash_table_insert (priv->default_route_candidates_x[IS_IPv4].by_device, device, candidate);
+	} else if (   candidate->metric == metric
+	           && candidate->is_fully_activated == is_fully_activated)
+		return FALSE;
+
+	candidate->metric = metric;
+	candidate->is_fully_activated = is_fully_activated;
+	_default_route_heap_add (HEAP_ALL, heaps[HEAP_ALL], candidate);
+	if (is_fully_activated)
+		_default_route_heap_add (HEAP_ACTIVATED, heaps[HEAP_ACTIVATED], candidate);
+	else
+		_default_route_heap_remove (HEAP_ACTIVATED, heaps[HEAP_ACTIVATED], candidate);
+	return TRUE;
+
+remove:
+	return _default_route_candidate_remove (self, device, addr_family);
+}
+
+/*****************************************************************************/
+
 typedef struct {
 	NMPlatformIP6Address prefix;
 	NMDevice *device;             /* The requesting ("uplink") device */
@@ -399,79 +596,43 @@ get_best_active_connection (NMPolicy *self,
                             gboolean fully_activated)
 {
 	NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE (self);
-	const CList *tmp_lst;
-	NMDevice *device;
-	guint32 best_metric = G_MAXUINT32;
-	gboolean best_is_fully_activated = FALSE;
-	NMActiveConnection *best_ac, *prev_ac;
+	const gboolean IS_IPv4 = (addr_family == AF_INET);
+	const HeapType heap_type = fully_activated ? HEAP_ACTIVATED : HEAP_ALL;
+	GPtrArray *heap = priv->default_route_candidates_x[IS_IPv4].heaps[heap_type];
+	const DefaultRouteCandidate *best;
+	const DefaultRouteCandidate *prev;
+	NMActiveConnection *prev_ac;
+	NMDevice *prev_device;
 
 	nm_assert (NM_IN_SET (addr_family, AF_INET, AF_INET6));
 
-	/* we prefer the current AC in case of identical metric.
-	 * Hence, try that one first. */
-	prev_ac = addr_family == AF_INET
-	              ? (fully_activated ? priv->default_ac4 : priv->activating_ac4)
-	              : (fully_activated ? priv->default_ac6 : priv->activating_ac6);
-	best_ac = NULL;
-
-	nm_manager_for_each_device (priv->manager, device, tmp_lst) {
-		NMDeviceState state;
-		const NMPObject *r;
-		NMActiveConnection *ac;
-		NMConnection *connection;
-		guint32 metric;
-		gboolean is_fully_activated;
-
-		state = nm_device_get_state (device);
-		if (   state <= NM_DEVICE_STATE_DISCONNECTED
-		    || state >= NM_DEVICE_STATE_DEACTIVATING)
-			continue;
-
-		if (nm_device_sys_iface_state_is_external (device))
-			continue;
-
-		r = nm_device_get_best_default_route (device, addr_family);
-		if (r) {
-			/* NOTE: the best route might have rt_source NM_IP_CONFIG_SOURCE_VPN,
-			 * which means it was injected by a VPN, not added by device.
-			 *
-			 * In this case, is it really the best device? Why do we even need the best
-			 * device?? */
-			metric = nm_utils_ip_route_metric_normalize (addr_family,
-			                                             NMP_OBJECT_CAST_IP_ROUTE (r)->metric);
-			is_fully_activated = TRUE;
-		} else if (   !fully_activated
-		           && (connection = nm_device_get_applied_connection (device))
-		           && nm_utils_connection_has_default_route (connection, addr_family, NULL)) {
-			metric = nm_utils_ip_route_metric_normalize (addr_family,
-			                                             nm_device_get_route_metric (device, addr_family));
-			is_fully_activated = FALSE;
-		} else
-			continue;
-
-		ac = (NMActiveConnection *) nm_device_get_act_request (device);
-		nm_assert (ac);
-
-		if (   !best_ac
-		    || (!best_is_fully_activated && is_fully_activated)
-		    || (   metric < best_metric
-		        || (metric == best_metric && ac == prev_ac))) {
-			best_ac = ac;
-			best_metric = metric;
-			best_is_fully_activated = is_fully_activated;
-		}
-	}
+	if (heap->len == 0)
+		return NULL;
 
+	best = heap->pdata[0];
 	if (   !fully_activated
-	    && best_ac
-	    && best_is_fully_activated) {
+	    && best->is_fully_activated) {
 		/* There's a best activating AC only if the best device
 		 * among all activating and already-activated devices is a
 		 * still-activating one. */
 		return NULL;
 	}
 
-	return best_ac;
+	/* we prefer the current AC in case of identical metric. */
+	prev_ac = IS_IPv4
+	              ? (fully_activated ? priv->default_ac4 : priv->activating_ac4)
+	              : (fully_activated ? priv->default_ac6 : priv->activating_ac6);
+	if (   prev_ac
+	    && (prev_device = nm_active_connection_get_device (prev_ac))
+	    && prev_device != best->device
+	    && (prev = g_hash_table_lookup (priv->default_route_candidates_x[IS_IPv4].by_device, prev_device))
+	    && prev->heap_idx[heap_type] != G_MAXUINT
+	    && _default_route_candidate_cmp (heap_type, prev, best) == 0
+	    && (NMActiveConnection *) nm_device_get_act_request (prev_device) == prev_ac)
+		best = prev;
+
+	nm_assert (nm_device_get_act_request (best->device));
+	return (NMActiveConnection *) nm_device_get_act_request (best->device);
 }
 
 static gboolean
@@ -1235,7 +1396,9 @@ auto_activate_device (NMPolicy *self,
 	if (!nm_device_autoconnect_allowed (device))
 		return;
 
-	connections = nm_manager_get_activatable_connections (priv->manager, TRUE, TRUE, &len);
+	/* The candidates are already restricted to connections that are not blocked,
+	 * have autoconnect enabled and a type that the device can handle. */
+	connections = nm_manager_get_autoconnect_candidates (priv->manager, device, &len);
 	if (!connections[0])
 		return;
 
@@ -1244,18 +1407,10 @@ auto_activate_device (NMPolicy *self,
 	for (i = 0; i < len; i++) {
 		NMSettingsConnection *candidate = connections[i];
 		NMConnection *cand_conn;
-		NMSettingConnection *s_con;
 		const char *permission;
 
-		if (nm_settings_connection_autoconnect_is_blocked (candidate))
-			continue;
-
 		cand_conn = nm_settings_connection_get_connection (candidate);
 
-		s_con = nm_connection_get_setting_connection (cand_conn);
-		if (!nm_setting_connection_get_autoconnect (s_con))
-			continue;
-
 		permission = nm_utils_get_shared_wifi_permission (cand_conn);
 		if (   permission
 		    && !nm_settings_connection_check_permission (candidate, permission))
@@ -1750,6 +1905,9 @@ device_state_changed (NMDevice *device,
 	NMIP6Config *ip6_config;
 	NMSettingConnection *s_con = NULL;
 
+	_default_route_candidate_update (self, device, AF_INET);
+	_default_route_candidate_update (self, device, AF_INET6);
+
 	switch (nm_device_state_reason_check (reason)) {
 	case NM_DEVICE_STATE_REASON_GSM_REGISTRATION_DENIED:
 	case NM_DEVICE_STATE_REASON_GSM_REGISTRATION_NOT_SEARCHING:
@@ -1944,6 +2102,24 @@ device_state_changed (NMDevice *device,
 	check_activating_active_connections (self);
 }
 
+static gboolean
+_default_route_winner_affected (NMPolicy *self, NMDevice *device, int addr_family)
+{
+	NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE (self);
+	NMActiveConnection *default_ac;
+	NMActiveConnection *best_ac;
+
+	default_ac = (addr_family == AF_INET) ? priv->default_ac4 : priv->default_ac6;
+	if (   !default_ac
+	    || NM_IS_VPN_CONNECTION (default_ac)
+	    || nm_active_connection_get_device (default_ac) == device)
+		return TRUE;
+
+	best_ac = get_best_active_connection (self, addr_family, TRUE);
+	return    best_ac != default_ac
+	       || nm_active_connection_get_device (best_ac) == device;
+}
+
 static void
 device_ip_config_changed (NMDevice *device,
                           NMIPConfig *new_config,
@@ -1964,6 +2140,8 @@ device_ip_config_changed (NMDevice *device,
 	} else
 		addr_family = nm_ip_config_get_addr_family (old_config);
 
+	_default_route_candidate_update (self, device, addr_family);
+
 	nm_dns_manager_begin_updates (priv->dns_manager, __func__);
 
 	/* We catch already all the IP events registering on the device state changes but
@@ -1978,6 +2156,12 @@ device_ip_config_changed (NMDevice *device,
 			if (old_config)
 				nm_dns_manager_set_ip_config (priv->dns_manager, old_config, NM_DNS_IP_CONFIG_TYPE_REMOVED);
 		}
+
+		/* If this device neither was nor becomes the best device, the change cannot
+		 * affect the default route, the preferred DNS configuration or the hostname. */
+		if (!_default_route_winner_affected (self, device, addr_family))
+			goto out;
+
 		update_ip_dns (self, addr_family);
 		if (addr_family == AF_INET)
 			update_ip4_routing (self, TRUE);
@@ -1993,11 +2177,30 @@ device_ip_config_changed (NMDevice *device,
 			nm_dns_manager_set_ip_config (priv->dns_manager, old_config, NM_DNS_IP_CONFIG_TYPE_REMOVED);
 	}
 
+out:
 	nm_dns_manager_end_updates (priv->dns_manager, __func__);
 }
 
 /*****************************************************************************/
 
+static void
+device_recheck_default_route (NMDevice *device, gpointer user_data)
+{
+	NMPolicyPrivate *priv = user_data;
+	NMPolicy *self = _PRIV_TO_SELF (priv);
+	gboolean changed4, changed6;
+
+	changed4 = _default_route_candidate_update (self, device, AF_INET);
+	changed6 = _default_route_candidate_update (self, device, AF_INET6);
+
+	if (nm_device_get_state (device) != NM_DEVICE_STATE_ACTIVATED)
+		return;
+
+	if (   (changed4 && _default_route_winner_affected (self, device, AF_INET))
+	    || (changed6 && _default_route_winner_affected (self, device, AF_INET6)))
+		update_routing_and_dns (self, TRUE);
+}
+
 static void
 device_autoconnect_changed (NMDevice *device,
                             GParamSpec *pspec,
@@ -2024,6 +2227,9 @@ devices_list_unregister (NMPolicy *self, NMDevice *device)
 	NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE (self);
 
 	g_signal_handlers_disconnect_by_data ((GObject *) device, priv);
+
+	_default_route_candidate_remove (self, device, AF_INET);
+	_default_route_candidate_remove (self, device, AF_INET6);
 }
 
 static void
@@ -2039,6 +2245,10 @@ devices_list_register (NMPolicy *self, NMDevice *device)
 	g_signal_connect       (device, NM_DEVICE_IP6_SUBNET_NEEDED,      (GCallback) device_ip6_subnet_needed, priv);
 	g_signal_connect       (device, "notify::" NM_DEVICE_AUTOCONNECT, (GCallback) device_autoconnect_changed, priv);
 	g_signal_connect       (device, NM_DEVICE_RECHECK_AUTO_ACTIVATE,  (GCallback) device_recheck_auto_activate, priv);
+	g_signal_connect       (device, NM_DEVICE_RECHECK_DEFAULT_ROUTE,  (GCallback) device_recheck_default_route, priv);
+
+	_default_route_candidate_update (self, device, AF_INET);
+	_default_route_candidate_update (self, device, AF_INET6);
 }
 
 static void
@@ -2515,6 +2725,7 @@ nm_policy_init (NMPolicy *self)
 {
 	NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE (self);
 	const char *hostname_mode;
+	guint i;
 
 	c_list_init (&priv->pending_activation_checks);
 
@@ -2534,6 +2745,11 @@ nm_policy_init (NMPolicy *self)
 		priv->hostname_mode = NM_POLICY_HOSTNAME_MODE_FULL;
 
 	priv->devices = g_hash_table_new (nm_direct_hash, NULL);
+	for (i = 0; i < 2; i++) {
+		priv->default_route_candidates_x[i].heaps[HEAP_ALL] = g_ptr_array_new ();
+		priv->default_route_candidates_x[i].heaps[HEAP_ACTIVATED] = g_ptr_array_new ();
+		priv->default_route_candidates_x[i].by_device = g_hash_table_new (nm_direct_hash, NULL);
+	}
 	priv->pending_active_connections = g_hash_table_new (nm_direct_hash, NULL);
 	priv->ip6_prefix_delegations = g_array_new (FALSE, FALSE, sizeof (IP6PrefixDelegation));
 	g_array_set_clear_func (priv->ip6_prefix_delegations, clear_ip6_prefix_delegation);
@@ -2695,8 +2911,20 @@ finalize (GObject *object)
 {
 	NMPolicy *self = NM_POLICY (object);
 	NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE (self);
+	guint i;
 
 	g_hash_table_unref (priv->devices);
+	for (i = 0; i < 2; i++) {
+		GPtrArray *heap = priv->default_route_candidates_x[i].heaps[HEAP_ALL];
+		guint j;
+
+		/* every candidate is in the heap of all candidates. */
+		for (j = 0; j < heap->len; j++)
+			g_slice_free (DefaultRouteCandidate, heap->pdata[j]);
+		g_ptr_array_unref (heap);
+		g_ptr_array_unref (priv->default_route_candidates_x[i].heaps[HEAP_ACTIVATED]);
+		g_hash_table_unref (priv->default_route_candidates_x[i].by_device);
+	}
 
 	G_OBJECT_CLASS (nm_policy_parent_class)->finalize (object);
 
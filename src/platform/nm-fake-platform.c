@@ -48,6 +48,12 @@ typedef struct {
 typedef struct {
 	GHashTable *options;
 	GArray *links;
+	guint sysctl_async_delay_msec;
+
+	/* statistics of the asynchronous sysctl writes, for the tests. */
+	int sysctl_async_running;
+	int sysctl_async_running_max;
+	GPtrArray *sysctl_async_log;
 } NMFakePlatformPrivate;
 
 struct _NMFakePlatform {
@@ -160,6 +166,158 @@ sysctl_get (NMPlatform *platform, const char *pathid, int dirfd, const char *pat
 	return g_strdup (g_hash_table_lookup (priv->options, path));
 }
 
+typedef struct {
+	char *path;
+	char **values;
+	NMPlatformAsyncCallback callback;
+	gpointer callback_data;
+	guint delay_msec;
+	guint n_written;
+} SysctlAsyncInfo;
+
+static void
+sysctl_async_info_free (SysctlAsyncInfo *info)
+{
+	g_free (info->path);
+	g_strfreev (info->values);
+	g_slice_free (SysctlAsyncInfo, info);
+}
+
+static void
+sysctl_set_async_thread_fn (GTask *task,
+                            gpointer source_object,
+                            gpointer task_data,
+                            GCancellable *cancellable)
+{
+	NMFakePlatformPrivate *priv = NM_FAKE_PLATFORM_GET_PRIVATE ((NMFakePlatform *) source_object);
+	SysctlAsyncInfo *info = task_data;
+	int running, running_max;
+
+	running = g_atomic_int_add (&priv->sysctl_async_running, 1) + 1;
+	do {
+		running_max = g_atomic_int_get (&priv->sysctl_async_running_max);
+	} while (   running > running_max
+	         && !g_atomic_int_compare_and_exchange (&priv->sysctl_async_running_max, running_max, running));
+
+	/* pretend to be a slow kernel, like a driver creating SR-IOV VFs. Like
+	 * the real implementation, write the values one after the other. The
+	 * options table is only touched on the main context. */
+	for (info->n_written = 0; info->values[info->n_written]; info->n_written++) {
+		if (g_cancellable_is_cancelled (cancellable))
+			break;
+		if (info->delay_msec)
+			g_usleep (((gulong) info->delay_msec) * 1000);
+	}
+
+	g_atomic_int_add (&priv->sysctl_async_running, -1);
+
+	if (!g_task_return_error_if_cancelled (task))
+		g_task_return_boolean (task, TRUE);
+}
+
+static void
+sysctl_set_async_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	NMFakePlatformPrivate *priv = NM_FAKE_PLATFORM_GET_PRIVATE ((NMFakePlatform *) source);
+	GTask *task = G_TASK (result);
+	SysctlAsyncInfo *info = g_task_get_task_data (task);
+	gs_free_error GError *error = NULL;
+	guint i;
+
+	g_task_propagate_boolean (task, &error);
+
+	/* apply the values that the worker wrote, in order. */
+	for (i = 0; i < info->n_written; i++) {
+		g_hash_table_insert (priv->options, g_strdup (info->path), g_strdup (info->values[i]));
+		g_ptr_array_add (priv->sysctl_async_log, g_strdup_printf ("%s=%s", info->path, info->values[i]));
+	}
+
+	if (info->callback)
+		info->callback (error, info->callback_data);
+}
+
+static void
+sysctl_set_async (NMPlatform *platform,
+                  const char *pathid,
+                  int dirfd,
+                  const char *path,
+                  const char *const *values,
+                  NMPlatformAsyncCallback callback,
+                  gpointer data,
+                  GCancellable *cancellable)
+{
+	NMFakePlatformPrivate *priv = NM_FAKE_PLATFORM_GET_PRIVATE ((NMFakePlatform *) platform);
+	SysctlAsyncInfo *info;
+	GTask *task;
+
+	ASSERT_SYSCTL_ARGS (pathid, dirfd, path);
+
+	info = g_slice_new0 (SysctlAsyncInfo);
+	info->path = g_strdup (path);
+	info->values = g_strdupv ((char **) values);
+	info->callback = callback;
+	info->callback_data = data;
+	info->delay_msec = priv->sysctl_async_delay_msec;
+
+	task = g_task_new (platform, cancellable, sysctl_set_async_cb, NULL);
+	g_task_set_task_data (task, info, (GDestroyNotify) sysctl_async_info_free);
+	nm_platform_task_run_in_thread (task, sysctl_set_async_thread_fn);
+	g_object_unref (task);
+}
+
+/**
+ * nm_fake_platform_set_sysctl_async_delay:
+ * @platform: the fake platform instance
+ * @delay_msec: how long each asynchronous sysctl write takes
+ *
+ * Lets tests emulate sysfs attributes that block in the kernel, to
+ * measure how well asynchronous operations run in parallel.
+ */
+void
+nm_fake_platform_set_sysctl_async_delay (NMPlatform *platform, guint delay_msec)
+{
+	g_return_if_fail (NM_IS_FAKE_PLATFORM (platform));
+
+	NM_FAKE_PLATFORM_GET_PRIVATE ((NMFakePlatform *) platform)->sysctl_async_delay_msec = delay_msec;
+}
+
+/**
+ * nm_fake_platform_get_sysctl_async_stats:
+ * @platform: the fake platform instance
+ * @out_running_max: (allow-none): the largest number of asynchronous sysctl
+ *   writes that were in progress at the same time
+ *
+ * Returns: (transfer none): the completed asynchronous writes as "path=value"
+ *   strings, in the order in which they were written.
+ */
+const GPtrArray *
+nm_fake_platform_get_sysctl_async_stats (NMPlatform *platform, guint *out_running_max)
+{
+	NMFakePlatformPrivate *priv;
+
+	g_return_val_if_fail (NM_IS_FAKE_PLATFORM (platform), NULL);
+
+	priv = NM_FAKE_PLATFORM_GET_PRIVATE ((NMFakePlatform *) platform);
+	NM_SET_OUT (out_running_max, g_atomic_int_get (&priv->sysctl_async_running_max));
+	return priv->sysctl_async_log;
+}
+
+/**
+ * nm_fake_platform_reset_sysctl_async_stats:
+ * @platform: the fake platform instance
+ */
+void
+nm_fake_platform_reset_sysctl_async_stats (NMPlatform *platform)
+{
+	NMFakePlatformPrivate *priv;
+
+	g_return_if_fail (NM_IS_FAKE_PLATFORM (platform));
+
+	priv = NM_FAKE_PLATFORM_GET_PRIVATE ((NMFakePlatform *) platform);
+	g_atomic_int_set (&priv->sysctl_async_running_max, 0);
+	g_ptr_array_set_size (priv->sysctl_async_log, 0);
+}
+
 static NMFakePlatformLink *
 link_get (NMPlatform *platform, int ifindex)
 {
@@ -1347,6 +1505,7 @@ nm_fake_platform_init (NMFakePlatform *fake_platform)
 
 	priv->options = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, g_free);
 	priv->links = g_array_new (TRUE, TRUE, sizeof (NMFakePlatformLink));
+	priv->sysctl_async_log = g_ptr_array_new_with_free_func (g_free);
 }
 
 void
@@ -1383,6 +1542,7 @@ finalize (GObject *object)
 		g_clear_pointer (&device->obj, nmp_object_unref);
 	}
 	g_array_unref (priv->links);
+	g_ptr_array_unref (priv->sysctl_async_log);
 
 	G_OBJECT_CLASS (nm_fake_platform_parent_class)->finalize (object);
 }
@@ -1397,6 +1557,7 @@ nm_fake_platform_class_init (NMFakePlatformClass *klass)
 
 	platform_class->sysctl_set = sysctl_set;
 	platform_class->sysctl_get = sysctl_get;
+	platform_class->sysctl_set_async = sysctl_set_async;
 
 	platform_class->link_add = link_add;
 	platform_class->link_delete = link_delete;
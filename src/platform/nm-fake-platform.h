@@ -37,4 +37,8 @@ GType nm_fake_platform_get_type (void);
 
 void nm_fake_platform_setup (void);
 
+void nm_fake_platform_set_sysctl_async_delay (NMPlatform *platform, guint delay_msec);
+const GPtrArray *nm_fake_platform_get_sysctl_async_stats (NMPlatform *platform, guint *out_running_max);
+void nm_fake_platform_reset_sysctl_async_stats (NMPlatform *platform);
+
 #endif /* __NETWORKMANAGER_FAKE_PLATFORM_H__ */
@@ -372,6 +372,14 @@ typedef struct {
 	bool sysctl_get_warned;
 	GHashTable *sysctl_get_prev_values;
 
+	/* ifindex -> EthtoolCacheEntry */
+	GHashTable *ethtool_cache;
+	guint64 ethtool_cache_generation;
+
+	/* result of the last lookup for a link that is not in the platform
+	 * cache. Such links never get a RTM_DELLINK to invalidate an entry. */
+	NMPlatformEthtoolInfo ethtool_info_uncached;
+
 	NMUdevClient *udev_client;
 
 	struct {
@@ -471,6 +479,7 @@ static void cache_on_change (NMPlatform *platform,
 static void cache_prune_all (NMPlatform *platform);
 static gboolean event_handler_read_netlink (NMPlatform *platform, gboolean wait_for_acks);
 static struct nl_sock *_genl_sock (NMLinuxPlatform *platform);
+static void ethtool_cache_invalidate (NMPlatform *platform, int ifindex);
 
 /*****************************************************************************/
 
@@ -3823,6 +3832,156 @@ sysctl_set (NMPlatform *platform, const char *pathid, int dirfd, const char *pat
 	return TRUE;
 }
 
+typedef struct {
+	char *pathid;
+	char *path;
+	char **values;
+	NMPlatformAsyncCallback callback;
+	gpointer callback_data;
+	int dirfd;
+} SysctlAsyncInfo;
+
+static void
+sysctl_async_info_free (SysctlAsyncInfo *info)
+{
+	if (info->dirfd >= 0)
+		nm_close (info->dirfd);
+	g_free (info->pathid);
+	g_free (info->path);
+	g_strfreev (info->values);
+	g_slice_free (SysctlAsyncInfo, info);
+}
+
+static void
+sysctl_set_async_thread_fn (GTask *task,
+                            gpointer source_object,
+                            gpointer task_data,
+                            GCancellable *cancellable)
+{
+	SysctlAsyncInfo *info = task_data;
+	char **value;
+
+	/* This runs on a worker thread. Only touch @info and don't log,
+	 * everything else happens on the main context in sysctl_set_async_cb(). */
+
+	for (value = info->values; *value; value++) {
+		nm_auto_close int fd = -1;
+		gs_free char *actual = NULL;
+		gssize nwrote;
+		gsize len;
+		int errsv;
+
+		if (g_task_return_error_if_cancelled (task))
+			return;
+
+		fd = openat (info->dirfd, info->path, O_WRONLY | O_TRUNC | O_CLOEXEC);
+		if (fd == -1) {
+			errsv = errno;
+			g_task_return_new_error (task, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+			                         "failed to open '%s': %s",
+			                         info->pathid, g_strerror (errsv));
+			return;
+		}
+
+		/* See sysctl_set() about the trailing LF. */
+		actual = g_strconcat (*value, "\n", NULL);
+		len = strlen (actual);
+		do {
+			nwrote = write (fd, actual, len);
+		} while (nwrote == -1 && errno == EINTR);
+
+		if (nwrote == -1 || (gsize) nwrote != len) {
+			errsv = (nwrote == -1) ? errno : EIO;
+			g_task_return_new_error (task, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+			                         "failed to set '%s' to '%s': %s",
+			                         info->pathid, *value, g_strerror (errsv));
+			return;
+		}
+	}
+
+	g_task_return_boolean (task, TRUE);
+}
+
+static void
+sysctl_set_async_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	NMPlatform *platform = NM_PLATFORM (source);
+	GTask *task = G_TASK (result);
+	SysctlAsyncInfo *info = g_task_get_task_data (task);
+	gs_free_error GError *error = NULL;
+
+	if (g_task_propagate_boolean (task, &error)) {
+		gs_free char *values_str = NULL;
+
+		_LOGD ("sysctl: successfully set '%s' to '%s'",
+		       info->pathid,
+		       (values_str = g_strjoinv ("', '", info->values)));
+	} else if (!nm_utils_error_is_cancelled (error, FALSE))
+		_LOGW ("sysctl: %s", error->message);
+
+	if (info->callback)
+		info->callback (error, info->callback_data);
+}
+
+static void
+sysctl_set_async (NMPlatform *platform,
+                  const char *pathid,
+                  int dirfd,
+                  const char *path,
+                  const char *const *values,
+                  NMPlatformAsyncCallback callback,
+                  gpointer data,
+                  GCancellable *cancellable)
+{
+	SysctlAsyncInfo *info;
+	GTask *task;
+	int errsv;
+
+	ASSERT_SYSCTL_ARGS (pathid, dirfd, path);
+
+	info = g_slice_new0 (SysctlAsyncInfo);
+	info->values = g_strdupv ((char **) values);
+	info->callback = callback;
+	info->callback_data = data;
+
+	/* The worker thread can neither switch the network namespace nor
+	 * rely on @dirfd staying open. Resolve the parent directory here,
+	 * and only pass on our own file descriptor. */
+	if (dirfd < 0) {
+		nm_auto_pop_netns NMPNetns *netns = NULL;
+		gs_free char *dirname = NULL;
+
+		info->pathid = g_strdup (path);
+		info->path = g_path_get_basename (path);
+		if (!nm_platform_netns_push (platform, &netns)) {
+			info->dirfd = -1;
+			errsv = ENETDOWN;
+		} else {
+			dirname = g_path_get_dirname (path);
+			info->dirfd = open (dirname, O_PATH | O_DIRECTORY | O_CLOEXEC);
+			errsv = errno;
+		}
+	} else {
+		info->pathid = g_strdup (pathid);
+		info->path = g_strdup (path);
+		info->dirfd = fcntl (dirfd, F_DUPFD_CLOEXEC, 0);
+		errsv = errno;
+	}
+
+	task = g_task_new (platform, cancellable, sysctl_set_async_cb, NULL);
+	g_task_set_task_data (task, info, (GDestroyNotify) sysctl_async_info_free);
+
+	if (info->dirfd < 0) {
+		/* GTask takes care that the callback is not invoked synchronously. */
+		g_task_return_new_error (task, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+		                         "failed to open parent directory of '%s': %s",
+		                         info->pathid, g_strerror (errsv));
+	} else
+		nm_platform_task_run_in_thread (task, sysctl_set_async_thread_fn);
+
+	g_object_unref (task);
+}
+
 static GSList *sysctl_clear_cache_list;
 
 static void
@@ -4477,6 +4636,16 @@ cache_on_change (NMPlatform *platform,
 			         && obj_new->_link.netlink.is_in_netlink != obj_old->_link.netlink.is_in_netlink)
 				ifindex = obj_new->link.ifindex;
 
+			/* Drop the cached ethtool information when the link goes away or
+			 * gets renamed. Also when it changes IFF_UP, because some drivers
+			 * only report their capabilities while the link is up. */
+			if (   cache_op == NMP_CACHE_OPS_REMOVED
+			    || (   cache_op == NMP_CACHE_OPS_UPDATED
+			        && obj_old && obj_new /* <-- nonsensical, make coverity happy */
+			        && (   !nm_streq (obj_old->link.name, obj_new->link.name)
+			            || NM_FLAGS_HAS (obj_old->link.n_ifi_flags ^ obj_new->link.n_ifi_flags, IFF_UP))))
+				ethtool_cache_invalidate (platform, (obj_old ?: obj_new)->link.ifindex);
+
 			if (ifindex > 0) {
 				delayed_action_schedule (platform,
 				                         DELAYED_ACTION_TYPE_REFRESH_ALL_IP4_ADDRESSES |
@@ -5590,25 +5759,233 @@ link_set_token (NMPlatform *platform, int ifindex, NMUtilsIPv6IfaceId iid)
 	return do_change_link (platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL) == NM_PLATFORM_ERROR_SUCCESS;
 }
 
-static gboolean
-link_supports_carrier_detect (NMPlatform *platform, int ifindex)
+/*****************************************************************************/
+
+typedef struct {
+	NMPlatformEthtoolInfo info;
+
+	/* asynchronous results are only merged into the entry, if it
+	 * was not invalidated in the meantime. */
+	guint64 generation;
+} EthtoolCacheEntry;
+
+static void
+ethtool_cache_entry_free (EthtoolCacheEntry *entry)
+{
+	g_slice_free (EthtoolCacheEntry, entry);
+}
+
+static EthtoolCacheEntry *
+ethtool_cache_entry_get (NMPlatform *platform, int ifindex, gboolean create)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+	EthtoolCacheEntry *entry;
+
+	entry = g_hash_table_lookup (priv->ethtool_cache, GINT_TO_POINTER (ifindex));
+	if (!entry && create) {
+		entry = g_slice_new0 (EthtoolCacheEntry);
+		entry->generation = ++priv->ethtool_cache_generation;
+		g_hash_table_insert (priv->ethtool_cache, GINT_TO_POINTER (ifindex), entry);
+	}
+	return entry;
+}
+
+static void
+ethtool_cache_invalidate (NMPlatform *platform, int ifindex)
+{
+	NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE (platform);
+
+	if (g_hash_table_remove (priv->ethtool_cache, GINT_TO_POINTER (ifindex)))
+		_LOGt ("ethtool: drop cached information for link %d", ifindex);
+}
+
+static void
+ethtool_info_merge (NMPlatformEthtoolInfo *dst, const NMPlatformEthtoolInfo *src)
+{
+	NMPlatformEthtoolInfoFlags missing = src->valid & ~dst->valid;
+
+	if (NM_FLAGS_HAS (missing, NM_PLATFORM_ETHTOOL_INFO_DRIVER)) {
+		dst->has_driver_info = src->has_driver_info;
+		memcpy (dst->driver, src->driver, sizeof (dst->driver));
+		memcpy (dst->driver_version, src->driver_version, sizeof (dst->driver_version));
+		memcpy (dst->fw_version, src->fw_version, sizeof (dst->fw_version));
+	}
+	if (NM_FLAGS_HAS (missing, NM_PLATFORM_ETHTOOL_INFO_PERM_ADDR)) {
+		dst->perm_addr_len = src->perm_addr_len;
+		memcpy (dst->perm_addr, src->perm_addr, sizeof (dst->perm_addr));
+	}
+	if (NM_FLAGS_HAS (missing, NM_PLATFORM_ETHTOOL_INFO_CARRIER_DETECT))
+		dst->supports_carrier_detect = src->supports_carrier_detect;
+	if (NM_FLAGS_HAS (missing, NM_PLATFORM_ETHTOOL_INFO_VLANS))
+		dst->supports_vlans = src->supports_vlans;
+	dst->valid |= missing;
+}
+
+static const NMPlatformEthtoolInfo *
+ethtool_info_get (NMPlatform *platform, int ifindex, NMPlatformEthtoolInfoFlags request)
 {
 	nm_auto_pop_netns NMPNetns *netns = NULL;
+	NMPUtilsEthtoolHandle *handle;
+	EthtoolCacheEntry *entry;
+
+	entry = ethtool_cache_entry_get (platform, ifindex, FALSE);
+	if (   entry
+	    && !NM_FLAGS_ANY (request, ~entry->info.valid))
+		return &entry->info;
 
 	if (!nm_platform_netns_push (platform, &netns))
-		return FALSE;
+		return NULL;
+
+	handle = nmp_utils_ethtool_handle_new (ifindex);
+	if (!handle)
+		return NULL;
+
+	if (!nm_platform_link_get (platform, ifindex)) {
+		NMPlatformEthtoolInfo *info = &NM_LINUX_PLATFORM_GET_PRIVATE (platform)->ethtool_info_uncached;
+
+		memset (info, 0, sizeof (*info));
+		nmp_utils_ethtool_handle_get_info (handle, request, info);
+		nmp_utils_ethtool_handle_free (handle);
+		return info;
+	}
+
+	entry = ethtool_cache_entry_get (platform, ifindex, TRUE);
+	nmp_utils_ethtool_handle_get_info (handle, request, &entry->info);
+	nmp_utils_ethtool_handle_free (handle);
+	return &entry->info;
+}
+
+typedef struct {
+	NMPUtilsEthtoolHandle *handle;
+	NMPlatformEthtoolInfo info;
+	NMPlatformEthtoolInfoFlags request;
+	NMPlatformEthtoolInfoCallback callback;
+	gpointer callback_data;
+	guint64 generation;
+	int ifindex;
+} EthtoolAsyncInfo;
+
+static void
+ethtool_async_info_free (EthtoolAsyncInfo *info)
+{
+	nmp_utils_ethtool_handle_free (info->handle);
+	g_slice_free (EthtoolAsyncInfo, info);
+}
+
+static void
+ethtool_info_get_async_thread_fn (GTask *task,
+                                  gpointer source_object,
+                                  gpointer task_data,
+                                  GCancellable *cancellable)
+{
+	EthtoolAsyncInfo *info = task_data;
+
+	if (info->handle)
+		nmp_utils_ethtool_handle_get_info (info->handle, info->request, &info->info);
+	g_task_return_boolean (task, TRUE);
+}
+
+static void
+ethtool_info_get_async_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	NMPlatform *platform = NM_PLATFORM (source);
+	GTask *task = G_TASK (result);
+	EthtoolAsyncInfo *info = g_task_get_task_data (task);
+	gs_free_error GError *error = NULL;
+	EthtoolCacheEntry *entry;
+
+	if (!g_task_propagate_boolean (task, &error)) {
+		info->callback (NULL, error, info->callback_data);
+		return;
+	}
+
+	if (!info->handle) {
+		/* the result came from the cache or the link is gone. */
+		info->callback (   NM_FLAGS_ANY (info->request, ~info->info.valid)
+		                ? NULL
+		                : &info->info,
+		                NULL,
+		                info->callback_data);
+		return;
+	}
+
+	entry = ethtool_cache_entry_get (platform, info->ifindex, FALSE);
+	if (!entry && info->generation == 0) {
+		/* there was no cache entry when we started. Create one, unless the
+		 * link was removed in the meantime. */
+		if (nm_platform_link_get (platform, info->ifindex))
+			entry = ethtool_cache_entry_get (platform, info->ifindex, TRUE);
+	} else if (entry && entry->generation != info->generation)
+		entry = NULL;
+
+	if (entry) {
+		ethtool_info_merge (&entry->info, &info->info);
+		info->callback (&entry->info, NULL, info->callback_data);
+	} else
+		info->callback (&info->info, NULL, info->callback_data);
+}
+
+static void
+link_get_ethtool_info_async (NMPlatform *platform,
+                             int ifindex,
+                             NMPlatformEthtoolInfoFlags request,
+                             NMPlatformEthtoolInfoCallback callback,
+                             gpointer callback_data,
+                             GCancellable *cancellable)
+{
+	EthtoolAsyncInfo *info;
+	EthtoolCacheEntry *entry;
+	GTask *task;
+
+	info = g_slice_new0 (EthtoolAsyncInfo);
+	info->ifindex = ifindex;
+	info->request = request;
+	info->callback = callback;
+	info->callback_data = callback_data;
+
+	entry = ethtool_cache_entry_get (platform, ifindex, FALSE);
+	if (entry) {
+		info->info = entry->info;
+		info->generation = entry->generation;
+	}
+
+	if (NM_FLAGS_ANY (request, ~info->info.valid)) {
+		nm_auto_pop_netns NMPNetns *netns = NULL;
+
+		/* the ioctls may block for a long time with some drivers. The
+		 * handle binds the socket and the ifname to our netns, so that
+		 * the worker thread does not need to switch namespaces. */
+		if (nm_platform_netns_push (platform, &netns))
+			info->handle = nmp_utils_ethtool_handle_new (ifindex);
+	}
+
+	task = g_task_new (platform, cancellable, ethtool_info_get_async_cb, NULL);
+	g_task_set_task_data (task, info, (GDestroyNotify) ethtool_async_info_free);
+	if (info->handle)
+		nm_platform_task_run_in_thread (task, ethtool_info_get_async_thread_fn);
+	else
+		g_task_return_boolean (task, TRUE);
+	g_object_unref (task);
+}
+
+static gboolean
+link_supports_carrier_detect (NMPlatform *platform, int ifindex)
+{
+	const NMPlatformEthtoolInfo *info;
 
 	/* We use netlink for the actual carrier detection, but netlink can't tell
 	 * us whether the device actually supports carrier detection in the first
-	 * place. We assume any device that does implements one of these two APIs.
+	 * place. We assume any device that does implements one of the ethtool
+	 * or MII APIs.
 	 */
-	return nmp_utils_ethtool_supports_carrier_detect (ifindex) || nmp_utils_mii_supports_carrier_detect (ifindex);
+	info = ethtool_info_get (platform, ifindex, NM_PLATFORM_ETHTOOL_INFO_CARRIER_DETECT);
+	return info && info->supports_carrier_detect;
 }
 
 static gboolean
 link_supports_vlans (NMPlatform *platform, int ifindex)
 {
-	nm_auto_pop_netns NMPNetns *netns = NULL;
+	const NMPlatformEthtoolInfo *info;
 	const NMPObject *obj;
 
 	obj = nm_platform_link_get_obj (platform, ifindex, TRUE);
@@ -5617,10 +5994,8 @@ link_supports_vlans (NMPlatform *platform, int ifindex)
 	if (!obj || obj->link.arptype != ARPHRD_ETHER)
 		return FALSE;
 
-	if (!nm_platform_netns_push (platform, &netns))
-		return FALSE;
-
-	return nmp_utils_ethtool_supports_vlans (ifindex);
+	info = ethtool_info_get (platform, ifindex, NM_PLATFORM_ETHTOOL_INFO_VLANS);
+	return info && info->supports_vlans;
 }
 
 static gboolean
@@ -5704,12 +6079,15 @@ link_get_permanent_address (NMPlatform *platform,
                             guint8 *buf,
                             size_t *length)
 {
-	nm_auto_pop_netns NMPNetns *netns = NULL;
+	const NMPlatformEthtoolInfo *info;
 
-	if (!nm_platform_netns_push (platform, &netns))
+	info = ethtool_info_get (platform, ifindex, NM_PLATFORM_ETHTOOL_INFO_PERM_ADDR);
+	if (!info || !info->perm_addr_len)
 		return FALSE;
 
-	return nmp_utils_ethtool_get_permanent_address (ifindex, buf, length);
+	memcpy (buf, info->perm_addr, info->perm_addr_len);
+	*length = info->perm_addr_len;
+	return TRUE;
 }
 
 static NMPlatformError
@@ -5733,33 +6111,64 @@ nla_put_failure:
 	g_return_val_if_reached (FALSE);
 }
 
-static gboolean
-link_set_sriov_params (NMPlatform *platform,
-                       int ifindex,
-                       guint num_vfs,
-                       int autoprobe)
+static void
+sriov_idle_cb (gpointer user_data,
+               GCancellable *cancellable)
+{
+	gs_unref_object NMPlatform *platform = NULL;
+	gs_free_error GError *cancelled_error = NULL;
+	gs_free_error GError *error = NULL;
+	NMPlatformAsyncCallback callback;
+	gpointer callback_data;
+
+	nm_utils_user_data_unpack (user_data, &platform, &error, &callback, &callback_data);
+
+	g_cancellable_set_error_if_cancelled (cancellable, &cancelled_error);
+	callback (cancelled_error ?: error, callback_data);
+}
+
+static void
+link_set_sriov_params_async (NMPlatform *platform,
+                             int ifindex,
+                             guint num_vfs,
+                             int autoprobe,
+                             NMPlatformAsyncCallback callback,
+                             gpointer data,
+                             GCancellable *cancellable)
 {
 	nm_auto_pop_netns NMPNetns *netns = NULL;
+	gs_free_error GError *error = NULL;
 	nm_auto_close int dirfd = -1;
 	gboolean current_autoprobe;
 	guint total, current_num;
+	const char *values[3];
+	guint n_values = 0;
 	char ifname[IFNAMSIZ];
 	char buf[64];
 
-	if (!nm_platform_netns_push (platform, &netns))
-		return FALSE;
+	if (!nm_platform_netns_push (platform, &netns)) {
+		g_set_error_literal (&error, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+		                     "couldn't change namespace");
+		goto out_idle;
+	}
 
 	dirfd = nm_platform_sysctl_open_netdir (platform, ifindex, ifname);
-	if (!dirfd)
-		return FALSE;
+	if (dirfd < 0) {
+		g_set_error (&error, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+		             "couldn't open sysfs directory of link %d", ifindex);
+		goto out_idle;
+	}
 
 	total = nm_platform_sysctl_get_int_checked (platform,
 	                                            NMP_SYSCTL_PATHID_NETDIR (dirfd,
 	                                                                      ifname,
 	                                                                      "device/sriov_totalvfs"),
 	                                            10, 0, G_MAXUINT, 0);
-	if (errno)
-		return FALSE;
+	if (errno) {
+		g_set_error (&error, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+		             "failed reading sriov_totalvfs value: %s", g_strerror (errno));
+		goto out_idle;
+	}
 	if (num_vfs > total) {
 		_LOGW ("link: %d only supports %u VFs (requested %u)", ifindex, total, num_vfs);
 		num_vfs = total;
@@ -5783,44 +6192,58 @@ link_set_sriov_params (NMPlatform *platform,
 	                                                        10, 0, G_MAXUINT, 0);
 	if (   current_num == num_vfs
 	    && (autoprobe == -1 || current_autoprobe == autoprobe))
-		return TRUE;
-
-	if (current_num != 0) {
-		/* We need to destroy all other VFs before changing any value */
-		if (!nm_platform_sysctl_set (NM_PLATFORM_GET,
-		                             NMP_SYSCTL_PATHID_NETDIR (dirfd,
-		                                                       ifname,
-		                                                      "device/sriov_numvfs"),
-		                             "0")) {
-			_LOGW ("link: couldn't reset SR-IOV num_vfs: %s", strerror (errno));
-			return FALSE;
-		}
-	}
-
-	if (num_vfs == 0)
-		return TRUE;
-
-	if (   autoprobe >= 0
+		goto out_idle;
+
+	/* Writing sriov_drivers_autoprobe is cheap and only takes effect
+	 * for VFs created afterwards. Only sriov_numvfs blocks while the
+	 * driver destroys and creates the VFs, so only that is written
+	 * by the worker thread. */
+	if (   num_vfs != 0
+	    && autoprobe >= 0
 	    && current_autoprobe != autoprobe
-	    && !nm_platform_sysctl_set (NM_PLATFORM_GET,
+	    && !nm_platform_sysctl_set (platform,
 	                                NMP_SYSCTL_PATHID_NETDIR (dirfd,
 	                                                          ifname,
 	                                                          "device/sriov_drivers_autoprobe"),
 	                                nm_sprintf_buf (buf, "%d", autoprobe))) {
-		_LOGW ("link: couldn't set SR-IOV drivers-autoprobe to %d: %s", autoprobe, strerror (errno));
-		return FALSE;
+		g_set_error (&error, NM_UTILS_ERROR, NM_UTILS_ERROR_UNKNOWN,
+		             "couldn't set SR-IOV drivers-autoprobe to %d: %s",
+		             autoprobe, g_strerror (errno));
+		goto out_idle;
 	}
 
-	if (!nm_platform_sysctl_set (NM_PLATFORM_GET,
-	                             NMP_SYSCTL_PATHID_NETDIR (dirfd,
-	                                                       ifname,
-	                                                       "device/sriov_numvfs"),
-	                             nm_sprintf_buf (buf, "%u", num_vfs))) {
-		_LOGW ("link: couldn't set SR-IOV num_vfs to %d: %s", num_vfs, strerror (errno));
-		return FALSE;
+	if (current_num != 0) {
+		/* We need to destroy all other VFs before changing any value */
+		values[n_values++] = "0";
+	}
+	if (num_vfs != 0)
+		values[n_values++] = nm_sprintf_buf (buf, "%u", num_vfs);
+	values[n_values] = NULL;
+
+	if (n_values == 0)
+		goto out_idle;
+
+	sysctl_set_async (platform,
+	                  NMP_SYSCTL_PATHID_NETDIR (dirfd,
+	                                            ifname,
+	                                            "device/sriov_numvfs"),
+	                  values,
+	                  callback,
+	                  data,
+	                  cancellable);
+	return;
+
+out_idle:
+	if (error)
+		_LOGW ("link: %s", error->message);
+	if (callback) {
+		nm_utils_invoke_on_idle (sriov_idle_cb,
+		                         nm_utils_user_data_pack (g_object_ref (platform),
+		                                                  g_steal_pointer (&error),
+		                                                  callback,
+		                                                  data),
+		                         cancellable);
 	}
-
-	return TRUE;
 }
 
 static gboolean
@@ -6847,6 +7270,20 @@ wifi_set_wake_on_wlan (NMPlatform *platform, int ifindex,
 	return nm_wifi_utils_set_wake_on_wlan (wifi_data, wowl);
 }
 
+static GPtrArray *
+wifi_get_scan_results (NMPlatform *platform, int ifindex)
+{
+	WIFI_GET_WIFI_DATA_NETNS (wifi_data, platform, ifindex, NULL);
+	return nm_wifi_utils_get_scan_results (wifi_data);
+}
+
+static GArray *
+wifi_get_frequencies (NMPlatform *platform, int ifindex)
+{
+	WIFI_GET_WIFI_DATA_NETNS (wifi_data, platform, ifindex, NULL);
+	return nm_wifi_utils_get_freqs (wifi_data);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -6985,17 +7422,14 @@ link_get_driver_info (NMPlatform *platform,
                       char **out_driver_version,
                       char **out_fw_version)
 {
-	nm_auto_pop_netns NMPNetns *netns = NULL;
-	NMPUtilsEthtoolDriverInfo driver_info;
-
-	if (!nm_platform_netns_push (platform, &netns))
-		return FALSE;
+	const NMPlatformEthtoolInfo *info;
 
-	if (!nmp_utils_ethtool_get_driver_info (ifindex, &driver_info))
+	info = ethtool_info_get (platform, ifindex, NM_PLATFORM_ETHTOOL_INFO_DRIVER);
+	if (!info || !info->has_driver_info)
 		return FALSE;
-	NM_SET_OUT (out_driver_name,    g_strdup (driver_info.driver));
-	NM_SET_OUT (out_driver_version, g_strdup (driver_info.version));
-	NM_SET_OUT (out_fw_version,     g_strdup (driver_info.fw_version));
+	NM_SET_OUT (out_driver_name,    g_strdup (info->driver));
+	NM_SET_OUT (out_driver_version, g_strdup (info->driver_version));
+	NM_SET_OUT (out_fw_version,     g_strdup (info->fw_version));
 	return TRUE;
 }
 
@@ -7803,6 +8237,7 @@ nm_linux_platform_init (NMLinuxPlatform *self)
 	priv->delayed_action.list_master_connected = g_ptr_array_new ();
 	priv->delayed_action.list_refresh_link = g_ptr_array_new ();
 	priv->delayed_action.list_wait_for_nl_response = g_array_new (FALSE, TRUE, sizeof (DelayedActionWaitForNlResponseData));
+	priv->ethtool_cache = g_hash_table_new_full (nm_direct_hash, NULL, NULL, (GDestroyNotify) ethtool_cache_entry_free);
 }
 
 static void
@@ -7977,6 +8412,7 @@ finalize (GObject *object)
 	g_ptr_array_unref (priv->delayed_action.list_master_connected);
 	g_ptr_array_unref (priv->delayed_action.list_refresh_link);
 	g_array_unref (priv->delayed_action.list_wait_for_nl_response);
+	g_hash_table_unref (priv->ethtool_cache);
 
 	nl_socket_free (priv->genl);
 
@@ -8005,6 +8441,7 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 	object_class->finalize = finalize;
 
 	platform_class->sysctl_set = sysctl_set;
+	platform_class->sysctl_set_async = sysctl_set_async;
 	platform_class->sysctl_get = sysctl_get;
 
 	platform_class->link_add = link_add;
@@ -8029,7 +8466,7 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 	platform_class->link_get_permanent_address = link_get_permanent_address;
 	platform_class->link_set_mtu = link_set_mtu;
 	platform_class->link_set_name = link_set_name;
-	platform_class->link_set_sriov_params = link_set_sriov_params;
+	platform_class->link_set_sriov_params_async = link_set_sriov_params_async;
 	platform_class->link_set_sriov_vfs = link_set_sriov_vfs;
 
 	platform_class->link_get_physical_port_id = link_get_physical_port_id;
@@ -8037,6 +8474,7 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 	platform_class->link_get_wake_on_lan = link_get_wake_on_lan;
 	platform_class->link_get_driver_info = link_get_driver_info;
 
+	platform_class->link_get_ethtool_info_async = link_get_ethtool_info_async;
 	platform_class->link_supports_carrier_detect = link_supports_carrier_detect;
 	platform_class->link_supports_vlans = link_supports_vlans;
 	platform_class->link_supports_sriov = link_supports_sriov;
@@ -8065,6 +8503,8 @@ nm_linux_platform_class_init (NMLinuxPlatformClass *klass)
 	platform_class->wifi_indicate_addressing_running = wifi_indicate_addressing_running;
 	platform_class->wifi_get_wake_on_wlan = wifi_get_wake_on_wlan;
 	platform_class->wifi_set_wake_on_wlan = wifi_set_wake_on_wlan;
+	platform_class->wifi_get_scan_results = wifi_get_scan_results;
+	platform_class->wifi_get_frequencies = wifi_get_frequencies;
 
 	platform_class->mesh_get_channel = mesh_get_channel;
 	platform_class->mesh_set_channel = mesh_set_channel;
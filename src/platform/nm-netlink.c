@@ -827,6 +827,94 @@ genl_ctrl_resolve (struct nl_sock *sk, const char *name)
 	return response_data;
 }
 
+typedef struct {
+	const char *grp_name;
+	gint32 grp_id;
+} GenlResolveGrpData;
+
+static int
+_genl_parse_getfamily_grp (struct nl_msg *msg, void *arg)
+{
+	static const struct nla_policy ctrl_policy[CTRL_ATTR_MAX+1] = {
+		[CTRL_ATTR_MCAST_GROUPS] = { .type = NLA_NESTED },
+	};
+	static const struct nla_policy grp_policy[CTRL_ATTR_MCAST_GRP_MAX+1] = {
+		[CTRL_ATTR_MCAST_GRP_NAME] = { .type = NLA_STRING },
+		[CTRL_ATTR_MCAST_GRP_ID]   = { .type = NLA_U32 },
+	};
+	struct nlattr *tb[CTRL_ATTR_MAX+1];
+	struct nlmsghdr *nlh = nlmsg_hdr (msg);
+	GenlResolveGrpData *data = arg;
+	struct nlattr *grp;
+	int rem;
+
+	if (genlmsg_parse (nlh, 0, tb, CTRL_ATTR_MAX, ctrl_policy))
+		return NL_SKIP;
+
+	if (!tb[CTRL_ATTR_MCAST_GROUPS])
+		return NL_STOP;
+
+	nla_for_each_nested (grp, tb[CTRL_ATTR_MCAST_GROUPS], rem) {
+		struct nlattr *tb_grp[CTRL_ATTR_MCAST_GRP_MAX+1];
+
+		if (nla_parse_nested (tb_grp, CTRL_ATTR_MCAST_GRP_MAX, grp, grp_policy) < 0)
+			continue;
+		if (   !tb_grp[CTRL_ATTR_MCAST_GRP_NAME]
+		    || !tb_grp[CTRL_ATTR_MCAST_GRP_ID])
+			continue;
+		if (nm_streq (nla_get_string (tb_grp[CTRL_ATTR_MCAST_GRP_NAME]), data->grp_name)) {
+			data->grp_id = nla_get_u32 (tb_grp[CTRL_ATTR_MCAST_GRP_ID]);
+			break;
+		}
+	}
+
+	return NL_STOP;
+}
+
+/* resolves the id of the multicast group @grp_name of the generic netlink
+ * family @family_name, for nl_socket_add_memberships(). */
+int
+genl_ctrl_resolve_grp (struct nl_sock *sk, const char *family_name, const char *grp_name)
+{
+	nm_auto_nlmsg struct nl_msg *msg = NULL;
+	int nlerr;
+	GenlResolveGrpData data = {
+		.grp_name = grp_name,
+		.grp_id = -1,
+	};
+	const struct nl_cb cb = {
+		.valid_cb = _genl_parse_getfamily_grp,
+		.valid_arg = &data,
+	};
+
+	msg = nlmsg_alloc ();
+
+	if (!genlmsg_put (msg, NL_AUTO_PORT, NL_AUTO_SEQ, GENL_ID_CTRL,
+	                  0, 0, CTRL_CMD_GETFAMILY, 1))
+		return -ENOMEM;
+
+	nlerr = nla_put_string (msg, CTRL_ATTR_FAMILY_NAME, family_name);
+	if (nlerr < 0)
+		return nlerr;
+
+	nlerr = nl_send_auto (sk, msg);
+	if (nlerr < 0)
+		return nlerr;
+
+	nlerr = nl_recvmsgs (sk, &cb);
+	if (nlerr < 0)
+		return nlerr;
+
+	nlerr = nl_wait_for_ack (sk, NULL);
+	if (nlerr < 0)
+		return nlerr;
+
+	if (data.grp_id < 0)
+		return -NLE_UNSPEC;
+
+	return data.grp_id;
+}
+
 /*****************************************************************************/
 
 struct nl_sock *
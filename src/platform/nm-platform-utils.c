@@ -670,9 +670,9 @@ nmp_utils_ethtool_set_features (int ifindex,
 
 /*****************************************************************************/
 
-gboolean
-nmp_utils_ethtool_get_driver_info (int ifindex,
-                                   NMPUtilsEthtoolDriverInfo *data)
+static gboolean
+ethtool_get_driver_info (SocketHandle *shandle,
+                         NMPUtilsEthtoolDriverInfo *data)
 {
 	struct ethtool_drvinfo *drvinfo;
 
@@ -684,20 +684,32 @@ nmp_utils_ethtool_get_driver_info (int ifindex,
 	G_STATIC_ASSERT_EXPR (sizeof (data->version)    == sizeof (drvinfo->version));
 	G_STATIC_ASSERT_EXPR (sizeof (data->fw_version) == sizeof (drvinfo->fw_version));
 
-	g_return_val_if_fail (ifindex > 0, FALSE);
-	g_return_val_if_fail (data, FALSE);
-
 	drvinfo = (struct ethtool_drvinfo *) data;
 
 	memset (drvinfo, 0, sizeof (*drvinfo));
 	drvinfo->cmd = ETHTOOL_GDRVINFO;
-	return ethtool_call_ifindex (ifindex, drvinfo) >= 0;
+	return ethtool_call_handle (shandle, drvinfo) >= 0;
 }
 
 gboolean
-nmp_utils_ethtool_get_permanent_address (int ifindex,
-                                         guint8 *buf,
-                                         size_t *length)
+nmp_utils_ethtool_get_driver_info (int ifindex,
+                                   NMPUtilsEthtoolDriverInfo *data)
+{
+	nm_auto_socket_handle SocketHandle shandle = { };
+
+	g_return_val_if_fail (ifindex > 0, FALSE);
+	g_return_val_if_fail (data, FALSE);
+
+	if (socket_handle_init (&shandle, ifindex) < 0)
+		return FALSE;
+
+	return ethtool_get_driver_info (&shandle, data);
+}
+
+static gboolean
+ethtool_get_permanent_address (SocketHandle *shandle,
+                               guint8 *buf,
+                               size_t *length)
 {
 	struct {
 		struct ethtool_perm_addr e;
@@ -705,13 +717,11 @@ nmp_utils_ethtool_get_permanent_address (int ifindex,
 	} edata;
 	guint i;
 
-	g_return_val_if_fail (ifindex > 0, FALSE);
-
 	memset (&edata, 0, sizeof (edata));
 	edata.e.cmd = ETHTOOL_GPERMADDR;
 	edata.e.size = NM_UTILS_HWADDR_LEN_MAX;
 
-	if (ethtool_call_ifindex (ifindex, &edata.e) < 0)
+	if (ethtool_call_handle (shandle, &edata.e) < 0)
 		return FALSE;
 
 	if (edata.e.size > NM_UTILS_HWADDR_LEN_MAX)
@@ -737,41 +747,27 @@ not_all_0or1:
 	return TRUE;
 }
 
-gboolean
-nmp_utils_ethtool_supports_carrier_detect (int ifindex)
+static gboolean
+ethtool_supports_carrier_detect (SocketHandle *shandle)
 {
 	struct ethtool_cmd edata = { .cmd = ETHTOOL_GLINK };
 
-	g_return_val_if_fail (ifindex > 0, FALSE);
-
 	/* We ignore the result. If the ETHTOOL_GLINK call succeeded, then we
 	 * assume the device supports carrier-detect, otherwise we assume it
 	 * doesn't.
 	 */
-	return ethtool_call_ifindex (ifindex, &edata) >= 0;
+	return ethtool_call_handle (shandle, &edata) >= 0;
 }
 
-gboolean
-nmp_utils_ethtool_supports_vlans (int ifindex)
+static gboolean
+ethtool_supports_vlans (SocketHandle *shandle, gboolean *out_supported)
 {
-	nm_auto_socket_handle SocketHandle shandle = { };
-	int r;
 	gs_free struct ethtool_gfeatures *features = NULL;
 	int idx, block, bit, size;
 
-	g_return_val_if_fail (ifindex > 0, FALSE);
-
-	if ((r = socket_handle_init (&shandle, ifindex)) < 0) {
-		nm_log_trace (LOGD_PLATFORM, "ethtool[%d]: %s: failed creating ethtool socket: %s",
-		              ifindex,
-		              "support-vlans",
-		              g_strerror (-r));
-		return FALSE;
-	}
-
-	idx = ethtool_get_stringset_index (&shandle, ETH_SS_FEATURES, "vlan-challenged");
+	idx = ethtool_get_stringset_index (shandle, ETH_SS_FEATURES, "vlan-challenged");
 	if (idx < 0) {
-		nm_log_dbg (LOGD_PLATFORM, "ethtool[%d]: vlan-challenged ethtool feature does not exist?", ifindex);
+		nm_log_dbg (LOGD_PLATFORM, "ethtool[%d]: vlan-challenged ethtool feature does not exist?", shandle->ifindex);
 		return FALSE;
 	}
 
@@ -783,10 +779,11 @@ nmp_utils_ethtool_supports_vlans (int ifindex)
 	features->cmd = ETHTOOL_GFEATURES;
 	features->size = size;
 
-	if (ethtool_call_handle (&shandle, features) < 0)
+	if (ethtool_call_handle (shandle, features) < 0)
 		return FALSE;
 
-	return !(features->features[block].active & (1 << bit));
+	*out_supported = !(features->features[block].active & (1 << bit));
+	return TRUE;
 }
 
 int
@@ -1037,28 +1034,17 @@ nmp_utils_ethtool_set_wake_on_lan (int ifindex,
  * mii
  *****************************************************************************/
 
-gboolean
-nmp_utils_mii_supports_carrier_detect (int ifindex)
+static gboolean
+mii_supports_carrier_detect (SocketHandle *shandle)
 {
-	nm_auto_socket_handle SocketHandle shandle = { };
-	int r;
 	struct ifreq ifr;
 	struct mii_ioctl_data *mii;
 
-	g_return_val_if_fail (ifindex > 0, FALSE);
-
-	if ((r = socket_handle_init (&shandle, ifindex)) < 0) {
-		nm_log_trace (LOGD_PLATFORM, "mii[%d]: carrier-detect no: failed creating ethtool socket: %s",
-		              ifindex,
-		              g_strerror (-r));
-		return FALSE;
-	}
-
 	memset (&ifr, 0, sizeof (struct ifreq));
-	memcpy (ifr.ifr_name, shandle.ifname, IFNAMSIZ);
+	memcpy (ifr.ifr_name, shandle->ifname, IFNAMSIZ);
 
-	if (ioctl (shandle.fd, SIOCGMIIPHY, &ifr) < 0) {
-		nm_log_trace (LOGD_PLATFORM, "mii[%d,%s]: carrier-detect no: SIOCGMIIPHY failed: %s", ifindex, shandle.ifname, strerror (errno));
+	if (ioctl (shandle->fd, SIOCGMIIPHY, &ifr) < 0) {
+		nm_log_trace (LOGD_PLATFORM, "mii[%d,%s]: carrier-detect no: SIOCGMIIPHY failed: %s", shandle->ifindex, shandle->ifname, strerror (errno));
 		return FALSE;
 	}
 
@@ -1066,15 +1052,133 @@ nmp_utils_mii_supports_carrier_detect (int ifindex)
 	mii = (struct mii_ioctl_data *) &ifr.ifr_ifru;
 	mii->reg_num = MII_BMSR;
 
-	if (ioctl (shandle.fd, SIOCGMIIREG, &ifr) != 0) {
-		nm_log_trace (LOGD_PLATFORM, "mii[%d,%s]: carrier-detect no: SIOCGMIIREG failed: %s", ifindex, shandle.ifname, strerror (errno));
+	if (ioctl (shandle->fd, SIOCGMIIREG, &ifr) != 0) {
+		nm_log_trace (LOGD_PLATFORM, "mii[%d,%s]: carrier-detect no: SIOCGMIIREG failed: %s", shandle->ifindex, shandle->ifname, strerror (errno));
 		return FALSE;
 	}
 
-	nm_log_trace (LOGD_PLATFORM, "mii[%d,%s]: carrier-detect yes: SIOCGMIIREG result 0x%X", ifindex, shandle.ifname, mii->val_out);
+	nm_log_trace (LOGD_PLATFORM, "mii[%d,%s]: carrier-detect yes: SIOCGMIIREG result 0x%X", shandle->ifindex, shandle->ifname, mii->val_out);
 	return TRUE;
 }
 
+/******************************************************************************
+ * combined ethtool/mii information
+ *****************************************************************************/
+
+struct _NMPUtilsEthtoolHandle {
+	SocketHandle shandle;
+};
+
+/**
+ * nmp_utils_ethtool_handle_new:
+ * @ifindex: the link to query
+ *
+ * Resolves the interface name and creates the ioctl socket. Both depend
+ * on the network namespace of the calling thread, so this must be called
+ * from the platform's netns. The handle itself can then be passed to
+ * a worker thread for nmp_utils_ethtool_handle_get_info().
+ *
+ * Returns: the handle or %NULL if the link doesn't exist.
+ */
+NMPUtilsEthtoolHandle *
+nmp_utils_ethtool_handle_new (int ifindex)
+{
+	NMPUtilsEthtoolHandle *handle;
+	int r;
+
+	g_return_val_if_fail (ifindex > 0, NULL);
+
+	handle = g_slice_new0 (NMPUtilsEthtoolHandle);
+	if ((r = socket_handle_init (&handle->shandle, ifindex)) < 0) {
+		nm_log_trace (LOGD_PLATFORM, "ethtool[%d]: failed creating ethtool socket: %s",
+		              ifindex,
+		              g_strerror (-r));
+		g_slice_free (NMPUtilsEthtoolHandle, handle);
+		return NULL;
+	}
+	return handle;
+}
+
+void
+nmp_utils_ethtool_handle_free (NMPUtilsEthtoolHandle *handle)
+{
+	if (handle) {
+		socket_handle_destroy (&handle->shandle);
+		g_slice_free (NMPUtilsEthtoolHandle, handle);
+	}
+}
+
+/**
+ * nmp_utils_ethtool_handle_get_info:
+ * @handle: the handle from nmp_utils_ethtool_handle_new()
+ * @request: the information to fetch
+ * @info: the result. Fields that are already marked as valid
+ *   in @info are not fetched again.
+ *
+ * Issues all requested ioctls via the same socket. The call may block
+ * for as long as the driver takes to answer, but it does not access any
+ * global state and is safe to call from a worker thread.
+ */
+void
+nmp_utils_ethtool_handle_get_info (NMPUtilsEthtoolHandle *handle,
+                                   NMPlatformEthtoolInfoFlags request,
+                                   NMPlatformEthtoolInfo *info)
+{
+	SocketHandle *shandle;
+	size_t len;
+
+	g_return_if_fail (handle);
+	g_return_if_fail (info);
+
+	shandle = &handle->shandle;
+	request &= ~info->valid;
+
+	/* Only mark the information as valid that we actually got. A failed
+	 * ioctl must not get cached, the next request tries again. */
+
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_DRIVER)) {
+		NMPUtilsEthtoolDriverInfo driver_info;
+
+		if (ethtool_get_driver_info (shandle, &driver_info)) {
+			G_STATIC_ASSERT_EXPR (sizeof (info->driver) == sizeof (driver_info.driver));
+			G_STATIC_ASSERT_EXPR (sizeof (info->driver_version) == sizeof (driver_info.version));
+			G_STATIC_ASSERT_EXPR (sizeof (info->fw_version) == sizeof (driver_info.fw_version));
+
+			g_strlcpy (info->driver, driver_info.driver, sizeof (info->driver));
+			g_strlcpy (info->driver_version, driver_info.version, sizeof (info->driver_version));
+			g_strlcpy (info->fw_version, driver_info.fw_version, sizeof (info->fw_version));
+			info->has_driver_info = TRUE;
+			info->valid |= NM_PLATFORM_ETHTOOL_INFO_DRIVER;
+		}
+	}
+
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_PERM_ADDR)) {
+		if (ethtool_get_permanent_address (shandle, info->perm_addr, &len)) {
+			info->perm_addr_len = len;
+			info->valid |= NM_PLATFORM_ETHTOOL_INFO_PERM_ADDR;
+		}
+	}
+
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_CARRIER_DETECT)) {
+		/* A failing call can't be told apart from missing support,
+		 * so only a positive answer is final. */
+		if (   ethtool_supports_carrier_detect (shandle)
+		    || mii_supports_carrier_detect (shandle)) {
+			info->supports_carrier_detect = TRUE;
+			info->valid |= NM_PLATFORM_ETHTOOL_INFO_CARRIER_DETECT;
+		}
+	}
+
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_VLANS)) {
+		gboolean supported;
+
+		if (ethtool_supports_vlans (shandle, &supported)) {
+			info->supports_vlans = supported;
+			info->valid |= NM_PLATFORM_ETHTOOL_INFO_VLANS;
+		}
+	}
+}
+
 /******************************************************************************
  * udev
  *****************************************************************************/
@@ -28,8 +28,6 @@
 /*****************************************************************************/
 
 const char *nmp_utils_ethtool_get_driver (int ifindex);
-gboolean nmp_utils_ethtool_supports_carrier_detect (int ifindex);
-gboolean nmp_utils_ethtool_supports_vlans (int ifindex);
 int nmp_utils_ethtool_get_peer_ifindex (int ifindex);
 gboolean nmp_utils_ethtool_get_wake_on_lan (int ifindex);
 gboolean nmp_utils_ethtool_set_wake_on_lan (int ifindex, NMSettingWiredWakeOnLan wol,
@@ -38,10 +36,6 @@ gboolean nmp_utils_ethtool_set_wake_on_lan (int ifindex, NMSettingWiredWakeOnLan
 gboolean nmp_utils_ethtool_get_link_settings (int ifindex, gboolean *out_autoneg, guint32 *out_speed, NMPlatformLinkDuplexType *out_duplex);
 gboolean nmp_utils_ethtool_set_link_settings (int ifindex, gboolean autoneg, guint32 speed, NMPlatformLinkDuplexType duplex);
 
-gboolean  nmp_utils_ethtool_get_permanent_address (int ifindex,
-                                                   guint8 *buf,
-                                                   size_t *length);
-
 typedef struct {
 	/* We don't want to include <linux/ethtool.h> in header files,
 	 * thus create a ABI compatible version of struct ethtool_drvinfo.*/
@@ -109,7 +103,13 @@ gboolean nmp_utils_ethtool_set_features (int ifindex,
 
 /*****************************************************************************/
 
-gboolean nmp_utils_mii_supports_carrier_detect (int ifindex);
+typedef struct _NMPUtilsEthtoolHandle NMPUtilsEthtoolHandle;
+
+NMPUtilsEthtoolHandle *nmp_utils_ethtool_handle_new (int ifindex);
+void nmp_utils_ethtool_handle_free (NMPUtilsEthtoolHandle *handle);
+void nmp_utils_ethtool_handle_get_info (NMPUtilsEthtoolHandle *handle,
+                                        NMPlatformEthtoolInfoFlags request,
+                                        NMPlatformEthtoolInfo *info);
 
 struct udev_device;
 
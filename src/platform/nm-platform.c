@@ -474,6 +474,96 @@ nm_platform_sysctl_set (NMPlatform *self, const char *pathid, int dirfd, const c
 	return klass->sysctl_set (self, pathid, dirfd, path, value);
 }
 
+/**
+ * nm_platform_sysctl_set_async:
+ * @self: platform instance
+ * @pathid: if @dirfd is present, this must be the full path that is looked up.
+ *   It is required for logging.
+ * @dirfd: optional file descriptor for parent directory for openat()
+ * @path: absolute option path
+ * @values: a %NULL terminated list of values to write, one after the other
+ * @callback: (allow-none): invoked on completion
+ * @data: user data for @callback
+ * @cancellable: (allow-none): to cancel the operation
+ *
+ * Like nm_platform_sysctl_set(), but the (possibly slow) writes are performed
+ * by a worker thread. Some sysfs attributes like "device/sriov_numvfs" block
+ * until the driver finished reconfiguring the hardware, which can take seconds.
+ * The worker does not use the platform cache, so it's safe to run operations
+ * for different links in parallel. @callback is invoked on the main context.
+ */
+void
+nm_platform_sysctl_set_async (NMPlatform *self,
+                              const char *pathid,
+                              int dirfd,
+                              const char *path,
+                              const char *const *values,
+                              NMPlatformAsyncCallback callback,
+                              gpointer data,
+                              GCancellable *cancellable)
+{
+	_CHECK_SELF_VOID (self, klass);
+
+	g_return_if_fail (path);
+	g_return_if_fail (values && values[0]);
+
+	klass->sysctl_set_async (self, pathid, dirfd, path, values, callback, data, cancellable);
+}
+
+static gboolean
+_async_task_release_cb (gpointer user_data)
+{
+	return G_SOURCE_REMOVE;
+}
+
+/* Blocking sysfs writes can take seconds. Don't run them on GIO's shared
+ * worker pool, where they would starve other asynchronous operations, and
+ * limit how many of them run at the same time. */
+static void
+_async_worker_fn (gpointer data, gpointer user_data)
+{
+	GTask *task;
+	GTaskThreadFunc func;
+
+	nm_utils_user_data_unpack (data, &task, &func);
+	func (task,
+	      g_task_get_source_object (task),
+	      g_task_get_task_data (task),
+	      g_task_get_cancellable (task));
+
+	/* the reference might be the last one. Drop it on the context of the
+	 * caller, so that the task data is never freed on a worker thread. */
+	g_main_context_invoke_full (g_task_get_context (task),
+	                            G_PRIORITY_DEFAULT,
+	                            _async_task_release_cb,
+	                            task,
+	                            g_object_unref);
+}
+
+/**
+ * nm_platform_task_run_in_thread:
+ * @task: the task to run
+ * @func: the function that performs the blocking operation
+ *
+ * Like g_task_run_in_thread(), but uses the platform's own thread pool
+ * of at most %NM_PLATFORM_ASYNC_WORKERS_MAX threads.
+ */
+void
+nm_platform_task_run_in_thread (GTask *task, GTaskThreadFunc func)
+{
+	static GThreadPool *pool;
+
+	g_return_if_fail (G_IS_TASK (task));
+	g_return_if_fail (func);
+
+	if (G_UNLIKELY (!pool))
+		pool = g_thread_pool_new (_async_worker_fn, NULL, NM_PLATFORM_ASYNC_WORKERS_MAX, FALSE, NULL);
+
+	g_thread_pool_push (pool,
+	                    nm_utils_user_data_pack (g_object_ref (task), (gpointer) func),
+	                    NULL);
+}
+
 gboolean
 nm_platform_sysctl_set_ip6_hop_limit_safe (NMPlatform *self, const char *iface, int value)
 {
@@ -1486,26 +1576,43 @@ nm_platform_link_supports_sriov (NMPlatform *self, int ifindex)
 }
 
 /**
- * nm_platform_link_set_sriov_params:
+ * nm_platform_link_set_sriov_params_async:
  * @self: platform instance
  * @ifindex: the index of the interface to change
  * @num_vfs: the number of VFs to create
  * @autoprobe: -1 to keep the current autoprobe-drivers value,
  *   or {0,1} to set a new value
+ * @callback: (allow-none): invoked on completion
+ * @callback_data: user data for @callback
+ * @cancellable: (allow-none): to cancel the operation
+ *
+ * Changing the number of VFs makes the kernel driver destroy and create
+ * the VFs, which blocks for a long time. The write is thus done
+ * asynchronously (see nm_platform_sysctl_set_async()). @callback is
+ * always invoked asynchronously, also if there was nothing to do.
  */
-gboolean
-nm_platform_link_set_sriov_params (NMPlatform *self,
-                                   int ifindex,
-                                   guint num_vfs,
-                                   int autoprobe)
+void
+nm_platform_link_set_sriov_params_async (NMPlatform *self,
+                                         int ifindex,
+                                         guint num_vfs,
+                                         int autoprobe,
+                                         NMPlatformAsyncCallback callback,
+                                         gpointer callback_data,
+                                         GCancellable *cancellable)
 {
-	_CHECK_SELF (self, klass, FALSE);
+	_CHECK_SELF_VOID (self, klass);
 
-	g_return_val_if_fail (ifindex > 0, FALSE);
-	g_return_val_if_fail (NM_IN_SET (autoprobe, -1, 0, 1), FALSE);
+	g_return_if_fail (ifindex > 0);
+	g_return_if_fail (NM_IN_SET (autoprobe, -1, 0, 1));
 
 	_LOG3D ("link: setting %u total VFs and autoprobe %d", num_vfs, autoprobe);
-	return klass->link_set_sriov_params (self, ifindex, num_vfs, autoprobe);
+	klass->link_set_sriov_params_async (self,
+	                                    ifindex,
+	                                    num_vfs,
+	                                    autoprobe,
+	                                    callback,
+	                                    callback_data,
+	                                    cancellable);
 }
 
 gboolean
@@ -1760,6 +1867,98 @@ nm_platform_link_get_driver_info (NMPlatform *self,
 	                                    out_fw_version);
 }
 
+typedef struct {
+	NMPlatformEthtoolInfo info;
+	NMPlatformEthtoolInfoCallback callback;
+	gpointer callback_data;
+} EthtoolInfoIdleData;
+
+static void
+_ethtool_info_idle_cb (gpointer user_data,
+                       GCancellable *cancellable)
+{
+	EthtoolInfoIdleData *data = user_data;
+	gs_free_error GError *error = NULL;
+
+	if (g_cancellable_set_error_if_cancelled (cancellable, &error))
+		data->callback (NULL, error, data->callback_data);
+	else
+		data->callback (&data->info, NULL, data->callback_data);
+	g_slice_free (EthtoolInfoIdleData, data);
+}
+
+/**
+ * nm_platform_link_get_ethtool_info_async:
+ * @self: platform instance
+ * @ifindex: Interface index
+ * @request: the information that the caller is interested in
+ * @callback: called on completion. It is always invoked asynchronously,
+ *   with either the info or an error set. On cancellation, the error
+ *   is a cancelled error.
+ * @callback_data: user data for @callback
+ * @cancellable: a #GCancellable
+ *
+ * Fetch the ethtool information of a link without blocking the
+ * main loop on the ioctls. The fields in @request are valid in the
+ * info passed to @callback, unless the link disappeared.
+ */
+void
+nm_platform_link_get_ethtool_info_async (NMPlatform *self,
+                                         int ifindex,
+                                         NMPlatformEthtoolInfoFlags request,
+                                         NMPlatformEthtoolInfoCallback callback,
+                                         gpointer callback_data,
+                                         GCancellable *cancellable)
+{
+	EthtoolInfoIdleData *data;
+
+	_CHECK_SELF_VOID (self, klass);
+
+	g_return_if_fail (ifindex > 0);
+	g_return_if_fail (callback);
+
+	if (klass->link_get_ethtool_info_async) {
+		klass->link_get_ethtool_info_async (self,
+		                                    ifindex,
+		                                    request,
+		                                    callback,
+		                                    callback_data,
+		                                    cancellable);
+		return;
+	}
+
+	/* Fallback for implementations that can answer synchronously. */
+	data = g_slice_new0 (EthtoolInfoIdleData);
+	data->callback = callback;
+	data->callback_data = callback_data;
+
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_DRIVER)) {
+		gs_free char *driver = NULL;
+		gs_free char *driver_version = NULL;
+		gs_free char *fw_version = NULL;
+
+		if (nm_platform_link_get_driver_info (self, ifindex, &driver, &driver_version, &fw_version)) {
+			data->info.has_driver_info = TRUE;
+			g_strlcpy (data->info.driver, driver ?: "", sizeof (data->info.driver));
+			g_strlcpy (data->info.driver_version, driver_version ?: "", sizeof (data->info.driver_version));
+			g_strlcpy (data->info.fw_version, fw_version ?: "", sizeof (data->info.fw_version));
+		}
+	}
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_PERM_ADDR)) {
+		size_t len = 0;
+
+		if (nm_platform_link_get_permanent_address (self, ifindex, data->info.perm_addr, &len))
+			data->info.perm_addr_len = len;
+	}
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_CARRIER_DETECT))
+		data->info.supports_carrier_detect = nm_platform_link_supports_carrier_detect (self, ifindex);
+	if (NM_FLAGS_HAS (request, NM_PLATFORM_ETHTOOL_INFO_VLANS))
+		data->info.supports_vlans = nm_platform_link_supports_vlans (self, ifindex);
+	data->info.valid = request;
+
+	nm_utils_invoke_on_idle (_ethtool_info_idle_cb, data, cancellable);
+}
+
 /**
  * nm_platform_link_enslave:
  * @self: platform instance
@@ -3057,6 +3256,47 @@ nm_platform_wifi_set_wake_on_wlan (NMPlatform *self, int ifindex, NMSettingWirel
 	return klass->wifi_set_wake_on_wlan (self, ifindex, wowl);
 }
 
+/**
+ * nm_platform_wifi_get_scan_results:
+ * @self: platform instance
+ * @ifindex: the ifindex of the Wi-Fi interface
+ *
+ * Returns: (transfer container): the scan results of the kernel as
+ *   GVariant "a{sv}" dictionaries with the same keys as the properties of
+ *   wpa_supplicant's BSS objects, or %NULL if they cannot be obtained.
+ */
+GPtrArray *
+nm_platform_wifi_get_scan_results (NMPlatform *self, int ifindex)
+{
+	_CHECK_SELF (self, klass, NULL);
+
+	g_return_val_if_fail (ifindex > 0, NULL);
+
+	if (!klass->wifi_get_scan_results)
+		return NULL;
+	return klass->wifi_get_scan_results (self, ifindex);
+}
+
+/**
+ * nm_platform_wifi_get_frequencies:
+ * @self: platform instance
+ * @ifindex: the ifindex of the Wi-Fi interface
+ *
+ * Returns: (transfer full): the frequencies in MHz (as guint32) supported
+ *   by the device, or %NULL if they cannot be obtained.
+ */
+GArray *
+nm_platform_wifi_get_frequencies (NMPlatform *self, int ifindex)
+{
+	_CHECK_SELF (self, klass, NULL);
+
+	g_return_val_if_fail (ifindex > 0, NULL);
+
+	if (!klass->wifi_get_frequencies)
+		return NULL;
+	return klass->wifi_get_frequencies (self, ifindex);
+}
+
 guint32
 nm_platform_mesh_get_channel (NMPlatform *self, int ifindex)
 {
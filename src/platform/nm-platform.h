@@ -776,6 +776,52 @@ typedef enum {
 
 /*****************************************************************************/
 
+/**
+ * NMPlatformAsyncCallback:
+ * @error: %NULL on success, or the reason of the failure. If the
+ *   operation was cancelled, the error is %G_IO_ERROR_CANCELLED.
+ * @user_data: the user data passed to the asynchronous function.
+ *
+ * Completion callback of asynchronous platform operations. It is
+ * always invoked on the main context, never from a worker thread.
+ */
+typedef void (*NMPlatformAsyncCallback) (GError *error, gpointer user_data);
+
+/*****************************************************************************/
+
+typedef enum {
+	NM_PLATFORM_ETHTOOL_INFO_NONE           = 0,
+	NM_PLATFORM_ETHTOOL_INFO_DRIVER         = (1LL << 0),
+	NM_PLATFORM_ETHTOOL_INFO_PERM_ADDR      = (1LL << 1),
+	NM_PLATFORM_ETHTOOL_INFO_CARRIER_DETECT = (1LL << 2),
+	NM_PLATFORM_ETHTOOL_INFO_VLANS          = (1LL << 3),
+} NMPlatformEthtoolInfoFlags;
+
+/* Information about a link that can only be obtained by ethtool (or MII)
+ * ioctls. It does not change as long as the link exists, so the platform
+ * caches it per ifindex. */
+typedef struct {
+	/* the fields that were already fetched. */
+	NMPlatformEthtoolInfoFlags valid;
+
+	char driver[32];
+	char driver_version[32];
+	char fw_version[32];
+
+	guint8 perm_addr[20]; /* NM_UTILS_HWADDR_LEN_MAX */
+	guint8 perm_addr_len;
+
+	bool has_driver_info:1;
+	bool supports_carrier_detect:1;
+	bool supports_vlans:1;
+} NMPlatformEthtoolInfo;
+
+typedef void (*NMPlatformEthtoolInfoCallback) (const NMPlatformEthtoolInfo *info,
+                                               GError *error,
+                                               gpointer user_data);
+
+/*****************************************************************************/
+
 struct _NMPlatformPrivate;
 
 struct _NMPlatform {
@@ -789,6 +835,14 @@ typedef struct {
 
 	gboolean (*sysctl_set) (NMPlatform *, const char *pathid, int dirfd, const char *path, const char *value);
 	char * (*sysctl_get) (NMPlatform *, const char *pathid, int dirfd, const char *path);
+	void (*sysctl_set_async) (NMPlatform *self,
+	                          const char *pathid,
+	                          int dirfd,
+	                          const char *path,
+	                          const char *const *values,
+	                          NMPlatformAsyncCallback callback,
+	                          gpointer data,
+	                          GCancellable *cancellable);
 
 	void (*refresh_all) (NMPlatform *self, NMPObjectType obj_type);
 
@@ -825,7 +879,13 @@ typedef struct {
 	NMPlatformError (*link_set_address) (NMPlatform *, int ifindex, gconstpointer address, size_t length);
 	NMPlatformError (*link_set_mtu) (NMPlatform *, int ifindex, guint32 mtu);
 	gboolean (*link_set_name) (NMPlatform *, int ifindex, const char *name);
-	gboolean (*link_set_sriov_params) (NMPlatform *, int ifindex, guint num_vfs, int autoprobe);
+	void (*link_set_sriov_params_async) (NMPlatform *self,
+	                                     int ifindex,
+	                                     guint num_vfs,
+	                                     int autoprobe,
+	                                     NMPlatformAsyncCallback callback,
+	                                     gpointer callback_data,
+	                                     GCancellable *cancellable);
 	gboolean (*link_set_sriov_vfs) (NMPlatform *self, int ifindex, const NMPlatformVF *const *vfs);
 
 	char *   (*link_get_physical_port_id) (NMPlatform *, int ifindex);
@@ -836,6 +896,12 @@ typedef struct {
 	                                  char **out_driver_name,
 	                                  char **out_driver_version,
 	                                  char **out_fw_version);
+	void (*link_get_ethtool_info_async) (NMPlatform *self,
+	                                     int ifindex,
+	                                     NMPlatformEthtoolInfoFlags request,
+	                                     NMPlatformEthtoolInfoCallback callback,
+	                                     gpointer callback_data,
+	                                     GCancellable *cancellable);
 
 	gboolean (*link_supports_carrier_detect) (NMPlatform *, int ifindex);
 	gboolean (*link_supports_vlans) (NMPlatform *, int ifindex);
@@ -918,6 +984,8 @@ typedef struct {
 	void        (*wifi_indicate_addressing_running) (NMPlatform *, int ifindex, gboolean running);
 	NMSettingWirelessWakeOnWLan (*wifi_get_wake_on_wlan) (NMPlatform *, int ifindex);
 	gboolean    (*wifi_set_wake_on_wlan) (NMPlatform *, int ifindex, NMSettingWirelessWakeOnWLan wowl);
+	GPtrArray * (*wifi_get_scan_results) (NMPlatform *, int ifindex);
+	GArray *    (*wifi_get_frequencies)  (NMPlatform *, int ifindex);
 
 	guint32     (*mesh_get_channel)      (NMPlatform *, int ifindex);
 	gboolean    (*mesh_set_channel)      (NMPlatform *, int ifindex, guint32 channel);
@@ -1117,6 +1185,16 @@ const char *nm_platform_error_to_string (NMPlatformError error,
 
 int nm_platform_sysctl_open_netdir (NMPlatform *self, int ifindex, char *out_ifname);
 gboolean nm_platform_sysctl_set (NMPlatform *self, const char *pathid, int dirfd, const char *path, const char *value);
+void nm_platform_sysctl_set_async (NMPlatform *self,
+                                   const char *pathid,
+                                   int dirfd,
+                                   const char *path,
+                                   const char *const *values,
+                                   NMPlatformAsyncCallback callback,
+                                   gpointer data,
+                                   GCancellable *cancellable);
+#define NM_PLATFORM_ASYNC_WORKERS_MAX 8
+void nm_platform_task_run_in_thread (GTask *task, GTaskThreadFunc func);
 char *nm_platform_sysctl_get (NMPlatform *self, const char *pathid, int dirfd, const char *path);
 gint32 nm_platform_sysctl_get_int32 (NMPlatform *self, const char *pathid, int dirfd, const char *path, gint32 fallback);
 gint64 nm_platform_sysctl_get_int_checked (NMPlatform *self, const char *pathid, int dirfd, const char *path, guint base, gint64 min, gint64 max, gint64 fallback);
@@ -1217,7 +1295,13 @@ gboolean nm_platform_link_get_permanent_address (NMPlatform *self, int ifindex,
 NMPlatformError nm_platform_link_set_address (NMPlatform *self, int ifindex, const void *address, size_t length);
 NMPlatformError nm_platform_link_set_mtu (NMPlatform *self, int ifindex, guint32 mtu);
 gboolean nm_platform_link_set_name (NMPlatform *self, int ifindex, const char *name);
-gboolean nm_platform_link_set_sriov_params (NMPlatform *self, int ifindex, guint num_vfs, int autoprobe);
+void nm_platform_link_set_sriov_params_async (NMPlatform *self,
+                                              int ifindex,
+                                              guint num_vfs,
+                                              int autoprobe,
+                                              NMPlatformAsyncCallback callback,
+                                              gpointer callback_data,
+                                              GCancellable *cancellable);
 gboolean nm_platform_link_set_sriov_vfs (NMPlatform *self, int ifindex, const NMPlatformVF *const *vfs);
 
 char    *nm_platform_link_get_physical_port_id (NMPlatform *self, int ifindex);
@@ -1228,6 +1312,12 @@ gboolean nm_platform_link_get_driver_info (NMPlatform *self,
                                            char **out_driver_name,
                                            char **out_driver_version,
                                            char **out_fw_version);
+void nm_platform_link_get_ethtool_info_async (NMPlatform *self,
+                                              int ifindex,
+                                              NMPlatformEthtoolInfoFlags request,
+                                              NMPlatformEthtoolInfoCallback callback,
+                                              gpointer callback_data,
+                                              GCancellable *cancellable);
 
 gboolean nm_platform_link_supports_carrier_detect (NMPlatform *self, int ifindex);
 gboolean nm_platform_link_supports_vlans (NMPlatform *self, int ifindex);
@@ -1309,6 +1399,8 @@ guint32     nm_platform_wifi_find_frequency   (NMPlatform *self, int ifindex, co
 void        nm_platform_wifi_indicate_addressing_running (NMPlatform *self, int ifindex, gboolean running);
 NMSettingWirelessWakeOnWLan nm_platform_wifi_get_wake_on_wlan (NMPlatform *self, int ifindex);
 gboolean    nm_platform_wifi_set_wake_on_wlan (NMPlatform *self, int ifindex, NMSettingWirelessWakeOnWLan wowl);
+GPtrArray * nm_platform_wifi_get_scan_results (NMPlatform *self, int ifindex);
+GArray *    nm_platform_wifi_get_frequencies  (NMPlatform *self, int ifindex);
 
 guint32     nm_platform_mesh_get_channel      (NMPlatform *self, int ifindex);
 gboolean    nm_platform_mesh_set_channel      (NMPlatform *self, int ifindex, guint32 channel);
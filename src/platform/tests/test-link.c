@@ -2818,6 +2818,143 @@ test_ethtool_features_get (void)
 
 /*****************************************************************************/
 
+static void
+_ethtool_info_async_cb (const NMPlatformEthtoolInfo *info,
+                        GError *error,
+                        gpointer user_data)
+{
+	NMPlatformEthtoolInfo *result = user_data;
+
+	g_assert_no_error (error);
+	g_assert (info);
+	g_assert (info->valid);
+	*result = *info;
+}
+
+static void
+test_ethtool_info_async (void)
+{
+	const NMPlatformEthtoolInfoFlags request =   NM_PLATFORM_ETHTOOL_INFO_DRIVER
+	                                           | NM_PLATFORM_ETHTOOL_INFO_VLANS;
+	NMPlatformEthtoolInfo info = { 0 };
+	gs_free char *driver = NULL;
+	int ifindex;
+	guint i;
+
+	ifindex = nmtstp_link_dummy_add (NM_PLATFORM_GET, FALSE, DEVICE_NAME)->ifindex;
+
+	/* the first query populates the cache from the worker, the second
+	 * one is answered from the cache. Both must agree with the
+	 * synchronous API. */
+	for (i = 0; i < 2; i++) {
+		memset (&info, 0, sizeof (info));
+		nm_platform_link_get_ethtool_info_async (NM_PLATFORM_GET,
+		                                         ifindex,
+		                                         request,
+		                                         _ethtool_info_async_cb,
+		                                         &info,
+		                                         NULL);
+		while (!info.valid)
+			g_main_context_iteration (NULL, TRUE);
+
+		g_assert_cmpint (info.valid & request, ==, request);
+		g_assert (info.has_driver_info);
+		g_assert_cmpstr (info.driver, ==, "dummy");
+		g_assert_cmpint (info.supports_vlans, ==, nm_platform_link_supports_vlans (NM_PLATFORM_GET, ifindex));
+		g_assert (nm_platform_link_get_driver_info (NM_PLATFORM_GET, ifindex, &driver, NULL, NULL));
+		g_assert_cmpstr (driver, ==, "dummy");
+		nm_clear_g_free (&driver);
+	}
+
+	/* toggling IFF_UP drops the cached information, but it must be fetched
+	 * again with the same result. */
+	nmtstp_link_set_updown (NM_PLATFORM_GET, -1, ifindex, TRUE);
+	g_assert (nm_platform_link_get_driver_info (NM_PLATFORM_GET, ifindex, &driver, NULL, NULL));
+	g_assert_cmpstr (driver, ==, "dummy");
+
+	g_assert (nm_platform_link_delete (NM_PLATFORM_GET, ifindex));
+}
+
+/*****************************************************************************/
+
+typedef struct {
+	guint n_pending;
+	guint n_completed;
+} SysctlAsyncData;
+
+static void
+_sysctl_set_async_cb (GError *error, gpointer user_data)
+{
+	SysctlAsyncData *data = user_data;
+
+	g_assert_no_error (error);
+	g_assert_cmpint (data->n_pending, >, 0);
+	data->n_pending--;
+	data->n_completed++;
+}
+
+static void
+test_sysctl_set_async (void)
+{
+	const guint N_LINKS = 100;
+	const char *const values[] = { "0", "8", NULL };
+	SysctlAsyncData data = { 0 };
+	const GPtrArray *log;
+	guint running_max;
+	guint i, j;
+	char path[100];
+	char entry[150];
+
+	/* Emulate booting with many SR-IOV capable devices, where each write to
+	 * sriov_numvfs blocks for a while. The writes of different links must
+	 * overlap, but never use more than the platform's worker threads. All
+	 * writes must complete, and the callbacks must only be invoked from the
+	 * main context. */
+	nm_fake_platform_reset_sysctl_async_stats (NM_PLATFORM_GET);
+	nm_fake_platform_set_sysctl_async_delay (NM_PLATFORM_GET, 10);
+
+	for (i = 0; i < N_LINKS; i++) {
+		data.n_pending++;
+		nm_platform_sysctl_set_async (NM_PLATFORM_GET,
+		                              NMP_SYSCTL_PATHID_ABSOLUTE (nm_sprintf_buf (path, "/sys/class/net/vf%u/device/sriov_numvfs", i)),
+		                              values,
+		                              _sysctl_set_async_cb,
+		                              &data,
+		                              NULL);
+	}
+	g_assert_cmpint (data.n_completed, ==, 0);
+
+	while (data.n_pending > 0)
+		g_main_context_iteration (NULL, TRUE);
+	g_assert_cmpint (data.n_completed, ==, N_LINKS);
+
+	log = nm_fake_platform_get_sysctl_async_stats (NM_PLATFORM_GET, &running_max);
+	g_assert_cmpint (running_max, >, 1);
+	g_assert_cmpint (running_max, <=, NM_PLATFORM_ASYNC_WORKERS_MAX);
+
+	/* the values of one link are written in order, the last one stays. */
+	g_assert_cmpint (log->len, ==, N_LINKS * 2);
+	for (i = 0; i < N_LINKS; i++) {
+		gssize idx_first = -1;
+		gssize idx_last = -1;
+
+		nm_sprintf_buf (path, "/sys/class/net/vf%u/device/sriov_numvfs", i);
+		for (j = 0; j < log->len; j++) {
+			if (nm_streq (log->pdata[j], nm_sprintf_buf (entry, "%s=0", path)))
+				idx_first = j;
+			else if (nm_streq (log->pdata[j], nm_sprintf_buf (entry, "%s=8", path)))
+				idx_last = j;
+		}
+		g_assert_cmpint (idx_first, >=, 0);
+		g_assert_cmpint (idx_first, <, idx_last);
+		_sysctl_assert_eq (NM_PLATFORM_GET, path, "8");
+	}
+
+	nm_fake_platform_set_sysctl_async_delay (NM_PLATFORM_GET, 0);
+}
+
+/*****************************************************************************/
+
 NMTstpSetupFunc const _nmtstp_setup_platform_func = SETUP;
 
 void
@@ -2881,5 +3018,7 @@ _nmtstp_setup_tests (void)
 		g_test_add_func ("/general/sysctl/netns-switch", test_sysctl_netns_switch);
 
 		g_test_add_func ("/link/ethtool/features/get", test_ethtool_features_get);
-	}
+		g_test_add_func ("/link/ethtool/info-async", test_ethtool_info_async);
+	} else
+		g_test_add_func ("/general/sysctl/set-async", test_sysctl_set_async);
 }
@@ -417,17 +417,6 @@ nl80211_bss_dump_handler (struct nl_msg *msg, void *arg)
 	struct genlmsghdr *gnlh = nlmsg_data (nlmsg_hdr (msg));
 	struct nlattr *tb[NL80211_ATTR_MAX + 1];
 	struct nlattr *bss[NL80211_BSS_MAX + 1];
-	static const struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
-		[NL80211_BSS_TSF] = { .type = NLA_U64 },
-		[NL80211_BSS_FREQUENCY] = { .type = NLA_U32 },
-		[NL80211_BSS_BSSID] = { },
-		[NL80211_BSS_BEACON_INTERVAL] = { .type = NLA_U16 },
-		[NL80211_BSS_CAPABILITY] = { .type = NLA_U16 },
-		[NL80211_BSS_INFORMATION_ELEMENTS] = { },
-		[NL80211_BSS_SIGNAL_MBM] = { .type = NLA_U32 },
-		[NL80211_BSS_SIGNAL_UNSPEC] = { .type = NLA_U8 },
-		[NL80211_BSS_STATUS] = { .type = NLA_U32 },
-	};
 	guint32 status;
 
 	if (nla_parse (tb, NL80211_ATTR_MAX, genlmsg_attrdata (gnlh, 0),
@@ -497,6 +486,404 @@ nl80211_get_bss_info (NMWifiUtilsNl80211 *self,
 	nl80211_send_and_recv (self, msg, nl80211_bss_dump_handler, bss_info);
 }
 
+#define WLAN_EID_RSN             48
+#define WLAN_EID_VENDOR_SPECIFIC 221
+
+#define WLAN_CAPABILITY_IBSS     0x0002
+#define WLAN_CAPABILITY_PRIVACY  0x0010
+
+static const guint8 OUI_RSN[3] = { 0x00, 0x0F, 0xAC };
+static const guint8 OUI_WPA[3] = { 0x00, 0x50, 0xF2 };
+
+static const char *
+_suite_cipher_to_string (guint8 type)
+{
+	switch (type) {
+	case 1:  return "wep40";
+	case 2:  return "tkip";
+	case 4:  return "ccmp";
+	case 5:  return "wep104";
+	default: return NULL;
+	}
+}
+
+static const char *
+_suite_akm_to_string (guint8 type)
+{
+	switch (type) {
+	case 1:  return "wpa-eap";
+	case 2:  return "wpa-psk";
+	case 14: return "wpa-fils-sha256";
+	case 15: return "wpa-fils-sha384";
+	default: return NULL;
+	}
+}
+
+static void
+_parse_suite_list (const guint8 **p_data,
+                   gsize *p_len,
+                   const guint8 *oui,
+                   const char *(*to_string) (guint8 type),
+                   GVariantBuilder *builder,
+                   const char *key)
+{
+	const guint8 *data = *p_data;
+	gsize len = *p_len;
+	const char *strv[16];
+	const char *str;
+	guint count, i, n = 0;
+
+	if (len < 2)
+		return;
+	count = data[0] | (data[1] << 8);
+	data += 2;
+	len -= 2;
+
+	for (i = 0; i < count && len >= 4; i++, data += 4, len -= 4) {
+		if (   memcmp (data, oui, 3) == 0
+		    && (str = to_string (data[3]))
+		    && n < G_N_ELEMENTS (strv))
+			strv[n++] = str;
+	}
+
+	g_variant_builder_add (builder, "{sv}", key, g_variant_new_strv (strv, n));
+	*p_data = data;
+	*p_len = len;
+}
+
+/* Parses the body of a RSN or WPA information element into a dictionary
+ * like the "RSN" and "WPA" properties of wpa_supplicant's BSS objects. */
+static GVariant *
+_parse_security_ie (const guint8 *data, gsize len, const guint8 *oui)
+{
+	GVariantBuilder builder;
+	const char *str;
+
+	/* version */
+	if (len < 2)
+		return NULL;
+	data += 2;
+	len -= 2;
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+	if (len >= 4) {
+		if (   memcmp (data, oui, 3) == 0
+		    && (str = _suite_cipher_to_string (data[3])))
+			g_variant_builder_add (&builder, "{sv}", "Group", g_variant_new_string (str));
+		data += 4;
+		len -= 4;
+	}
+
+	_parse_suite_list (&data, &len, oui, _suite_cipher_to_string, &builder, "Pairwise");
+	_parse_suite_list (&data, &len, oui, _suite_akm_to_string, &builder, "KeyMgmt");
+
+	return g_variant_builder_end (&builder);
+}
+
+static const struct nla_policy bss_policy[NL80211_BSS_MAX + 1] = {
+	[NL80211_BSS_TSF] = { .type = NLA_U64 },
+	[NL80211_BSS_FREQUENCY] = { .type = NLA_U32 },
+	[NL80211_BSS_BSSID] = { },
+	[NL80211_BSS_BEACON_INTERVAL] = { .type = NLA_U16 },
+	[NL80211_BSS_CAPABILITY] = { .type = NLA_U16 },
+	[NL80211_BSS_INFORMATION_ELEMENTS] = { },
+	[NL80211_BSS_SIGNAL_MBM] = { .type = NLA_U32 },
+	[NL80211_BSS_SIGNAL_UNSPEC] = { .type = NLA_U8 },
+	[NL80211_BSS_STATUS] = { .type = NLA_U32 },
+};
+
+/**
+ * nm_wifi_utils_nl80211_parse_scan_result:
+ * @msg: a NL80211_CMD_NEW_SCAN_RESULTS message, as returned by a
+ *   NL80211_CMD_GET_SCAN dump.
+ *
+ * Returns: (transfer full): the BSS as a "a{sv}" dictionary using the
+ *   same keys as the properties of a wpa_supplicant BSS object, or %NULL
+ *   if @msg doesn't contain a valid BSS.
+ */
+GVariant *
+nm_wifi_utils_nl80211_parse_scan_result (struct nl_msg *msg)
+{
+	struct genlmsghdr *gnlh = nlmsg_data (nlmsg_hdr (msg));
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+	struct nlattr *bss[NL80211_BSS_MAX + 1];
+	GVariantBuilder builder;
+	const guint8 *ies;
+	gsize ies_len;
+	gboolean has_ssid = FALSE;
+	gboolean has_rsn = FALSE;
+	gboolean has_wpa = FALSE;
+
+	if (nla_parse (tb, NL80211_ATTR_MAX, genlmsg_attrdata (gnlh, 0),
+	               genlmsg_attrlen (gnlh, 0), NULL) < 0)
+		return NULL;
+
+	if (   !tb[NL80211_ATTR_BSS]
+	    || nla_parse_nested (bss, NL80211_BSS_MAX, tb[NL80211_ATTR_BSS], bss_policy) < 0)
+		return NULL;
+
+	if (   !bss[NL80211_BSS_BSSID]
+	    || nla_len (bss[NL80211_BSS_BSSID]) != ETH_ALEN)
+		return NULL;
+
+	g_variant_builder_init (&builder, G_VARIANT_TYPE_VARDICT);
+
+	g_variant_builder_add (&builder, "{sv}", "BSSID",
+	                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE,
+	                                                  nla_data (bss[NL80211_BSS_BSSID]),
+	                                                  ETH_ALEN, 1));
+
+	if (bss[NL80211_BSS_FREQUENCY]) {
+		g_variant_builder_add (&builder, "{sv}", "Frequency",
+		                       g_variant_new_uint16 (nla_get_u32 (bss[NL80211_BSS_FREQUENCY])));
+	}
+
+	/* "Signal" is in dBm. Drivers that don't know the dBm value report
+	 * a quality between 0 and 100, which is mapped onto the dBm range
+	 * that nm_wifi_utils_level_to_quality() maps back to 0-100%. */
+	if (bss[NL80211_BSS_SIGNAL_MBM]) {
+		g_variant_builder_add (&builder, "{sv}", "Signal",
+		                       g_variant_new_int16 (((gint32) nla_get_u32 (bss[NL80211_BSS_SIGNAL_MBM])) / 100));
+	} else if (bss[NL80211_BSS_SIGNAL_UNSPEC]) {
+		guint8 quality = MIN (nla_get_u8 (bss[NL80211_BSS_SIGNAL_UNSPEC]), 100);
+
+		g_variant_builder_add (&builder, "{sv}", "Signal",
+		                       g_variant_new_int16 (-100 + (quality * 60) / 100));
+	}
+
+	if (bss[NL80211_BSS_CAPABILITY]) {
+		guint16 caps = nla_get_u16 (bss[NL80211_BSS_CAPABILITY]);
+
+		g_variant_builder_add (&builder, "{sv}", "Privacy",
+		                       g_variant_new_boolean (NM_FLAGS_HAS (caps, WLAN_CAPABILITY_PRIVACY)));
+		g_variant_builder_add (&builder, "{sv}", "Mode",
+		                       g_variant_new_string (NM_FLAGS_HAS (caps, WLAN_CAPABILITY_IBSS)
+		                                             ? "ad-hoc"
+		                                             : "infrastructure"));
+	}
+
+	if (bss[NL80211_BSS_INFORMATION_ELEMENTS]) {
+		ies = nla_data (bss[NL80211_BSS_INFORMATION_ELEMENTS]);
+		ies_len = nla_len (bss[NL80211_BSS_INFORMATION_ELEMENTS]);
+
+		g_variant_builder_add (&builder, "{sv}", "IEs",
+		                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE, ies, ies_len, 1));
+
+		/* a dictionary can't have duplicate keys. Like wpa_supplicant,
+		 * only the first of repeated elements is used. */
+		while (ies_len >= 2 && ies_len >= 2u + ies[1]) {
+			const guint8 *data = &ies[2];
+			gsize len = ies[1];
+			GVariant *v;
+
+			switch (ies[0]) {
+			case WLAN_EID_SSID:
+				if (has_ssid)
+					break;
+				has_ssid = TRUE;
+				g_variant_builder_add (&builder, "{sv}", "SSID",
+				                       g_variant_new_fixed_array (G_VARIANT_TYPE_BYTE, data, len, 1));
+				break;
+			case WLAN_EID_RSN:
+				if (has_rsn)
+					break;
+				v = _parse_security_ie (data, len, OUI_RSN);
+				if (v) {
+					has_rsn = TRUE;
+					g_variant_builder_add (&builder, "{sv}", "RSN", v);
+				}
+				break;
+			case WLAN_EID_VENDOR_SPECIFIC:
+				if (   !has_wpa
+				    && len >= 4
+				    && memcmp (data, OUI_WPA, 3) == 0
+				    && data[3] == 1) {
+					v = _parse_security_ie (&data[4], len - 4, OUI_WPA);
+					if (v) {
+						has_wpa = TRUE;
+						g_variant_builder_add (&builder, "{sv}", "WPA", v);
+					}
+				}
+				break;
+			}
+
+			ies_len -= 2 + ies[1];
+			ies += 2 + ies[1];
+		}
+	}
+
+	return g_variant_ref_sink (g_variant_builder_end (&builder));
+}
+
+static int
+nl80211_scan_dump_handler (struct nl_msg *msg, void *arg)
+{
+	GPtrArray *results = arg;
+	GVariant *v;
+
+	v = nm_wifi_utils_nl80211_parse_scan_result (msg);
+	if (v)
+		g_ptr_array_add (results, v);
+	return NL_SKIP;
+}
+
+static GPtrArray *
+wifi_nl80211_get_scan_results (NMWifiUtils *data)
+{
+	NMWifiUtilsNl80211 *self = (NMWifiUtilsNl80211 *) data;
+	nm_auto_nlmsg struct nl_msg *msg = NULL;
+	gs_unref_ptrarray GPtrArray *results = NULL;
+	int err;
+
+	msg = nl80211_alloc_msg (self, NL80211_CMD_GET_SCAN, NLM_F_DUMP);
+	results = g_ptr_array_new_with_free_func ((GDestroyNotify) g_variant_unref);
+
+	err = nl80211_send_and_recv (self, msg, nl80211_scan_dump_handler, results);
+	if (err < 0) {
+		_LOGD ("failed to dump scan results: %s", nl_geterror (err));
+		return NULL;
+	}
+	return g_steal_pointer (&results);
+}
+
+/**
+ * nm_wifi_utils_nl80211_parse_scan_done:
+ * @msg: a message of the "scan" multicast group of nl80211
+ *
+ * Returns: the ifindex of the interface if @msg announces that its scan
+ *   finished with new results, or 0.
+ */
+int
+nm_wifi_utils_nl80211_parse_scan_done (struct nl_msg *msg)
+{
+	struct nlmsghdr *nlh = nlmsg_hdr (msg);
+	struct genlmsghdr *gnlh;
+	struct nlattr *tb[NL80211_ATTR_MAX + 1];
+
+	if (   nlh->nlmsg_type < NLMSG_MIN_TYPE
+	    || !genlmsg_valid_hdr (nlh, 0))
+		return 0;
+
+	gnlh = nlmsg_data (nlh);
+	if (gnlh->cmd != NL80211_CMD_NEW_SCAN_RESULTS)
+		return 0;
+
+	if (nla_parse (tb, NL80211_ATTR_MAX, genlmsg_attrdata (gnlh, 0),
+	               genlmsg_attrlen (gnlh, 0), NULL) < 0)
+		return 0;
+
+	/* the replies of a NL80211_CMD_GET_SCAN dump use the same command,
+	 * but each carries a BSS. */
+	if (   tb[NL80211_ATTR_BSS]
+	    || !tb[NL80211_ATTR_IFINDEX])
+		return 0;
+
+	return nla_get_u32 (tb[NL80211_ATTR_IFINDEX]);
+}
+
+struct _NMWifiUtilsNl80211ScanMonitor {
+	struct nl_sock *nl_sock;
+	GIOChannel *channel;
+	guint event_id;
+	int ifindex;
+	NMWifiUtilsNl80211ScanDoneFunc callback;
+	gpointer user_data;
+};
+
+static gboolean
+_scan_monitor_event_cb (GIOChannel *channel,
+                        GIOCondition condition,
+                        gpointer user_data)
+{
+	NMWifiUtilsNl80211ScanMonitor *monitor = user_data;
+	gboolean scan_done = FALSE;
+
+	for (;;) {
+		gs_free unsigned char *buf = NULL;
+		struct sockaddr_nl nla = { 0 };
+		struct nlmsghdr *hdr;
+		int n;
+
+		n = nl_recv (monitor->nl_sock, &nla, &buf, NULL);
+		if (n == -ENOBUFS) {
+			/* events were lost, one of them might have been ours. */
+			scan_done = TRUE;
+			continue;
+		}
+		if (n <= 0)
+			break;
+
+		for (hdr = (struct nlmsghdr *) buf; nlmsg_ok (hdr, n); hdr = nlmsg_next (hdr, &n)) {
+			nm_auto_nlmsg struct nl_msg *msg = NULL;
+
+			msg = nlmsg_alloc_convert (hdr);
+			if (nm_wifi_utils_nl80211_parse_scan_done (msg) == monitor->ifindex)
+				scan_done = TRUE;
+		}
+	}
+
+	if (scan_done)
+		monitor->callback (monitor->user_data);
+
+	return G_SOURCE_CONTINUE;
+}
+
+/**
+ * nm_wifi_utils_nl80211_scan_monitor_new:
+ * @ifindex: the interface to watch
+ * @callback: invoked when the kernel has new scan results for @ifindex
+ * @user_data: data for @callback
+ *
+ * Subscribes to the "scan" multicast group of nl80211 in the current
+ * network namespace.
+ *
+ * Returns: the monitor, or %NULL if nl80211 is not available.
+ */
+NMWifiUtilsNl80211ScanMonitor *
+nm_wifi_utils_nl80211_scan_monitor_new (int ifindex,
+                                        NMWifiUtilsNl80211ScanDoneFunc callback,
+                                        gpointer user_data)
+{
+	NMWifiUtilsNl80211ScanMonitor *monitor;
+	struct nl_sock *nl_sock;
+	int grp;
+
+	g_return_val_if_fail (ifindex > 0, NULL);
+	g_return_val_if_fail (callback, NULL);
+
+	nl_sock = nl_socket_alloc ();
+	if (   nl_connect (nl_sock, NETLINK_GENERIC) < 0
+	    || (grp = genl_ctrl_resolve_grp (nl_sock, "nl80211", "scan")) < 0
+	    || nl_socket_add_memberships (nl_sock, grp, 0) < 0
+	    || nl_socket_set_nonblocking (nl_sock) < 0) {
+		nl_socket_free (nl_sock);
+		return NULL;
+	}
+
+	monitor = g_slice_new0 (NMWifiUtilsNl80211ScanMonitor);
+	monitor->nl_sock = nl_sock;
+	monitor->ifindex = ifindex;
+	monitor->callback = callback;
+	monitor->user_data = user_data;
+	monitor->channel = g_io_channel_unix_new (nl_socket_get_fd (nl_sock));
+	g_io_channel_set_encoding (monitor->channel, NULL, NULL);
+	monitor->event_id = g_io_add_watch (monitor->channel, G_IO_IN, _scan_monitor_event_cb, monitor);
+	return monitor;
+}
+
+void
+nm_wifi_utils_nl80211_scan_monitor_free (NMWifiUtilsNl80211ScanMonitor *monitor)
+{
+	if (!monitor)
+		return;
+
+	nm_clear_g_source (&monitor->event_id);
+	g_io_channel_unref (monitor->channel);
+	nl_socket_free (monitor->nl_sock);
+	g_slice_free (NMWifiUtilsNl80211ScanMonitor, monitor);
+}
+
 static guint32
 wifi_nl80211_get_freq (NMWifiUtils *data)
 {
@@ -524,6 +911,17 @@ wifi_nl80211_find_freq (NMWifiUtils *data, const guint32 *freqs)
 	return 0;
 }
 
+static GArray *
+wifi_nl80211_get_freqs (NMWifiUtils *data)
+{
+	NMWifiUtilsNl80211 *self = (NMWifiUtilsNl80211 *) data;
+	GArray *freqs;
+
+	freqs = g_array_sized_new (FALSE, FALSE, sizeof (guint32), self->num_freqs);
+	g_array_append_vals (freqs, self->freqs, self->num_freqs);
+	return freqs;
+}
+
 static gboolean
 wifi_nl80211_get_bssid (NMWifiUtils *data, guint8 *out_bssid)
 {
@@ -915,10 +1313,12 @@ nm_wifi_utils_nl80211_class_init (NMWifiUtilsNl80211Class *klass)
 	wifi_utils_class->set_wake_on_wlan = wifi_nl80211_set_wake_on_wlan,
 	wifi_utils_class->get_freq = wifi_nl80211_get_freq;
 	wifi_utils_class->find_freq = wifi_nl80211_find_freq;
+	wifi_utils_class->get_freqs = wifi_nl80211_get_freqs;
 	wifi_utils_class->get_bssid = wifi_nl80211_get_bssid;
 	wifi_utils_class->get_rate = wifi_nl80211_get_rate;
 	wifi_utils_class->get_qual = wifi_nl80211_get_qual;
 	wifi_utils_class->indicate_addressing_running = wifi_nl80211_indicate_addressing_running;
+	wifi_utils_class->get_scan_results = wifi_nl80211_get_scan_results;
 }
 
 NMWifiUtils *
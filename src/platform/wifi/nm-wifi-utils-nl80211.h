@@ -36,4 +36,17 @@ GType nm_wifi_utils_nl80211_get_type (void);
 
 NMWifiUtils *nm_wifi_utils_nl80211_new (int ifindex, struct nl_sock *genl);
 
+GVariant *nm_wifi_utils_nl80211_parse_scan_result (struct nl_msg *msg);
+
+int nm_wifi_utils_nl80211_parse_scan_done (struct nl_msg *msg);
+
+typedef struct _NMWifiUtilsNl80211ScanMonitor NMWifiUtilsNl80211ScanMonitor;
+
+typedef void (*NMWifiUtilsNl80211ScanDoneFunc) (gpointer user_data);
+
+NMWifiUtilsNl80211ScanMonitor *nm_wifi_utils_nl80211_scan_monitor_new (int ifindex,
+                                                                       NMWifiUtilsNl80211ScanDoneFunc callback,
+                                                                       gpointer user_data);
+void nm_wifi_utils_nl80211_scan_monitor_free (NMWifiUtilsNl80211ScanMonitor *monitor);
+
 #endif  /* __WIFI_UTILS_NL80211_H__ */
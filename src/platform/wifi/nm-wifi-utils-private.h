@@ -67,6 +67,13 @@ typedef struct {
 	gboolean (*set_mesh_ssid) (NMWifiUtils *data, const guint8 *ssid, gsize len);
 
 	gboolean (*indicate_addressing_running) (NMWifiUtils *data, gboolean running);
+
+	/* Return the scan results known to the kernel, as "a{sv}" dictionaries
+	 * like the properties of wpa_supplicant BSS objects (optional). */
+	GPtrArray *(*get_scan_results) (NMWifiUtils *data);
+
+	/* Return the supported frequencies in MHz as an array of guint32 (optional). */
+	GArray *(*get_freqs) (NMWifiUtils *data);
 } NMWifiUtilsClass;
 
 struct NMWifiUtils {
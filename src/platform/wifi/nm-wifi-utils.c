@@ -133,6 +133,28 @@ nm_wifi_utils_set_wake_on_wlan (NMWifiUtils *data, NMSettingWirelessWakeOnWLan w
 	return klass->set_wake_on_wlan ? klass->set_wake_on_wlan (data, wowl) : FALSE;
 }
 
+GPtrArray *
+nm_wifi_utils_get_scan_results (NMWifiUtils *data)
+{
+	NMWifiUtilsClass *klass;
+
+	g_return_val_if_fail (data != NULL, NULL);
+
+	klass = NM_WIFI_UTILS_GET_CLASS (data);
+	return klass->get_scan_results ? klass->get_scan_results (data) : NULL;
+}
+
+GArray *
+nm_wifi_utils_get_freqs (NMWifiUtils *data)
+{
+	NMWifiUtilsClass *klass;
+
+	g_return_val_if_fail (data != NULL, NULL);
+
+	klass = NM_WIFI_UTILS_GET_CLASS (data);
+	return klass->get_freqs ? klass->get_freqs (data) : NULL;
+}
+
 guint32
 nm_wifi_utils_get_freq (NMWifiUtils *data)
 {
@@ -74,6 +74,12 @@ NMSettingWirelessWakeOnWLan nm_wifi_utils_get_wake_on_wlan (NMWifiUtils *data);
 
 gboolean nm_wifi_utils_set_wake_on_wlan (NMWifiUtils *data, NMSettingWirelessWakeOnWLan wowl);
 
+/* Returns the kernel's scan results as a{sv} GVariants, or NULL if unsupported */
+GPtrArray *nm_wifi_utils_get_scan_results (NMWifiUtils *data);
+
+/* Returns the supported frequencies (guint32, MHz), or NULL if unsupported */
+GArray *nm_wifi_utils_get_freqs (NMWifiUtils *data);
+
 /* OLPC Mesh-only functions */
 guint32 nm_wifi_utils_get_mesh_channel (NMWifiUtils *data);
 
@@ -125,7 +125,7 @@ typedef struct _NMSettingsConnectionPrivate {
 
 	char *filename;
 
-	GHashTable *seen_bssids; /* Up-to-date BSSIDs that's been seen for the connection */
+	GHashTable *seen_bssids; /* Up-to-date BSSIDs that's been seen for the connection (SeenBssidEntry) */
 
 	guint64 timestamp;   /* Up-to-date timestamp of connection use */
 
@@ -1558,6 +1558,53 @@ check_writable (NMConnection *self, GError **error)
 	return TRUE;
 }
 
+/**
+ * nm_settings_connection_to_dbus_settings:
+ * @self: the #NMSettingsConnection
+ *
+ * Returns: (transfer full): the settings as returned by GetSettings(),
+ *   that is without secrets, but with the actual timestamp and seen-bssids.
+ */
+GVariant *
+nm_settings_connection_to_dbus_settings (NMSettingsConnection *self)
+{
+	gs_unref_object NMConnection *dupl_con = NULL;
+	NMSettingConnection *s_con;
+	NMSettingWireless *s_wifi;
+	guint64 timestamp = 0;
+	gs_free char **bssids = NULL;
+
+	g_return_val_if_fail (NM_IS_SETTINGS_CONNECTION (self), NULL);
+
+	dupl_con = nm_simple_connection_new_clone (nm_settings_connection_get_connection (self));
+
+	/* Timestamp is not updated in connection's 'timestamp' property,
+	 * because it would force updating the connection and in turn
+	 * writing to /etc periodically, which we want to avoid. Rather real
+	 * timestamps are kept track of in a private variable. So, substitute
+	 * timestamp property with the real one here before returning the settings.
+	 */
+	nm_settings_connection_get_timestamp (self, &timestamp);
+	if (timestamp) {
+		s_con = nm_connection_get_setting_connection (dupl_con);
+		g_object_set (s_con, NM_SETTING_CONNECTION_TIMESTAMP, timestamp, NULL);
+	}
+	/* Seen BSSIDs are not updated in 802-11-wireless 'seen-bssids' property
+	 * from the same reason as timestamp. Thus we put it here to GetSettings()
+	 * return settings too.
+	 */
+	bssids = nm_settings_connection_get_seen_bssids (self);
+	s_wifi = nm_connection_get_setting_wireless (dupl_con);
+	if (bssids && bssids[0] && s_wifi)
+		g_object_set (s_wifi, NM_SETTING_WIRELESS_SEEN_BSSIDS, bssids, NULL);
+
+	/* Secrets should *never* be returned by the GetSettings method, they
+	 * get returned by the GetSecrets method which can be better
+	 * protected against leakage of secrets to unprivileged callers.
+	 */
+	return nm_connection_to_dbus (dupl_con, NM_CONNECTION_SERIALIZE_NO_SECRETS);
+}
+
 static void
 get_settings_auth_cb (NMSettingsConnection *self,
                       GDBusMethodInvocation *context,
@@ -1568,42 +1615,9 @@ get_settings_auth_cb (NMSettingsConnection *self,
 	if (error)
 		g_dbus_method_invocation_return_gerror (context, error);
 	else {
-		gs_unref_object NMConnection *dupl_con = NULL;
-		GVariant *settings;
-		NMSettingConnection *s_con;
-		NMSettingWireless *s_wifi;
-		guint64 timestamp = 0;
-		gs_free char **bssids = NULL;
-
-		dupl_con = nm_simple_connection_new_clone (nm_settings_connection_get_connection (self));
-
-		/* Timestamp is not updated in connection's 'timestamp' property,
-		 * because it would force updating the connection and in turn
-		 * writing to /etc periodically, which we want to avoid. Rather real
-		 * timestamps are kept track of in a private variable. So, substitute
-		 * timestamp property with the real one here before returning the settings.
-		 */
-		nm_settings_connection_get_timestamp (self, &timestamp);
-		if (timestamp) {
-			s_con = nm_connection_get_setting_connection (dupl_con);
-			g_object_set (s_con, NM_SETTING_CONNECTION_TIMESTAMP, timestamp, NULL);
-		}
-		/* Seen BSSIDs are not updated in 802-11-wireless 'seen-bssids' property
-		 * from the same reason as timestamp. Thus we put it here to GetSettings()
-		 * return settings too.
-		 */
-		bssids = nm_settings_connection_get_seen_bssids (self);
-		s_wifi = nm_connection_get_setting_wireless (dupl_con);
-		if (bssids && bssids[0] && s_wifi)
-			g_object_set (s_wifi, NM_SETTING_WIRELESS_SEEN_BSSIDS, bssids, NULL);
-
-		/* Secrets should *never* be returned by the GetSettings method, they
-		 * get returned by the GetSecrets method which can be better
-		 * protected against leakage of secrets to unprivileged callers.
-		 */
-		settings = nm_connection_to_dbus (dupl_con, NM_CONNECTION_SERIALIZE_NO_SECRETS);
 		g_dbus_method_invocation_return_value (context,
-		                                       g_variant_new ("(@a{sa{sv}})", settings));
+		                                       g_variant_new ("(@a{sa{sv}})",
+		                                                      nm_settings_connection_to_dbus_settings (self)));
 	}
 }
 
@@ -2580,6 +2594,117 @@ nm_settings_connection_read_and_fill_timestamp (NMSettingsConnection *self)
 	priv->timestamp_set = TRUE;
 }
 
+/* All seen BSSIDs of all connections are also tracked in a global index,
+ * mapping each BSSID to the list of connections that have seen it. This
+ * lets devices resolve the SSID of a hidden AP without looking at every
+ * connection. */
+
+typedef struct {
+	char *bssid;
+	CList entries_lst_head;
+} SeenBssidBucket;
+
+typedef struct {
+	char *bssid;
+	CList bucket_lst;
+	NMSettingsConnection *self;
+	SeenBssidBucket *bucket;
+} SeenBssidEntry;
+
+static GHashTable *_seen_bssids_index = NULL;
+
+static void
+_seen_bssid_bucket_free (gpointer data)
+{
+	SeenBssidBucket *bucket = data;
+
+	nm_assert (c_list_is_empty (&bucket->entries_lst_head));
+
+	g_free (bucket->bssid);
+	g_slice_free (SeenBssidBucket, bucket);
+}
+
+static void
+_seen_bssid_entry_free (gpointer data)
+{
+	SeenBssidEntry *entry = data;
+	SeenBssidBucket *bucket = entry->bucket;
+
+	c_list_unlink_stale (&entry->bucket_lst);
+	if (c_list_is_empty (&bucket->entries_lst_head))
+		g_hash_table_remove (_seen_bssids_index, bucket);
+
+	g_free (entry->bssid);
+	g_slice_free (SeenBssidEntry, entry);
+}
+
+/* takes ownership of @bssid */
+static void
+_seen_bssid_add (NMSettingsConnection *self, char *bssid)
+{
+	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
+	SeenBssidBucket *bucket;
+	SeenBssidEntry *entry;
+
+	if (g_hash_table_lookup (priv->seen_bssids, &bssid)) {
+		g_free (bssid);
+		return;
+	}
+
+	if (G_UNLIKELY (!_seen_bssids_index))
+		_seen_bssids_index = g_hash_table_new_full (nm_pstr_hash, nm_pstr_equal, _seen_bssid_bucket_free, NULL);
+
+	bucket = g_hash_table_lookup (_seen_bssids_index, &bssid);
+	if (!bucket) {
+		bucket = g_slice_new (SeenBssidBucket);
+		bucket->bssid = g_strdup (bssid);
+		c_list_init (&bucket->entries_lst_head);
+		g_hash_table_add (_seen_bssids_index, bucket);
+	}
+
+	entry = g_slice_new (SeenBssidEntry);
+	entry->bssid = bssid;
+	entry->self = self;
+	entry->bucket = bucket;
+	c_list_link_tail (&bucket->entries_lst_head, &entry->bucket_lst);
+	g_hash_table_add (priv->seen_bssids, entry);
+}
+
+/**
+ * nm_settings_connection_find_by_seen_bssid:
+ * @bssid: the BSSID to look up
+ *
+ * Returns: (transfer none): a Wi-Fi connection known to #NMSettings that
+ *   has seen @bssid, or %NULL if there is none.
+ **/
+NMSettingsConnection *
+nm_settings_connection_find_by_seen_bssid (const char *bssid)
+{
+	SeenBssidBucket *bucket;
+	SeenBssidEntry *entry;
+
+	g_return_val_if_fail (bssid, NULL);
+
+	if (!_seen_bssids_index)
+		return NULL;
+
+	bucket = g_hash_table_lookup (_seen_bssids_index, &bssid);
+	if (!bucket)
+		return NULL;
+
+	c_list_for_each_entry (entry, &bucket->entries_lst_head, bucket_lst) {
+		NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (entry->self);
+
+		if (c_list_is_empty (&entry->self->_connections_lst))
+			continue;
+		if (   !priv->connection
+		    || !nm_connection_get_setting_wireless (priv->connection))
+			continue;
+		return entry->self;
+	}
+	return NULL;
+}
+
 /**
  * nm_settings_connection_get_seen_bssids:
  * @self: the #NMSettingsConnection
@@ -2594,7 +2719,8 @@ nm_settings_connection_get_seen_bssids (NMSettingsConnection *self)
 {
 	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
 	GHashTableIter iter;
-	char **bssids, *bssid;
+	char **bssids;
+	SeenBssidEntry *entry;
 	int i;
 
 	g_return_val_if_fail (NM_IS_SETTINGS_CONNECTION (self), NULL);
@@ -2603,8 +2729,8 @@ nm_settings_connection_get_seen_bssids (NMSettingsConnection *self)
 
 	i = 0;
 	g_hash_table_iter_init (&iter, priv->seen_bssids);
-	while (g_hash_table_iter_next (&iter, NULL, (gpointer) &bssid))
-		bssids[i++] = bssid;
+	while (g_hash_table_iter_next (&iter, (gpointer *) &entry, NULL))
+		bssids[i++] = entry->bssid;
 	bssids[i] = NULL;
 
 	return bssids;
@@ -2624,7 +2750,7 @@ nm_settings_connection_has_seen_bssid (NMSettingsConnection *self,
 	g_return_val_if_fail (NM_IS_SETTINGS_CONNECTION (self), FALSE);
 	g_return_val_if_fail (bssid != NULL, FALSE);
 
-	return !!g_hash_table_lookup (NM_SETTINGS_CONNECTION_GET_PRIVATE (self)->seen_bssids, bssid);
+	return !!g_hash_table_lookup (NM_SETTINGS_CONNECTION_GET_PRIVATE (self)->seen_bssids, &bssid);
 }
 
 /**
@@ -2642,28 +2768,28 @@ nm_settings_connection_add_seen_bssid (NMSettingsConnection *self,
 	NMSettingsConnectionPrivate *priv = NM_SETTINGS_CONNECTION_GET_PRIVATE (self);
 	const char *connection_uuid;
 	GKeyFile *seen_bssids_file;
-	char *data, *bssid_str;
+	char *data;
 	const char **list;
 	gsize len;
 	GError *error = NULL;
 	GHashTableIter iter;
+	SeenBssidEntry *entry;
 	guint n;
 
 	g_return_if_fail (seen_bssid != NULL);
 
-	if (g_hash_table_lookup (priv->seen_bssids, seen_bssid))
+	if (g_hash_table_lookup (priv->seen_bssids, &seen_bssid))
 		return;  /* Already in the list */
 
-	/* Add the new BSSID; let the hash take ownership of the allocated BSSID string */
-	bssid_str = g_strdup (seen_bssid);
-	g_hash_table_insert (priv->seen_bssids, bssid_str, bssid_str);
+	/* Add the new BSSID */
+	_seen_bssid_add (self, g_strdup (seen_bssid));
 
 	/* Build up a list of all the BSSIDs in string form */
 	n = 0;
 	list = g_malloc0 (g_hash_table_size (priv->seen_bssids) * sizeof (char *));
 	g_hash_table_iter_init (&iter, priv->seen_bssids);
-	while (g_hash_table_iter_next (&iter, NULL, (gpointer) &bssid_str))
-		list[n++] = bssid_str;
+	while (g_hash_table_iter_next (&iter, (gpointer *) &entry, NULL))
+		list[n++] = entry->bssid;
 
 	/* Save BSSID to seen-bssids file */
 	seen_bssids_file = g_key_file_new ();
@@ -2724,7 +2850,7 @@ nm_settings_connection_read_and_fill_seen_bssids (NMSettingsConnection *self)
 	if (tmp_strv) {
 		g_hash_table_remove_all (priv->seen_bssids);
 		for (i = 0; i < len; i++)
-			g_hash_table_insert (priv->seen_bssids, tmp_strv[i], tmp_strv[i]);
+			_seen_bssid_add (self, tmp_strv[i]);
 		g_free (tmp_strv);
 	} else {
 		/* If this connection didn't have an entry in the seen-bssids database,
@@ -2735,11 +2861,8 @@ nm_settings_connection_read_and_fill_seen_bssids (NMSettingsConnection *self)
 		s_wifi = nm_connection_get_setting_wireless (nm_settings_connection_get_connection (self));
 		if (s_wifi) {
 			len = nm_setting_wireless_get_num_seen_bssids (s_wifi);
-			for (i = 0; i < len; i++) {
-				char *bssid_dup = g_strdup (nm_setting_wireless_get_seen_bssid (s_wifi, i));
-
-				g_hash_table_insert (priv->seen_bssids, bssid_dup, bssid_dup);
-			}
+			for (i = 0; i < len; i++)
+				_seen_bssid_add (self, g_strdup (nm_setting_wireless_get_seen_bssid (s_wifi, i)));
 		}
 	}
 }
@@ -3002,7 +3125,7 @@ nm_settings_connection_init (NMSettingsConnection *self)
 
 	priv->agent_mgr = g_object_ref (nm_agent_manager_get ());
 
-	priv->seen_bssids = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, NULL);
+	priv->seen_bssids = g_hash_table_new_full (nm_pstr_hash, nm_pstr_equal, _seen_bssid_entry_free, NULL);
 
 	priv->autoconnect_retries = AUTOCONNECT_RETRIES_UNSET;
 
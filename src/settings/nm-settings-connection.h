@@ -231,6 +231,8 @@ void nm_settings_connection_read_and_fill_timestamp (NMSettingsConnection *self)
 
 char **nm_settings_connection_get_seen_bssids (NMSettingsConnection *self);
 
+GVariant *nm_settings_connection_to_dbus_settings (NMSettingsConnection *self);
+
 gboolean nm_settings_connection_has_seen_bssid (NMSettingsConnection *self,
                                                 const char *bssid);
 
@@ -239,6 +241,8 @@ void nm_settings_connection_add_seen_bssid (NMSettingsConnection *self,
 
 void nm_settings_connection_read_and_fill_seen_bssids (NMSettingsConnection *self);
 
+NMSettingsConnection *nm_settings_connection_find_by_seen_bssid (const char *bssid);
+
 int nm_settings_connection_autoconnect_retries_get (NMSettingsConnection *self);
 void nm_settings_connection_autoconnect_retries_set (NMSettingsConnection *self,
                                                      int retries);
@@ -124,6 +124,14 @@ typedef struct {
 	CList connections_lst_head;
 
 	NMSettingsConnection **connections_cached_list;
+
+	/* connection type -> GPtrArray of connections with autoconnect enabled.
+	 * The key "" indexes all of them. Built lazily and then kept up to date
+	 * when a connection gets added, removed or updated. autoconnect_index_by_con
+	 * maps each indexed connection to the key of its type bucket. */
+	GHashTable *autoconnect_index;
+	GHashTable *autoconnect_index_by_con;
+
 	GSList *unmanaged_specs;
 	GSList *unrecognized_specs;
 
@@ -283,6 +291,54 @@ impl_settings_list_connections (NMDBusObject *obj,
 	                                       g_variant_new ("(^ao)", strv));
 }
 
+static void
+impl_settings_get_all_settings (NMDBusObject *obj,
+                                const NMDBusInterfaceInfoExtended *interface_info,
+                                const NMDBusMethodInfoExtended *method_info,
+                                GDBusConnection *dbus_connection,
+                                const char *sender,
+                                GDBusMethodInvocation *invocation,
+                                GVariant *parameters)
+{
+	NMSettings *self = NM_SETTINGS (obj);
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE (self);
+	gs_unref_object NMAuthSubject *subject = NULL;
+	NMSettingsConnection *sett_conn;
+	GVariantBuilder builder;
+
+	subject = nm_auth_subject_new_unix_process_from_context (invocation);
+	if (!subject) {
+		g_dbus_method_invocation_return_error_literal (invocation,
+		                                               NM_SETTINGS_ERROR,
+		                                               NM_SETTINGS_ERROR_PERMISSION_DENIED,
+		                                               "Unable to determine UID of request.");
+		return;
+	}
+
+	/* Like calling GetSettings() on each connection, except that the
+	 * connections that are not visible to the caller are silently
+	 * skipped instead of failing. */
+	g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{oa{sa{sv}}}"));
+	c_list_for_each_entry (sett_conn, &priv->connections_lst_head, _connections_lst) {
+		const char *path;
+
+		path = nm_dbus_object_get_path (NM_DBUS_OBJECT (sett_conn));
+		if (!path)
+			continue;
+		if (!nm_auth_is_subject_in_acl (nm_settings_connection_get_connection (sett_conn),
+		                                subject,
+		                                NULL))
+			continue;
+
+		g_variant_builder_add (&builder, "{o@a{sa{sv}}}",
+		                       path,
+		                       nm_settings_connection_to_dbus_settings (sett_conn));
+	}
+
+	g_dbus_method_invocation_return_value (invocation,
+	                                       g_variant_new ("(a{oa{sa{sv}}})", &builder));
+}
+
 NMSettingsConnection *
 nm_settings_get_connection_by_uuid (NMSettings *self, const char *uuid)
 {
@@ -351,6 +407,66 @@ error:
 	g_dbus_method_invocation_take_error (invocation, error);
 }
 
+static GPtrArray *
+_autoconnect_index_ensure_bucket (GHashTable *index, const char *connection_type, const char **out_key)
+{
+	GPtrArray *bucket;
+	char *key;
+
+	if (!g_hash_table_lookup_extended (index, connection_type, (gpointer *) &key, (gpointer *) &bucket)) {
+		bucket = g_ptr_array_new ();
+		key = g_strdup (connection_type);
+		g_hash_table_insert (index, key, bucket);
+	}
+	NM_SET_OUT (out_key, key);
+	return bucket;
+}
+
+static void
+_autoconnect_index_add (NMSettingsPrivate *priv, NMSettingsConnection *sett_conn)
+{
+	NMSettingConnection *s_con;
+	const char *type;
+	const char *key;
+
+	if (!priv->autoconnect_index)
+		return;
+
+	nm_assert (!g_hash_table_contains (priv->autoconnect_index_by_con, sett_conn));
+
+	s_con = nm_connection_get_setting_connection (nm_settings_connection_get_connection (sett_conn));
+	if (   !s_con
+	    || !nm_setting_connection_get_autoconnect (s_con))
+		return;
+
+	g_ptr_array_add (g_hash_table_lookup (priv->autoconnect_index, ""), sett_conn);
+
+	type = nm_setting_connection_get_connection_type (s_con);
+	if (type && type[0]) {
+		g_ptr_array_add (_autoconnect_index_ensure_bucket (priv->autoconnect_index, type, &key),
+		                 sett_conn);
+	} else
+		key = "";
+	g_hash_table_insert (priv->autoconnect_index_by_con, sett_conn, (gpointer) key);
+}
+
+static void
+_autoconnect_index_remove (NMSettingsPrivate *priv, NMSettingsConnection *sett_conn)
+{
+	const char *key;
+
+	if (!priv->autoconnect_index)
+		return;
+
+	if (!g_hash_table_lookup_extended (priv->autoconnect_index_by_con, sett_conn, NULL, (gpointer *) &key))
+		return;
+
+	g_hash_table_remove (priv->autoconnect_index_by_con, sett_conn);
+	g_ptr_array_remove_fast (g_hash_table_lookup (priv->autoconnect_index, ""), sett_conn);
+	if (key[0])
+		g_ptr_array_remove_fast (g_hash_table_lookup (priv->autoconnect_index, key), sett_conn);
+}
+
 static void
 _clear_connections_cached_list (NMSettingsPrivate *priv)
 {
@@ -476,6 +592,51 @@ nm_settings_get_connections_clone (NMSettings *self,
 	return list;
 }
 
+/**
+ * nm_settings_get_autoconnect_connections:
+ * @self: the #NMSettings
+ * @connection_type: (allow-none): the connection type to look up,
+ *   or %NULL for all types.
+ * @out_len: (out): the number of returned connections
+ *
+ * Returns: (transfer-none): the connections of @connection_type that
+ * have autoconnect enabled. The list is unsorted and not NULL terminated.
+ * It is cached internally and only valid until the next NMSettings
+ * operation.
+ */
+NMSettingsConnection *const*
+nm_settings_get_autoconnect_connections (NMSettings *self,
+                                         const char *connection_type,
+                                         guint *out_len)
+{
+	NMSettingsPrivate *priv;
+	NMSettingsConnection *con;
+	GPtrArray *bucket;
+
+	g_return_val_if_fail (NM_IS_SETTINGS (self), NULL);
+	g_return_val_if_fail (out_len, NULL);
+
+	priv = NM_SETTINGS_GET_PRIVATE (self);
+
+	if (G_UNLIKELY (!priv->autoconnect_index)) {
+		priv->autoconnect_index = g_hash_table_new_full (nm_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
+		priv->autoconnect_index_by_con = g_hash_table_new (nm_direct_hash, NULL);
+		_autoconnect_index_ensure_bucket (priv->autoconnect_index, "", NULL);
+
+		c_list_for_each_entry (con, &priv->connections_lst_head, _connections_lst)
+			_autoconnect_index_add (priv, con);
+	}
+
+	bucket = g_hash_table_lookup (priv->autoconnect_index, connection_type ?: "");
+	if (!bucket) {
+		*out_len = 0;
+		return NULL;
+	}
+
+	*out_len = bucket->len;
+	return (NMSettingsConnection *const*) bucket->pdata;
+}
+
 NMSettingsConnection *
 nm_settings_get_connection_by_path (NMSettings *self, const char *path)
 {
@@ -778,6 +939,12 @@ load_plugins (NMSettings *self, const char **plugins, GError **error)
 static void
 connection_updated (NMSettingsConnection *connection, gboolean by_user, gpointer user_data)
 {
+	NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE ((NMSettings *) user_data);
+
+	/* only the bucket of this connection is affected. */
+	_autoconnect_index_remove (priv, connection);
+	_autoconnect_index_add (priv, connection);
+
 	g_signal_emit (NM_SETTINGS (user_data),
 	               signals[CONNECTION_UPDATED],
 	               0,
@@ -828,6 +995,7 @@ connection_removed (NMSettingsConnection *connection, gpointer user_data)
 
 	/* Forget about the connection internally */
 	_clear_connections_cached_list (priv);
+	_autoconnect_index_remove (priv, connection);
 	priv->connections_len--;
 	c_list_unlink (&connection->_connections_lst);
 
@@ -975,6 +1143,7 @@ claim_connection (NMSettings *self, NMSettingsConnection *sett_conn)
 	g_object_ref (self);
 	priv->connections_len++;
 	c_list_link_tail (&priv->connections_lst_head, &sett_conn->_connections_lst);
+	_autoconnect_index_add (priv, sett_conn);
 
 	path = nm_dbus_object_export (NM_DBUS_OBJECT (sett_conn));
 
@@ -1912,6 +2081,8 @@ finalize (GObject *object)
 	GSList *iter;
 
 	_clear_connections_cached_list (priv);
+	nm_clear_pointer (&priv->autoconnect_index_by_con, g_hash_table_unref);
+	nm_clear_pointer (&priv->autoconnect_index, g_hash_table_unref);
 
 	nm_assert (c_list_is_empty (&priv->connections_lst_head));
 
@@ -1971,6 +2142,15 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
 				),
 				.handle = impl_settings_get_connection_by_uuid,
 			),
+			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
+				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
+					"GetAllSettings",
+					.out_args = NM_DEFINE_GDBUS_ARG_INFOS (
+						NM_DEFINE_GDBUS_ARG_INFO ("settings", "a{oa{sa{sv}}}"),
+					),
+				),
+				.handle = impl_settings_get_all_settings,
+			),
 			NM_DEFINE_DBUS_METHOD_INFO_EXTENDED (
 				NM_DEFINE_GDBUS_METHOD_INFO_INIT (
 					"AddConnection",
@@ -94,6 +94,10 @@ NMSettingsConnection **nm_settings_get_connections_clone (NMSettings *self,
                                                           GCompareDataFunc sort_compare_func,
                                                           gpointer sort_data);
 
+NMSettingsConnection *const*nm_settings_get_autoconnect_connections (NMSettings *self,
+                                                                     const char *connection_type,
+                                                                     guint *out_len);
+
 NMSettingsConnection *nm_settings_add_connection (NMSettings *settings,
                                                   NMConnection *connection,
                                                   gboolean save_to_disk,
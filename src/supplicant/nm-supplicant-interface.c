@@ -41,8 +41,12 @@
 /*****************************************************************************/
 
 typedef struct {
-	GDBusProxy *proxy;
-	gulong change_id;
+	/* the D-Bus path of the BSS. Also the key in bss_table. */
+	char *path;
+
+	/* all properties of the BSS (a{sv}), or %NULL while the initial
+	 * GetAll call is still pending. */
+	GVariant *props;
 } BssData;
 
 struct _AddNetworkData;
@@ -126,7 +130,10 @@ typedef struct {
 	AssocData *    assoc_data;
 
 	char *         net_path;
-	GHashTable *   bss_proxies;
+	GHashTable *   bss_table;
+	guint          bss_pending_count;
+	guint          bss_props_changed_id;
+	GCancellable * bss_cancellable;
 	char *         current_bss;
 
 	gint64         last_scan; /* timestamp as returned by nm_utils_get_monotonic_timestamp_ms() */
@@ -194,121 +201,242 @@ bss_data_destroy (gpointer user_data)
 {
 	BssData *bss_data = user_data;
 
-	nm_clear_g_signal_handler (bss_data->proxy, &bss_data->change_id);
-	g_object_unref (bss_data->proxy);
+	g_free (bss_data->path);
+	nm_clear_pointer (&bss_data->props, g_variant_unref);
 	g_slice_free (BssData, bss_data);
 }
 
 static void
-bss_proxy_properties_changed_cb (GDBusProxy *proxy,
-                                 GVariant *changed_properties,
-                                 char **invalidated_properties,
-                                 gpointer user_data)
+bss_data_remove (NMSupplicantInterface *self, BssData *bss_data)
+{
+	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
+
+	if (!bss_data->props) {
+		nm_assert (priv->bss_pending_count > 0);
+		priv->bss_pending_count--;
+	}
+	g_hash_table_remove (priv->bss_table, bss_data);
+}
+
+static void
+bss_check_scan_done (NMSupplicantInterface *self)
+{
+	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
+
+	if (   priv->scan_done_pending
+	    && priv->bss_pending_count == 0)
+		scan_done_emit_signal (self);
+}
+
+static GVariant *
+bss_props_merge (GVariant *props, GVariant *changed_properties)
+{
+	GVariantDict dict;
+	GVariantIter iter;
+	const char *name;
+	GVariant *value;
+
+	g_variant_dict_init (&dict, props);
+	g_variant_iter_init (&iter, changed_properties);
+	while (g_variant_iter_next (&iter, "{&sv}", &name, &value)) {
+		g_variant_dict_insert_value (&dict, name, value);
+		g_variant_unref (value);
+	}
+	return g_variant_ref_sink (g_variant_dict_end (&dict));
+}
+
+static void
+bss_set_props (NMSupplicantInterface *self, BssData *bss_data, GVariant *props)
+{
+	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
+
+	if (!bss_data->props) {
+		nm_assert (priv->bss_pending_count > 0);
+		priv->bss_pending_count--;
+	} else
+		g_variant_unref (bss_data->props);
+	bss_data->props = g_variant_ref (props);
+
+	g_signal_emit (self, signals[BSS_UPDATED], 0,
+	               bss_data->path,
+	               props);
+
+	bss_check_scan_done (self);
+}
+
+static void
+bss_props_changed_cb (GDBusConnection *connection,
+                      const char *sender_name,
+                      const char *object_path,
+                      const char *interface_name,
+                      const char *signal_name,
+                      GVariant *parameters,
+                      gpointer user_data)
 {
 	NMSupplicantInterface *self = NM_SUPPLICANT_INTERFACE (user_data);
 	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
+	gs_unref_variant GVariant *changed_properties = NULL;
+	GVariant *props;
+	const char *iface;
+	BssData *bss_data;
+
+	if (!g_variant_is_of_type (parameters, G_VARIANT_TYPE ("(sa{sv}as)")))
+		return;
+
+	g_variant_get (parameters, "(&s@a{sv}^a&s)", &iface, &changed_properties, NULL);
+	if (!nm_streq (iface, WPAS_DBUS_IFACE_BSS))
+		return;
+
+	/* the subscription is shared by all BSS objects of wpa_supplicant. Only
+	 * the ones of this interface are in the table. */
+	bss_data = g_hash_table_lookup (priv->bss_table, &object_path);
+	if (!bss_data)
+		return;
+
+	if (!bss_data->props) {
+		/* the pending GetAll reply is queued after this signal and already
+		 * contains the change. */
+		return;
+	}
 
 	if (priv->scanning)
 		priv->last_scan = nm_utils_get_monotonic_timestamp_ms ();
 
+	props = bss_props_merge (bss_data->props, changed_properties);
+	g_variant_unref (bss_data->props);
+	bss_data->props = props;
+
 	g_signal_emit (self, signals[BSS_UPDATED], 0,
-	               g_dbus_proxy_get_object_path (proxy),
+	               bss_data->path,
 	               changed_properties);
 }
 
-static GVariant *
-bss_proxy_get_properties (NMSupplicantInterface *self, GDBusProxy *proxy)
+static void
+bss_props_changed_subscribe (NMSupplicantInterface *self)
 {
-	gs_strfreev char **properties = NULL;
-	GVariantBuilder builder;
-	char **iter;
+	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
 
-	iter = properties = g_dbus_proxy_get_cached_property_names (proxy);
+	nm_assert (priv->iface_proxy);
 
-	g_variant_builder_init (&builder, G_VARIANT_TYPE ("a{sv}"));
-	if (iter) {
-		while (*iter) {
-			GVariant *copy = g_dbus_proxy_get_cached_property (proxy, *iter);
+	if (priv->bss_props_changed_id)
+		return;
 
-			g_variant_builder_add (&builder, "{sv}", *iter++, copy);
-			g_variant_unref (copy);
-		}
-	}
-	return g_variant_builder_end (&builder);
+	priv->bss_cancellable = g_cancellable_new ();
+
+	/* one subscription for the PropertiesChanged signals of all BSS objects,
+	 * instead of a proxy with its own match rule per BSS. */
+	priv->bss_props_changed_id = g_dbus_connection_signal_subscribe (g_dbus_proxy_get_connection (priv->iface_proxy),
+	                                                                 WPAS_DBUS_SERVICE,
+	                                                                 DBUS_INTERFACE_PROPERTIES,
+	                                                                 "PropertiesChanged",
+	                                                                 NULL,
+	                                                                 WPAS_DBUS_IFACE_BSS,
+	                                                                 G_DBUS_SIGNAL_FLAGS_NONE,
+	                                                                 bss_props_changed_cb,
+	                                                                 self,
+	                                                                 NULL);
 }
 
 static void
-bss_proxy_acquired_cb (GDBusProxy *proxy, GAsyncResult *result, gpointer user_data)
+bss_props_changed_unsubscribe (NMSupplicantInterface *self)
+{
+	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
+
+	if (!priv->bss_props_changed_id)
+		return;
+
+	nm_assert (priv->iface_proxy);
+
+	g_dbus_connection_signal_unsubscribe (g_dbus_proxy_get_connection (priv->iface_proxy),
+	                                      priv->bss_props_changed_id);
+	priv->bss_props_changed_id = 0;
+	nm_clear_g_cancellable (&priv->bss_cancellable);
+}
+
+static void
+bss_get_all_cb (GObject *source, GAsyncResult *result, gpointer user_data)
 {
 	NMSupplicantInterface *self;
 	NMSupplicantInterfacePrivate *priv;
+	gs_free char *object_path = NULL;
 	gs_free_error GError *error = NULL;
-	GVariant *props = NULL;
-	const char *object_path;
+	gs_unref_variant GVariant *res = NULL;
+	gs_unref_variant GVariant *props = NULL;
 	BssData *bss_data;
-	gboolean success;
 
-	success = g_async_initable_init_finish (G_ASYNC_INITABLE (proxy), result, &error);
-	if (   !success
+	nm_utils_user_data_unpack (user_data, &self, &object_path);
+
+	res = g_dbus_connection_call_finish (G_DBUS_CONNECTION (source), result, &error);
+	if (   !res
 	    && g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
 		return;
 
-	self = NM_SUPPLICANT_INTERFACE (user_data);
 	priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
 
-	if (!success) {
-		_LOGD ("failed to acquire BSS proxy: (%s)", error->message);
-		g_hash_table_remove (priv->bss_proxies,
-		                     g_dbus_proxy_get_object_path (proxy));
+	bss_data = g_hash_table_lookup (priv->bss_table, &object_path);
+	if (!bss_data || bss_data->props)
 		return;
-	}
 
-	object_path = g_dbus_proxy_get_object_path (proxy);
-	bss_data = g_hash_table_lookup (priv->bss_proxies, object_path);
-	if (!bss_data)
+	if (!res) {
+		_LOGD ("failed to get properties of BSS %s: (%s)", object_path, error->message);
+		bss_data_remove (self, bss_data);
+		bss_check_scan_done (self);
 		return;
+	}
 
-	bss_data->change_id = g_signal_connect (proxy, "g-properties-changed", G_CALLBACK (bss_proxy_properties_changed_cb), self);
-
-	props = bss_proxy_get_properties (self, proxy);
-	g_signal_emit (self, signals[BSS_UPDATED], 0,
-	               g_dbus_proxy_get_object_path (proxy),
-	               g_variant_ref_sink (props));
-	g_variant_unref (props);
-
-	if (priv->scan_done_pending)
-		scan_done_emit_signal (self);
+	props = g_variant_get_child_value (res, 0);
+	bss_set_props (self, bss_data, props);
 }
 
 static void
-bss_add_new (NMSupplicantInterface *self, const char *object_path)
+bss_add_new (NMSupplicantInterface *self,
+             const char *object_path,
+             GVariant *props)
 {
 	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
-	GDBusProxy *bss_proxy;
 	BssData *bss_data;
 
 	g_return_if_fail (object_path != NULL);
 
-	if (g_hash_table_lookup (priv->bss_proxies, object_path))
+	if (   props
+	    && g_variant_n_children (props) == 0)
+		props = NULL;
+
+	bss_data = g_hash_table_lookup (priv->bss_table, &object_path);
+	if (bss_data) {
+		if (   props
+		    && !bss_data->props)
+			bss_set_props (self, bss_data, props);
 		return;
+	}
+
+	bss_props_changed_subscribe (self);
 
-	bss_proxy = g_object_new (G_TYPE_DBUS_PROXY,
-	                          "g-bus-type", G_BUS_TYPE_SYSTEM,
-	                          "g-flags", G_DBUS_PROXY_FLAGS_NONE,
-	                          "g-name", WPAS_DBUS_SERVICE,
-	                          "g-object-path", object_path,
-	                          "g-interface-name", WPAS_DBUS_IFACE_BSS,
-	                          NULL);
 	bss_data = g_slice_new0 (BssData);
-	bss_data->proxy = bss_proxy;
-	g_hash_table_insert (priv->bss_proxies,
-	                     (char *) g_dbus_proxy_get_object_path (bss_proxy),
-	                     bss_data);
-	g_async_initable_init_async (G_ASYNC_INITABLE (bss_proxy),
-	                             G_PRIORITY_DEFAULT,
-	                             priv->other_cancellable,
-	                             (GAsyncReadyCallback) bss_proxy_acquired_cb,
-	                             self);
+	bss_data->path = g_strdup (object_path);
+	g_hash_table_add (priv->bss_table, bss_data);
+	priv->bss_pending_count++;
+
+	if (props) {
+		/* BSSAdded already carries all properties. */
+		bss_set_props (self, bss_data, props);
+		return;
+	}
+
+	/* the BSSs we learn from the interface's "BSSs" property come in bulk.
+	 * Issue all GetAll calls at once, without waiting for each other. */
+	g_dbus_connection_call (g_dbus_proxy_get_connection (priv->iface_proxy),
+	                        WPAS_DBUS_SERVICE,
+	                        object_path,
+	                        DBUS_INTERFACE_PROPERTIES,
+	                        "GetAll",
+	                        g_variant_new ("(s)", WPAS_DBUS_IFACE_BSS),
+	                        G_VARIANT_TYPE ("(a{sv})"),
+	                        G_DBUS_CALL_FLAGS_NONE,
+	                        -1,
+	                        priv->bss_cancellable,
+	                        bss_get_all_cb,
+	                        nm_utils_user_data_pack (self, g_strdup (object_path)));
 }
 
 /*****************************************************************************/
@@ -336,6 +464,7 @@ set_state (NMSupplicantInterface *self, NMSupplicantInterfaceState new_state)
 		nm_clear_g_cancellable (&priv->init_cancellable);
 		nm_clear_g_cancellable (&priv->other_cancellable);
 
+		bss_props_changed_unsubscribe (self);
 		if (priv->iface_proxy)
 			g_signal_handlers_disconnect_by_data (priv->iface_proxy, self);
 	}
@@ -946,30 +1075,24 @@ static void
 scan_done_emit_signal (NMSupplicantInterface *self)
 {
 	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
-	const char *object_path;
 	BssData *bss_data;
 	gboolean success;
 	GHashTableIter iter;
 
-	g_hash_table_iter_init (&iter, priv->bss_proxies);
-	while (g_hash_table_iter_next (&iter, NULL, (gpointer *) &bss_data)) {
+	if (priv->bss_pending_count > 0) {
 		/* we have some BSS' that need to be initialized first. Delay
 		 * emitting signal. */
-		if (!bss_data->change_id) {
-			priv->scan_done_pending = TRUE;
-			return;
-		}
+		priv->scan_done_pending = TRUE;
+		return;
 	}
 
 	/* Emit BSS_UPDATED so that wifi device has the APs (in case it removed them) */
-	g_hash_table_iter_init (&iter, priv->bss_proxies);
-	while (g_hash_table_iter_next (&iter, (gpointer *) &object_path, (gpointer *) &bss_data)) {
-		gs_unref_variant GVariant *props = NULL;
-
-		props = bss_proxy_get_properties (self, bss_data->proxy);
+	g_hash_table_iter_init (&iter, priv->bss_table);
+	while (g_hash_table_iter_next (&iter, (gpointer *) &bss_data, NULL)) {
+		nm_assert (bss_data->props);
 		g_signal_emit (self, signals[BSS_UPDATED], 0,
-		               object_path,
-		               g_variant_ref_sink (props));
+		               bss_data->path,
+		               bss_data->props);
 	}
 
 	success = priv->scan_done_success;
@@ -1004,7 +1127,7 @@ wpas_iface_bss_added (GDBusProxy *proxy,
 	if (priv->scanning)
 		priv->last_scan = nm_utils_get_monotonic_timestamp_ms ();
 
-	bss_add_new (self, path);
+	bss_add_new (self, path, props);
 }
 
 static void
@@ -1016,12 +1139,12 @@ wpas_iface_bss_removed (GDBusProxy *proxy,
 	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
 	BssData *bss_data;
 
-	bss_data = g_hash_table_lookup (priv->bss_proxies, path);
+	bss_data = g_hash_table_lookup (priv->bss_table, &path);
 	if (!bss_data)
 		return;
-	g_hash_table_steal (priv->bss_proxies, path);
+	bss_data_remove (self, bss_data);
 	g_signal_emit (self, signals[BSS_REMOVED], 0, path);
-	bss_data_destroy (bss_data);
+	bss_check_scan_done (self);
 }
 
 static void
@@ -1069,7 +1192,7 @@ props_changed_cb (GDBusProxy *proxy,
 	if (g_variant_lookup (changed_properties, "BSSs", "^a&o", &array)) {
 		iter = array;
 		while (*iter)
-			bss_add_new (self, *iter++);
+			bss_add_new (self, *iter++, NULL);
 		g_free (array);
 	}
 
@@ -1130,6 +1253,7 @@ on_iface_proxy_acquired (GDBusProxy *proxy, GAsyncResult *result, gpointer user_
 	                         G_CALLBACK (wpas_iface_bss_removed), self);
 	_nm_dbus_signal_connect (priv->iface_proxy, "NetworkRequest", G_VARIANT_TYPE ("(oss)"),
 	                         G_CALLBACK (wpas_iface_network_request), self);
+	bss_props_changed_subscribe (self);
 
 	/* Scan result aging parameters */
 	g_dbus_proxy_call (priv->iface_proxy,
@@ -1791,7 +1915,9 @@ scan_request_cb (GDBusProxy *proxy, GAsyncResult *result, gpointer user_data)
 void
 nm_supplicant_interface_request_scan (NMSupplicantInterface *self,
                                       GBytes *const*ssids,
-                                      guint ssids_len)
+                                      guint ssids_len,
+                                      const guint32 *freqs,
+                                      guint freqs_len)
 {
 	NMSupplicantInterfacePrivate *priv;
 	GVariantBuilder builder;
@@ -1816,6 +1942,16 @@ nm_supplicant_interface_request_scan (NMSupplicantInterface *self,
 		}
 		g_variant_builder_add (&builder, "{sv}", "SSIDs", g_variant_builder_end (&ssids_builder));
 	}
+	if (freqs_len > 0) {
+		GVariantBuilder freqs_builder;
+
+		/* wpa_supplicant only scans the given center frequencies and
+		 * ignores the channel width. */
+		g_variant_builder_init (&freqs_builder, G_VARIANT_TYPE ("a(uu)"));
+		for (i = 0; i < freqs_len; i++)
+			g_variant_builder_add (&freqs_builder, "(uu)", freqs[i], (guint32) 20);
+		g_variant_builder_add (&builder, "{sv}", "Channels", g_variant_builder_end (&freqs_builder));
+	}
 
 	g_dbus_proxy_call (priv->iface_proxy,
 	                   "Scan",
@@ -1930,7 +2066,7 @@ nm_supplicant_interface_init (NMSupplicantInterface * self)
 	NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE (self);
 
 	priv->state = NM_SUPPLICANT_INTERFACE_STATE_INIT;
-	priv->bss_proxies = g_hash_table_new_full (nm_str_hash, g_str_equal, NULL, bss_data_destroy);
+	priv->bss_table = g_hash_table_new_full (nm_pstr_hash, nm_pstr_equal, bss_data_destroy, NULL);
 }
 
 NMSupplicantInterface *
@@ -1976,6 +2112,7 @@ dispose (GObject *object)
 		assoc_return (self, error, "cancelled due to dispose of supplicant interface");
 	}
 
+	bss_props_changed_unsubscribe (self);
 	if (priv->iface_proxy)
 		g_signal_handlers_disconnect_by_data (priv->iface_proxy, object);
 	g_clear_object (&priv->iface_proxy);
@@ -1984,7 +2121,7 @@ dispose (GObject *object)
 	nm_clear_g_cancellable (&priv->other_cancellable);
 
 	g_clear_object (&priv->wpas_proxy);
-	g_clear_pointer (&priv->bss_proxies, g_hash_table_destroy);
+	g_clear_pointer (&priv->bss_table, g_hash_table_destroy);
 
 	g_clear_pointer (&priv->net_path, g_free);
 	g_clear_pointer (&priv->dev, g_free);
@@ -102,7 +102,9 @@ const char *nm_supplicant_interface_get_object_path (NMSupplicantInterface * ifa
 
 void nm_supplicant_interface_request_scan (NMSupplicantInterface *self,
                                            GBytes *const*ssids,
-                                           guint ssids_len);
+                                           guint ssids_len,
+                                           const guint32 *freqs,
+                                           guint freqs_len);
 
 NMSupplicantInterfaceState nm_supplicant_interface_get_state (NMSupplicantInterface * self);
 
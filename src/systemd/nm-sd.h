@@ -39,5 +39,13 @@ struct sd_dhcp_lease;
 int dhcp_lease_save(struct sd_dhcp_lease *lease, const char *lease_file);
 int dhcp_lease_load(struct sd_dhcp_lease **ret, const char *lease_file);
 
+struct msghdr;
+
+int dhcp_network_get_pktinfo_ifindex(struct msghdr *msg);
+
+int dhcp_client_shared_udp_add(sd_dhcp_client *client);
+bool dhcp_client_shared_udp_remove(sd_dhcp_client *client);
+sd_dhcp_client *dhcp_client_shared_udp_lookup(struct msghdr *msg);
+
 #endif /* __NM_SD_H__ */
 
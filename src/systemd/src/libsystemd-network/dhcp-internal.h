@@ -24,6 +24,11 @@ int dhcp_network_send_raw_socket(int s, const union sockaddr_union *link,
                                  const void *packet, size_t len);
 int dhcp_network_send_udp_socket(int s, be32_t address, uint16_t port,
                                  const void *packet, size_t len);
+int dhcp_network_get_pktinfo_ifindex(struct msghdr *msg);
+
+int dhcp_client_shared_udp_add(sd_dhcp_client *client);
+bool dhcp_client_shared_udp_remove(sd_dhcp_client *client);
+sd_dhcp_client *dhcp_client_shared_udp_lookup(struct msghdr *msg);
 
 int dhcp_option_append(DHCPMessage *message, size_t size, size_t *offset, uint8_t overload,
                        uint8_t code, size_t optlen, const void *optval);
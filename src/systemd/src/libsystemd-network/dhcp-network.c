@@ -196,6 +196,22 @@ int dhcp_network_bind_udp_socket(int ifindex, be32_t address, uint16_t port) {
         return TAKE_FD(s);
 }
 
+/* NM: returns the ifindex of the IP_PKTINFO control message of @msg, or 0. */
+int dhcp_network_get_pktinfo_ifindex(struct msghdr *msg) {
+        struct cmsghdr *cmsg;
+
+        assert(msg);
+
+        CMSG_FOREACH(cmsg, msg) {
+                if (cmsg->cmsg_level == IPPROTO_IP &&
+                    cmsg->cmsg_type == IP_PKTINFO &&
+                    cmsg->cmsg_len == CMSG_LEN(sizeof(struct in_pktinfo)))
+                        return ((struct in_pktinfo *) CMSG_DATA(cmsg))->ipi_ifindex;
+        }
+
+        return 0;
+}
+
 int dhcp_network_send_raw_socket(int s, const union sockaddr_union *link,
                                  const void *packet, size_t len) {
         int r;
@@ -23,6 +23,8 @@
 #include "dhcp-lease-internal.h"
 #include "dhcp-protocol.h"
 #include "dns-domain.h"
+#include "fd-util.h"
+#include "hashmap.h"
 #include "hostname-util.h"
 #include "random-util.h"
 #include "string-util.h"
@@ -35,6 +37,10 @@
 #define RESTART_AFTER_NAK_MIN_USEC (1 * USEC_PER_SEC)
 #define RESTART_AFTER_NAK_MAX_USEC (30 * USEC_PER_MINUTE)
 
+/* NM: with shared I/O, the T1/T2 timers of all clients are coalesced into
+ * wakeups of this granularity. */
+#define SHARED_IO_TIMER_ACCURACY_USEC (1 * USEC_PER_SEC)
+
 struct sd_dhcp_client {
         unsigned n_ref;
 
@@ -97,6 +103,21 @@ struct sd_dhcp_client {
         void *userdata;
         sd_dhcp_lease *lease;
         usec_t start_delay;
+        bool shared_io;
+};
+
+/* NM: clients with shared I/O don't keep a UDP socket of their own while
+ * BOUND. Instead, a single socket receives the (FORCERENEW) messages for
+ * all of them and demultiplexes them by the ifindex of the packet. While
+ * RENEWING, the client binds its own socket as usual. Only this UDP socket
+ * is shared: in the other states, each client still uses a packet socket
+ * of its own. */
+static struct {
+        int fd;
+        sd_event_source *receive_message;
+        Hashmap *clients; /* ifindex -> sd_dhcp_client */
+} shared_udp = {
+        .fd = -1,
 };
 
 static const uint8_t default_req_opts[] = {
@@ -144,6 +165,9 @@ static int client_receive_message_udp(
                 uint32_t revents,
                 void *userdata);
 static void client_stop(sd_dhcp_client *client, int error);
+static int client_handle_udp_message(sd_dhcp_client *client, DHCPMessage *message, ssize_t len);
+static int client_shared_udp_register(sd_dhcp_client *client);
+static void client_shared_udp_unregister(sd_dhcp_client *client);
 
 int sd_dhcp_client_set_callback(
                 sd_dhcp_client *client,
@@ -515,6 +539,14 @@ int sd_dhcp_client_set_client_port(
         return 0;
 }
 
+int sd_dhcp_client_set_shared_io(sd_dhcp_client *client, int b) {
+        assert_return(client, -EINVAL);
+
+        client->shared_io = b;
+
+        return 0;
+}
+
 int sd_dhcp_client_set_mtu(sd_dhcp_client *client, uint32_t mtu) {
         assert_return(client, -EINVAL);
         assert_return(mtu >= DHCP_DEFAULT_MIN_SIZE, -ERANGE);
@@ -549,6 +581,7 @@ static int client_initialize(sd_dhcp_client *client) {
         client->receive_message = sd_event_source_unref(client->receive_message);
 
         client->fd = asynchronous_close(client->fd);
+        client_shared_udp_unregister(client);
 
         client->timeout_resend = sd_event_source_unref(client->timeout_resend);
 
@@ -1277,6 +1310,7 @@ static int client_timeout_t2(sd_event_source *s, uint64_t usec, void *userdata)
 
         client->receive_message = sd_event_source_unref(client->receive_message);
         client->fd = asynchronous_close(client->fd);
+        client_shared_udp_unregister(client);
 
         client->state = DHCP_STATE_REBINDING;
         client->attempt = 1;
@@ -1297,6 +1331,26 @@ static int client_timeout_t2(sd_event_source *s, uint64_t usec, void *userdata)
 static int client_timeout_t1(sd_event_source *s, uint64_t usec, void *userdata) {
         sd_dhcp_client *client = userdata;
         DHCP_CLIENT_DONT_DESTROY(client);
+        int r;
+
+        if (client->fd < 0) {
+                /* shared I/O: the replies to our requests are unicast to
+                 * the leased address; bind a socket for them. */
+                client_shared_udp_unregister(client);
+
+                r = dhcp_network_bind_udp_socket(client->ifindex, client->lease->address, client->port);
+                if (r < 0) {
+                        client_stop(client, r);
+                        return 0;
+                }
+                client->fd = r;
+
+                r = client_initialize_io_events(client, client_receive_message_udp);
+                if (r < 0) {
+                        client_stop(client, r);
+                        return 0;
+                }
+        }
 
         client->state = DHCP_STATE_RENEWING;
         client->attempt = 1;
@@ -1548,7 +1602,7 @@ static int client_set_lease_timeouts(sd_dhcp_client *client) {
                               &client->timeout_t2,
                               clock_boottime_or_monotonic(),
                               t2_timeout,
-                              10 * USEC_PER_MSEC,
+                              client->shared_io ? SHARED_IO_TIMER_ACCURACY_USEC : 10 * USEC_PER_MSEC,
                               client_timeout_t2, client);
         if (r < 0)
                 return r;
@@ -1573,7 +1627,8 @@ static int client_set_lease_timeouts(sd_dhcp_client *client) {
         r = sd_event_add_time(client->event,
                               &client->timeout_t1,
                               clock_boottime_or_monotonic(),
-                              t1_timeout, 10 * USEC_PER_MSEC,
+                              t1_timeout,
+                              client->shared_io ? SHARED_IO_TIMER_ACCURACY_USEC : 10 * USEC_PER_MSEC,
                               client_timeout_t1, client);
         if (r < 0)
                 return r;
@@ -1667,16 +1722,24 @@ static int client_handle_message(sd_dhcp_client *client, DHCPMessage *message, i
                                 goto error;
                         }
 
-                        r = dhcp_network_bind_udp_socket(client->ifindex, client->lease->address, client->port);
-                        if (r < 0) {
-                                log_dhcp_client(client, "could not bind UDP socket");
-                                goto error;
+                        if (client->shared_io && client->port == DHCP_PORT_CLIENT) {
+                                r = client_shared_udp_register(client);
+                                if (r < 0) {
+                                        log_dhcp_client(client, "could not register with shared UDP socket");
+                                        goto error;
+                                }
+                        } else {
+                                r = dhcp_network_bind_udp_socket(client->ifindex, client->lease->address, client->port);
+                                if (r < 0) {
+                                        log_dhcp_client(client, "could not bind UDP socket");
+                                        goto error;
+                                }
+
+                                client->fd = r;
+
+                                client_initialize_io_events(client, client_receive_message_udp);
                         }
 
-                        client->fd = r;
-
-                        client_initialize_io_events(client, client_receive_message_udp);
-
                         if (notify_event) {
                                 client_notify(client, notify_event);
                                 if (client->state == DHCP_STATE_STOPPED)
@@ -1748,9 +1811,6 @@ static int client_receive_message_udp(
 
         sd_dhcp_client *client = userdata;
         _cleanup_free_ DHCPMessage *message = NULL;
-        const struct ether_addr zero_mac = {};
-        const struct ether_addr *expected_chaddr = NULL;
-        uint8_t expected_hlen = 0;
         ssize_t len, buflen;
 
         assert(s);
@@ -1772,6 +1832,15 @@ static int client_receive_message_udp(
                 return log_dhcp_client_errno(client, errno,
                                              "Could not receive message from UDP socket: %m");
         }
+
+        return client_handle_udp_message(client, message, len);
+}
+
+static int client_handle_udp_message(sd_dhcp_client *client, DHCPMessage *message, ssize_t len) {
+        const struct ether_addr zero_mac = {};
+        const struct ether_addr *expected_chaddr = NULL;
+        uint8_t expected_hlen = 0;
+
         if ((size_t) len < sizeof(DHCPMessage)) {
                 log_dhcp_client(client, "Too small to be a DHCP message: ignoring");
                 return 0;
@@ -1823,6 +1892,131 @@ static int client_receive_message_udp(
         return client_handle_message(client, message, len);
 }
 
+static int shared_udp_receive_message(
+                sd_event_source *s,
+                int fd,
+                uint32_t revents,
+                void *userdata) {
+
+        _cleanup_free_ DHCPMessage *message = NULL;
+        uint8_t cmsgbuf[CMSG_SPACE(sizeof(struct in_pktinfo))];
+        struct iovec iov = {};
+        struct msghdr msg = {
+                .msg_iov = &iov,
+                .msg_iovlen = 1,
+                .msg_control = cmsgbuf,
+                .msg_controllen = sizeof(cmsgbuf),
+        };
+        sd_dhcp_client *client;
+        ssize_t len, buflen;
+
+        buflen = next_datagram_size_fd(fd);
+        if (buflen < 0)
+                return buflen;
+
+        message = malloc0(buflen);
+        if (!message)
+                return -ENOMEM;
+
+        iov.iov_base = message;
+        iov.iov_len = buflen;
+
+        len = recvmsg(fd, &msg, 0);
+        if (len < 0) {
+                if (IN_SET(errno, EAGAIN, EINTR))
+                        return 0;
+
+                return log_debug_errno(errno, "DHCP CLIENT: Could not receive message from shared UDP socket: %m");
+        }
+
+        client = dhcp_client_shared_udp_lookup(&msg);
+        if (!client)
+                return 0;
+
+        return client_handle_udp_message(client, message, len);
+}
+
+/* NM: the bookkeeping of the shared UDP socket is separate from the socket
+ * itself, so that the demultiplexing can be tested without binding port 68. */
+int dhcp_client_shared_udp_add(sd_dhcp_client *client) {
+        int r;
+
+        assert(client);
+        assert(client->ifindex > 0);
+
+        r = hashmap_ensure_allocated(&shared_udp.clients, NULL);
+        if (r < 0)
+                return r;
+
+        return hashmap_replace(shared_udp.clients, INT_TO_PTR(client->ifindex), client);
+}
+
+bool dhcp_client_shared_udp_remove(sd_dhcp_client *client) {
+        assert(client);
+
+        if (!hashmap_remove_value(shared_udp.clients, INT_TO_PTR(client->ifindex), client))
+                return false;
+
+        if (hashmap_isempty(shared_udp.clients))
+                shared_udp.clients = hashmap_free(shared_udp.clients);
+
+        return true;
+}
+
+sd_dhcp_client *dhcp_client_shared_udp_lookup(struct msghdr *msg) {
+        int ifindex;
+
+        assert(msg);
+
+        ifindex = dhcp_network_get_pktinfo_ifindex(msg);
+        if (ifindex <= 0)
+                return NULL;
+
+        return hashmap_get(shared_udp.clients, INT_TO_PTR(ifindex));
+}
+
+static int client_shared_udp_register(sd_dhcp_client *client) {
+        _cleanup_close_ int fd = -1;
+        int r;
+
+        assert(client);
+        assert(client->fd < 0);
+
+        if (shared_udp.fd < 0) {
+                fd = dhcp_network_bind_udp_socket(0, INADDR_ANY, DHCP_PORT_CLIENT);
+                if (fd < 0)
+                        return fd;
+
+                r = sd_event_add_io(client->event, &shared_udp.receive_message,
+                                    fd, EPOLLIN, shared_udp_receive_message, NULL);
+                if (r < 0)
+                        return r;
+
+                (void) sd_event_source_set_description(shared_udp.receive_message, "dhcp4-shared-receive-message");
+
+                shared_udp.fd = TAKE_FD(fd);
+        }
+
+        r = dhcp_client_shared_udp_add(client);
+        if (r < 0 && !shared_udp.clients) {
+                shared_udp.receive_message = sd_event_source_unref(shared_udp.receive_message);
+                shared_udp.fd = safe_close(shared_udp.fd);
+        }
+        return r;
+}
+
+static void client_shared_udp_unregister(sd_dhcp_client *client) {
+        assert(client);
+
+        if (!dhcp_client_shared_udp_remove(client))
+                return;
+
+        if (!shared_udp.clients) {
+                shared_udp.receive_message = sd_event_source_unref(shared_udp.receive_message);
+                shared_udp.fd = safe_close(shared_udp.fd);
+        }
+}
+
 static int client_receive_message_raw(
                 sd_event_source *s,
                 int fd,
@@ -355,6 +355,41 @@ test_strip_search_trailing_dot (void)
 
 /*****************************************************************************/
 
+static void
+test_merge_shares_objects (void)
+{
+	nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = nm_dedup_multi_index_new ();
+	const int IFINDEX = 1;
+	gs_unref_object NMIP6Config *src_conf = NULL;
+	gs_unref_object NMIP6Config *dst_conf = NULL;
+	NMDedupMultiIndexStats stats_before;
+	NMDedupMultiIndexStats stats;
+
+	src_conf = nm_ip6_config_new (multi_idx, IFINDEX);
+	dst_conf = nm_ip6_config_new (multi_idx, IFINDEX);
+
+	nm_ip6_config_add_route (src_conf, nmtst_platform_ip6_route ("abcd:1200::", 24, "abcd:1234:4321:cdde::2", NULL), NULL);
+	nm_ip6_config_add_route (src_conf, nmtst_platform_ip6_route ("2001::", 16, "2001:abba::2234", NULL), NULL);
+
+	nm_dedup_multi_index_get_stats (multi_idx, &stats_before);
+	g_assert_cmpint (stats_before.n_objs, ==, 2);
+	g_assert_cmpint (stats_before.n_objs_shared, ==, 0);
+
+	/* merging must reuse the interned routes of @src_conf instead of
+	 * creating new instances. */
+	nm_ip6_config_merge (dst_conf, src_conf, NM_IP_CONFIG_MERGE_DEFAULT, 0);
+	g_assert_cmpint (nm_ip6_config_get_num_routes (dst_conf), ==, 2);
+
+	nm_dedup_multi_index_get_stats (multi_idx, &stats);
+	g_assert_cmpint (stats.n_objs, ==, 2);
+	g_assert_cmpint (stats.n_objs_shared, ==, 2);
+	g_assert_cmpint (stats.n_refs_shared, ==, 2);
+	g_assert_cmpint (stats.intern_hits - stats_before.intern_hits, ==, 2);
+	g_assert_cmpint (stats.intern_lookups - stats_before.intern_lookups, ==, 2);
+}
+
+/*****************************************************************************/
+
 static void
 test_replace (gconstpointer user_data)
 {
@@ -433,6 +468,7 @@ main (int argc, char **argv)
 	g_test_add_func ("/ip6-config/add-route-with-source", test_add_route_with_source);
 	g_test_add_func ("/ip6-config/test_nm_ip6_config_addresses_sort", test_nm_ip6_config_addresses_sort);
 	g_test_add_func ("/ip6-config/strip-search-trailing-dot", test_strip_search_trailing_dot);
+	g_test_add_func ("/ip6-config/merge-shares-objects", test_merge_shares_objects);
 	g_test_add_data_func ("/ip6-config/replace/1", GINT_TO_POINTER (1), test_replace);
 	g_test_add_data_func ("/ip6-config/replace/2", GINT_TO_POINTER (2), test_replace);
 
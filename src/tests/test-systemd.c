@@ -19,6 +19,8 @@
 
 #include "nm-default.h"
 
+#include <netinet/in.h>
+
 #include "systemd/nm-sd.h"
 #include "systemd/nm-sd-utils.h"
 
@@ -94,6 +96,125 @@ test_dhcp_create (void)
 
 /*****************************************************************************/
 
+typedef struct {
+	struct msghdr msg;
+	union {
+		struct cmsghdr align;
+		guint8 buf[CMSG_SPACE (sizeof (int)) + CMSG_SPACE (sizeof (struct in_pktinfo))];
+	} control;
+} PktinfoMsg;
+
+/* Fills @m like recvmsg() on a socket with IP_PKTINFO would. If @other is set,
+ * another control message precedes the pktinfo. An @ifindex of zero means no
+ * pktinfo at all. */
+static struct msghdr *
+_pktinfo_msg_init (PktinfoMsg *m, int ifindex, gboolean other)
+{
+	struct cmsghdr *cmsg;
+	gsize len = 0;
+
+	memset (m, 0, sizeof (*m));
+	m->msg.msg_control = m->control.buf;
+	m->msg.msg_controllen = sizeof (m->control.buf);
+
+	cmsg = CMSG_FIRSTHDR (&m->msg);
+	if (other) {
+		cmsg->cmsg_level = IPPROTO_IP;
+		cmsg->cmsg_type = IP_TTL;
+		cmsg->cmsg_len = CMSG_LEN (sizeof (int));
+		*((int *) CMSG_DATA (cmsg)) = ifindex + 100;
+		len += CMSG_SPACE (sizeof (int));
+		cmsg = CMSG_NXTHDR (&m->msg, cmsg);
+	}
+	if (ifindex > 0) {
+		cmsg->cmsg_level = IPPROTO_IP;
+		cmsg->cmsg_type = IP_PKTINFO;
+		cmsg->cmsg_len = CMSG_LEN (sizeof (struct in_pktinfo));
+		((struct in_pktinfo *) CMSG_DATA (cmsg))->ipi_ifindex = ifindex;
+		len += CMSG_SPACE (sizeof (struct in_pktinfo));
+	}
+	m->msg.msg_controllen = len;
+	return &m->msg;
+}
+
+static void
+test_dhcp_shared_udp_pktinfo (void)
+{
+	PktinfoMsg m;
+
+	g_assert_cmpint (dhcp_network_get_pktinfo_ifindex (_pktinfo_msg_init (&m, 0, FALSE)), ==, 0);
+	g_assert_cmpint (dhcp_network_get_pktinfo_ifindex (_pktinfo_msg_init (&m, 0, TRUE)), ==, 0);
+	g_assert_cmpint (dhcp_network_get_pktinfo_ifindex (_pktinfo_msg_init (&m, 5, FALSE)), ==, 5);
+	g_assert_cmpint (dhcp_network_get_pktinfo_ifindex (_pktinfo_msg_init (&m, 7, TRUE)), ==, 7);
+
+	/* a truncated pktinfo is ignored. */
+	_pktinfo_msg_init (&m, 5, FALSE);
+	CMSG_FIRSTHDR (&m.msg)->cmsg_len = CMSG_LEN (sizeof (struct in_pktinfo) - 1);
+	g_assert_cmpint (dhcp_network_get_pktinfo_ifindex (&m.msg), ==, 0);
+}
+
+static sd_dhcp_client *
+_shared_udp_client_new (int ifindex)
+{
+	sd_dhcp_client *client = NULL;
+
+	g_assert_cmpint (sd_dhcp_client_new (&client, FALSE), ==, 0);
+	g_assert_cmpint (sd_dhcp_client_set_ifindex (client, ifindex), ==, 0);
+	g_assert_cmpint (sd_dhcp_client_set_shared_io (client, TRUE), ==, 0);
+	return client;
+}
+
+static void
+test_dhcp_shared_udp_demux (void)
+{
+	sd_dhcp_client *clients[4];
+	sd_dhcp_client *client_dup;
+	PktinfoMsg m;
+	guint i;
+
+	for (i = 0; i < G_N_ELEMENTS (clients); i++)
+		clients[i] = _shared_udp_client_new (i + 2);
+
+	g_assert (!dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 2, FALSE)));
+
+	for (i = 0; i < G_N_ELEMENTS (clients); i++)
+		g_assert_cmpint (dhcp_client_shared_udp_add (clients[i]), >=, 0);
+
+	/* every message goes to the client of its ifindex. */
+	for (i = 0; i < G_N_ELEMENTS (clients); i++) {
+		g_assert (dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, i + 2, FALSE)) == clients[i]);
+		g_assert (dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, i + 2, TRUE)) == clients[i]);
+	}
+	g_assert (!dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 0, FALSE)));
+	g_assert (!dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 0, TRUE)));
+	g_assert (!dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 1, FALSE)));
+	g_assert (!dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, G_N_ELEMENTS (clients) + 2, FALSE)));
+
+	/* a new client for the same interface takes over, and removing the
+	 * old one afterwards doesn't drop it. */
+	client_dup = _shared_udp_client_new (3);
+	g_assert_cmpint (dhcp_client_shared_udp_add (client_dup), >=, 0);
+	g_assert (dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 3, FALSE)) == client_dup);
+	g_assert (!dhcp_client_shared_udp_remove (clients[1]));
+	g_assert (dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 3, FALSE)) == client_dup);
+	g_assert (dhcp_client_shared_udp_remove (client_dup));
+	g_assert (!dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 3, FALSE)));
+	sd_dhcp_client_unref (client_dup);
+
+	g_assert (dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 2, FALSE)) == clients[0]);
+	g_assert (dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, 4, FALSE)) == clients[2]);
+
+	for (i = 0; i < G_N_ELEMENTS (clients); i++) {
+		if (i != 1)
+			g_assert (dhcp_client_shared_udp_remove (clients[i]));
+		g_assert (!dhcp_client_shared_udp_remove (clients[i]));
+		g_assert (!dhcp_client_shared_udp_lookup (_pktinfo_msg_init (&m, i + 2, FALSE)));
+		sd_dhcp_client_unref (clients[i]);
+	}
+}
+
+/*****************************************************************************/
+
 static void
 test_lldp_create (void)
 {
@@ -226,6 +347,8 @@ main (int argc, char **argv)
 	nmtst_init_assert_logging (&argc, &argv, "INFO", "ALL");
 
 	g_test_add_func ("/systemd/dhcp/create", test_dhcp_create);
+	g_test_add_func ("/systemd/dhcp/shared-udp/pktinfo", test_dhcp_shared_udp_pktinfo);
+	g_test_add_func ("/systemd/dhcp/shared-udp/demux", test_dhcp_shared_udp_demux);
 	g_test_add_func ("/systemd/lldp/create", test_lldp_create);
 	g_test_add_func ("/systemd/sd-event", test_sd_event);
 	g_test_add_func ("/systemd/test_path_equal", test_path_equal);